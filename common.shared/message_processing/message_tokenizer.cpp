@@ -86,6 +86,15 @@ void common::tools::message_tokenizer::parse(const tokenizer_string& _message, c
 
     const auto ranges_to_skip = get_ranges_to_skip_sorted(_formatting);
 
+    if (ranges_to_skip.empty() && !url_parser::has_url_anchor(_message))
+    {
+        if (!_message.empty())
+            add_text_token(tokenizer_string(_message), 0);
+
+        tokens_.push(message_token()); // terminator
+        return;
+    }
+
     auto get_next_range_start = [end_it = ranges_to_skip.cend(), end_pos = _message.size()](const auto it)
     {
         return (it == end_it) ? end_pos : it->first.offset_;
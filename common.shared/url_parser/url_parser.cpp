@@ -12,6 +12,7 @@
 #include "../config/config.h"
 
 #include <cctype>
+#include <cstring>
 #include <locale>
 
 namespace
@@ -32,6 +33,49 @@ namespace
 
     constexpr const char* LEFT_QUOTE = "‘";
     constexpr const char* RIGHT_QUOTE = "’";
+
+    constexpr char URL_ANCHORS[] = { '.', ':', '/', '@' };
+
+    template <typename Char>
+    bool is_url_anchor(Char _c) noexcept
+    {
+        return std::any_of(std::begin(URL_ANCHORS), std::end(URL_ANCHORS), [_c](auto _anchor) { return _c == Char(_anchor); });
+    }
+
+    // checks a machine word of chars at once: a lane equal to the anchor turns into a zero lane
+    template <typename Char>
+    bool has_url_anchor_impl(std::basic_string_view<Char> _text) noexcept
+    {
+        using word = uint64_t;
+        constexpr size_t lanes = sizeof(word) / sizeof(Char);
+        constexpr word ones = ~word(0) / ((word(1) << (8 * sizeof(Char))) - 1);
+        constexpr word highs = ones << (8 * sizeof(Char) - 1);
+
+        const auto has_lane = [](word _w, char _c) noexcept
+        {
+            const auto x = _w ^ (ones * word(_c));
+            return ((x - ones) & ~x & highs) != 0;
+        };
+
+        const auto data = _text.data();
+        const auto size = _text.size();
+
+        size_t i = 0;
+        for (; i + lanes <= size; i += lanes)
+        {
+            word w;
+            std::memcpy(&w, data + i, sizeof(w));
+            if (std::any_of(std::begin(URL_ANCHORS), std::end(URL_ANCHORS), [w, &has_lane](auto _anchor) { return has_lane(w, _anchor); }))
+                return true;
+        }
+
+        return std::any_of(data + i, data + size, [](auto _c) { return is_url_anchor(_c); });
+    }
+
+    bool is_ascii_space(char _c) noexcept
+    {
+        return _c == ' ' || _c == '\n' || _c == '\r' || _c == '\t';
+    }
 }
 
 const char* to_string(common::tools::url::type _value)
@@ -318,9 +362,16 @@ common::tools::url_vector_t common::tools::url_parser::parse_urls(const std::str
 {
     url_vector_t urls;
 
+    // nothing before the word holding the first anchor can be a part of an url
+    const auto first_anchor = std::find_if(_source.begin(), _source.end(), [](auto _c) { return is_url_anchor(_c); });
+    if (first_anchor == _source.end())
+        return urls;
+
+    const auto start = std::find_if(std::make_reverse_iterator(first_anchor), _source.rend(), is_ascii_space).base();
+
     url_parser parser(_files_url);
 
-    for (char c : _source)
+    for (char c : std::string_view(_source).substr(std::distance(_source.begin(), start)))
     {
         parser.process(c);
         if (parser.has_url())
@@ -341,6 +392,9 @@ common::tools::url_vector_t common::tools::url_parser_utf16::parse_urls(std::u16
 {
     url_vector_t urls;
 
+    if (!has_url_anchor(_source))
+        return urls;
+
     url_parser_utf16 parser(_files_url);
 
     for (char16_t c : _source)
@@ -360,6 +414,16 @@ common::tools::url_vector_t common::tools::url_parser_utf16::parse_urls(std::u16
     return urls;
 }
 
+bool common::tools::url_parser::has_url_anchor(std::string_view _text) noexcept
+{
+    return has_url_anchor_impl(_text);
+}
+
+bool common::tools::url_parser::has_url_anchor(std::u16string_view _text) noexcept
+{
+    return has_url_anchor_impl(_text);
+}
+
 void common::tools::url_parser::add_fixed_urls(std::vector<compare_item>&& _items)
 {
     for (auto&& item : _items)
@@ -367,7 +431,7 @@ void common::tools::url_parser::add_fixed_urls(std::vector<compare_item>&& _item
         if (item.str.empty())
             continue;
 
-        compare_set_.insert(item.str[0]);
+        compare_set_[static_cast<unsigned char>(item.str[0])] = true;
         fixed_urls_.push_back(std::move(item));
     }
 }
@@ -408,28 +472,52 @@ void common::tools::url_parser_utf16::process()
 {
     if (char16_buf_[0] != 0)
     {
-        static std::wstring_convert<std::codecvt_utf8_utf16<char16_t>, char16_t> convert;
-        std::u16string source;
-        source.resize(char16_size_);
-        for (auto i = 0; i < char16_size_; ++i)
-            source[i] = char16_buf_[i];
-        auto dest = std::string();
-        try
+        uint32_t code_point = char16_buf_[0];
+        const auto is_low_surrogate = [](char16_t _c) { return _c >= 0xdc00 && _c < 0xe000; };
+        if (char16_size_ == 2)
         {
-            dest = convert.to_bytes(source);
+            if (!is_low_surrogate(char16_buf_[1]))
+            {
+                char16_buf_.fill(0);
+                return;
+            }
+            code_point = 0x10000 + ((code_point - 0xd800) << 10) + (char16_buf_[1] - 0xdc00);
         }
-        catch (const std::range_error&)
+        else if (is_low_surrogate(char16_buf_[0]))
         {
-            // might happen on linux for invalid emoji
+            // an unpaired surrogate, e.g. a broken emoji
             char16_buf_.fill(0);
             return;
         }
-        assert(dest.size() <= char_buf_.size());
-        char_size_ = std::min(char_buf_.size(), dest.size());
+
         char_buf_.fill(0);
-        for (auto i = 0; i < char_size_; ++i)
-            char_buf_[i] = dest[i];
-        is_utf8_ = dest.size() > 1;
+        if (code_point < 0x80)
+        {
+            char_buf_[0] = static_cast<char>(code_point);
+            char_size_ = 1;
+        }
+        else if (code_point < 0x800)
+        {
+            char_buf_[0] = static_cast<char>(0xc0 | (code_point >> 6));
+            char_buf_[1] = static_cast<char>(0x80 | (code_point & 0x3f));
+            char_size_ = 2;
+        }
+        else if (code_point < 0x10000)
+        {
+            char_buf_[0] = static_cast<char>(0xe0 | (code_point >> 12));
+            char_buf_[1] = static_cast<char>(0x80 | ((code_point >> 6) & 0x3f));
+            char_buf_[2] = static_cast<char>(0x80 | (code_point & 0x3f));
+            char_size_ = 3;
+        }
+        else
+        {
+            char_buf_[0] = static_cast<char>(0xf0 | (code_point >> 18));
+            char_buf_[1] = static_cast<char>(0x80 | ((code_point >> 12) & 0x3f));
+            char_buf_[2] = static_cast<char>(0x80 | ((code_point >> 6) & 0x3f));
+            char_buf_[3] = static_cast<char>(0x80 | (code_point & 0x3f));
+            char_size_ = 4;
+        }
+        is_utf8_ = char_size_ > 1;
         char16_buf_.fill(0);
     }
 
@@ -444,7 +532,7 @@ void common::tools::url_parser::process()
     {
     case states::lookup:
         num_processed_chars_since_url_start_ = 1;
-        if (compare_set_.count(c)) { start_fixed_urls_compare(states::lookup_without_fixed_urls); return; }
+        if (compare_set_[static_cast<unsigned char>(c)]) { start_fixed_urls_compare(states::lookup_without_fixed_urls); return; }
         [[fallthrough]];
     case states::lookup_without_fixed_urls:
         if (c == 'w' || c == 'W') { state_ = states::www_2; break; }
@@ -579,7 +667,7 @@ void common::tools::url_parser::process()
         break;
     case states::check_www:
         if (c == 'w' || c == 'W') state_ = states::www_2;
-        else if (compare_set_.count(c)) { start_fixed_urls_compare(); return; }
+        else if (compare_set_[static_cast<unsigned char>(c)]) { start_fixed_urls_compare(); return; }
         else if (is_allowable_char(c, is_utf8_)) { save_char_buf(domain_); state_ = states::host; }
         else URL_PARSER_RESET_PARSER
             break;
@@ -630,7 +718,7 @@ void common::tools::url_parser::process()
         else if (!is_allowed_profile_id_char(c, is_utf8_)) URL_PARSER_RESET_PARSER
             break;
     case states::check_filesharing:
-        if (compare_set_.count(c)) { start_fixed_urls_compare(); return; }
+        if (compare_set_[static_cast<unsigned char>(c)]) { start_fixed_urls_compare(); return; }
         else if (is_allowable_char(c, is_utf8_)) { save_char_buf(domain_); state_ = states::host; }
         else URL_PARSER_RESET_PARSER
             break;
@@ -1398,7 +1486,7 @@ void common::tools::url_parser::init_fixed_urls_compare()
     for (const auto& item : fixed_urls_)
     {
         if (!item.str.empty())
-            compare_set_.insert(item.str[0]);
+            compare_set_[static_cast<unsigned char>(item.str[0])] = true;
     }
 }
 
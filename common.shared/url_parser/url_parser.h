@@ -200,6 +200,11 @@ namespace common
 
             static url_vector_t parse_urls(const std::string& _source, const std::string& _files_url);
 
+            // every url, fixed ones included, has one of . : / @ in it;
+            // texts without them can skip the state machine
+            static bool has_url_anchor(std::string_view _text) noexcept;
+            static bool has_url_anchor(std::u16string_view _text) noexcept;
+
             void add_fixed_urls(std::vector<compare_item>&& _items);
 
         protected:
@@ -260,7 +265,7 @@ namespace common
 
             int num_processed_chars_since_url_start_ = 0;
             std::vector<compare_item> fixed_urls_;
-            std::set<char> compare_set_;
+            std::array<bool, 256> compare_set_ = {};
 
             states ok_state_;
             states fallback_state_;
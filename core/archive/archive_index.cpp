@@ -190,7 +190,9 @@ void archive_index::insert_header(archive::message_header& header, const std::ch
 
 void archive_index::notify_core_outgoing_msg_count()
 {
-    g_core->update_outgoing_msg_count(aimid_, get_outgoing_count());
+    // absent when the index is used outside of the running core, e.g. by core_benchmarks
+    if (g_core)
+        g_core->update_outgoing_msg_count(aimid_, get_outgoing_count());
 }
 
 bool archive_index::get_header(int64_t _msgid, message_header& _header) const
@@ -8,6 +8,7 @@
 #include "message_flags.h"
 #include "errors.h"
 #include "storage.h"
+#include "../stats/memory/memory_accounting.h"
 
 namespace core
 {
@@ -19,7 +20,8 @@ namespace core
         typedef std::list<message_header> headers_list;
         typedef std::shared_ptr<headers_list> headers_list_sptr;
 
-        typedef std::map<int64_t, message_header> headers_map;
+        typedef std::map<int64_t, message_header, std::less<int64_t>,
+            memory_stats::counting_allocator<std::pair<const int64_t, message_header>, memory_stats::memory_tag::archive>> headers_map;
 
         class archive_hole
         {
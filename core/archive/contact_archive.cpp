@@ -24,16 +24,16 @@
 using namespace core;
 using namespace archive;
 
-contact_archive::contact_archive(std::wstring _archive_path, const std::string& _contact_id)
+contact_archive::contact_archive(std::wstring _archive_path, const std::string& _contact_id, const std::shared_ptr<kv_store>& _store)
     : path_(std::move(_archive_path))
     , index_(std::make_unique<archive_index>(su::wconcat(path_, L'/', index_filename()), _contact_id))
     , data_(std::make_unique<messages_data>(su::wconcat(path_, L'/', db_filename())))
-    , state_(std::make_unique<archive_state>(su::wconcat(path_, L'/', dlg_state_filename()), _contact_id))
-    , mentions_(std::make_unique<mentions_me>(su::wconcat(path_, L'/', mentions_filename())))
+    , state_(std::make_unique<archive_state>(su::wconcat(path_, L'/', dlg_state_filename()), _contact_id, _store))
+    , mentions_(std::make_unique<mentions_me>(su::wconcat(path_, L'/', mentions_filename()), _contact_id, _store))
     , gallery_(std::make_unique<gallery_storage>(su::wconcat(path_, L'/', gallery_cache_filename()), su::wconcat(path_, L'/', gallery_state_filename())))
     , reactions_(std::make_unique<reactions_storage>(su::wconcat(path_, L'/', reactions_index_filename()), su::wconcat(path_, L'/', reactions_data_filename())))
     , thread_updates_(std::make_unique<thread_update_storage>(su::wconcat(path_, L'/', thread_updates_index_filename()), su::wconcat(path_, L'/', thread_updates_data_filename())))
-    , draft_(std::make_unique<draft_storage>(su::wconcat(path_, L'/', draft_filename())))
+    , draft_(std::make_unique<draft_storage>(su::wconcat(path_, L'/', draft_filename()), _contact_id, _store))
     , local_loaded_(false)
     , load_metrics_({0})
 {
@@ -108,15 +108,15 @@ bool contact_archive::get_messages_buddies_from_ids(const archive::msgids_list&
         _headers.emplace_back(std::move(msg_header));
     }
 
-    return get_messages_buddies_from_headers(_headers, _messages, _errors);
+    return get_messages_buddies_from_headers(_headers, _messages, _errors, message_decode::full);
 }
 
-bool contact_archive::get_messages_buddies_from_headers(const headers_list& _headers, history_block& _messages, error_vector& _errors) const
+bool contact_archive::get_messages_buddies_from_headers(const headers_list& _headers, history_block& _messages, error_vector& _errors, message_decode _decode) const
 {
     if (_headers.empty())
         return false;
 
-    _errors = data_->get_messages(_headers, _messages);
+    _errors = data_->get_messages(_headers, _messages, _decode);
 
     for (auto id : boost::adaptors::keys(std::as_const(_errors)))
     {
@@ -132,9 +132,9 @@ bool contact_archive::get_messages_buddies(const std::shared_ptr<archive::msgids
     return get_messages_buddies_from_ids(*_ids, *_messages, *_errors);
 }
 
-bool contact_archive::get_messages_buddies(const headers_list& _headers, const std::shared_ptr<history_block>& _messages, const std::shared_ptr<error_vector>& _errors) const
+bool contact_archive::get_messages_buddies(const headers_list& _headers, const std::shared_ptr<history_block>& _messages, const std::shared_ptr<error_vector>& _errors, message_decode _decode) const
 {
-    return get_messages_buddies_from_headers(_headers, *_messages, *_errors);
+    return get_messages_buddies_from_headers(_headers, *_messages, *_errors, _decode);
 }
 
 dlg_state contact_archive::get_dlg_state() const
@@ -523,7 +523,7 @@ std::optional<std::string> contact_archive::get_locale() const
     headers_list headers;
     get_messages_index(-1, count, 0, headers);
     error_vector errors;
-    get_messages_buddies_from_headers(headers, messages, errors);
+    get_messages_buddies_from_headers(headers, messages, errors, message_decode::header_and_text);
 
 #ifndef STRIP_RE2
     const static RE2 reg(russian_letters());
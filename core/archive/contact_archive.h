@@ -14,6 +14,7 @@ namespace core
         struct dlg_state_changes;
         class archive_hole;
         enum class archive_hole_error;
+        enum class message_decode;
         class archive_state;
         class image_data;
         class mentions_me;
@@ -27,6 +28,7 @@ namespace core
         struct thread_update;
         class draft_storage;
         struct draft;
+        class kv_store;
 
         using image_list = std::list<image_data>;
         using history_block = std::vector<std::shared_ptr<history_message>>;
@@ -58,7 +60,7 @@ namespace core
             } load_metrics_;
 
             bool get_messages_buddies_from_ids(const archive::msgids_list& _ids, history_block& _messages, error_vector& _errors) const;
-            bool get_messages_buddies_from_headers(const headers_list& _headers, history_block& _messages, error_vector& _errors) const;
+            bool get_messages_buddies_from_headers(const headers_list& _headers, history_block& _messages, error_vector& _errors, message_decode _decode) const;
 
         public:
 
@@ -72,7 +74,7 @@ namespace core
             void get_messages_index(int64_t _from, int64_t _count_early, int64_t _count_later, headers_list& _headers) const;
 
             bool get_messages_buddies(const std::shared_ptr<archive::msgids_list>& _ids, const std::shared_ptr<history_block>& _messages, const std::shared_ptr<error_vector>& _errors) const;
-            bool get_messages_buddies(const headers_list& _headers, const std::shared_ptr<history_block>& _messages, const std::shared_ptr<error_vector>& _errors) const;
+            bool get_messages_buddies(const headers_list& _headers, const std::shared_ptr<history_block>& _messages, const std::shared_ptr<error_vector>& _errors, message_decode _decode) const;
 
             static bool get_history_file(const std::wstring& _file_name, core::tools::binary_stream& _data
                 , const std::shared_ptr<int64_t>& _offset, const std::shared_ptr<int64_t>& _remaining_size, int64_t& _cur_index, const std::shared_ptr<int64_t>& _mode);
@@ -115,7 +117,7 @@ namespace core
 
             void delete_messages_up_to(const int64_t _up_to);
 
-            contact_archive(std::wstring _archive_path, const std::string& _contact_id);
+            contact_archive(std::wstring _archive_path, const std::string& _contact_id, const std::shared_ptr<kv_store>& _store);
             ~contact_archive();
 
             void add_mention(const std::shared_ptr<archive::history_message>& _message);
@@ -5,11 +5,13 @@
 
 #include "../../core/core.h"
 #include "tools/coretime.h"
+#include "tools/system.h"
 
 #include "../log/log.h"
 
 #include "history_message.h"
 #include "storage.h"
+#include "kv_store.h"
 #include "draft_storage.h"
 
 #include "dlg_state.h"
@@ -553,8 +555,9 @@ dlg_state_changes::dlg_state_changes()
 {
 }
 
-archive_state::archive_state(std::wstring _file_name, std::string _contact_id)
-    : storage_(std::make_unique<storage>(std::move(_file_name)))
+archive_state::archive_state(std::wstring _file_name, std::string _contact_id, std::shared_ptr<kv_store> _store)
+    : store_(std::move(_store))
+    , legacy_storage_(std::make_unique<storage>(std::move(_file_name)))
     , contact_id_(std::move(_contact_id))
 {
     im_assert(!contact_id_.empty());
@@ -573,12 +576,6 @@ bool archive_state::save()
         return false;
     }
 
-    archive::storage_mode mode;
-    mode.flags_.write_ = true;
-    mode.flags_.truncate_ = true;
-    if (!storage_->open(mode))
-        return false;
-
     __INFO(
         "delete_history",
         "serializing dialog state\n"
@@ -587,32 +584,47 @@ bool archive_state::save()
         "    del-up-to=<%3%>",
         contact_id_ % state_->get_history_patch_version().as_string() % state_->get_del_up_to());
 
-    auto p_storage = storage_.get();
-    core::tools::auto_scope lb([p_storage]{p_storage->close();});
-
     core::tools::binary_stream block_data;
     state_->serialize(block_data);
 
-    int64_t offset = 0;
-    return storage_->write_data_block(block_data, offset);
+    store_->put(kv_family::dlg_state, contact_id_, block_data);
+    return true;
 }
 
 bool archive_state::load()
+{
+    core::tools::binary_stream state_stream;
+    if (!store_->get(kv_family::dlg_state, contact_id_, state_stream))
+        return load_legacy();
+
+    return state_->unserialize(state_stream);
+}
+
+bool archive_state::load_legacy()
 {
     archive::storage_mode mode;
     mode.flags_.read_ = true;
 
-    if (!storage_->open(mode))
+    if (!legacy_storage_->open(mode))
         return false;
 
-    auto p_state_storage = storage_.get();
-    core::tools::auto_scope lbs([p_state_storage]{p_state_storage->close();});
-
     core::tools::binary_stream state_stream;
-    if (!storage_->read_data_block(-1, state_stream))
+    {
+        auto p_state_storage = legacy_storage_.get();
+        core::tools::auto_scope lbs([p_state_storage]{p_state_storage->close();});
+
+        if (!legacy_storage_->read_data_block(-1, state_stream))
+            return false;
+    }
+
+    if (!state_->unserialize(state_stream))
         return false;
 
-    return state_->unserialize(state_stream);
+    // the file is deleted only when the state is on disk in the store
+    if (save() && store_->commit())
+        core::tools::system::delete_file(legacy_storage_->get_file_name());
+
+    return true;
 }
 
 void dlg_state::set_heads(std::vector<dlg_state_head>&& _heads)
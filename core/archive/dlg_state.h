@@ -15,6 +15,7 @@ namespace core
     namespace archive
     {
         class storage;
+        class kv_store;
         class history_message;
         struct draft;
 
@@ -194,14 +195,17 @@ namespace core
         class archive_state
         {
             std::unique_ptr<dlg_state> state_;
-            std::unique_ptr<storage> storage_;
+            std::shared_ptr<kv_store> store_;
+            // the file of a version before the store, read once to migrate
+            std::unique_ptr<storage> legacy_storage_;
             const std::string contact_id_;
 
             bool load();
+            bool load_legacy();
 
         public:
 
-            archive_state(std::wstring _file_name, std::string _contact_id);
+            archive_state(std::wstring _file_name, std::string _contact_id, std::shared_ptr<kv_store> _store);
             ~archive_state();
 
             bool merge_state(const dlg_state& _new_state, Out dlg_state_changes& _changes);
@@ -1,5 +1,6 @@
 #include "stdafx.h"
 #include "draft_storage.h"
+#include "kv_store.h"
 #include "../corelib/collection_helper.h"
 #include "../../common.shared/json_helper.h"
 #include "tools/system.h"
@@ -111,8 +112,10 @@ bool draft::unserialize(const rapidjson::Value& _node, const std::string& _conta
     return timestamp_ > 0 && message_->unserialize(_node, _contact);
 }
 
-draft_storage::draft_storage(std::wstring _data_path)
+draft_storage::draft_storage(std::wstring _data_path, std::string _contact_id, std::shared_ptr<kv_store> _store)
     : path_(std::move(_data_path))
+    , contact_id_(std::move(_contact_id))
+    , store_(std::move(_store))
 {
     load();
 }
@@ -127,28 +130,53 @@ void draft_storage::set_draft(const draft& _draft)
     if (is_first_same_or_newer(_draft, draft_))
     {
         draft_ = _draft;
-        write_file();
+        save();
     }
 }
 
 void draft_storage::load()
 {
     core::tools::binary_stream bstream;
-    if (!bstream.load_from_file(path_))
+    if (!store_->get(kv_family::draft, contact_id_, bstream))
+    {
+        load_legacy();
         return;
+    }
 
     if (!draft_.unserialize(bstream))
     {
-        core::tools::system::delete_file(path_);
+        store_->remove(kv_family::draft, contact_id_);
+        draft_ = {};
+    }
+}
+
+void draft_storage::load_legacy()
+{
+    core::tools::binary_stream bstream;
+    if (!bstream.load_from_file(path_))
+        return;
+
+    if (draft_.unserialize(bstream))
+    {
+        if (!save())
+            return;
+    }
+    else
+    {
         draft_ = {};
     }
+
+    core::tools::system::delete_file(path_);
 }
 
-void draft_storage::write_file()
+bool draft_storage::save()
 {
     core::tools::binary_stream bstream;
     draft_.serialize(bstream);
-    bstream.save_2_file(path_);
+    store_->put(kv_family::draft, contact_id_, bstream);
+
+    // the user typed it, so it is on disk right away as with the file, not at the next batch
+    return store_->commit();
 }
 
 }
@@ -4,6 +4,8 @@
 
 namespace core::archive
 {
+    class kv_store;
+
     struct draft
     {
         enum class state { local, syncing, synced };
@@ -25,17 +27,21 @@ namespace core::archive
     class draft_storage
     {
     public:
-        draft_storage(std::wstring _data_path);
+        draft_storage(std::wstring _data_path, std::string _contact_id, std::shared_ptr<kv_store> _store);
 
         const draft& get_draft() noexcept;
         void set_draft(const draft& _draft);
 
     private:
         void load();
-        void write_file();
+        void load_legacy();
+        bool save();
 
         draft draft_;
+        // the file of a version before the store, read once to migrate
         std::wstring path_;
+        std::string contact_id_;
+        std::shared_ptr<kv_store> store_;
     };
 }
 
@@ -46,10 +46,75 @@ namespace
 
     const auto consistency_valid_value = 0.95;
     const auto consistency_check_period = std::chrono::hours(24);
+
+    // up to _limit positions from all _lists merged, starting at _start inclusive and going in one direction
+    std::vector<uint32_t> collect_positions(const std::vector<const std::vector<uint32_t>*>& _lists, size_t _start, bool _descending, size_t _limit)
+    {
+        std::vector<size_t> cursors;
+        cursors.reserve(_lists.size());
+        for (const auto list : _lists)
+        {
+            const auto iter = _descending
+                ? std::upper_bound(list->begin(), list->end(), _start)
+                : std::lower_bound(list->begin(), list->end(), _start);
+            cursors.push_back(std::distance(list->begin(), iter));
+        }
+
+        std::vector<uint32_t> result;
+        while (result.size() < _limit)
+        {
+            auto best = _lists.size();
+            for (size_t i = 0; i < _lists.size(); ++i)
+            {
+                const auto& list = *_lists[i];
+                if (_descending ? cursors[i] == 0 : cursors[i] == list.size())
+                    continue;
+
+                if (best == _lists.size())
+                {
+                    best = i;
+                    continue;
+                }
+
+                const auto candidate = _descending ? list[cursors[i] - 1] : list[cursors[i]];
+                const auto current = _descending ? (*_lists[best])[cursors[best] - 1] : (*_lists[best])[cursors[best]];
+                if (_descending ? candidate > current : candidate < current)
+                    best = i;
+            }
+
+            if (best == _lists.size())
+                break;
+
+            if (_descending)
+                result.push_back((*_lists[best])[--cursors[best]]);
+            else
+                result.push_back((*_lists[best])[cursors[best]++]);
+        }
+
+        return result;
+    }
 }
 
 using namespace core::archive;
 
+gallery_item_type core::archive::to_gallery_item_type(std::string_view _type) noexcept
+{
+    if (_type == "image")
+        return gallery_item_type::image;
+    if (_type == "video")
+        return gallery_item_type::video;
+    if (_type == "file")
+        return gallery_item_type::file;
+    if (_type == "link")
+        return gallery_item_type::link;
+    if (_type == "ptt")
+        return gallery_item_type::ptt;
+    if (_type == "audio")
+        return gallery_item_type::audio;
+
+    return gallery_item_type::unknown;
+}
+
 gallery_entry_id::gallery_entry_id(int64_t _msg_id, int64_t _seq)
     : msg_id_(_msg_id)
     , seq_(_seq)
@@ -288,6 +353,7 @@ void gallery_storage::free()
     aimid_ = std::string();
     state_ = gallery_state();
     items_.clear();
+    invalidate_type_index();
     patches_.clear();
     older_entry_id_ = gallery_entry_id();
     first_entry_reached_ = false;
@@ -322,6 +388,8 @@ const gallery_state& gallery_storage::get_gallery_state() const
 
 void gallery_storage::merge_from_server(const gallery_storage& _other, const gallery_entry_id& _from, const gallery_entry_id& _till, std::vector<gallery_item>& _changes)
 {
+    invalidate_type_index();
+
     if (_other.delUpTo_ != -1)
     {
         auto iter = items_.begin();
@@ -343,7 +411,7 @@ void gallery_storage::merge_from_server(const gallery_storage& _other, const gal
 
     auto contains = [this](const auto& _item_id)
     {
-        return std::any_of(items_.begin(), items_.end(), [_item_id](const auto& iter) { return iter.id_ == _item_id; });
+        return find_item(_item_id) != items_.end();
     };
 
     auto hole = false;
@@ -362,7 +430,8 @@ void gallery_storage::merge_from_server(const gallery_storage& _other, const gal
     auto max_count_reached = false;
     for (const auto& i : _other.items_)
     {
-        if (std::find(items_.begin(), items_.end(), i) != items_.end())
+        const auto iter = std::lower_bound(items_.begin(), items_.end(), i);
+        if (iter != items_.end() && *iter == i)
             continue;
 
         auto ch = i;
@@ -383,22 +452,9 @@ void gallery_storage::merge_from_server(const gallery_storage& _other, const gal
             continue;
         }
 
-        auto prev = items_.end();
-        auto iter = items_.begin();
-        for (;iter != items_.end(); ++iter)
-        {
-            if (*(iter) < i)
-            {
-                prev = iter;
-                continue;
-            }
-
-            break;
-        }
-
         auto next = iter == items_.end() ? gallery_entry_id() : iter->id_;
-        if (prev != items_.end() && !hole)
-            prev->next_ = i.id_;
+        if (iter != items_.begin() && !hole)
+            std::prev(iter)->next_ = i.id_;
 
         auto inserted = items_.insert(iter, i);
         inserted->next_ = next;
@@ -430,21 +486,14 @@ void gallery_storage::merge_from_server(const gallery_storage& _other, const gal
     {
         for (const auto& p : _other.patches_)
         {
-        auto iter = items_.begin();
-        while (iter != items_.end())
+        auto iter = std::lower_bound(items_.begin(), items_.end(), gallery_entry_id(p.msg_id_, std::numeric_limits<int64_t>::min()), [](const auto& _item, const auto& _id) { return _item.id_ < _id; });
+        while (iter != items_.end() && iter->id_.msg_id_ == p.msg_id_)
         {
-            if (iter->id_.msg_id_ == p.msg_id_)
-            {
-                iter = items_.erase(iter);
-                if (!items_.empty() && iter != items_.begin() && p.type_ == "del")
-                {
-                    auto prev = std::prev(iter);
-                    prev->next_ = (iter == items_.end()) ? gallery_entry_id() : iter->id_;
-                }
-            }
-            else
+            iter = items_.erase(iter);
+            if (!items_.empty() && iter != items_.begin() && p.type_ == "del")
             {
-                ++iter;
+                auto prev = std::prev(iter);
+                prev->next_ = (iter == items_.end()) ? gallery_entry_id() : iter->id_;
             }
         }
 
@@ -455,10 +504,10 @@ void gallery_storage::merge_from_server(const gallery_storage& _other, const gal
         }
     }
 
-    auto erase_item = [this](auto _id, auto pred)
+    auto erase_item = [this](auto _id)
     {
         auto state_changed = false;
-        auto found = std::find_if(items_.begin(), items_.end(), pred);
+        auto found = find_item(_id);
         if (found == items_.end())
             return;
 
@@ -495,12 +544,12 @@ void gallery_storage::merge_from_server(const gallery_storage& _other, const gal
     auto find_from = [_from](auto iter) { return iter.id_ == _from; };
     auto contains_from = (std::find_if(_other.items_.begin(), _other.items_.end(), find_from) != _other.items_.end());
     if (!_from.empty() && !contains_from)
-        erase_item(_from, find_from);
+        erase_item(_from);
 
     auto find_till = [_till](auto iter) { return iter.id_ == _till; };
     auto contains_till = (std::find_if(_other.items_.begin(), _other.items_.end(), find_till) != _other.items_.end());
     if (_other.items_.size() < 1000 && !_till.empty() && !contains_till)
-        erase_item(_till, find_till);
+        erase_item(_till);
 
     if (_other.items_.size() < 1000 && !_from.empty() && !_till.empty())
     {
@@ -562,6 +611,8 @@ void gallery_storage::set_state(const gallery_state& _state, bool _store_patch_v
 
 int32_t gallery_storage::unserialize(const rapidjson::Value& _node, bool _parse_for_patches)
 {
+    invalidate_type_index();
+
     tools::unserialize_value(_node, "delUpto", delUpTo_);
 
     const auto node_state = _node.FindMember("galleryState");
@@ -685,6 +736,49 @@ std::vector<gallery_item> gallery_storage::get_items(const gallery_entry_id& _fr
         return result;
     }
 
+    if (const auto lists = get_type_positions(_types); lists && (!_from.empty() || _page_size >= 0))
+    {
+        // the same page as the scan below gives, one extra item tells if there are more
+        const auto limit = static_cast<size_t>(std::abs(_page_size)) + 1;
+
+        auto descending = true;
+        auto start = items_.size() - 1;
+        if (!_from.empty())
+        {
+            const auto iter = find_item(_from);
+            if (iter == items_.end())
+            {
+                _exhausted = true;
+                return result;
+            }
+
+            const auto pos = static_cast<size_t>(std::distance(items_.begin(), iter));
+            if (_page_size > 0 && pos == 0)
+            {
+                _exhausted = !state_.first_entry_.empty();
+                return result;
+            }
+
+            descending = _page_size > 0;
+            start = descending ? pos - 1 : pos + 1;
+        }
+
+        const auto positions = collect_positions(*lists, start, descending, limit);
+        result.reserve(positions.size());
+        for (const auto pos : positions)
+            result.push_back(items_[pos]);
+
+        const auto boundary = descending ? 0 : items_.size() - 1;
+        const auto reached_end = positions.size() < limit || positions.back() == boundary;
+        if (reached_end && (_from.empty() || !descending))
+            _exhausted = !state_.first_entry_.empty();
+
+        if (positions.size() == limit)
+            result.pop_back();
+
+        return result;
+    }
+
     auto count = -1;
     if (_from.empty())
     {
@@ -771,6 +865,28 @@ std::vector<gallery_item> gallery_storage::get_items(int64_t _msg_id, const std:
 
     _index = 0;
     _total = 0;
+
+    if (const auto lists = get_type_positions(_types))
+    {
+        std::vector<uint32_t> found;
+        for (const auto list : *lists)
+        {
+            _total += static_cast<int>(list->size());
+
+            auto iter = std::lower_bound(list->begin(), list->end(), _msg_id, [this](uint32_t _pos, int64_t _id) { return items_[_pos].id_.msg_id_ < _id; });
+            _index += static_cast<int>(std::distance(list->begin(), iter));
+
+            for (; iter != list->end() && items_[*iter].id_.msg_id_ == _msg_id; ++iter)
+                found.push_back(*iter);
+        }
+
+        std::sort(found.begin(), found.end());
+        for (const auto pos : found)
+            result.push_back(items_[pos]);
+
+        return result;
+    }
+
     for (const auto& item : items_)
     {
         if (std::none_of(_types.begin(), _types.end(), [&item](const auto& t) { return t == item.type_; }))
@@ -882,6 +998,8 @@ void gallery_storage::clear_hole_request()
 
 void gallery_storage::make_hole(int64_t _from, int64_t _till)
 {
+    invalidate_type_index();
+
     if (_from == -1)
     {
         items_.clear();
@@ -945,6 +1063,8 @@ bool gallery_storage::load_cache_from_local()
 
     core::tools::auto_scope lb([this] { cache_storage_->close(); });
 
+    invalidate_type_index();
+
     core::tools::binary_stream stream;
     while (cache_storage_->read_data_block(-1, stream))
     {
@@ -1179,8 +1299,59 @@ bool gallery_storage::check_consistency()
 void gallery_storage::clear_gallery()
 {
     items_.clear();
+    invalidate_type_index();
     state_ = gallery_state();
 
     save_cache();
     save_state();
-}
\ No newline at end of file
+}
+
+gallery_items_block::iterator gallery_storage::find_item(const gallery_entry_id& _id)
+{
+    const auto iter = std::lower_bound(items_.begin(), items_.end(), _id, [](const auto& _item, const auto& _item_id) { return _item.id_ < _item_id; });
+    if (iter != items_.end() && iter->id_ == _id)
+        return iter;
+
+    return items_.end();
+}
+
+void gallery_storage::invalidate_type_index()
+{
+    type_index_valid_ = false;
+}
+
+std::optional<std::vector<const gallery_storage::type_positions*>> gallery_storage::get_type_positions(const std::vector<std::string>& _types)
+{
+    std::array<bool, std::tuple_size_v<decltype(type_index_)>> requested = {};
+    for (const auto& type : _types)
+    {
+        const auto t = to_gallery_item_type(type);
+        if (t == gallery_item_type::unknown)
+            return std::nullopt;
+
+        requested[static_cast<size_t>(t)] = true;
+    }
+
+    if (!type_index_valid_)
+    {
+        for (auto& positions : type_index_)
+            positions.clear();
+
+        for (size_t i = 0; i < items_.size(); ++i)
+        {
+            if (const auto t = to_gallery_item_type(items_[i].type_); t != gallery_item_type::unknown)
+                type_index_[static_cast<size_t>(t)].push_back(static_cast<uint32_t>(i));
+        }
+
+        type_index_valid_ = true;
+    }
+
+    std::vector<const type_positions*> result;
+    for (size_t i = 0; i < requested.size(); ++i)
+    {
+        if (requested[i])
+            result.push_back(&type_index_[i]);
+    }
+
+    return result;
+}
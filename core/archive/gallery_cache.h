@@ -29,6 +29,20 @@ namespace core
             bool is_first_ = false;
         };
 
+        enum class gallery_item_type
+        {
+            image,
+            video,
+            file,
+            link,
+            ptt,
+            audio,
+
+            unknown
+        };
+
+        gallery_item_type to_gallery_item_type(std::string_view _type) noexcept;
+
         struct gallery_item
         {
             bool operator<(const gallery_item& _other) const;
@@ -127,6 +141,14 @@ namespace core
             bool check_consistency();
             void clear_gallery();
 
+            gallery_items_block::iterator find_item(const gallery_entry_id& _id);
+
+            using type_positions = std::vector<uint32_t>;
+
+            void invalidate_type_index();
+            // nullopt if some of _types is not indexed
+            std::optional<std::vector<const type_positions*>> get_type_positions(const std::vector<std::string>& _types);
+
         private:
             std::string aimid_;
             std::string my_aimid_;
@@ -145,6 +167,11 @@ namespace core
             bool first_load_;
 
             std::chrono::system_clock::time_point last_consistency_check_time_;
+
+            // ascending positions in items_ of the items of every known type,
+            // rebuilt on the first request after items_ has changed
+            std::array<type_positions, static_cast<size_t>(gallery_item_type::unknown)> type_index_;
+            bool type_index_valid_ = false;
         };
     }
 }
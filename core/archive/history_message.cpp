@@ -3505,57 +3505,161 @@ int32_t history_message::unserialize(const rapidjson::Value& _node, const std::s
     return 0;
 }
 
-void history_message::jump_to_text_field(core::tools::binary_stream& _stream, uint32_t& length)
+int32_t history_message::unserialize_header_and_text(core::tools::binary_stream& _data)
 {
-    while (_stream.available())
+    history_message_view view;
+    if (!view.init(_data))
+        return -1;
+
+    if (view.is_json())
     {
-        if (!core::tools::tlv::try_get_field_with_type(_stream, message_fields::mf_text, length))
-            return;
-        else if (length != 0)
-            return;
+        const auto message = view.materialize();
+        if (!message)
+            return -1;
+
+        *this = *message;
+        return 0;
     }
+
+    msgid_ = view.get_msgid();
+    prev_msg_id_ = view.get_prev_msgid();
+    flags_ = view.get_flags();
+    time_ = view.get_time();
+    internal_id_ = view.get_internal_id();
+    sender_friendly_ = view.get_sender_friendly();
+
+    if (!view.is_shared_contact())
+        text_ = view.get_text();
+
+    return 0;
 }
 
-bool history_message::is_sticker(core::tools::binary_stream& _stream)
+bool history_message_view::init(const core::tools::binary_stream& _data)
 {
-    uint32_t length;
-    while (_stream.available())
-    {
-        if (!core::tools::tlv::try_get_field_with_type(_stream, message_fields::mf_sticker, length))
-            return false;
-        else if (length != 0)
-            return true;
-    }
+    if (const auto size = _data.available(); size > 0)
+        return init(std::string_view(_data.read_available(), static_cast<size_t>(size)));
 
-    return false;
+    return init(std::string_view());
 }
 
-bool history_message::is_chat_event(core::tools::binary_stream& _stream)
+bool history_message_view::init(std::string_view _block)
 {
-    uint32_t length;
-    while (_stream.available())
+    block_ = _block;
+    fields_.clear();
+
+    // the same layout tlvpack::unserialize reads: type, length and value, a tail shorter than a header is ignored
+    constexpr size_t header_size = sizeof(uint32_t) * 2;
+
+    size_t offset = 0;
+    while (block_.size() - offset >= header_size)
     {
-        if (!core::tools::tlv::try_get_field_with_type(_stream, message_fields::mf_chat_event, length))
+        uint32_t type = 0;
+        uint32_t length = 0;
+        memcpy(&type, block_.data() + offset, sizeof(type));
+        memcpy(&length, block_.data() + offset + sizeof(type), sizeof(length));
+        offset += header_size;
+
+        if (length > block_.size() - offset)
             return false;
-        else if (length != 0)
-            return true;
+
+        if (length != 0)
+            fields_.push_back({ type, static_cast<uint32_t>(offset), length });
+
+        offset += length;
     }
 
-    return false;
+    return true;
 }
 
-int64_t history_message::get_id_field(core::tools::binary_stream& _stream)
+std::string_view history_message_view::get_field(uint32_t _type) const
 {
-    uint32_t length = 0;
-    while (_stream.available())
-    {
-        if (!core::tools::tlv::try_get_field_with_type(_stream, message_fields::mf_msg_id, length))
-            return -1;
-        else if (length != 0)
-            return _stream.read<int64_t>();
-    }
+    // the last one wins, as in unserialize
+    const auto it = std::find_if(fields_.rbegin(), fields_.rend(), [_type](const auto& _field) { return _field.type_ == _type; });
+    if (it == fields_.rend())
+        return std::string_view();
+
+    return block_.substr(it->offset_, it->length_);
+}
+
+template <typename T>
+T history_message_view::get_value(uint32_t _type, T _default_value) const
+{
+    const auto value = get_field(_type);
+    if (value.size() < sizeof(T))
+        return _default_value;
+
+    T result;
+    memcpy(&result, value.data(), sizeof(T));
+    return result;
+}
+
+int64_t history_message_view::get_msgid() const
+{
+    return get_value<int64_t>(message_fields::mf_msg_id, -1);
+}
+
+int64_t history_message_view::get_prev_msgid() const
+{
+    return get_value<int64_t>(message_fields::mf_prev_msg_id, -1);
+}
+
+message_flags history_message_view::get_flags() const
+{
+    message_flags flags;
+    flags.value_ = get_value<uint32_t>(message_fields::mf_flags, 0);
+    return flags;
+}
+
+time_t history_message_view::get_time() const
+{
+    return static_cast<time_t>(get_value<uint64_t>(message_fields::mf_time, 0));
+}
+
+std::string_view history_message_view::get_internal_id() const
+{
+    return get_field(message_fields::mf_internal_id);
+}
+
+std::string_view history_message_view::get_sender_friendly() const
+{
+    return get_field(message_fields::mf_sender_friendly);
+}
+
+std::string_view history_message_view::get_text() const
+{
+    return get_field(message_fields::mf_text);
+}
+
+bool history_message_view::is_sticker() const
+{
+    return !get_field(message_fields::mf_sticker).empty();
+}
+
+bool history_message_view::is_chat_event() const
+{
+    return !get_field(message_fields::mf_chat_event).empty();
+}
+
+bool history_message_view::is_shared_contact() const
+{
+    return !get_field(message_fields::mf_shared_contact).empty();
+}
+
+bool history_message_view::is_json() const
+{
+    return !get_field(message_fields::mf_json).empty() && !get_field(message_fields::mf_sender_aimid).empty();
+}
+
+history_message_sptr history_message_view::materialize() const
+{
+    core::tools::binary_stream data;
+    data.write(block_.data(), static_cast<int64_t>(block_.size()));
+
+    auto message = std::make_shared<history_message>();
+    if (message->unserialize(data) != 0)
+        return nullptr;
 
-    return -1;
+    return message;
 }
 
 void core::archive::history_message::set_description_format(const core::data::format& _format)
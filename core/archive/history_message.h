@@ -530,10 +530,9 @@ namespace core
             int32_t unserialize(core::tools::binary_stream& _data);
             int32_t unserialize_call(core::tools::binary_stream& _data, std::string& _aimid);
 
-            static void jump_to_text_field(core::tools::binary_stream& _stream, uint32_t& length);
-            static int64_t get_id_field(core::tools::binary_stream& _stream);
-            static bool is_sticker(core::tools::binary_stream& _stream);
-            static bool is_chat_event(core::tools::binary_stream& _stream);
+            // ids, flags, time, internal id, sender friendly and text only, the rest stays empty;
+            // a message stored as json is decoded whole
+            int32_t unserialize_header_and_text(core::tools::binary_stream& _data);
 
             void set_msgid(const int64_t _msgid) noexcept { msgid_ = _msgid; }
             int64_t get_msgid() const noexcept { return msgid_; }
@@ -662,6 +661,52 @@ namespace core
             void set_thread_id(const std::string& _thread_id);
         };
 
+        // a message over its raw archive block: one pass over the tlv headers indexes the fields,
+        // a value is decoded when it is asked for; nothing is copied, so the block has to outlive the view
+        class history_message_view
+        {
+        public:
+            // takes the block from the output position of the stream up to its end
+            bool init(const core::tools::binary_stream& _data);
+            bool init(std::string_view _block);
+
+            std::string_view get_block() const noexcept { return block_; }
+
+            int64_t get_msgid() const;
+            int64_t get_prev_msgid() const;
+            message_flags get_flags() const;
+            time_t get_time() const;
+            std::string_view get_internal_id() const;
+            std::string_view get_sender_friendly() const;
+            // as stored, history_message drops it for a shared contact
+            std::string_view get_text() const;
+
+            bool is_sticker() const;
+            bool is_chat_event() const;
+            bool is_shared_contact() const;
+            bool is_json() const;
+
+            // the whole message, decoded the same way history_message::unserialize does
+            history_message_sptr materialize() const;
+
+        private:
+            std::string_view get_field(uint32_t _type) const;
+
+            template <typename T>
+            T get_value(uint32_t _type, T _default_value) const;
+
+        private:
+            struct field
+            {
+                uint32_t type_;
+                uint32_t offset_;
+                uint32_t length_;
+            };
+
+            std::string_view block_;
+            std::vector<field> fields_;
+        };
+
         class quote
         {
             std::string text_;
@@ -0,0 +1,256 @@
+#include "stdafx.h"
+
+#include "kv_store.h"
+
+#include "../tools/binary_stream.h"
+#include "../tools/system.h"
+
+using namespace core;
+using namespace archive;
+
+namespace
+{
+    // record: payload size, crc32 of the payload, payload
+    // payload: operation, key size, key, value
+    enum class kv_operation : uint8_t
+    {
+        remove = 0,
+        put = 1,
+    };
+
+    constexpr size_t record_header_size() noexcept { return 2 * sizeof(uint32_t); }
+    constexpr size_t payload_header_size() noexcept { return sizeof(kv_operation) + sizeof(uint32_t); }
+    constexpr size_t max_payload_size() noexcept { return 16 * 1024 * 1024; }
+    constexpr size_t max_pending_size() noexcept { return 512 * 1024; }
+    constexpr int64_t min_compaction_size() noexcept { return 1024 * 1024; }
+
+    std::string make_key(kv_family _family, std::string_view _key)
+    {
+        std::string key;
+        key.reserve(_key.size() + 1);
+        key += static_cast<char>(_family);
+        key += _key;
+        return key;
+    }
+
+    template <typename T>
+    void append_pod(std::string& _out, const T& _value)
+    {
+        _out.append(reinterpret_cast<const char*>(&_value), sizeof(_value));
+    }
+
+    template <typename T>
+    T read_pod(const char* _data) noexcept
+    {
+        T value;
+        std::memcpy(&value, _data, sizeof(value));
+        return value;
+    }
+
+    uint32_t checksum(std::string_view _data) noexcept
+    {
+        return static_cast<uint32_t>(crc32(crc32(0L, Z_NULL, 0), reinterpret_cast<const Bytef*>(_data.data()), static_cast<uInt>(_data.size())));
+    }
+}
+
+kv_store::kv_store(std::wstring _file_name)
+    : file_name_(std::move(_file_name))
+{
+}
+
+kv_store::~kv_store()
+{
+    commit();
+}
+
+bool kv_store::get(kv_family _family, std::string_view _key, Out core::tools::binary_stream& _value)
+{
+    load();
+
+    const auto it = entries_.find(make_key(_family, _key));
+    if (it == entries_.end())
+        return false;
+
+    if (const auto& value = it->second.value_; !value.empty())
+        _value.write(value.data(), int64_t(value.size()));
+
+    return true;
+}
+
+void kv_store::put(kv_family _family, std::string_view _key, core::tools::binary_stream& _value)
+{
+    load();
+
+    std::string_view value;
+    if (const auto size = _value.available(); size > 0)
+        value = std::string_view(_value.read(size), size_t(size));
+
+    if (value.size() + _key.size() + 1 + payload_header_size() > max_payload_size())
+    {
+        im_assert(!"kv_store value is too big");
+        return;
+    }
+
+    auto key = make_key(_family, _key);
+    const auto record_size = append_record(key, value);
+
+    auto& e = entries_[std::move(key)];
+    live_size_ += record_size - e.record_size_;
+    e.value_ = value;
+    e.record_size_ = record_size;
+
+    if (pending_.size() >= max_pending_size())
+        commit();
+}
+
+void kv_store::remove(kv_family _family, std::string_view _key)
+{
+    load();
+
+    const auto it = entries_.find(make_key(_family, _key));
+    if (it == entries_.end())
+        return;
+
+    append_record(it->first, std::nullopt);
+
+    live_size_ -= it->second.record_size_;
+    entries_.erase(it);
+}
+
+bool kv_store::commit()
+{
+    const auto log_size = file_size_ + int64_t(pending_.size());
+    if (needs_compaction_ || (log_size > min_compaction_size() && live_size_ * 2 < log_size))
+        return compact();
+
+    if (pending_.empty())
+        return true;
+
+    const std::wstring folder_name = boost::filesystem::wpath(file_name_).parent_path().wstring();
+    if (!core::tools::system::is_exist(folder_name) && !core::tools::system::create_directory(folder_name))
+        return false;
+
+    auto file = core::tools::system::open_file_for_write(file_name_, std::ofstream::binary | std::ofstream::app);
+    if (!file.is_open())
+        return false;
+
+    file.write(pending_.data(), std::streamsize(pending_.size()));
+    file.flush();
+    if (!file.good())
+    {
+        // a part of the block could have been written, the next commit rewrites the log
+        needs_compaction_ = true;
+        return false;
+    }
+
+    file_size_ += int64_t(pending_.size());
+    pending_.clear();
+
+    return true;
+}
+
+int64_t kv_store::get_memory_usage() const
+{
+    int64_t size = int64_t(pending_.capacity());
+    for (const auto& it : entries_)
+        size += int64_t(it.first.capacity() + it.second.value_.capacity() + sizeof(entry));
+
+    return size;
+}
+
+void kv_store::load()
+{
+    if (loaded_)
+        return;
+
+    loaded_ = true;
+
+    core::tools::binary_stream data;
+    if (!data.load_from_file(file_name_))
+        return;
+
+    const auto size = data.available();
+    if (size <= 0)
+        return;
+
+    const char* buffer = data.read(size);
+
+    int64_t pos = 0;
+    while (pos + int64_t(record_header_size()) <= size)
+    {
+        const auto payload_size = read_pod<uint32_t>(buffer + pos);
+        const auto crc = read_pod<uint32_t>(buffer + pos + sizeof(uint32_t));
+        if (payload_size < payload_header_size() || payload_size > max_payload_size())
+            break;
+
+        const auto record_size = int64_t(record_header_size() + payload_size);
+        if (pos + record_size > size)
+            break;
+
+        const std::string_view payload(buffer + pos + record_header_size(), payload_size);
+        if (checksum(payload) != crc)
+            break;
+
+        const auto operation = static_cast<kv_operation>(payload[0]);
+        const auto key_size = read_pod<uint32_t>(payload.data() + sizeof(kv_operation));
+        if (key_size > payload_size - payload_header_size())
+            break;
+
+        std::string key(payload.substr(payload_header_size(), key_size));
+        if (const auto it = entries_.find(key); it != entries_.end())
+        {
+            live_size_ -= it->second.record_size_;
+            entries_.erase(it);
+        }
+
+        if (operation == kv_operation::put)
+        {
+            live_size_ += record_size;
+            entries_[std::move(key)] = entry{ std::string(payload.substr(payload_header_size() + key_size)), record_size };
+        }
+
+        pos += record_size;
+    }
+
+    file_size_ = pos;
+
+    // the tail of an interrupted write is dropped by rewriting the log
+    needs_compaction_ = (pos != size);
+}
+
+int64_t kv_store::append_record(std::string_view _key, std::optional<std::string_view> _value)
+{
+    std::string payload;
+    payload.reserve(payload_header_size() + _key.size() + (_value ? _value->size() : 0));
+    payload += static_cast<char>(_value ? kv_operation::put : kv_operation::remove);
+    append_pod(payload, uint32_t(_key.size()));
+    payload += _key;
+    if (_value)
+        payload += *_value;
+
+    append_pod(pending_, uint32_t(payload.size()));
+    append_pod(pending_, checksum(payload));
+    pending_ += payload;
+
+    return int64_t(record_header_size() + payload.size());
+}
+
+bool kv_store::compact()
+{
+    pending_.clear();
+    for (auto& it : entries_)
+        it.second.record_size_ = append_record(it.first, it.second.value_);
+
+    if (!core::tools::binary_stream::save_2_file(pending_, file_name_))
+    {
+        needs_compaction_ = true;
+        return false;
+    }
+
+    file_size_ = int64_t(pending_.size());
+    live_size_ = file_size_;
+    pending_.clear();
+    needs_compaction_ = false;
+
+    return true;
+}
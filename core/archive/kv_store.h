@@ -0,0 +1,63 @@
+#pragma once
+
+namespace core
+{
+    namespace tools
+    {
+        class binary_stream;
+    }
+
+    namespace archive
+    {
+        // stored in the records, never renumber;
+        // reactions and thread updates stay in their offset-indexed files: the store keeps every value in memory,
+        // and they grow with the history while the families here hold a bounded value per chat
+        enum class kv_family : uint8_t
+        {
+            dlg_state = 1,
+            draft = 2,
+            mentions = 3,
+        };
+
+        // key-value log shared by all chats of an account;
+        // the log is read once on first access, changes are buffered and appended by commit()
+        // in a single write, the log is rewritten when most of it is stale
+        class kv_store
+        {
+        public:
+            explicit kv_store(std::wstring _file_name);
+            ~kv_store();
+
+            bool get(kv_family _family, std::string_view _key, Out core::tools::binary_stream& _value);
+            // the value is read out of _value
+            void put(kv_family _family, std::string_view _key, core::tools::binary_stream& _value);
+            void remove(kv_family _family, std::string_view _key);
+
+            bool commit();
+
+            int64_t get_memory_usage() const;
+
+        private:
+            struct entry
+            {
+                std::string value_;
+                int64_t record_size_ = 0;
+            };
+
+            void load();
+            int64_t append_record(std::string_view _key, std::optional<std::string_view> _value);
+            bool compact();
+
+            const std::wstring file_name_;
+
+            // family byte followed by the key
+            std::unordered_map<std::string, entry> entries_;
+
+            std::string pending_;
+            int64_t file_size_ = 0;
+            int64_t live_size_ = 0;
+            bool loaded_ = false;
+            bool needs_compaction_ = false;
+        };
+    }
+}
@@ -19,6 +19,7 @@
 #include "../../corelib/enumerations.h"
 #include "draft_storage.h"
 #include "pending_drafts.h"
+#include "kv_store.h"
 
 #include "local_history.h"
 
@@ -53,6 +54,7 @@ local_history::local_history(const std::wstring& _archive_path)
         _archive_path + L"/pending.db",
         _archive_path + L"/pending.delete.db"))
     , pending_drafts_(std::make_unique<pending_drafts>(_archive_path + L"/pending.drafts.db"))
+    , store_(std::make_shared<kv_store>(_archive_path + L"/kv.db"))
 {
 }
 
@@ -68,7 +70,7 @@ std::shared_ptr<contact_archive> local_history::get_contact_archive(const std::s
 
     std::wstring contact_folder = core::tools::from_utf8(_contact);
     std::replace(contact_folder.begin(), contact_folder.end(), L'|', L'_');
-    auto contact_arch = std::make_shared<contact_archive>(su::wconcat(archive_path_, L'/', contact_folder), _contact);
+    auto contact_arch = std::make_shared<contact_archive>(su::wconcat(archive_path_, L'/', contact_folder), _contact, store_);
 
     archives_.insert(std::make_pair(_contact, contact_arch));
 
@@ -117,7 +119,7 @@ bool local_history::get_messages(const std::string& _contact,
     headers_list headers;
     const auto start_get_messages = std::chrono::steady_clock::now();
     archive->get_messages_index(_from, _count_early, _count_later, headers);
-    archive->get_messages_buddies(headers, _messages, _errors);
+    archive->get_messages_buddies(headers, _messages, _errors, message_decode::full);
 
     if (_first_load && configuration::get_app_config().is_full_log_enabled())
     {
@@ -225,6 +227,26 @@ bool local_history::has_hole_in_range(const std::string& _contact, int64_t _msgi
     return archive->has_hole_in_range(_msgid, _count_before, _count_after);
 }
 
+void local_history::prefetch_history(const std::string& _contact, int32_t _count, /*out*/ bool& _has_top_hole)
+{
+    _has_top_hole = false;
+
+    auto archive = get_contact_archive(_contact);
+    if (!archive)
+        return;
+
+    bool first_load = false;
+    archive->load_from_local(first_load);
+
+    // the bodies are dropped, reading them brings the tail of the data file into the page cache
+    headers_list headers;
+    archive->get_messages_index(-1, _count, 0, headers);
+    archive->get_messages_buddies(headers, std::make_shared<history_block>(), std::make_shared<error_vector>(), message_decode::header_and_text);
+
+    if (const auto last_msgid = archive->get_dlg_state().get_last_msgid(); last_msgid > 0)
+        _has_top_hole = archive->has_hole_in_range(last_msgid, _count, 0);
+}
+
 local_history::hole_result local_history::get_next_hole(const std::string& _contact, int64_t _from, int64_t _depth)
 {
     auto hole = std::make_shared<archive_hole>();
@@ -538,6 +560,11 @@ void local_history::free_dialog(const std::string& _contact)
     get_contact_archive(_contact)->free();
 }
 
+void local_history::commit_store()
+{
+    store_->commit();
+}
+
 void local_history::add_mention(const std::string& _contact, const std::shared_ptr<archive::history_message>& _message)
 {
     get_contact_archive(_contact)->add_mention(_message);
@@ -1104,6 +1131,27 @@ std::shared_ptr<has_hole_in_range_handler> face::has_hole_in_range(const std::st
     return handler;
 }
 
+std::shared_ptr<has_hole_in_range_handler> face::prefetch_history(const std::string& _contact, int32_t _count)
+{
+    auto handler = std::make_shared<has_hole_in_range_handler>();
+    auto has_hole = std::make_shared<bool>(false);
+
+    static constexpr char task_name[] = "face::prefetch_history";
+
+    thread_->run_async_function([history_cache = history_cache_, has_hole, _contact, _count]()->int32_t
+    {
+        history_cache->prefetch_history(_contact, _count, *has_hole);
+        return 0;
+
+    }, task_name)->on_result_ = [handler, has_hole](int32_t _error)
+    {
+        if (handler->on_result)
+            handler->on_result(*has_hole);
+    };
+
+    return handler;
+}
+
 std::shared_ptr<request_next_hole_handler> face::get_next_hole(const std::string& _contact, int64_t _from, int64_t _depth)
 {
     auto handler = std::make_shared<request_next_hole_handler>();
@@ -1597,8 +1645,10 @@ std::shared_ptr<async_task_handlers> face::sync_with_history()
 
     static constexpr char task_name[] = "face::sync_with_history";
 
-    thread_->run_async_function([]()->int32_t
+    thread_->run_async_function([history_cache = history_cache_]()->int32_t
     {
+        history_cache->commit_store();
+
         return 0;
 
     }, task_name)->on_result_ = [handler](int32_t _error)
@@ -1927,6 +1977,19 @@ void face::free_dialog(const std::string& _contact)
     }, task_name);
 }
 
+void face::commit_store()
+{
+    static constexpr char task_name[] = "face::commit_store";
+
+    thread_->run_async_function([history_cache = history_cache_]()->int32_t
+    {
+        history_cache->commit_store();
+
+        return 0;
+
+    }, task_name);
+}
+
 std::shared_ptr<memory_usage> face::get_memory_usage()
 {
     auto handler = std::make_shared<memory_usage>();
@@ -46,6 +46,7 @@ namespace core
         struct thread_update;
         struct draft;
         class pending_drafts;
+        class kv_store;
 
         struct message_stat_time;
         using message_stat_time_v = std::vector<message_stat_time>;
@@ -387,6 +388,8 @@ namespace core
 
             std::unique_ptr<pending_drafts> pending_drafts_;
 
+            std::shared_ptr<kv_store> store_;
+
             message_stat_time_v stat_message_times_;
 
             std::shared_ptr<contact_archive> get_contact_archive(const std::string& _contact);
@@ -416,6 +419,8 @@ namespace core
             void optimize_contact_archive(const std::string& _contact);
             void free_dialog(const std::string& _contact);
 
+            void commit_store();
+
             void get_messages_buddies(const std::string& _contact, std::shared_ptr<archive::msgids_list> _ids, /*out*/ std::shared_ptr<history_block> _messages, /*out*/ bool& _first_load, /*out*/ std::shared_ptr<error_vector> _errors);
             bool get_messages(const std::string& _contact, int64_t _from, int64_t _count_early, int64_t _count_later, /*out*/ std::shared_ptr<history_block> _messages, /*out*/ bool& _first_load, /*out*/ std::shared_ptr<error_vector> _errors);
             bool get_history_file(const std::string& _contact, /*out*/ core::tools::binary_stream& _history_archive
@@ -440,6 +445,7 @@ namespace core
             };
 
             bool has_hole_in_range(const std::string& _contact, int64_t _msgid, int32_t _count_before, int32_t _count_after);
+            void prefetch_history(const std::string& _contact, int32_t _count, /*out*/ bool& _has_top_hole);
             hole_result get_next_hole(const std::string& _contact, int64_t _from, int64_t _depth = -1);
             int64_t validate_hole_request(const std::string& _contact, const archive_hole& _hole_request, const int32_t _count);
 
@@ -540,6 +546,7 @@ namespace core
             explicit face(const std::wstring& _archive_path);
 
             void free_dialog(const std::string& _contact);
+            void commit_store();
 
             std::shared_ptr<update_history_handler> update_history(const std::string& _contact, const std::shared_ptr<archive::history_block>& _data, int64_t _from = -1, local_history::has_older_message_id _has_older_msgid = local_history::has_older_message_id::yes);
             std::shared_ptr<async_task_handlers> update_message_data(const std::string& _contact, const history_message& _message);
@@ -560,6 +567,9 @@ namespace core
             std::shared_ptr<set_dlg_state_handler> set_dlg_state(const std::string& _contact, const dlg_state& _state);
             std::shared_ptr<async_task_handlers> clear_dlg_state(const std::string& _contact);
             std::shared_ptr<has_hole_in_range_handler> has_hole_in_range(const std::string& _contact, int64_t _msgid, int32_t _count_before, int32_t _count_after);
+            // loads the index and reads the last _count messages, so the chat opens without waiting for the disk;
+            // the result tells if the last _count messages of the dialog are not all in the archive
+            std::shared_ptr<has_hole_in_range_handler> prefetch_history(const std::string& _contact, int32_t _count);
             std::shared_ptr<request_next_hole_handler> get_next_hole(const std::string& _contact, int64_t _from, int64_t _depth = -1);
             std::shared_ptr<validate_hole_request_handler> validate_hole_request(const std::string& _contact, const archive_hole& _hole_request, const int32_t _count);
 
@@ -5,17 +5,29 @@
 #include "history_message.h"
 #include "messages_data.h"
 #include "storage.h"
+#include "kv_store.h"
 
 #include "mentions_me.h"
 
+#include "tools/system.h"
+
 #include <boost/range/adaptor/map.hpp>
 
 using namespace core;
 using namespace archive;
 
+namespace
+{
+    enum mentions_tlv_fields : uint32_t
+    {
+        tlv_message = 1,
+    };
+}
 
-mentions_me::mentions_me(std::wstring _file_name)
-    : storage_(std::make_unique<storage>(std::move(_file_name)))
+mentions_me::mentions_me(std::wstring _file_name, std::string _contact_id, std::shared_ptr<kv_store> _store)
+    : store_(std::move(_store))
+    , legacy_storage_(std::make_unique<storage>(std::move(_file_name)))
+    , contact_id_(std::move(_contact_id))
 {
 
 }
@@ -52,40 +64,73 @@ bool core::archive::mentions_me::load_from_local()
     if (loaded_from_local_)
         return true;
 
-    archive::storage_mode mode;
-    mode.flags_.read_ = true;
+    core::tools::binary_stream data;
+    if (!store_->get(kv_family::mentions, contact_id_, data))
+        return load_legacy();
 
-    if (!storage_->open(mode))
+    // the mentions added before the load are kept
+    auto tmp_messages = std::move(messages_);
+    messages_.clear();
+
+    core::tools::tlvpack pack;
+    if (data.available() > 0 && !pack.unserialize(data))
+    {
+        messages_ = std::move(tmp_messages);
         return false;
+    }
+
+    for (auto item = pack.get_first(); item; item = pack.get_next())
+    {
+        auto message_stream = item->get_value<core::tools::binary_stream>();
+        if (!unserialize(message_stream))
+        {
+            messages_.insert(tmp_messages.begin(), tmp_messages.end());
+            return false;
+        }
+    }
 
-    auto p_storage = storage_.get();
-    core::tools::auto_scope lb([p_storage] { p_storage->close(); });
+    messages_.insert(tmp_messages.begin(), tmp_messages.end());
+
+    loaded_from_local_ = true;
+    return true;
+}
+
+bool mentions_me::load_legacy()
+{
+    loaded_from_local_ = true;
+
+    archive::storage_mode mode;
+    mode.flags_.read_ = true;
+
+    // no file, no mentions
+    if (!legacy_storage_->open(mode))
+        return true;
 
     auto tmp_messages = std::move(messages_);
     messages_.clear();
 
-    core::tools::binary_stream data_stream;
-    while (storage_->read_data_block(-1, data_stream))
+    auto loaded = true;
     {
-        if (!unserialize(data_stream))
-        {
-            for (auto &x : tmp_messages)
-                messages_.insert({x.first, x.second});
+        auto p_storage = legacy_storage_.get();
+        core::tools::auto_scope lb([p_storage] { p_storage->close(); });
 
-            return false;
+        core::tools::binary_stream data_stream;
+        while (loaded && legacy_storage_->read_data_block(-1, data_stream))
+        {
+            loaded = unserialize(data_stream);
+            data_stream.reset();
         }
 
-        data_stream.reset();
+        loaded = loaded && legacy_storage_->get_last_error() == archive::error::end_of_file;
     }
 
-    for (auto &x : tmp_messages)
-        messages_.insert({ x.first, x.second });
+    messages_.insert(tmp_messages.begin(), tmp_messages.end());
 
-    if (storage_->get_last_error() != archive::error::end_of_file)
-        return false;
+    // the file is deleted only when the mentions are on disk in the store, a broken one is replaced as before
+    if (save_all() && store_->commit())
+        core::tools::system::delete_file(legacy_storage_->get_file_name());
 
-    loaded_from_local_ = true;
-    return true;
+    return loaded;
 }
 
 void mentions_me::delete_up_to(int64_t _id)
@@ -116,7 +161,7 @@ void mentions_me::add(const std::shared_ptr<archive::history_message>& _message)
     if (_message->has_msgid())
     {
         if (auto[it, res] = messages_.insert({ _message->get_msgid(), _message }); res)
-            save(_message);
+            save_all();
     }
     else
     {
@@ -124,45 +169,29 @@ void mentions_me::add(const std::shared_ptr<archive::history_message>& _message)
     }
 }
 
-storage::result_type mentions_me::save(const std::shared_ptr<archive::history_message>& _message)
-{
-    archive::storage_mode mode;
-    mode.flags_.write_ = true;
-    mode.flags_.append_ = true;
-    if (!storage_->open(mode))
-        return { false, 0 };
-
-    auto p_storage = storage_.get();
-    core::tools::auto_scope lb([p_storage] { p_storage->close(); });
-
-    core::tools::binary_stream data;
-    serialize(_message, data);
-
-    int64_t offset = 0;
-    return storage_->write_data_block(data, offset);
-}
-
+// a chat has a few unread mentions at most, so they are stored as one value
 bool mentions_me::save_all()
 {
-    archive::storage_mode mode;
-    mode.flags_.write_ = true;
-    mode.flags_.truncate_ = true;
-    if (!storage_->open(mode))
-        return false;
-
-    auto p_storage = storage_.get();
-    core::tools::auto_scope lb([p_storage] { p_storage->close(); });
+    // the stored mentions would be overwritten by the ones added so far
+    if (!loaded_from_local_)
+        load_from_local();
 
     if (messages_.empty())
+    {
+        store_->remove(kv_family::mentions, contact_id_);
         return true;
+    }
 
-    core::tools::binary_stream block_data;
+    core::tools::tlvpack pack;
     for (const auto& [_, message] : messages_)
     {
-        serialize(message, block_data);
-        int64_t offset = 0;
-        storage_->write_data_block(block_data, offset);
-        block_data.reset();
+        core::tools::binary_stream message_data;
+        serialize(message, message_data);
+        pack.push_child(core::tools::tlv(tlv_message, message_data));
     }
+
+    core::tools::binary_stream data;
+    pack.serialize(data);
+    store_->put(kv_family::mentions, contact_id_, data);
     return true;
 }
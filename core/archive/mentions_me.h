@@ -8,6 +8,7 @@ namespace core
         class archive_index;
         class contact_archive;
         class history_message;
+        class kv_store;
         class storage;
 
         using history_block = std::vector<std::shared_ptr<history_message>>;
@@ -19,7 +20,7 @@ namespace core
 
         public:
 
-            mentions_me(std::wstring _file_name);
+            mentions_me(std::wstring _file_name, std::string _contact_id, std::shared_ptr<kv_store> _store);
             ~mentions_me();
 
             void serialize(const std::shared_ptr<archive::history_message>& _mention, core::tools::binary_stream& _data) const;
@@ -38,11 +39,14 @@ namespace core
             bool save_all();
 
         private:
-            storage::result_type save(const std::shared_ptr<archive::history_message>& _message);
+            bool load_legacy();
 
         private:
             bool loaded_from_local_ = false;
-            std::unique_ptr<storage> storage_;
+            std::shared_ptr<kv_store> store_;
+            // the file of a version before the store, read once to migrate
+            std::unique_ptr<storage> legacy_storage_;
+            std::string contact_id_;
 
             mentions_map messages_;
         };
@@ -19,7 +19,18 @@ messages_data::messages_data(std::wstring _file_name)
 messages_data::~messages_data() = default;
 
 
-messages_data::error_vector messages_data::get_messages(const headers_list& _headers, history_block& _messages) const
+namespace
+{
+    int32_t unserialize_message(history_message& _message, core::tools::binary_stream& _data, message_decode _decode)
+    {
+        if (_decode == message_decode::header_and_text)
+            return _message.unserialize_header_and_text(_data);
+
+        return _message.unserialize(_data);
+    }
+}
+
+messages_data::error_vector messages_data::get_messages(const headers_list& _headers, history_block& _messages, message_decode _decode) const
 {
     error_vector res;
     auto p_storage = storage_.get();
@@ -62,7 +73,7 @@ messages_data::error_vector messages_data::get_messages(const headers_list& _hea
         }
 
         auto msg = std::make_shared<history_message>();
-        if (msg->unserialize(message_data) != 0)
+        if (unserialize_message(*msg, message_data, _decode) != 0)
         {
             im_assert(!"unserialize message error");
             res.emplace_back(header.get_id(), 2);
@@ -80,7 +91,7 @@ messages_data::error_vector messages_data::get_messages(const headers_list& _hea
 
         msg->apply_header_flags(header);
 
-        const auto modifications = get_message_modifications(header);
+        const auto modifications = get_message_modifications(header, _decode);
         msg->apply_modifications(modifications);
 
         _messages.push_back(std::move(msg));
@@ -221,10 +232,18 @@ void messages_data::search_in_archive(std::shared_ptr<contact_and_offsets_v> _co
 
         int64_t begin_of_block;
 
+        // blocks of the matching messages, a later version of a message replaces or drops an earlier one;
+        // only the blocks left after the scan are decoded
+        std::vector<std::pair<int64_t, std::string_view>> hits;
+        history_message_view view;
+
         while (storage::fast_read_data_block((*_data), current_pos, begin_of_block, end_pos))
         {
             _data->set_output(begin_of_block);
-            auto mess_id = history_message::get_id_field(*_data);
+            if (!view.init(*_data))
+                continue;
+
+            const auto mess_id = view.get_msgid();
 
             if (mess_id == -1 || mess_id <= _min_id)
                 continue;
@@ -245,47 +264,29 @@ void messages_data::search_in_archive(std::shared_ptr<contact_and_offsets_v> _co
                 }
             }
 
-            uint32_t text_length = 0;
-
-            _data->set_output(begin_of_block);
-
-            if (history_message::is_sticker(*_data))
-                continue;
-
-            _data->set_output(begin_of_block);
-
-            if (history_message::is_chat_event(*_data))
+            if (view.is_sticker() || view.is_chat_event())
                 continue;
 
-            _data->set_output(begin_of_block);
-
-            history_message::jump_to_text_field(*_data, text_length);
-
-            if (!text_length)
+            const auto text = view.get_text();
+            if (text.empty())
                 continue;
 
-            char* pointer = nullptr;
-            if (_data->available())
-                pointer = _data->read_available();
+            const auto hit_it = std::find_if(hits.begin(), hits.end(), [mess_id](const auto& _hit) { return _hit.first == mess_id; });
 
             if (find_by_id(term_id, mess_id)
-                || kmp_strstr(pointer, text_length, _cterm->coded_string, _cterm->prefix, _cterm->symbs, _cterm->symb_indexes) != -1)
+                || kmp_strstr(text.data(), static_cast<uint32_t>(text.size()), _cterm->coded_string, _cterm->prefix, _cterm->symbs, _cterm->symb_indexes) != -1)
             {
-                _data->set_output(begin_of_block);
-                auto msg = std::make_shared<history_message>();
-                if (msg->unserialize(*_data) == 0)
-                {
-                    top_ids.insert(mess_id);
-                    auto& messages = found_messages[_contact];
-                    const auto msg_it = std::find_if(messages.begin(), messages.end(), [mess_id](const auto& msg) { return msg->get_msgid() == mess_id; });
-                    if (msg_it != messages.end())
-                        *msg_it = std::move(msg);
-                    else
-                        messages.push_back(std::move(msg));
-                }
+                top_ids.insert(mess_id);
+                if (hit_it != hits.end())
+                    hit_it->second = view.get_block();
+                else
+                    hits.emplace_back(mess_id, view.get_block());
             }
             else
             {
+                if (hit_it != hits.end())
+                    hits.erase(hit_it);
+
                 if (const auto it = found_messages.find(_contact); it != found_messages.end())
                 {
                     auto& messages = it->second;
@@ -296,6 +297,23 @@ void messages_data::search_in_archive(std::shared_ptr<contact_and_offsets_v> _co
             }
         }
 
+        for (const auto& [mess_id, block] : hits)
+        {
+            if (!view.init(block))
+                continue;
+
+            auto msg = view.materialize();
+            if (!msg)
+                continue;
+
+            auto& messages = found_messages[_contact];
+            const auto msg_it = std::find_if(messages.begin(), messages.end(), [mess_id = mess_id](const auto& msg) { return msg->get_msgid() == mess_id; });
+            if (msg_it != messages.end())
+                *msg_it = std::move(msg);
+            else
+                messages.push_back(std::move(msg));
+        }
+
         if (current_pos == (*_archive)[contact_i].second && !((*_archive)[contact_i].first.empty()))
             *_offset = -1;
 
@@ -304,7 +322,7 @@ void messages_data::search_in_archive(std::shared_ptr<contact_and_offsets_v> _co
     }
 }
 
-history_block messages_data::get_message_modifications(const message_header& _header) const
+history_block messages_data::get_message_modifications(const message_header& _header, message_decode _decode) const
 {
     history_block modifications;
     if (!_header.is_modified() && !_header.is_updated())
@@ -323,7 +341,7 @@ history_block messages_data::get_message_modifications(const message_header& _he
         }
 
         auto modification = std::make_shared<history_message>();
-        if (modification->unserialize(message_data) != 0)
+        if (unserialize_message(*modification, message_data, _decode) != 0)
         {
             im_assert(!"unserialize modification error");
             continue;
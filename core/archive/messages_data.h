@@ -38,11 +38,19 @@ namespace core
             std::vector<int32_t> symb_indexes;
         };
 
+        // header_and_text skips everything but the ids, flags, time, sender friendly and text
+        // for the readers which need nothing else
+        enum class message_decode
+        {
+            full,
+            header_and_text
+        };
+
         class messages_data
         {
             std::unique_ptr<storage> storage_;
 
-            history_block get_message_modifications(const message_header& _header) const;
+            history_block get_message_modifications(const message_header& _header, message_decode _decode) const;
 
         public:
 
@@ -53,7 +61,7 @@ namespace core
 
             using error_vector = std::vector<std::pair<int64_t, int32_t>>;
 
-            error_vector get_messages(const headers_list& _headers, history_block& _messages) const;
+            error_vector get_messages(const headers_list& _headers, history_block& _messages, message_decode _decode = message_decode::full) const;
 
             void drop();
 
@@ -136,6 +136,16 @@ pt::ptree app_config::as_ptree() const
         case app_config::AppConfigOption::ssl_verification_enabled:
             result.add(option_name(key), is_ssl_verification_enabled());
             break;
+#ifdef SUPPORT_REPLAY_SERVER
+        case app_config::AppConfigOption::replay_server:
+            // only the replay runs set it, app.ini of the others doesn't get an empty key
+            if (const auto server = replay_server(); !server.empty())
+                result.add(option_name(key), server);
+            break;
+#endif // SUPPORT_REPLAY_SERVER
+        case app_config::AppConfigOption::trace_events:
+            result.add(option_name(key), is_trace_events_enabled());
+            break;
         default:
             im_assert(!"unhandled option for as_ptree");
             continue;
@@ -236,6 +246,13 @@ bool app_config::is_watch_gui_memory_enabled() const
                                            : boost::any_cast<bool>(it->second);
 }
 
+bool app_config::is_trace_events_enabled() const
+{
+    auto it = app_config_options_.find(app_config::AppConfigOption::trace_events);
+    return it == app_config_options_.end() ? false
+                                           : boost::any_cast<bool>(it->second);
+}
+
 bool app_config::is_net_compression_enabled() const
 {
     auto it = app_config_options_.find(app_config::AppConfigOption::net_compression);
@@ -320,6 +337,13 @@ std::string app_config::device_id() const
                                            : boost::any_cast<std::string>(it->second);
 }
 
+std::string app_config::replay_server() const
+{
+    auto it = app_config_options_.find(app_config::AppConfigOption::replay_server);
+    return it == app_config_options_.end() ? std::string()
+                                           : boost::any_cast<std::string>(it->second);
+}
+
 std::string_view app_config::get_update_win_alpha_url() const
 {
     return config::get().url(config::urls::update_win_alpha);
@@ -475,6 +499,7 @@ void app_config::serialize(Out core::coll_helper& _collection) const
     _collection.set<uint32_t>(option_name(app_config::AppConfigOption::app_update_interval_secs), app_update_interval_secs());
     _collection.set<bool>(option_name(app_config::AppConfigOption::net_compression), is_net_compression_enabled());
     _collection.set<bool>(option_name(app_config::AppConfigOption::ssl_verification_enabled), is_ssl_verification_enabled());
+    _collection.set<bool>(option_name(app_config::AppConfigOption::trace_events), is_trace_events_enabled());
 
     // urls
     _collection.set<std::string_view>("urls.url_update_mac_alpha", get_update_mac_alpha_url());
@@ -679,6 +704,16 @@ namespace
             {
                 app_config::AppConfigOption::ssl_verification_enabled,
                 property_tree_.get<bool>(option_name(app_config::AppConfigOption::ssl_verification_enabled), true)
+            },
+#ifdef SUPPORT_REPLAY_SERVER
+            {
+                app_config::AppConfigOption::replay_server,
+                property_tree_.get<std::string>(option_name(app_config::AppConfigOption::replay_server), std::string())
+            },
+#endif // SUPPORT_REPLAY_SERVER
+            {
+                app_config::AppConfigOption::trace_events,
+                property_tree_.get<bool>(option_name(app_config::AppConfigOption::trace_events), false)
             }
         };
     }
@@ -739,6 +774,10 @@ namespace
             return "dev.net_compression";
         case app_config::AppConfigOption::ssl_verification_enabled:
             return "dev.webview_ssl_check";
+        case app_config::AppConfigOption::replay_server:
+            return "dev.replay_server";
+        case app_config::AppConfigOption::trace_events:
+            return "dev.trace_events";
         default:
             im_assert(!"unhandled option for option_name");
             return "";
@@ -42,7 +42,9 @@ public:
         app_update_interval_secs = 22,
         net_compression = 23,
         cache_history_pages_check_interval_secs = 24,
-        ssl_verification_enabled = 25
+        ssl_verification_enabled = 25,
+        replay_server = 26,
+        trace_events = 27
     };
 
     enum class gdpr_report_to_server_state
@@ -75,6 +77,7 @@ public:
     bool is_watch_gui_memory_enabled() const;
     bool is_net_compression_enabled() const;
     bool is_ssl_verification_enabled() const;
+    bool is_trace_events_enabled() const;
 
     bool gdpr_user_has_agreed() const;
     int32_t gdpr_agreement_reported_to_server() const;
@@ -82,6 +85,7 @@ public:
     bool is_updateble() const;
 
     std::string device_id() const;
+    std::string replay_server() const;
     uint32_t update_interval() const;
 
     int32_t forced_dpi() const;
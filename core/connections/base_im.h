@@ -3,6 +3,7 @@
 #include "../../common.shared/patch_version.h"
 
 #include "wim/privacy_settings.h"
+#include "wim/history_prefetcher.h"
 #include "archive/history_message.h"
 #include "smartreply/smartreply_marker.h"
 #ifndef STRIP_VOIP
@@ -261,6 +262,9 @@ namespace core
         virtual void add_opened_dialog(const std::string& _contact) = 0;
         virtual void remove_opened_dialog(const std::string& _contact) = 0;
 
+        virtual void set_history_prefetch_candidates(std::vector<wim::history_prefetch_candidate> _candidates) = 0;
+        virtual void add_history_prefetch_hint(const std::string& _contact) = 0;
+
         virtual void get_stickers_meta(int64_t _seq, std::string_view _size) = 0;
         virtual void get_sticker(const int64_t _seq, const int32_t _set_id, const int32_t _sticker_id, const core::tools::filesharing_id& _fs_id, const core::sticker_size _size) = 0;
         virtual void get_sticker_cancel(std::vector<core::tools::filesharing_id> _fs_ids, core::sticker_size _size) = 0;
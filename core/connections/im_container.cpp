@@ -16,6 +16,7 @@
 
 #include "../core.h"
 #include "../tools/system.h"
+#include "../tools/unicode.h"
 #include "../tools/file_sharing.h"
 #include "../utils.h"
 #include "../archive/contact_archive.h"
@@ -95,6 +96,8 @@ im_container::im_container(const std::shared_ptr<voip_manager::VoipManager>& voi
     REGISTER_IM_MESSAGE("messages/context/get", on_get_message_context);
     REGISTER_IM_MESSAGE("archive/make/holes", on_make_archive_holes);
     REGISTER_IM_MESSAGE("archive/invalidate/message_data", on_invalidate_archive_data);
+    REGISTER_IM_MESSAGE("archive/prefetch/candidates", on_set_history_prefetch_candidates);
+    REGISTER_IM_MESSAGE("archive/prefetch/hint", on_add_history_prefetch_hint);
 
     REGISTER_IM_MESSAGE("dialogs/search/local", on_dialogs_search_local);
     REGISTER_IM_MESSAGE("dialogs/search/local/end", on_dialogs_search_local_ended);
@@ -232,6 +235,7 @@ im_container::im_container(const std::shared_ptr<voip_manager::VoipManager>& voi
     REGISTER_IM_MESSAGE("request_memory_usage", on_request_memory_usage);
     REGISTER_IM_MESSAGE("report_memory_usage", on_report_memory_usage);
     REGISTER_IM_MESSAGE("get_ram_usage", on_get_ram_usage);
+    REGISTER_IM_MESSAGE("memory_accounting/get", on_get_memory_accounting);
     REGISTER_IM_MESSAGE("_ui_activity", on_ui_activity);
 
     REGISTER_IM_MESSAGE("localpin/set", on_local_pin_set);
@@ -790,6 +794,40 @@ void im_container::on_get_archive_messages(int64_t _seq, coll_helper& _params)
         _params.get_value_as_bool("after_search"));
 }
 
+void im_container::on_set_history_prefetch_candidates(int64_t _seq, coll_helper& _params)
+{
+    auto im = get_im(_params);
+    if (!im)
+        return;
+
+    std::vector<core::wim::history_prefetch_candidate> candidates;
+    if (auto array = _params.get_value_as_array("contacts"))
+    {
+        const auto size = array->size();
+        candidates.reserve(size);
+        for (std::remove_const_t<decltype(size)> i = 0; i < size; ++i)
+        {
+            coll_helper coll(array->get_at(i)->get_as_collection(), false);
+
+            core::wim::history_prefetch_candidate candidate;
+            candidate.aimid_ = coll.get_value_as_string("contact");
+            candidate.unread_count_ = coll.get_value_as_int("unread_count");
+            candidates.push_back(std::move(candidate));
+        }
+    }
+
+    im->set_history_prefetch_candidates(std::move(candidates));
+}
+
+void im_container::on_add_history_prefetch_hint(int64_t _seq, coll_helper& _params)
+{
+    auto im = get_im(_params);
+    if (!im)
+        return;
+
+    im->add_history_prefetch_hint(_params.get_value_as_string("contact"));
+}
+
 void core::im_container::on_get_archive_mentions(int64_t _seq, coll_helper& _params)
 {
     auto im = get_im(_params);
@@ -2237,7 +2275,7 @@ void core::im_container::on_search_contacts_local(int64_t _seq, coll_helper& _pa
     for (auto& symbol_iter : symbols_patterns)
     {
         for (auto& iter : symbol_iter)
-            iter = ::core::tools::system::to_upper(iter);
+            iter = ::core::tools::unicode::to_upper(iter);
     }
 
     im->search_contacts_local(symbols_patterns, _seq, fix_pat_count, pattern);
@@ -2758,6 +2796,21 @@ void im_container::on_get_ram_usage(const int64_t _seq, coll_helper &_params)
     im->get_ram_usage(_seq);
 }
 
+void im_container::on_get_memory_accounting(const int64_t _seq, coll_helper& _params)
+{
+    if (!memory_stats_collector_)
+        return;
+
+    coll_helper coll(g_core->create_collection(), true);
+    memory_stats_collector_->get_accounting_history().serialize(coll);
+
+    coll_helper coll_current(g_core->create_collection(), true);
+    memory_stats::serialize_sample(memory_stats::take_accounting_sample(), coll_current);
+    coll.set_value_as_collection("current", coll_current.get());
+
+    g_core->post_message_to_gui("memory_accounting/result", _seq, coll.get());
+}
+
 void im_container::on_make_archive_holes(const int64_t _seq, coll_helper& _params)
 {
     auto im = get_im(_params);
@@ -68,6 +68,8 @@ namespace core
 
         void on_get_archive_messages_buddies(int64_t _seq, coll_helper& _params);
         void on_get_archive_messages(int64_t _seq, coll_helper& _params);
+        void on_set_history_prefetch_candidates(int64_t _seq, coll_helper& _params);
+        void on_add_history_prefetch_hint(int64_t _seq, coll_helper& _params);
         void on_get_archive_mentions(int64_t _seq, coll_helper& _params);
         void on_delete_archive_messages(int64_t _seq, coll_helper& _params);
         void on_delete_archive_messages_batch(int64_t _seq, coll_helper& _params);
@@ -227,6 +229,7 @@ namespace core
         void on_request_memory_usage(const int64_t _seq, coll_helper& _params);
         void on_report_memory_usage(const int64_t _seq, coll_helper& _params);
         void on_get_ram_usage(const int64_t _seq, coll_helper& _params);
+        void on_get_memory_accounting(const int64_t _seq, coll_helper& _params);
 
         void on_make_archive_holes(const int64_t _seq, coll_helper& _params);
         void on_invalidate_archive_data(const int64_t _seq, coll_helper& _params);
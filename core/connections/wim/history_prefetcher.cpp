@@ -0,0 +1,210 @@
+#include "stdafx.h"
+
+#include "history_prefetcher.h"
+#include "../../../common.shared/string_utils.h"
+
+namespace
+{
+    constexpr std::chrono::seconds hint_lifetime() noexcept { return std::chrono::seconds(30); }
+    constexpr std::chrono::minutes rewarm_timeout() noexcept { return std::chrono::minutes(5); }
+
+    // requests per budget_period, the local ones read the disk, the server ones go to the network
+    constexpr std::chrono::minutes budget_period() noexcept { return std::chrono::minutes(1); }
+    constexpr int32_t max_local_requests() noexcept { return 20; }
+    constexpr int32_t max_server_requests() noexcept { return 5; }
+}
+
+namespace core::wim
+{
+    history_prefetcher::history_prefetcher(size_t _chats_count)
+        : chats_count_(_chats_count)
+    {
+    }
+
+    void history_prefetcher::set_candidates(std::vector<history_prefetch_candidate> _candidates)
+    {
+        candidates_ = std::move(_candidates);
+    }
+
+    void history_prefetcher::add_hint(std::string_view _aimid, time_point _now)
+    {
+        if (_aimid.empty())
+            return;
+
+        const auto it = std::find_if(hints_.begin(), hints_.end(), [_aimid](const auto& _hint) { return _hint.first == _aimid; });
+        if (it != hints_.end())
+            hints_.erase(it);
+
+        hints_.emplace_back(std::string(_aimid), _now);
+        if (hints_.size() > chats_count_)
+            hints_.erase(hints_.begin());
+    }
+
+    std::optional<std::string> history_prefetcher::take_next(time_point _now)
+    {
+        update_budget(_now);
+        if (local_requests_ >= max_local_requests())
+            return std::nullopt;
+
+        for (auto& aimid : get_top(_now))
+        {
+            if (warm_.find(aimid) != warm_.end())
+                continue;
+
+            if (const auto it = last_warmed_.find(aimid); it != last_warmed_.end() && _now - it->second < rewarm_timeout())
+                continue;
+
+            ++local_requests_;
+            ++warmed_;
+            warm_[aimid] = _now;
+            last_warmed_[aimid] = _now;
+            return std::move(aimid);
+        }
+
+        return std::nullopt;
+    }
+
+    bool history_prefetcher::is_budget_spent() const noexcept
+    {
+        return local_requests_ >= max_local_requests();
+    }
+
+    history_prefetcher::time_point history_prefetcher::next_budget_start() const noexcept
+    {
+        return budget_start_ + budget_period();
+    }
+
+    bool history_prefetcher::take_server_request(time_point _now)
+    {
+        update_budget(_now);
+        if (server_requests_ >= max_server_requests())
+            return false;
+
+        ++server_requests_;
+        return true;
+    }
+
+    std::vector<std::string> history_prefetcher::take_evicted(time_point _now)
+    {
+        std::vector<std::string> result;
+        if (warm_.empty())
+            return result;
+
+        const auto top = get_top(_now);
+        for (auto it = warm_.begin(); it != warm_.end();)
+        {
+            if (std::find(top.begin(), top.end(), it->first) == top.end())
+            {
+                result.push_back(it->first);
+                it = warm_.erase(it);
+                ++evicted_;
+            }
+            else
+            {
+                ++it;
+            }
+        }
+
+        for (auto it = last_warmed_.begin(); it != last_warmed_.end();)
+        {
+            if (_now - it->second >= rewarm_timeout())
+                it = last_warmed_.erase(it);
+            else
+                ++it;
+        }
+
+        return result;
+    }
+
+    bool history_prefetcher::on_opened(std::string_view _aimid)
+    {
+        // the chat belongs to the opened dialog now and is freed when the dialog is closed
+        const auto it = warm_.find(std::string(_aimid));
+        if (it == warm_.end())
+        {
+            ++misses_;
+            return false;
+        }
+
+        warm_.erase(it);
+        ++hits_;
+        return true;
+    }
+
+    void history_prefetcher::on_freed(std::string_view _aimid)
+    {
+        warm_.erase(std::string(_aimid));
+    }
+
+    bool history_prefetcher::has_candidates() const noexcept
+    {
+        return !candidates_.empty() || !hints_.empty();
+    }
+
+    std::string history_prefetcher::get_stats_for_log() const
+    {
+        const auto opened = hits_ + misses_;
+        const auto hit_rate = opened > 0 ? hits_ * 100 / opened : 0;
+        return su::concat("history prefetch: warmed=", std::to_string(warmed_),
+            " evicted=", std::to_string(evicted_),
+            " hits=", std::to_string(hits_),
+            " misses=", std::to_string(misses_),
+            " hit_rate=", std::to_string(hit_rate), "%\r\n");
+    }
+
+    std::vector<std::string> history_prefetcher::get_top(time_point _now) const
+    {
+        // the higher in the recents the better, an unread chat gets half of the list on top of it;
+        // the unread chats of that top keep their places, fresh hints take the rest before the read chats,
+        // so hovering over the list never pushes out a chat the user is about to read
+        const auto count = static_cast<int64_t>(candidates_.size());
+        std::vector<std::pair<const history_prefetch_candidate*, int64_t>> ranked;
+        ranked.reserve(candidates_.size());
+        for (int64_t i = 0; i < count; ++i)
+        {
+            const auto& c = candidates_[i];
+            ranked.emplace_back(&c, count - i + (c.unread_count_ > 0 ? count / 2 : 0));
+        }
+
+        const auto ranked_size = std::min(chats_count_, ranked.size());
+        std::partial_sort(ranked.begin(), ranked.begin() + ranked_size, ranked.end(), [](const auto& _l, const auto& _r)
+        {
+            return _l.second > _r.second;
+        });
+
+        std::vector<std::string> result;
+        result.reserve(chats_count_);
+        const auto add = [&result](std::string_view _aimid)
+        {
+            if (std::find(result.begin(), result.end(), _aimid) == result.end())
+                result.emplace_back(_aimid);
+        };
+
+        for (size_t i = 0; i < ranked_size; ++i)
+        {
+            if (ranked[i].first->unread_count_ > 0)
+                add(ranked[i].first->aimid_);
+        }
+
+        for (auto it = hints_.rbegin(); it != hints_.rend() && result.size() < chats_count_; ++it)
+        {
+            if (_now - it->second < hint_lifetime())
+                add(it->first);
+        }
+
+        for (size_t i = 0; i < ranked_size && result.size() < chats_count_; ++i)
+            add(ranked[i].first->aimid_);
+
+        return result;
+    }
+
+    void history_prefetcher::update_budget(time_point _now)
+    {
+        if (_now - budget_start_ < budget_period())
+            return;
+
+        budget_start_ = _now;
+        local_requests_ = 0;
+        server_requests_ = 0;
+    }
+}
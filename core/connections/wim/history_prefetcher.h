@@ -0,0 +1,78 @@
+#pragma once
+
+namespace core::wim
+{
+    struct history_prefetch_candidate
+    {
+        std::string aimid_;
+        int32_t unread_count_ = 0;
+    };
+
+    // picks the chats the user is likely to open next: the top of the recents, unread ones
+    // and the ones hovered or next to the selected chat; the archives of the picked chats are
+    // warmed in the background, so opening them does not wait for the index to load
+    class history_prefetcher
+    {
+    public:
+        using time_point = std::chrono::steady_clock::time_point;
+
+        explicit history_prefetcher(size_t _chats_count);
+
+        // the recents in their order, the top of the list first
+        void set_candidates(std::vector<history_prefetch_candidate> _candidates);
+
+        // a hovered chat or a neighbour of the selected one
+        void add_hint(std::string_view _aimid, time_point _now);
+
+        // the next chat to warm, nothing if all the top chats are warm or the budget is spent;
+        // the chat counts as warm from now on
+        std::optional<std::string> take_next(time_point _now);
+
+        // take_next returns nothing until next_budget_start if this is true
+        bool is_budget_spent() const noexcept;
+        time_point next_budget_start() const noexcept;
+
+        // a hole at the top of a warmed chat may be filled from the server if this returns true
+        bool take_server_request(time_point _now);
+
+        // warm chats which are not at the top anymore and were not opened, their archives can be freed
+        std::vector<std::string> take_evicted(time_point _now);
+
+        // returns true if the chat was warm when it was opened
+        bool on_opened(std::string_view _aimid);
+
+        // the archive of the chat was freed, it is cold again
+        void on_freed(std::string_view _aimid);
+
+        bool has_candidates() const noexcept;
+
+        int64_t get_hits() const noexcept { return hits_; }
+        int64_t get_misses() const noexcept { return misses_; }
+
+        std::string get_stats_for_log() const;
+
+    private:
+        std::vector<std::string> get_top(time_point _now) const;
+        void update_budget(time_point _now);
+
+    private:
+        const size_t chats_count_;
+
+        std::vector<history_prefetch_candidate> candidates_;
+        std::vector<std::pair<std::string, time_point>> hints_;
+
+        // warm chats and the time they were warmed
+        std::unordered_map<std::string, time_point> warm_;
+        // when the chat was warmed last time, so a freed chat is not warmed again right away
+        std::unordered_map<std::string, time_point> last_warmed_;
+
+        time_point budget_start_;
+        int32_t local_requests_ = 0;
+        int32_t server_requests_ = 0;
+
+        int64_t warmed_ = 0;
+        int64_t evicted_ = 0;
+        int64_t hits_ = 0;
+        int64_t misses_ = 0;
+    };
+}
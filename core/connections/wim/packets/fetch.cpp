@@ -7,6 +7,7 @@
 
 #include "../events/events.h"
 #include "../events/webrtc.h"
+#include "../response_sax_handler.h"
 
 #include "../../../log/log.h"
 
@@ -36,6 +37,8 @@ fetch::fetch(
     wait_function_(std::move(_wait_function)),
     fetch_time_(_fetch_params.next_fetch_time_),
     relogin_(relogin::none),
+    have_webrtc_event_(false),
+    events_parse_failed_(false),
     next_fetch_time_(std::chrono::system_clock::now()),
     ts_(0),
     time_offset_(0),
@@ -180,145 +183,168 @@ std::shared_ptr<core::wim::fetch_event> fetch::pop_event()
 }
 
 
-int32_t fetch::parse_response_data(const rapidjson::Value& _data)
+void fetch::parse_event(const rapidjson::Value& _event)
 {
-    try
+    ++events_count_;
+    const auto iter_event_data = _event.FindMember("eventData");
+    if (std::string_view event_type; tools::unserialize_value(_event, "type", event_type) && iter_event_data != _event.MemberEnd())
     {
-        bool have_webrtc_event = false;
+        if (event_type == "buddylist")
+            push_event(std::make_shared<fetch_event_buddy_list>())->parse(iter_event_data->value);
+        else if (event_type == "presence")
+            push_event(std::make_shared<fetch_event_presence>())->parse(iter_event_data->value);
+        else if (event_type == "histDlgState")
+            push_event(std::make_shared<fetch_event_dlg_state>())->parse(iter_event_data->value);
+        else if (event_type == "webrtcMsg")
+            have_webrtc_event_ = true;
+        else if (event_type == "hiddenChat")
+            push_event(std::make_shared<fetch_event_hidden_chat>())->parse(iter_event_data->value);
+        else if (event_type == "diff")
+            push_event(std::make_shared<fetch_event_diff>())->parse(iter_event_data->value);
+        else if (event_type == "myInfo")
+            push_event(std::make_shared<fetch_event_my_info>())->parse(iter_event_data->value);
+        else if (event_type == "userAddedToBuddyList")
+            push_event(std::make_shared<fetch_event_user_added_to_buddy_list>())->parse(iter_event_data->value);
+        else if (event_type == "typing")
+            push_event(std::make_shared<fetch_event_typing>())->parse(iter_event_data->value);
+        else if (event_type == "sessionEnded")
+            on_session_ended(iter_event_data->value);
+        else if (event_type == "permitDeny")
+            push_event(std::make_shared<fetch_event_permit>())->parse(iter_event_data->value);
+        else if (event_type == "imState")
+            push_event(std::make_shared<fetch_event_imstate>())->parse(iter_event_data->value);
+        else if (event_type == "notification")
+            push_event(std::make_shared<fetch_event_notification>())->parse(iter_event_data->value);
+        else if (event_type == "apps")
+            push_event(std::make_shared<fetch_event_appsdata>())->parse(iter_event_data->value);
+        else if (event_type == "mentionMeMessage")
+            push_event(std::make_shared<fetch_event_mention_me>())->parse(iter_event_data->value);
+        else if (event_type == "chatHeadsUpdate")
+            push_event(std::make_shared<fetch_event_chat_heads>())->parse(iter_event_data->value);
+        else if (event_type == "galleryNotify")
+            push_event(std::make_shared<fetch_event_gallery_notify>(get_params().aimid_))->parse(iter_event_data->value);
+        else if (event_type == "mchat")
+            push_event(std::make_shared<fetch_event_mchat>())->parse(iter_event_data->value);
+        else if (event_type == "suggest")
+            push_event(std::make_shared<fetch_event_smartreply_suggest>())->parse(iter_event_data->value);
+        else if (event_type == "pollUpdate")
+            push_event(std::make_shared<fetch_event_poll_update>())->parse(iter_event_data->value);
+        else if (event_type == "asyncResponse")
+            push_event(std::make_shared<fetch_event_async_response>())->parse(iter_event_data->value);
+        else if (event_type == "recentCallLog")
+            push_event(std::make_shared<fetch_event_recent_call_log>())->parse(iter_event_data->value);
+        else if (event_type == "recentCall")
+            push_event(std::make_shared<fetch_event_recent_call>())->parse(iter_event_data->value);
+        else if (event_type == "reactions")
+            push_event(std::make_shared<fetch_event_reactions>())->parse(iter_event_data->value);
+        else if (event_type == "status")
+            push_event(std::make_shared<fetch_event_status>())->parse(iter_event_data->value);
+        else if (event_type == "callRoomInfo")
+            push_event(std::make_shared<fetch_event_call_room_info>())->parse(iter_event_data->value);
+        else if (event_type == "suggestToNotifyUser")
+            push_event(std::make_shared<fetch_event_suggest_to_notify_user>())->parse(iter_event_data->value);
+        else if (event_type == "threadUpdate")
+            push_event(std::make_shared<fetch_event_thread_update>())->parse(iter_event_data->value);
+        else if (event_type == "unreadThreadsCount")
+            push_event(std::make_shared<fetch_event_unread_threads_count>())->parse(iter_event_data->value);
+        else if (event_type == "draft")
+            push_event(std::make_shared<fetch_event_draft>())->parse(iter_event_data->value);
+        else if (event_type == "task")
+            push_event(std::make_shared<fetch_event_task>())->parse(iter_event_data->value);
+        else if (event_type == "trustStatus")
+            push_event(std::make_shared<fetch_event_trust_status>())->parse(iter_event_data->value);
+    }
+}
 
-        events_count_ = 0;
+int32_t fetch::parse_data(const rapidjson::Value& _data)
+{
+    if (relogin_ == relogin::none)
+    {
+        if (!tools::unserialize_value(_data, "fetchBaseURL", next_fetch_url_))
+            return wpie_http_parse_response;
 
-        if (const auto iter_events = _data.FindMember("events"); iter_events != _data.MemberEnd() && iter_events->value.IsArray())
-        {
-            for (const auto& event : iter_events->value.GetArray())
-            {
-                ++events_count_;
-                const auto iter_event_data = event.FindMember("eventData");
-                if (std::string_view event_type; tools::unserialize_value(event, "type", event_type) && iter_event_data != event.MemberEnd())
-                {
-                    if (event_type == "buddylist")
-                        push_event(std::make_shared<fetch_event_buddy_list>())->parse(iter_event_data->value);
-                    else if (event_type == "presence")
-                        push_event(std::make_shared<fetch_event_presence>())->parse(iter_event_data->value);
-                    else if (event_type == "histDlgState")
-                        push_event(std::make_shared<fetch_event_dlg_state>())->parse(iter_event_data->value);
-                    else if (event_type == "webrtcMsg")
-                        have_webrtc_event = true;
-                    else if (event_type == "hiddenChat")
-                        push_event(std::make_shared<fetch_event_hidden_chat>())->parse(iter_event_data->value);
-                    else if (event_type == "diff")
-                        push_event(std::make_shared<fetch_event_diff>())->parse(iter_event_data->value);
-                    else if (event_type == "myInfo")
-                        push_event(std::make_shared<fetch_event_my_info>())->parse(iter_event_data->value);
-                    else if (event_type == "userAddedToBuddyList")
-                        push_event(std::make_shared<fetch_event_user_added_to_buddy_list>())->parse(iter_event_data->value);
-                    else if (event_type == "typing")
-                        push_event(std::make_shared<fetch_event_typing>())->parse(iter_event_data->value);
-                    else if (event_type == "sessionEnded")
-                        on_session_ended(iter_event_data->value);
-                    else if (event_type == "permitDeny")
-                        push_event(std::make_shared<fetch_event_permit>())->parse(iter_event_data->value);
-                    else if (event_type == "imState")
-                        push_event(std::make_shared<fetch_event_imstate>())->parse(iter_event_data->value);
-                    else if (event_type == "notification")
-                        push_event(std::make_shared<fetch_event_notification>())->parse(iter_event_data->value);
-                    else if (event_type == "apps")
-                        push_event(std::make_shared<fetch_event_appsdata>())->parse(iter_event_data->value);
-                    else if (event_type == "mentionMeMessage")
-                        push_event(std::make_shared<fetch_event_mention_me>())->parse(iter_event_data->value);
-                    else if (event_type == "chatHeadsUpdate")
-                        push_event(std::make_shared<fetch_event_chat_heads>())->parse(iter_event_data->value);
-                    else if (event_type == "galleryNotify")
-                        push_event(std::make_shared<fetch_event_gallery_notify>(get_params().aimid_))->parse(iter_event_data->value);
-                    else if (event_type == "mchat")
-                        push_event(std::make_shared<fetch_event_mchat>())->parse(iter_event_data->value);
-                    else if (event_type == "suggest")
-                        push_event(std::make_shared<fetch_event_smartreply_suggest>())->parse(iter_event_data->value);
-                    else if (event_type == "pollUpdate")
-                        push_event(std::make_shared<fetch_event_poll_update>())->parse(iter_event_data->value);
-                    else if (event_type == "asyncResponse")
-                        push_event(std::make_shared<fetch_event_async_response>())->parse(iter_event_data->value);
-                    else if (event_type == "recentCallLog")
-                        push_event(std::make_shared<fetch_event_recent_call_log>())->parse(iter_event_data->value);
-                    else if (event_type == "recentCall")
-                        push_event(std::make_shared<fetch_event_recent_call>())->parse(iter_event_data->value);
-                    else if (event_type == "reactions")
-                        push_event(std::make_shared<fetch_event_reactions>())->parse(iter_event_data->value);
-                    else if (event_type == "status")
-                        push_event(std::make_shared<fetch_event_status>())->parse(iter_event_data->value);
-                    else if (event_type == "callRoomInfo")
-                        push_event(std::make_shared<fetch_event_call_room_info>())->parse(iter_event_data->value);
-                    else if (event_type == "suggestToNotifyUser")
-                        push_event(std::make_shared<fetch_event_suggest_to_notify_user>())->parse(iter_event_data->value);
-                    else if (event_type == "threadUpdate")
-                        push_event(std::make_shared<fetch_event_thread_update>())->parse(iter_event_data->value);
-                    else if (event_type == "unreadThreadsCount")
-                        push_event(std::make_shared<fetch_event_unread_threads_count>())->parse(iter_event_data->value);
-                    else if (event_type == "draft")
-                        push_event(std::make_shared<fetch_event_draft>())->parse(iter_event_data->value);
-                    else if (event_type == "task")
-                        push_event(std::make_shared<fetch_event_task>())->parse(iter_event_data->value);
-                    else if (event_type == "trustStatus")
-                        push_event(std::make_shared<fetch_event_trust_status>())->parse(iter_event_data->value);
-                }
-            }
-        }
+        next_fetch_time_ = std::chrono::system_clock::now();
 
-        if (relogin_ == relogin::none)
-        {
-            if (!tools::unserialize_value(_data, "fetchBaseURL", next_fetch_url_))
-                return wpie_http_parse_response;
+        if (int64_t fetch_timeout = 0; tools::unserialize_value(_data, "timeToNextFetch", fetch_timeout))
+            next_fetch_time_ += std::chrono::milliseconds(fetch_timeout);
 
-            next_fetch_time_ = std::chrono::system_clock::now();
+        if (int64_t next_fetch_timeout = 0; tools::unserialize_value(_data, "fetchTimeout", next_fetch_timeout))
+            next_fetch_timeout_ = std::chrono::seconds(next_fetch_timeout);
 
-            if (int64_t fetch_timeout = 0; tools::unserialize_value(_data, "timeToNextFetch", fetch_timeout))
-                next_fetch_time_ += std::chrono::milliseconds(fetch_timeout);
+        if (int64_t ts = 0; tools::unserialize_value(_data, "ts", ts))
+            ts_ = ts;
+        else
+            return wpie_http_parse_response;
 
-            if (int64_t next_fetch_timeout = 0; tools::unserialize_value(_data, "fetchTimeout", next_fetch_timeout))
-                next_fetch_timeout_ = std::chrono::seconds(next_fetch_timeout);
+        now_ = time(nullptr);
 
-            if (int64_t ts = 0; tools::unserialize_value(_data, "ts", ts))
-                ts_ = ts;
-            else
-                return wpie_http_parse_response;
+        tm now_local_tm = { 0 };
+        tm now_gm_tm = { 0 };
 
-            now_ = time(nullptr);
+        tools::time::localtime(&now_, &now_local_tm);
+        tools::time::gmtime(&now_, &now_gm_tm);
 
-            tm now_local_tm = { 0 };
-            tm now_gm_tm = { 0 };
+        timezone_offset_ = mktime(&now_local_tm) - mktime(&now_gm_tm);
 
-            tools::time::localtime(&now_, &now_local_tm);
-            tools::time::gmtime(&now_, &now_gm_tm);
+        const auto diff = now_ - execute_time_ - std::round(request_time_);
 
-            timezone_offset_ = mktime(&now_local_tm) - mktime(&now_gm_tm);
+        const auto now_local = now_ + timezone_offset_;
 
-            const auto diff = now_ - execute_time_ - std::round(request_time_);
+        time_offset_ = now_ - ts_ - diff;
+        time_offset_local_ = now_local - ts_ - diff;
 
-            const auto now_local = now_ + timezone_offset_;
-
-            time_offset_ = now_ - ts_ - diff;
-            time_offset_local_ = now_local - ts_ - diff;
+        tools::unserialize_value(_data, "hotstartDataComplete", hotstart_complete_);
+    }
 
-            tools::unserialize_value(_data, "hotstartDataComplete", hotstart_complete_);
+    if (have_webrtc_event_) {
+        auto we = std::make_shared<webrtc_event>();
+        if (!!we) {
+            // sorry... the simplest way
+            we->parse(response_str());
+            push_event(we);
+        } else {
+            im_assert(false);
         }
+    }
+
+    return 0;
+}
+
+response_sax_handler* fetch::get_response_sax_handler()
+{
+    events_count_ = 0;
+    have_webrtc_event_ = false;
+    events_parse_failed_ = false;
 
-        if (have_webrtc_event) {
-            auto we = std::make_shared<webrtc_event>();
-            if (!!we) {
-                // sorry... the simplest way
-                we->parse(response_str());
-                push_event(we);
-            } else {
-                im_assert(false);
-            }
+    events_handler_ = std::make_unique<response_array_sax_handler>("events", [this](const rapidjson::Value& _event)
+    {
+        try
+        {
+            parse_event(_event);
+        }
+        catch (const std::exception&)
+        {
+            events_parse_failed_ = true;
         }
+        return true;
+    });
+
+    return events_handler_.get();
+}
+
+int32_t fetch::on_response_data_parsed()
+{
+    if (events_parse_failed_)
+        return wpie_http_parse_response;
+
+    try
+    {
+        return parse_data(events_handler_->get_data());
     }
     catch (const std::exception&)
     {
         return wpie_http_parse_response;
     }
-
-    return 0;
 }
 
 int32_t fetch::on_response_error_code()
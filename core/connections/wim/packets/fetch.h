@@ -17,6 +17,7 @@ namespace core
     namespace wim
     {
         class fetch_event;
+        class response_array_sax_handler;
 
         enum class relogin
         {
@@ -35,13 +36,25 @@ namespace core
             relogin relogin_;
 
             virtual int32_t init_request(const std::shared_ptr<core::http_request_simple>& request) override;
-            virtual int32_t parse_response_data(const rapidjson::Value& _data) override;
             virtual int32_t on_response_error_code() override;
             virtual int32_t execute_request(const std::shared_ptr<core::http_request_simple>& request) override;
 
+            // events are parsed one by one while the response is received
+            virtual response_sax_handler* get_response_sax_handler() override;
+            virtual int32_t on_response_data_parsed() override;
+            virtual bool use_streaming_response() const override { return true; }
+            // voip takes webrtc events from the raw response
+            virtual bool keep_streamed_response_str() const override { return true; }
+
+            void parse_event(const rapidjson::Value& _event);
+            int32_t parse_data(const rapidjson::Value& _data);
+
             void on_session_ended(const rapidjson::Value& _data);
 
             std::list< std::shared_ptr<core::wim::fetch_event> > events_;
+            std::unique_ptr<response_array_sax_handler> events_handler_;
+            bool have_webrtc_event_;
+            bool events_parse_failed_;
 
             std::string next_fetch_url_;
             timepoint next_fetch_time_;
@@ -10,6 +10,7 @@
 #include "../../../log/log.h"
 
 #include "../wim_history.h"
+#include "../response_sax_handler.h"
 #include "../../../utils.h"
 #include "../../../tools/system.h"
 #include "../../../../common.shared/json_helper.h"
@@ -169,6 +170,9 @@ int32_t get_history::parse_results(const rapidjson::Value& _node_results)
     if (!parse_history_messages_json(_node_results, older_msgid_, hist_params_.aimid_, *messages_, *persons_, parse_order))
         return wpie_http_parse_response;
 
+    // a streamed response has no messages in _node_results, they were taken by results_handler_
+    add_history_messages(std::exchange(streamed_messages_, {}), older_msgid_, *messages_, *persons_, parse_order);
+
     if (const auto iter_person = persons_->find(hist_params_.aimid_); iter_person != persons_->end())
     {
         dlg_state_->set_friendly(iter_person->second.friendly_);
@@ -198,8 +202,31 @@ int32_t get_history::parse_results(const rapidjson::Value& _node_results)
     return 0;
 }
 
+response_sax_handler* get_history::get_response_sax_handler()
+{
+    streamed_messages_.clear();
+    results_handler_ = std::make_unique<response_array_sax_handler>("messages", [this](const rapidjson::Value& _message)
+    {
+        streamed_messages_.push_back(unserialize_history_message(_message, hist_params_.aimid_));
+        return true;
+    });
+    return results_handler_.get();
+}
+
+int32_t get_history::on_response_data_parsed()
+{
+    const auto& results = results_handler_->get_data();
+    if (!results.IsObject())
+        return 0;
+
+    return parse_results(results);
+}
+
 priority_t get_history::get_priority() const
 {
+    if (hist_params_.prefetch_)
+        return low_priority();
+
     return priority_protocol();
 }
 
@@ -25,6 +25,8 @@ namespace core
 
     namespace wim
     {
+        class response_array_sax_handler;
+
         struct get_history_params
         {
             const std::string aimid_;
@@ -37,6 +39,8 @@ namespace core
             bool from_editing_;
             bool from_search_;
             bool from_delete_;
+            // requested ahead of opening the dialog, goes after the other requests
+            bool prefetch_ = false;
 
             get_history_params(
                 const std::string &_aimid,
@@ -66,11 +70,20 @@ namespace core
             std::string locale_;
             bool unpinned_;
             std::shared_ptr<core::archive::persons_map> persons_;
+            std::unique_ptr<response_array_sax_handler> results_handler_;
+            // unserialized one by one while the response is received, linked once the persons are known
+            archive::history_block streamed_messages_;
 
             virtual int32_t init_request(const std::shared_ptr<core::http_request_simple>& _request) override;
 
             virtual int32_t parse_results(const rapidjson::Value& _node_results) override;
 
+            // the messages are unserialized as they arrive and never become a DOM, the rest of the
+            // results is built as one; persons may follow the messages so they are linked at the end
+            virtual response_sax_handler* get_response_sax_handler() override;
+            virtual int32_t on_response_data_parsed() override;
+            virtual bool use_streaming_response() const override { return true; }
+
         public:
             get_history(
                 wim_packet_params _params,
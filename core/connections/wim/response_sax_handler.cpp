@@ -0,0 +1,157 @@
+#include "stdafx.h"
+
+#include "response_sax_handler.h"
+
+using namespace core;
+using namespace wim;
+
+bool json_value_builder::StartObject()
+{
+    frames_.push_back(stack_.size());
+    stack_.emplace_back(rapidjson::kObjectType);
+    return true;
+}
+
+bool json_value_builder::EndObject(rapidjson::SizeType /*_members*/)
+{
+    // members are counted on the stack since a caller may have skipped some
+    if (frames_.empty())
+        return false;
+
+    const auto frame = frames_.back();
+    frames_.pop_back();
+
+    auto& object = stack_[frame];
+    for (auto i = frame + 1; i + 1 < stack_.size(); i += 2)
+        object.AddMember(stack_[i], stack_[i + 1], allocator_);
+
+    stack_.resize(frame + 1);
+    return true;
+}
+
+bool json_value_builder::StartArray()
+{
+    frames_.push_back(stack_.size());
+    stack_.emplace_back(rapidjson::kArrayType);
+    return true;
+}
+
+bool json_value_builder::EndArray(rapidjson::SizeType /*_elements*/)
+{
+    if (frames_.empty())
+        return false;
+
+    const auto frame = frames_.back();
+    frames_.pop_back();
+
+    auto& array = stack_[frame];
+    array.Reserve(static_cast<rapidjson::SizeType>(stack_.size() - frame - 1), allocator_);
+    for (auto i = frame + 1; i < stack_.size(); ++i)
+        array.PushBack(stack_[i], allocator_);
+
+    stack_.resize(frame + 1);
+    return true;
+}
+
+const rapidjson::Value& json_value_builder::get() const
+{
+    static const rapidjson::Value null_value;
+    return is_complete() ? stack_.front() : null_value;
+}
+
+void json_value_builder::clear()
+{
+    stack_.clear();
+    frames_.clear();
+    allocator_.Clear();
+}
+
+bool json_value_builder::push(rapidjson::Value&& _value)
+{
+    // a scalar outside of any container is a complete value by itself
+    if (frames_.empty() && !stack_.empty())
+        return false;
+
+    stack_.push_back(std::move(_value));
+    return true;
+}
+
+response_array_sax_handler::response_array_sax_handler(std::string_view _array_key, element_function _on_element)
+    : array_key_(_array_key)
+    , on_element_(std::move(_on_element))
+{
+}
+
+bool response_array_sax_handler::Key(const char* _str, rapidjson::SizeType _length, bool _copy)
+{
+    if (!in_array_ && data_.depth() == 1 && std::string_view(_str, _length) == array_key_)
+    {
+        pending_key_ = std::string(_str, _length);
+        return true;
+    }
+
+    return forward([=](auto& _h) { return _h.Key(_str, _length, _copy); });
+}
+
+bool response_array_sax_handler::StartArray()
+{
+    if (!in_array_ && pending_key_)
+    {
+        pending_key_.reset();
+        in_array_ = true;
+        return true;
+    }
+
+    return forward([](auto& _h) { return _h.StartArray(); });
+}
+
+bool response_array_sax_handler::EndArray(rapidjson::SizeType _elements)
+{
+    if (in_array_ && element_.is_empty())
+    {
+        in_array_ = false;
+        return true;
+    }
+
+    return forward([_elements](auto& _h) { return _h.EndArray(_elements); });
+}
+
+const rapidjson::Value& response_array_sax_handler::get_data() const
+{
+    return data_.get();
+}
+
+response_stream_parser::response_stream_parser(response_sax_handler& _handler, response_envelope _envelope)
+    : filter_(_handler, _envelope)
+    , parser_(filter_)
+{
+}
+
+void response_stream_parser::push(const char* _data, size_t _size)
+{
+    received_size_ += _size;
+    if (failed_)
+        return;
+
+    // a packet handler throwing must not unwind into curl
+    try
+    {
+        failed_ = !parser_.push(_data, _size);
+    }
+    catch (...)
+    {
+        failed_ = true;
+    }
+}
+
+bool response_stream_parser::finish()
+{
+    try
+    {
+        return parser_.finish() && !failed_;
+    }
+    catch (...)
+    {
+        return false;
+    }
+}
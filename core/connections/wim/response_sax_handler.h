@@ -0,0 +1,362 @@
+#pragma once
+
+#include "../../tools/json_stream.h"
+
+namespace core
+{
+    namespace wim
+    {
+        // receives "response.data" of a wim response as rapidjson SAX events;
+        // returning false from any event stops parsing with wpie_error_parse_response
+        class response_sax_handler
+        {
+        public:
+            virtual ~response_sax_handler() = default;
+
+            virtual bool Null() { return true; }
+            virtual bool Bool(bool /*_value*/) { return true; }
+            virtual bool Int(int /*_value*/) { return true; }
+            virtual bool Uint(unsigned /*_value*/) { return true; }
+            virtual bool Int64(int64_t /*_value*/) { return true; }
+            virtual bool Uint64(uint64_t /*_value*/) { return true; }
+            virtual bool Double(double /*_value*/) { return true; }
+            virtual bool String(const char* /*_str*/, rapidjson::SizeType /*_length*/, bool /*_copy*/) { return true; }
+            virtual bool StartObject() { return true; }
+            virtual bool Key(const char* /*_str*/, rapidjson::SizeType /*_length*/, bool /*_copy*/) { return true; }
+            virtual bool EndObject(rapidjson::SizeType /*_members*/) { return true; }
+            virtual bool StartArray() { return true; }
+            virtual bool EndArray(rapidjson::SizeType /*_elements*/) { return true; }
+
+            bool RawNumber(const char* _str, rapidjson::SizeType _length, bool _copy) { return String(_str, _length, _copy); }
+        };
+
+        // how a response carries its status and its payload
+        enum class response_envelope
+        {
+            wim,        // {"response":{"statusCode":..,"statusText":..,"statusDetailCode":..,"data":{..}}}
+            robusto     // {"status":{"code":..},"results":{..}}
+        };
+
+        // status fields picked from the envelope by the SAX pass
+        struct response_sax_status
+        {
+            bool has_status_ = false;
+            bool has_data_ = false;
+            std::optional<uint32_t> status_code_;
+            std::optional<uint32_t> status_detail_code_;
+            std::optional<std::string> status_text_;
+        };
+
+        // builds a rapidjson value from SAX events
+        class json_value_builder
+        {
+        public:
+            bool Null() { return push(rapidjson::Value()); }
+            bool Bool(bool _value) { return push(rapidjson::Value(_value)); }
+            bool Int(int _value) { return push(rapidjson::Value(_value)); }
+            bool Uint(unsigned _value) { return push(rapidjson::Value(_value)); }
+            bool Int64(int64_t _value) { return push(rapidjson::Value(_value)); }
+            bool Uint64(uint64_t _value) { return push(rapidjson::Value(_value)); }
+            bool Double(double _value) { return push(rapidjson::Value(_value)); }
+            bool String(const char* _str, rapidjson::SizeType _length, bool /*_copy*/) { return push(rapidjson::Value(_str, _length, allocator_)); }
+            bool Key(const char* _str, rapidjson::SizeType _length, bool _copy) { return String(_str, _length, _copy); }
+            bool StartObject();
+            bool EndObject(rapidjson::SizeType _members);
+            bool StartArray();
+            bool EndArray(rapidjson::SizeType _elements);
+
+            // a complete value is built once every container is closed
+            bool is_complete() const noexcept { return frames_.empty() && stack_.size() == 1; }
+            bool is_empty() const noexcept { return stack_.empty(); }
+            size_t depth() const noexcept { return frames_.size(); }
+
+            const rapidjson::Value& get() const;
+            void clear();
+
+        private:
+            bool push(rapidjson::Value&& _value);
+
+            rapidjson::MemoryPoolAllocator<> allocator_;
+            std::vector<rapidjson::Value> stack_;
+            // positions of the open containers in stack_
+            std::vector<size_t> frames_;
+        };
+
+        // builds "response.data" as it is parsed, for packets that need all of it at once
+        class response_value_sax_handler : public response_sax_handler
+        {
+        public:
+            bool Null() override { return data_.Null(); }
+            bool Bool(bool _value) override { return data_.Bool(_value); }
+            bool Int(int _value) override { return data_.Int(_value); }
+            bool Uint(unsigned _value) override { return data_.Uint(_value); }
+            bool Int64(int64_t _value) override { return data_.Int64(_value); }
+            bool Uint64(uint64_t _value) override { return data_.Uint64(_value); }
+            bool Double(double _value) override { return data_.Double(_value); }
+            bool String(const char* _str, rapidjson::SizeType _length, bool _copy) override { return data_.String(_str, _length, _copy); }
+            bool Key(const char* _str, rapidjson::SizeType _length, bool _copy) override { return data_.Key(_str, _length, _copy); }
+            bool StartObject() override { return data_.StartObject(); }
+            bool EndObject(rapidjson::SizeType _members) override { return data_.EndObject(_members); }
+            bool StartArray() override { return data_.StartArray(); }
+            bool EndArray(rapidjson::SizeType _elements) override { return data_.EndArray(_elements); }
+
+            // null until the response is parsed
+            const rapidjson::Value& get_data() const { return data_.get(); }
+
+        private:
+            json_value_builder data_;
+        };
+
+        // takes "response.data" element by element: every element of the array under
+        // _array_key is built and handed over on its own, so the whole response never
+        // becomes one DOM; the other members of "response.data" are kept for get_data
+        class response_array_sax_handler : public response_sax_handler
+        {
+        public:
+            // returning false stops parsing
+            using element_function = std::function<bool(const rapidjson::Value& _element)>;
+
+            response_array_sax_handler(std::string_view _array_key, element_function _on_element);
+
+            bool Null() override { return forward([](auto& _h) { return _h.Null(); }); }
+            bool Bool(bool _value) override { return forward([_value](auto& _h) { return _h.Bool(_value); }); }
+            bool Int(int _value) override { return forward([_value](auto& _h) { return _h.Int(_value); }); }
+            bool Uint(unsigned _value) override { return forward([_value](auto& _h) { return _h.Uint(_value); }); }
+            bool Int64(int64_t _value) override { return forward([_value](auto& _h) { return _h.Int64(_value); }); }
+            bool Uint64(uint64_t _value) override { return forward([_value](auto& _h) { return _h.Uint64(_value); }); }
+            bool Double(double _value) override { return forward([_value](auto& _h) { return _h.Double(_value); }); }
+            bool String(const char* _str, rapidjson::SizeType _length, bool _copy) override { return forward([=](auto& _h) { return _h.String(_str, _length, _copy); }); }
+            bool Key(const char* _str, rapidjson::SizeType _length, bool _copy) override;
+            bool StartObject() override { return forward([](auto& _h) { return _h.StartObject(); }); }
+            bool EndObject(rapidjson::SizeType _members) override { return forward([_members](auto& _h) { return _h.EndObject(_members); }); }
+            bool StartArray() override;
+            bool EndArray(rapidjson::SizeType _elements) override;
+
+            // "response.data" without the array, null until the response is parsed
+            const rapidjson::Value& get_data() const;
+
+        private:
+            template <typename F>
+            bool forward(F _event)
+            {
+                if (in_array_)
+                {
+                    if (!_event(element_))
+                        return false;
+                    if (!element_.is_complete())
+                        return true;
+
+                    const auto result = on_element_(element_.get());
+                    element_.clear();
+                    return result;
+                }
+
+                if (pending_key_)
+                {
+                    // the member named like the array holds something else, keep it as is
+                    const auto key = *std::exchange(pending_key_, std::nullopt);
+                    if (!data_.Key(key.c_str(), static_cast<rapidjson::SizeType>(key.size()), true))
+                        return false;
+                }
+
+                return _event(data_);
+            }
+
+            const std::string array_key_;
+            const element_function on_element_;
+            json_value_builder data_;
+            json_value_builder element_;
+            std::optional<std::string> pending_key_;
+            bool in_array_ = false;
+        };
+
+        // picks the status fields of the envelope and forwards the payload to the packet handler
+        class response_sax_filter
+        {
+        public:
+            response_sax_filter(response_sax_handler& _data, response_envelope _envelope) : data_(_data), envelope_(_envelope) {}
+
+            bool Null() { return value([this]() { return data_.Null(); }); }
+            bool Bool(bool _value) { return value([this, _value]() { return data_.Bool(_value); }); }
+            bool Int(int _value) { return value([this, _value]() { return data_.Int(_value); }); }
+            bool Int64(int64_t _value) { return value([this, _value]() { return data_.Int64(_value); }); }
+            bool Uint64(uint64_t _value) { return value([this, _value]() { return data_.Uint64(_value); }); }
+            bool Double(double _value) { return value([this, _value]() { return data_.Double(_value); }); }
+            bool RawNumber(const char* _str, rapidjson::SizeType _length, bool _copy) { return String(_str, _length, _copy); }
+
+            bool Uint(unsigned _value)
+            {
+                if (!is_forwarding())
+                {
+                    if (next_ == slot::status_code)
+                        status_.status_code_ = _value;
+                    else if (next_ == slot::status_detail_code)
+                        status_.status_detail_code_ = _value;
+                }
+                return value([this, _value]() { return data_.Uint(_value); });
+            }
+
+            bool String(const char* _str, rapidjson::SizeType _length, bool _copy)
+            {
+                if (!is_forwarding() && next_ == slot::status_text)
+                    status_.status_text_ = std::string(_str, _length);
+                return value([this, _str, _length, _copy]() { return data_.String(_str, _length, _copy); });
+            }
+
+            bool Key(const char* _str, rapidjson::SizeType _length, bool _copy)
+            {
+                if (is_forwarding())
+                    return data_.Key(_str, _length, _copy);
+
+                const std::string_view key(_str, _length);
+                if (depth_ == 1)
+                    next_ = get_root_slot(key);
+                else if (depth_ == status_depth_)
+                    next_ = get_status_slot(key);
+                else
+                    next_ = slot::none;
+                return true;
+            }
+
+            bool StartObject() { return start([this]() { return data_.StartObject(); }); }
+            bool EndObject(rapidjson::SizeType _members) { return end([this, _members]() { return data_.EndObject(_members); }); }
+            bool StartArray() { return start([this]() { return data_.StartArray(); }); }
+            bool EndArray(rapidjson::SizeType _elements) { return end([this, _elements]() { return data_.EndArray(_elements); }); }
+
+            const response_sax_status& status() const noexcept { return status_; }
+
+        private:
+            enum class slot
+            {
+                none,
+                status,
+                status_code,
+                status_text,
+                status_detail_code,
+                data
+            };
+
+            slot get_root_slot(std::string_view _key) const noexcept
+            {
+                if (envelope_ == response_envelope::robusto)
+                {
+                    if (_key == "status")
+                        return slot::status;
+                    if (_key == "results")
+                        return slot::data;
+                    return slot::none;
+                }
+
+                return _key == "response" ? slot::status : slot::none;
+            }
+
+            slot get_status_slot(std::string_view _key) const noexcept
+            {
+                if (envelope_ == response_envelope::robusto)
+                    return _key == "code" ? slot::status_code : slot::none;
+
+                if (_key == "statusCode")
+                    return slot::status_code;
+                if (_key == "statusText")
+                    return slot::status_text;
+                if (_key == "statusDetailCode")
+                    return slot::status_detail_code;
+                if (_key == "data")
+                    return slot::data;
+                return slot::none;
+            }
+
+            bool is_forwarding() const noexcept { return data_depth_ >= 0; }
+
+            template <typename F>
+            bool value(F _forward)
+            {
+                if (is_forwarding())
+                    return _forward();
+
+                const auto next = std::exchange(next_, slot::none);
+                if (next == slot::data)
+                {
+                    status_.has_data_ = true;
+                    return _forward();
+                }
+                return true;
+            }
+
+            template <typename F>
+            bool start(F _forward)
+            {
+                ++depth_;
+                if (is_forwarding())
+                    return _forward();
+
+                const auto next = std::exchange(next_, slot::none);
+                if (next == slot::data)
+                {
+                    status_.has_data_ = true;
+                    data_depth_ = depth_;
+                    return _forward();
+                }
+
+                if (next == slot::status)
+                {
+                    status_.has_status_ = true;
+                    status_depth_ = depth_;
+                }
+                return true;
+            }
+
+            template <typename F>
+            bool end(F _forward)
+            {
+                auto result = true;
+                if (is_forwarding())
+                {
+                    result = _forward();
+                    if (depth_ == data_depth_)
+                        data_depth_ = -1;
+                }
+                else if (depth_ == status_depth_)
+                {
+                    status_depth_ = -1;
+                }
+
+                --depth_;
+                return result;
+            }
+
+        private:
+            response_sax_handler& data_;
+            const response_envelope envelope_;
+
+            int depth_ = 0;
+            int status_depth_ = -1;
+            int data_depth_ = -1;
+            slot next_ = slot::none;
+
+            response_sax_status status_;
+        };
+
+        // runs the SAX pass over the response while curl receives it, on the curl thread
+        class response_stream_parser
+        {
+        public:
+            response_stream_parser(response_sax_handler& _handler, response_envelope _envelope);
+
+            // called on the curl thread for every received chunk
+            void push(const char* _data, size_t _size);
+
+            // called once the request is done, parses what is left
+            bool finish();
+
+            const response_sax_status& status() const noexcept { return filter_.status(); }
+            size_t get_received_size() const noexcept { return received_size_; }
+
+        private:
+            response_sax_filter filter_;
+            tools::chunked_json_parser<response_sax_filter> parser_;
+            size_t received_size_ = 0;
+            bool failed_ = false;
+        };
+    }
+}
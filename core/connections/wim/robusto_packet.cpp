@@ -1,5 +1,6 @@
 #include "stdafx.h"
 #include "robusto_packet.h"
+#include "response_sax_handler.h"
 
 #include "../../http_request.h"
 #include "../../tools/hmac_sha_base64.h"
@@ -60,6 +61,13 @@ int32_t robusto_packet::parse_response(const std::shared_ptr<core::tools::binary
     load_response_str((const char*) _response->read(size), size);
     try
     {
+        if (auto handler = get_response_sax_handler())
+        {
+            _response->reset_out();
+            _response->write((char) 0);
+            return parse_response_sax(_response->read(_response->available()), *handler);
+        }
+
         rapidjson::Document doc;
         if (doc.Parse(response_str().c_str()).HasParseError())
             return wpie_error_parse_response;
@@ -91,6 +99,24 @@ int32_t robusto_packet::parse_response(const std::shared_ptr<core::tools::binary
 }
 
 
+response_envelope robusto_packet::get_response_envelope() const
+{
+    return response_envelope::robusto;
+}
+
+int32_t robusto_packet::on_response_sax_parsed(const response_sax_status& _status)
+{
+    if (!_status.has_status_ || !_status.status_code_)
+        return wpie_error_parse_response;
+
+    status_code_ = *_status.status_code_;
+
+    if (!is_status_code_ok())
+        return on_response_error_code();
+
+    return _status.has_data_ ? on_response_data_parsed() : 0;
+}
+
 int32_t robusto_packet::on_response_error_code()
 {
     if (40200 <= status_code_ && status_code_ < 40300)
@@ -36,6 +36,8 @@ namespace core
 
             int32_t parse_response(const std::shared_ptr<core::tools::binary_stream>& _response) override;
             int32_t on_response_error_code() override;
+            response_envelope get_response_envelope() const override;
+            int32_t on_response_sax_parsed(const response_sax_status& _status) override;
             int32_t execute_request(const std::shared_ptr<core::http_request_simple>& _request) override;
             void execute_request_async(const std::shared_ptr<core::http_request_simple>& request, handler_t _handler) override;
 
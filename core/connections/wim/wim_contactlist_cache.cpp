@@ -10,6 +10,7 @@
 #include "../../log/log.h"
 #include "../../../common.shared/json_helper.h"
 #include "../../tools/system.h"
+#include "../../tools/unicode.h"
 #include "../libomicron/include/omicron/omicron.h"
 
 using namespace core;
@@ -144,6 +145,24 @@ void cl_presence::unserialize(const rapidjson::Value& _node)
         auto_added_ = !aa.empty();
 }
 
+void cl_presence::update_memory_usage()
+{
+    int64_t size = sizeof(cl_presence);
+    for (const auto str : { &usertype_, &chattype_, &status_msg_, &other_number_, &sms_number_, &ab_contact_name_, &friendly_, &nick_,
+                            &icon_id_, &big_icon_id_, &large_icon_id_, &search_cache_.aimid_, &search_cache_.friendly_,
+                            &search_cache_.nick_, &search_cache_.ab_, &search_cache_.sms_number_ })
+    {
+        size += static_cast<int64_t>(str->capacity());
+    }
+
+    for (const auto& capability : capabilities_)
+        size += static_cast<int64_t>(capability.capacity());
+
+    size += static_cast<int64_t>((search_cache_.friendly_words_.capacity() + search_cache_.ab_words_.capacity()) * sizeof(std::string_view));
+
+    memory_.set(size);
+}
+
 bool cl_presence::are_icons_equal(const cl_presence& _other) const
 {
     return are_icons_equal(*this, _other);
@@ -159,13 +178,14 @@ void cl_buddy::prepare_search_cache()
 {
     if (presence_ && presence_->search_cache_.is_empty())
     {
-        presence_->search_cache_.aimid_ = tools::system::to_upper(aimid_);
-        presence_->search_cache_.friendly_ = tools::system::to_upper(presence_->friendly_);
-        presence_->search_cache_.nick_ = tools::system::to_upper(presence_->nick_);
-        presence_->search_cache_.ab_ = tools::system::to_upper(presence_->ab_contact_name_);
+        presence_->search_cache_.aimid_ = tools::unicode::to_upper(aimid_);
+        presence_->search_cache_.friendly_ = tools::unicode::to_upper(presence_->friendly_);
+        presence_->search_cache_.nick_ = tools::unicode::to_upper(presence_->nick_);
+        presence_->search_cache_.ab_ = tools::unicode::to_upper(presence_->ab_contact_name_);
         presence_->search_cache_.sms_number_ = presence_->sms_number_;
         presence_->search_cache_.friendly_words_ = tools::get_words(presence_->search_cache_.friendly_);
         presence_->search_cache_.ab_words_ = tools::get_words(presence_->search_cache_.ab_);
+        presence_->update_memory_usage();
     }
 }
 
@@ -3,6 +3,7 @@
 #include "persons.h"
 #include "lastseen.h"
 #include "status.h"
+#include "../../stats/memory/memory_accounting.h"
 
 namespace core
 {
@@ -69,6 +70,11 @@ namespace core
 
             } search_cache_;
 
+            memory_stats::tagged_size<memory_stats::memory_tag::contact_list> memory_{ static_cast<int64_t>(sizeof(cl_presence)) };
+
+            // counts the strings and the search cache, the object itself is counted from construction
+            void update_memory_usage();
+
             void serialize(icollection* _coll);
             void serialize(rapidjson::Value& _node, rapidjson_allocator& _a);
             void unserialize(const rapidjson::Value& _node);
@@ -83,13 +89,16 @@ namespace core
             std::string aimid_;
             std::shared_ptr<cl_presence> presence_;
 
+            memory_stats::tagged_size<memory_stats::memory_tag::contact_list> memory_{ static_cast<int64_t>(sizeof(cl_buddy)) };
+
             cl_buddy() : id_(0), presence_(std::make_shared<cl_presence>()) {}
 
             void prepare_search_cache();
         };
 
         using cl_buddy_ptr = std::shared_ptr<cl_buddy>;
-        using cl_buddies_map = std::map<std::string, cl_buddy_ptr>;
+        using cl_buddies_map = std::map<std::string, cl_buddy_ptr, std::less<std::string>,
+            memory_stats::counting_allocator<std::pair<const std::string, cl_buddy_ptr>, memory_stats::memory_tag::contact_list>>;
 
         struct cl_group
         {
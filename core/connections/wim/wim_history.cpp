@@ -39,46 +39,41 @@ namespace
     }
 
     template<typename R>
-    void parse_history_messages_array(R&& range, int64_t _older_msg_id, Out archive::history_block &_block, const archive::persons_map& _persons, const std::string &_sender_aimid)
+    void add_history_messages_range(R&& range, int64_t _older_msg_id, Out archive::history_block &_block, const archive::persons_map& _persons)
     {
         auto prev_msg_id = _older_msg_id;
 
-        for (const auto& x : std::forward<R>(range))
+        for (auto msg : std::forward<R>(range))
         {
-            auto msg = std::make_shared<archive::history_message>();
+            // failed to unserialize
+            if (!msg)
+                continue;
 
-            if (0 != msg->unserialize(x, _sender_aimid))
-            {
-                im_assert(!"parse message error");
-            }
-            else
-            {
-                im_assert(!msg->is_patch());
+            im_assert(!msg->is_patch());
 
-                const auto is_same_as_prev = (prev_msg_id == msg->get_msgid());
-                im_assert(!is_same_as_prev);
+            const auto is_same_as_prev = (prev_msg_id == msg->get_msgid());
+            im_assert(!is_same_as_prev);
 
-                if (is_same_as_prev)
-                {
-                    // workaround for the server issue
-
-                    __INFO(
-                        "delete_history",
-                        "server issue detected, message skipped\n"
-                        "    older_msg_id=<%1%>\n"
-                        "    prev_msg_id=<%2%>\n"
-                        "    msg_id=<%3%>",
-                        _older_msg_id % prev_msg_id % msg->get_msgid()
-                    );
-
-                    continue;
-                }
+            if (is_same_as_prev)
+            {
+                // workaround for the server issue
+
+                __INFO(
+                    "delete_history",
+                    "server issue detected, message skipped\n"
+                    "    older_msg_id=<%1%>\n"
+                    "    prev_msg_id=<%2%>\n"
+                    "    msg_id=<%3%>",
+                    _older_msg_id % prev_msg_id % msg->get_msgid()
+                );
+
+                continue;
+            }
 
-                msg->set_prev_msgid(prev_msg_id);
-                _block.push_back(msg);
+            msg->set_prev_msgid(prev_msg_id);
+            _block.push_back(msg);
 
-                prev_msg_id = msg->get_msgid();
-            }
+            prev_msg_id = msg->get_msgid();
 
             apply_persons(msg, _persons);
         }
@@ -106,16 +101,43 @@ bool core::wim::parse_history_messages_json(
     if (iter_messages->value.Empty())
         return true;
 
-    _block.reserve(iter_messages->value.Size());
+    archive::history_block messages;
+    messages.reserve(iter_messages->value.Size());
+    for (const auto& x : iter_messages->value.GetArray())
+        messages.push_back(unserialize_history_message(x, _sender_aimid));
 
-    if (auto array = iter_messages->value.GetArray(); message_order::reverse == _order)
-        parse_history_messages_array(boost::adaptors::reverse(boost::make_iterator_range(array.begin(), array.end())), _older_msg_id, _block, _persons, _sender_aimid);
-    else
-        parse_history_messages_array(std::move(array), _older_msg_id, _block, _persons, _sender_aimid);
+    add_history_messages(messages, _older_msg_id, _block, _persons, _order);
 
     return true;
 }
 
+archive::history_message_sptr core::wim::unserialize_history_message(const rapidjson::Value& _node, const std::string& _sender_aimid)
+{
+    auto msg = std::make_shared<archive::history_message>();
+    if (0 != msg->unserialize(_node, _sender_aimid))
+    {
+        im_assert(!"parse message error");
+        return nullptr;
+    }
+
+    return msg;
+}
+
+void core::wim::add_history_messages(
+    const archive::history_block& _messages,
+    const int64_t _older_msg_id,
+    Out archive::history_block& _block,
+    const archive::persons_map& _persons,
+    message_order _order)
+{
+    _block.reserve(_block.size() + _messages.size());
+
+    if (message_order::reverse == _order)
+        add_history_messages_range(boost::adaptors::reverse(_messages), _older_msg_id, _block, _persons);
+    else
+        add_history_messages_range(_messages, _older_msg_id, _block, _persons);
+}
+
 patch_container core::wim::parse_patches_json(const rapidjson::Value& _node_patch)
 {
     patch_container result;
@@ -20,6 +20,7 @@ namespace core
         class history_patch;
 
         using history_patch_uptr = std::unique_ptr<history_patch>;
+        using history_message_sptr = std::shared_ptr<history_message>;
         using dlg_state_head = std::pair<std::string, std::string>;
     }
 
@@ -40,6 +41,18 @@ namespace core
             message_order _order,
             const char* _node_member = "messages");
 
+        // one element of a messages array, null if it is broken
+        archive::history_message_sptr unserialize_history_message(const rapidjson::Value& _node, const std::string& _sender_aimid);
+
+        // links and orders unserialized messages in the order of their array, as parse_history_messages_json does;
+        // lets a packet unserialize the messages while the response streams in and link them once it is done
+        void add_history_messages(
+            const archive::history_block& _messages,
+            const int64_t _older_msg_id,
+            Out archive::history_block& _block,
+            const archive::persons_map& _persons,
+            message_order _order);
+
         using patch_container = std::vector<std::pair<int64_t, archive::history_patch_uptr>>;
 
         patch_container parse_patches_json(const rapidjson::Value& _node_patch);
@@ -74,6 +74,7 @@
 #include "../../../common.shared/smartreply/smartreply_types.h"
 
 #include "../../tools/system.h"
+#include "../../tools/unicode.h"
 #include "../../tools/file_sharing.h"
 #include "../../../common.shared/json_helper.h"
 #include "../../tools/features.h"
@@ -112,6 +113,7 @@
 #include "archive/draft_storage.h"
 #include "../../tasks/task_storage.h"
 #include "threads_unread_cache.h"
+#include "history_prefetcher.h"
 
 
 using namespace core;
@@ -125,6 +127,9 @@ namespace
     constexpr int64_t prefetch_count = 30;
     constexpr int32_t empty_timer_id = -1;
     constexpr auto gallery_holes_request_rate = std::chrono::milliseconds(400);
+    constexpr auto history_prefetch_rate = std::chrono::milliseconds(500);
+    constexpr int32_t history_prefetch_page_size = 30;
+    constexpr int64_t history_prefetch_log_period = 50;
     constexpr auto post_messages_rate = std::chrono::seconds(1);
     constexpr auto rate_limit_timeout = std::chrono::seconds(30);
     constexpr auto robusto_rate_limit_timeout = std::chrono::seconds(10);
@@ -565,6 +570,9 @@ im::im(const im_login_id& _login,
     waiting_for_local_pin_(false),
     last_gallery_hole_request_time_(std::chrono::steady_clock::now() - gallery_holes_request_rate),
     gallery_hole_timer_id_(empty_timer_id),
+    history_prefetcher_(std::make_unique<history_prefetcher>(features::history_prefetch_chats_count())),
+    history_prefetch_timer_id_(empty_timer_id),
+    history_prefetch_in_progress_(false),
     external_config_failed_(false),
     external_config_timer_id_(empty_timer_id)
 {
@@ -588,6 +596,7 @@ im::~im()
     stop_external_config_timer();
     stop_resolve_hosts_timer();
     stop_refresh_o2token_timer();
+    stop_timer(history_prefetch_timer_id_);
     g_core->write_string_to_network_log("im end dtor\n");
 }
 
@@ -1544,7 +1553,9 @@ void im::on_im_created()
 {
     im_created_ = true;
 
-    g_core->post_message_to_gui("im/created", 0, nullptr);
+    coll_helper coll(g_core->create_collection(), true);
+    coll.set_value_as_string("cache_path", tools::from_utf16(get_content_cache_path()));
+    g_core->post_message_to_gui("im/created", 0, coll.get());
 
     schedule_store_timer();
     schedule_ui_activity_timer();
@@ -2155,9 +2166,9 @@ file_info_handler_t im::make_sticker_handler(const stickers::download_task& _tas
                     set_id,
                     sticker_id,
                     fs_id,
-                    sz)->on_result_ = [set_id, sticker_id, fs_id, sz](std::wstring_view _path)
+                    sz)->on_result_ = [set_id, sticker_id, fs_id, sz](std::wstring_view _path, int64_t _offset, int64_t _length)
                 {
-                    stickers::post_sticker_2_gui(0, set_id, sticker_id, fs_id, sz, _path);
+                    stickers::post_sticker_2_gui(0, set_id, sticker_id, fs_id, sz, _path, _offset, _length);
                 };
             }
         }
@@ -2317,14 +2328,14 @@ void im::get_sticker(const int64_t _seq, const int32_t _set_id, const int32_t _s
     im_assert(_size < sticker_size::max);
 
     get_stickers()->get_sticker(_seq, _set_id, _sticker_id, _fs_id, _size)->on_result_ =
-        [_seq, _set_id, _sticker_id, fs_id = _fs_id, _size, wr_this = weak_from_this()](std::wstring_view _sticker_path)
+        [_seq, _set_id, _sticker_id, fs_id = _fs_id, _size, wr_this = weak_from_this()](std::wstring_view _sticker_path, int64_t _offset, int64_t _length)
     {
         auto ptr_this = wr_this.lock();
         if (!ptr_this)
             return;
 
         if (tools::system::is_exist(_sticker_path))
-            stickers::post_sticker_2_gui(_seq, _set_id, _sticker_id, fs_id, _size, _sticker_path);
+            stickers::post_sticker_2_gui(_seq, _set_id, _sticker_id, fs_id, _size, _sticker_path, _offset, _length);
         else
             ptr_this->download_stickers_and_icons();
     };
@@ -2891,6 +2902,9 @@ void im::save_cached_objects(force_save _force)
     save_group_members_caches();
     save_tasks();
     save_threads_unread_count();
+
+    if (archive_)
+        archive_->commit_store();
 }
 
 void im::start_session(is_ping _is_ping, is_login _is_login)
@@ -6666,7 +6680,7 @@ void im::search_dialogs_local(const std::string& _term, const std::vector<std::s
     auto last_symb_id = std::make_shared<int32_t>(0);
 
     auto cterm = std::make_shared<archive::coded_term>();
-    cterm->lower_term = ::tools::system::to_lower(_term);
+    cterm->lower_term = ::tools::unicode::to_lower(_term);
     cterm->coded_string = tools::convert_string_to_vector(_term, last_symb_id, cterm->symbs, cterm->symb_indexes, cterm->symb_table);
     cterm->prefix = std::vector<int32_t>(tools::build_prefix(cterm->coded_string));
 
@@ -8092,6 +8106,13 @@ void im::add_opened_dialog(const std::string& _contact)
         load_cached_smartreplies(_contact);
         post_dlg_state_to_gui(_contact, false, false, true, true);
         write_add_opened_dialog(_contact);
+
+        if (features::is_history_prefetch_enabled())
+        {
+            history_prefetcher_->on_opened(_contact);
+            if ((history_prefetcher_->get_hits() + history_prefetcher_->get_misses()) % history_prefetch_log_period == 0)
+                g_core->write_string_to_network_log(history_prefetcher_->get_stats_for_log());
+        }
     }
 }
 
@@ -8104,6 +8125,7 @@ void im::remove_opened_dialog(const std::string& _contact)
     }
 
     get_archive()->free_dialog(_contact);
+    history_prefetcher_->on_freed(_contact);
     remove_postponed_for_update_dialog(_contact);
     if (search_history_)
         search_history_->free_dialog(_contact, async_tasks_);
@@ -8114,6 +8136,112 @@ bool im::has_opened_dialogs(const std::string& _contact) const
     return opened_dialogs_.find(_contact) != opened_dialogs_.end();
 }
 
+void im::set_history_prefetch_candidates(std::vector<history_prefetch_candidate> _candidates)
+{
+    if (!features::is_history_prefetch_enabled())
+        return;
+
+    history_prefetcher_->set_candidates(std::move(_candidates));
+    schedule_history_prefetch();
+}
+
+void im::add_history_prefetch_hint(const std::string& _contact)
+{
+    if (!features::is_history_prefetch_enabled())
+        return;
+
+    history_prefetcher_->add_hint(_contact, std::chrono::steady_clock::now());
+    schedule_history_prefetch();
+}
+
+void im::schedule_history_prefetch()
+{
+    if (history_prefetch_timer_id_ != empty_timer_id)
+        return;
+
+    history_prefetch_timer_id_ = g_core->add_timer({ [wr_this = weak_from_this()]
+    {
+        auto ptr_this = wr_this.lock();
+        if (!ptr_this)
+            return;
+
+        ptr_this->prefetch_next_history();
+    } }, history_prefetch_rate);
+}
+
+void im::schedule_history_prefetch_budget(std::chrono::steady_clock::duration _wait)
+{
+    // the chats left are warmed when the next budget window starts, candidates and hints
+    // arriving meanwhile don't restart the prefetch as the timer id is taken
+    const auto timeout = std::chrono::ceil<std::chrono::milliseconds>(_wait);
+    history_prefetch_timer_id_ = g_core->add_single_shot_timer({ [wr_this = weak_from_this()]
+    {
+        auto ptr_this = wr_this.lock();
+        if (!ptr_this)
+            return;
+
+        ptr_this->history_prefetch_timer_id_ = empty_timer_id;
+        ptr_this->schedule_history_prefetch();
+    } }, std::max(timeout, history_prefetch_rate));
+}
+
+void im::prefetch_next_history()
+{
+    // one chat at a time, so the prefetch never holds up the archive thread for long
+    if (history_prefetch_in_progress_)
+        return;
+
+    const auto now = std::chrono::steady_clock::now();
+    for (const auto& contact : history_prefetcher_->take_evicted(now))
+    {
+        if (!has_opened_dialogs(contact))
+            get_archive()->free_dialog(contact);
+    }
+
+    const auto contact = history_prefetcher_->take_next(now);
+    if (!contact)
+    {
+        stop_timer(history_prefetch_timer_id_);
+        if (history_prefetcher_->is_budget_spent())
+            schedule_history_prefetch_budget(history_prefetcher_->next_budget_start() - now);
+        return;
+    }
+
+    if (has_opened_dialogs(*contact))
+    {
+        history_prefetcher_->on_freed(*contact);
+        return;
+    }
+
+    history_prefetch_in_progress_ = true;
+    get_archive()->prefetch_history(*contact, history_prefetch_page_size)->on_result = [wr_this = weak_from_this(), contact = *contact](bool _has_top_hole)
+    {
+        auto ptr_this = wr_this.lock();
+        if (!ptr_this)
+            return;
+
+        ptr_this->history_prefetch_in_progress_ = false;
+
+        if (!_has_top_hole || !core::configuration::get_app_config().is_server_history_enabled())
+            return;
+
+        if (!ptr_this->history_prefetcher_->take_server_request(std::chrono::steady_clock::now()))
+            return;
+
+        ptr_this->get_archive()->get_dlg_state(contact)->on_result = [wr_this, contact](const archive::dlg_state& _state)
+        {
+            auto ptr_this = wr_this.lock();
+            if (!ptr_this)
+                return;
+
+            // the newest page, so the hole found at the top of the warmed chat is filled by this one request
+            get_history_params hist_params(contact, -1, -1, -history_prefetch_page_size, _state.get_history_patch_version(default_patch_version).as_string());
+            hist_params.prefetch_ = true;
+            ptr_this->get_history_from_server(hist_params);
+        };
+    };
+}
+
 void im::set_last_read(const std::string& _contact, int64_t _message, message_read_mode _mode)
 {
     get_archive()->get_dlg_state(_contact)->on_result = [wr_this = weak_from_this(), _contact, _message, _mode](const archive::dlg_state& _local_dlg_state)
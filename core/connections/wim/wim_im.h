@@ -526,6 +526,10 @@ namespace core
             std::deque<std::string> gallery_hole_requests_;
             int32_t gallery_hole_timer_id_;
 
+            std::unique_ptr<history_prefetcher> history_prefetcher_;
+            int32_t history_prefetch_timer_id_;
+            bool history_prefetch_in_progress_;
+
             bool external_config_failed_;
             int32_t external_config_timer_id_;
 
@@ -819,6 +823,12 @@ namespace core
             void add_opened_dialog(const std::string& _contact) override;
             void remove_opened_dialog(const std::string& _contact) override;
             bool has_opened_dialogs(const std::string& _contact) const;
+
+            void set_history_prefetch_candidates(std::vector<history_prefetch_candidate> _candidates) override;
+            void add_history_prefetch_hint(const std::string& _contact) override;
+            void schedule_history_prefetch();
+            void schedule_history_prefetch_budget(std::chrono::steady_clock::duration _wait);
+            void prefetch_next_history();
             void set_last_read(const std::string& _contact, int64_t _message, message_read_mode _mode) override;
             void set_last_read_mention(const std::string& _contact, int64_t _message) override;
             void set_last_read_partial(const std::string& _contact, int64_t _message) override;
@@ -1,6 +1,7 @@
 #include "stdafx.h"
 
 #include "wim_packet.h"
+#include "response_sax_handler.h"
 
 #include "../../http_request.h"
 #include "../../tools/hmac_sha_base64.h"
@@ -54,13 +55,40 @@ int32_t wim_packet::execute()
     if (err != 0)
         return err;
 
+    std::shared_ptr<response_stream_parser> stream_parser;
+    if (use_streaming_response())
+    {
+        request->set_use_streaming_decompression(true);
+
+        if (auto handler = get_response_sax_handler())
+        {
+            response_str_.clear();
+            stream_parser = std::make_shared<response_stream_parser>(*handler, get_response_envelope());
+            request->set_response_data_function([this, stream_parser, keep_str = keep_streamed_response_str()](const char* _data, size_t _size)
+            {
+                stream_parser->push(_data, _size);
+                if (keep_str)
+                    response_str_.append(_data, _size);
+            });
+        }
+    }
+
     err = execute_request(request);
+    const auto stream_parsed = stream_parser && stream_parser->finish();
     if (err != 0)
         return err;
 
-    auto response = std::static_pointer_cast<tools::binary_stream>(request->get_response());
-    im_assert(response);
-    err = parse_response(response);
+    if (stream_parser)
+    {
+        err = on_response_streamed(*stream_parser, stream_parsed);
+    }
+    else
+    {
+        auto response = std::static_pointer_cast<tools::binary_stream>(request->get_response());
+        im_assert(response);
+        err = parse_response(response);
+    }
+
     if (err != 0 && g_core->is_im_stats_enabled())
     {
         core::stats::event_props_type props;
@@ -89,6 +117,9 @@ void wim_packet::execute_async(handler_t _handler)
         return;
     }
 
+    if (use_streaming_response())
+        request->set_use_streaming_decompression(true);
+
     execute_request_async(request, [wr_this = weak_from_this(), request, _handler = std::move(_handler)](int32_t _err)
     {
         auto ptr_this = wr_this.lock();
@@ -307,6 +338,9 @@ int32_t wim_packet::parse_response(const std::shared_ptr<core::tools::binary_str
         const std::string json_str_dbg(json_str);
 #endif
 
+        if (auto handler = get_response_sax_handler())
+            return parse_response_sax(json_str, *handler);
+
         rapidjson::Document doc;
         if (doc.ParseInsitu(json_str).HasParseError())
             return wpie_error_parse_response;
@@ -359,6 +393,62 @@ int32_t wim_packet::parse_response(const std::shared_ptr<core::tools::binary_str
     return 0;
 }
 
+int32_t wim_packet::parse_response_sax(char* _json, response_sax_handler& _handler)
+{
+    response_sax_filter filter(_handler, get_response_envelope());
+    rapidjson::InsituStringStream stream(_json);
+    rapidjson::Reader reader;
+    if (reader.Parse<rapidjson::kParseInsituFlag>(stream, filter).IsError())
+        return wpie_error_parse_response;
+
+    return on_response_sax_parsed(filter.status());
+}
+
+int32_t wim_packet::on_response_streamed(const response_stream_parser& _parser, bool _parsed)
+{
+    if (!_parser.get_received_size())
+        return wpie_http_empty_response;
+
+    if (!_parsed)
+        return wpie_error_parse_response;
+
+    try
+    {
+        return on_response_sax_parsed(_parser.status());
+    }
+    catch (...)
+    {
+        return 0;
+    }
+}
+
+response_envelope wim_packet::get_response_envelope() const
+{
+    return response_envelope::wim;
+}
+
+int32_t wim_packet::on_response_sax_parsed(const response_sax_status& _status)
+{
+    if (!_status.has_status_ || !_status.status_code_)
+        return wpie_http_parse_response;
+
+    status_code_ = *_status.status_code_;
+
+    if (_status.status_text_)
+        status_text_ = *_status.status_text_;
+
+    if (_status.status_detail_code_)
+        status_detail_code_ = *_status.status_detail_code_;
+
+    if (status_code_ != 200)
+        return on_response_error_code();
+
+    if (!_status.has_data_)
+        return on_empty_data();
+
+    return on_response_data_parsed();
+}
+
 int32_t wim_packet::on_response_error_code()
 {
     switch (status_code_)
@@ -11,6 +11,14 @@ namespace core
 {
     class http_request_simple;
 
+    namespace wim
+    {
+        class response_sax_handler;
+        class response_stream_parser;
+        struct response_sax_status;
+        enum class response_envelope;
+    }
+
     namespace tools
     {
         class binary_stream;
@@ -277,6 +285,22 @@ namespace core
             virtual int32_t on_empty_data();
             virtual int32_t on_response_error_code();
 
+            // packets with large responses may take "response.data" as SAX events instead of a DOM;
+            // on_response_data_parsed is then called in place of parse_response_data for status 200.
+            // the handler is asked for once per execution and must start clean
+            virtual response_sax_handler* get_response_sax_handler() { return nullptr; }
+            virtual int32_t on_response_data_parsed() { return 0; }
+            virtual response_envelope get_response_envelope() const;
+            virtual int32_t on_response_sax_parsed(const response_sax_status& _status);
+            int32_t parse_response_sax(char* _json, response_sax_handler& _handler);
+            int32_t on_response_streamed(const response_stream_parser& _parser, bool _parsed);
+
+            // inflate the response while it is received and, with a SAX handler, parse it on
+            // the curl thread as it arrives; execute_async still parses the received body
+            virtual bool use_streaming_response() const { return false; }
+            // a streamed response is not held anywhere unless the packet needs its text in response_str
+            virtual bool keep_streamed_response_str() const { return false; }
+
             virtual int32_t on_http_client_error();
 
             const wim_packet_params& get_params() const;
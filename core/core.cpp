@@ -34,6 +34,7 @@
 #include "archive/local_history.h"
 #include "log/log.h"
 #include "profiling/profiler.h"
+#include "profiling/trace.h"
 #include "updater/updater.h"
 #include "crash_sender.h"
 #include "statistics.h"
@@ -44,6 +45,7 @@
 #include "tools/system.h"
 #include "proxy_settings.h"
 #include "tools/strings.h"
+#include "stats/memory/memory_accounting.h"
 #include "stats/memory/memory_stats_collector.h"
 #include "connections/wim/memory_usage/gui_memory_consumption_reporter.h"
 #include "post_install_action.h"
@@ -321,6 +323,7 @@ core_dispatcher::core_dispatcher()
     , core_factory_(nullptr)
     , delayed_stat_timer_id_(0)
     , omicron_update_timer_id_(0)
+    , memory_accounting_timer_id_(0)
 {
 #ifdef _WIN32
     std::locale loc = boost::locale::generator().generate(std::string());
@@ -338,6 +341,9 @@ core_dispatcher::~core_dispatcher()
 {
     profiler::flush_logs();
 
+    if (profiler::trace::is_enabled())
+        profiler::trace::save_chrome_json((utils::get_logs_path() / L"trace.json").wstring());
+
     log::shutdown();
 
     http_request_simple::shutdown_global();
@@ -457,6 +463,9 @@ void core::core_dispatcher::start(const common::core_gui_settings& _settings)
     const auto app_ini_path = utils::get_app_ini_path();
     configuration::load_app_config(app_ini_path);
 
+    // recording costs a store per event, so it is a runtime switch of app.ini rather than a debug build option
+    profiler::trace::set_enabled(configuration::get_app_config().is_trace_events_enabled());
+
     // called from core thread
     network_log_ = std::make_unique<network_log>(utils::get_logs_path());
 
@@ -491,6 +500,13 @@ void core::core_dispatcher::start(const common::core_gui_settings& _settings)
     memory_stats_collector_->register_consumption_reporter(std::move(voip_memory_reporter));
 #endif
 
+    memory_stats_collector_->sample_accounting();
+    memory_accounting_timer_id_ = add_timer({ [this]
+    {
+        if (memory_stats_collector_)
+            write_string_to_network_log(memory_stats::format_sample(memory_stats_collector_->sample_accounting()));
+    } }, memory_stats::accounting_sample_interval());
+
     im_container_ = std::make_shared<im_container>(voip_manager_,
                                                    memory_stats_collector_);
 
@@ -557,6 +573,9 @@ void core::core_dispatcher::unlink_gui()
 
         if (omicron_update_timer_id_ > 0)
             stop_timer(omicron_update_timer_id_);
+
+        if (memory_accounting_timer_id_ > 0)
+            stop_timer(memory_accounting_timer_id_);
         omicronlib::omicron_cleanup();
 
 #ifndef STRIP_NET_CHANGE_NOTIFY
@@ -1246,6 +1265,9 @@ void core::core_dispatcher::on_message_profiler_proc_start(coll_helper _params)
     const auto id = _params.get_value_as_int64("id");
     const auto ts = _params.get_value_as_int64("ts");
 
+    if (profiler::trace::is_enabled())
+        profiler::trace::async_begin(profiler::trace::intern(name), id, ts);
+
     profiler::process_started(name, id, ts);
 }
 
@@ -1254,6 +1276,9 @@ void core::core_dispatcher::on_message_profiler_proc_stop(coll_helper _params) c
     const auto id = _params.get_value_as_int64("id");
     const auto ts = _params.get_value_as_int64("ts");
 
+    if (profiler::trace::is_enabled())
+        profiler::trace::async_end(profiler::trace::intern(_params.get_value_as_string("name")), id, ts);
+
     profiler::process_stopped(id, ts);
 }
 
@@ -1272,6 +1297,8 @@ void core::core_dispatcher::receive_message_from_gui(std::string_view _message,
 
     execute_core_context({ [this, message_string = std::string(_message), _seq, _message_data]
     {
+        profiler::trace::scope trace_scope{ std::string_view(message_string) };
+
         coll_helper params(_message_data, true);
 
         if (message_string.front() != '_')
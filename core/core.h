@@ -140,6 +140,7 @@ namespace core
         uint32_t delayed_stat_timer_id_;
         uint32_t delayed_post_timer_id_;
         uint32_t omicron_update_timer_id_;
+        uint32_t memory_accounting_timer_id_;
 
         void load_gui_settings();
         void post_gui_settings();
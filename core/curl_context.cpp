@@ -10,6 +10,7 @@
 #include "curl_handler.h"
 #include "network_log.h"
 #include "statistics.h"
+#include "profiling/trace.h"
 
 #include "curl_context.h"
 
@@ -68,6 +69,27 @@ namespace
         return CURLAUTH_BASIC;
     }
 
+#ifdef SUPPORT_REPLAY_SERVER
+    constexpr std::string_view get_replay_host_header_attribut() noexcept
+    {
+        return "IM-Replay-Host";
+    }
+
+    // dev.replay_server sends every request to a local server stand-in over plain http,
+    // the original host is passed in a header for the stand-in to tell the endpoints apart
+    std::string make_replay_url(std::string_view _url, std::string_view _replay_server, std::string& _host)
+    {
+        if (const auto scheme = _url.find("://"); scheme != std::string_view::npos)
+            _url.remove_prefix(scheme + 3);
+
+        const auto path_start = _url.find('/');
+        _host = std::string(_url.substr(0, path_start));
+
+        const auto path = path_start == std::string_view::npos ? std::string_view("/") : _url.substr(path_start);
+        return su::concat("http://", _replay_server, path);
+    }
+#endif // SUPPORT_REPLAY_SERVER
+
     constexpr std::string_view get_request_dict_header_attribut() noexcept
     {
         return "IM-ZSTD-Request-Dict";
@@ -163,6 +185,9 @@ core::curl_context::curl_context(std::shared_ptr<tools::stream> _output, http_re
     multi_(false),
     compression_method_(data_compression_method::none),
     use_curl_decompression_(false),
+    use_streaming_decompression_(false),
+    body_started_(false),
+    response_data_streamed_(false),
     resolve_failed_(false),
     use_new_connection_(false)
 {
@@ -282,12 +307,24 @@ bool core::curl_context::init_handler(CURL* _curl)
         }
     }
 
-    curl_easy_setopt(_curl, CURLOPT_URL, original_url_.c_str());
-    auto resolved = config::hosts::format_resolve_host_str(original_url_, 443);
-    if (!resolved.empty())
+#ifdef SUPPORT_REPLAY_SERVER
+    if (const auto replay_server = core::configuration::get_app_config().replay_server(); !replay_server.empty())
     {
-        resolve_host_ = curl_slist_append(resolve_host_, resolved.c_str());
-        curl_easy_setopt(_curl, CURLOPT_RESOLVE, resolve_host_);
+        std::string host;
+        const auto replay_url = make_replay_url(original_url_, replay_server, host);
+        curl_easy_setopt(_curl, CURLOPT_URL, replay_url.c_str());
+        set_custom_header_param(su::concat(get_replay_host_header_attribut(), ": ", host));
+    }
+    else
+#endif // SUPPORT_REPLAY_SERVER
+    {
+        curl_easy_setopt(_curl, CURLOPT_URL, original_url_.c_str());
+        auto resolved = config::hosts::format_resolve_host_str(original_url_, 443);
+        if (!resolved.empty())
+        {
+            resolve_host_ = curl_slist_append(resolve_host_, resolved.c_str());
+            curl_easy_setopt(_curl, CURLOPT_RESOLVE, resolve_host_);
+        }
     }
 
     curl_easy_setopt(_curl, CURLOPT_FOLLOWLOCATION, 1L);
@@ -493,6 +530,7 @@ const std::shared_ptr<core::tools::binary_stream>& core::curl_context::get_heade
 CURLcode core::curl_context::execute_handler(CURL* _curl)
 {
     start_time_ = std::chrono::steady_clock().now();
+    trace_started();
 
     auto res = curl_easy_perform(_curl);
 
@@ -506,11 +544,63 @@ CURLcode core::curl_context::execute_handler(CURL* _curl)
 CURLMcode core::curl_context::execute_multi_handler(CURLM* _multi, CURL* _curl)
 {
     start_time_ = std::chrono::steady_clock().now();
+    trace_started();
     return curl_multi_add_handle(_multi, _curl);
 }
 
+void core::curl_context::write_output(const char* _data, size_t _size)
+{
+    if (!body_started_)
+    {
+        body_started_ = true;
+
+        // headers are complete by the first body chunk
+        const auto encoding = use_curl_decompression_ ? std::string() : http_header::get_attribute(get_header(), "Content-Encoding");
+        if (use_streaming_decompression_ && encoding == get_data_compression_method_name(data_compression_method::gzip))
+            inflater_ = std::make_unique<tools::gzip_inflater>();
+
+        response_data_streamed_ = response_data_func_ && (encoding.empty() || inflater_);
+    }
+
+    if (response_data_streamed_)
+    {
+        // the consumer takes the body as it arrives, it is not held here in any form
+        if (inflater_)
+            inflater_->write(_data, _size, [this](const char* _inflated, size_t _inflated_size) { write_streamed_output(_inflated, _inflated_size); });
+        else
+            write_streamed_output(_data, _size);
+        return;
+    }
+
+    if (inflater_)
+    {
+        compressed_.append(_data, _size);
+        inflater_->write(_data, _size, *output_);
+    }
+    else
+        output_->write(_data, static_cast<int64_t>(_size));
+
+    body_buffered_.set(output_->available() + static_cast<int64_t>(compressed_.size()));
+}
+
+void core::curl_context::write_streamed_output(const char* _data, size_t _size)
+{
+    response_data_func_(_data, _size);
+
+    if (is_need_log() && !use_curl_decompression_)
+        write_log_data(_data, static_cast<int64_t>(_size));
+}
+
 void core::curl_context::decompress_output_if_needed()
 {
+    if (response_data_streamed_)
+    {
+        // already inflated and logged in write_output, a broken body fails the consumer's parsing
+        if (inflater_ && (!inflater_->is_finished() || inflater_->is_failed()))
+            write_log_string("\n*** failed to decompress response\n");
+        return;
+    }
+
     if (!use_curl_decompression_ && output_->available())
     {
         const auto encoding = http_header::get_attribute(get_header(), "Content-Encoding");
@@ -529,7 +619,15 @@ void core::curl_context::decompress_output_if_needed()
         {
             core::tools::binary_stream data;
             bool result = false;
-            if (is_gzip_encoding)
+            if (inflater_)
+            {
+                // already inflated in write_output, on failure the output gets the raw body back
+                result = inflater_->is_finished() && !inflater_->is_failed();
+                if (!result)
+                    data.write(compressed_.data(), static_cast<int64_t>(compressed_.size()));
+                std::string().swap(compressed_);
+            }
+            else if (is_gzip_encoding)
             {
                 result = tools::decompress_gzip(*output_, data);
             }
@@ -544,11 +642,15 @@ void core::curl_context::decompress_output_if_needed()
             }
 
 
-            if (result)
-            {
-                output_->swap(&data);
-            }
-            else if (is_send_stats)
+            if (result && !inflater_)
+                output_->swap(&data); // the inflated body
+            else if (!result && inflater_)
+                output_->swap(&data); // the raw body back
+
+            if (response_data_func_ && !response_data_streamed_)
+                response_data_func_(output_->get_data(), static_cast<size_t>(output_->available()));
+
+            if (!result && is_send_stats)
             {
                 core::stats::event_props_type props;
                 props.emplace_back("endpoint", normalized_url_);
@@ -556,6 +658,8 @@ void core::curl_context::decompress_output_if_needed()
 
                 write_log_string("\n*** failed to decompress response\n");
             }
+
+            body_buffered_.set(output_->available());
         }
 
         if (is_need_log())
@@ -566,8 +670,20 @@ void core::curl_context::decompress_output_if_needed()
     }
 }
 
+void core::curl_context::trace_started()
+{
+    if (!profiler::trace::is_enabled())
+        return;
+
+    trace_name_ = profiler::trace::intern(normalized_url_.empty() ? std::string_view("http_request") : std::string_view(normalized_url_));
+    profiler::trace::async_begin(trace_name_, reinterpret_cast<intptr_t>(this));
+}
+
 void core::curl_context::load_info(CURL* _curl, CURLcode _result)
 {
+    if (trace_name_)
+        profiler::trace::async_end(std::exchange(trace_name_, nullptr), reinterpret_cast<intptr_t>(this));
+
     decompress_output_if_needed();
 
     curl_easy_getinfo(_curl, CURLINFO_RESPONSE_CODE, &response_code_);
@@ -744,6 +860,16 @@ void core::curl_context::set_use_curl_decompression(bool _enable)
     use_curl_decompression_ = _enable;
 }
 
+void core::curl_context::set_use_streaming_decompression(bool _enable)
+{
+    use_streaming_decompression_ = _enable;
+}
+
+void core::curl_context::set_response_data_function(http_request_simple::response_data_function _func)
+{
+    response_data_func_ = std::move(_func);
+}
+
 void core::curl_context::set_use_new_connection(bool _use)
 {
     use_new_connection_ = _use;
@@ -880,6 +1006,7 @@ void core::curl_context::set_post_data(const char* _data, int64_t _size, bool _c
                 post_data_copy_ = std::make_unique<char[]>(post_data_size_);
                 post_data_ = post_data_copy_.get();
                 memcpy(post_data_, compressed_data.get_data(), post_data_size_);
+                buffered_.add(post_data_size_);
 
                 return;
             }
@@ -902,6 +1029,7 @@ void core::curl_context::set_post_data(const char* _data, int64_t _size, bool _c
         post_data_copy_ = std::make_unique<char[]>(post_data_size_);
         post_data_ = post_data_copy_.get();
         memcpy(post_data_, _data, post_data_size_);
+        buffered_.add(post_data_size_);
     }
     else
     {
@@ -934,6 +1062,7 @@ static size_t write_header_function(void *contents, size_t size, size_t nmemb, v
     auto ctx = (core::curl_context *) userp;
     ctx->header_->reserve((uint32_t)realsize);
     ctx->header_->write((char *)contents, (uint32_t)realsize);
+    ctx->buffered_.add(static_cast<int64_t>(realsize));
 
     return realsize;
 }
@@ -944,7 +1073,7 @@ static size_t write_memory_callback(void* _contents, size_t _size, size_t _nmemb
     auto ctx = static_cast<core::curl_context*>(_userp);
     auto contents = static_cast<char*>(_contents);
 
-    ctx->output_->write(contents, static_cast<int64_t>(realsize));
+    ctx->write_output(contents, realsize);
 
     if (ctx->is_use_curl_decompression() && ctx->is_write_data_log())
         ctx->write_log_data(contents, static_cast<int64_t>(realsize));
@@ -3,11 +3,17 @@
 #include "curl.h"
 
 #include "http_request.h"
+#include "stats/memory/memory_accounting.h"
 
 #include <boost/variant.hpp>
 
 namespace core
 {
+    namespace tools
+    {
+        class gzip_inflater;
+    }
+
     struct curl_context : std::enable_shared_from_this<curl_context>
     {
     public:
@@ -68,9 +74,12 @@ namespace core
         CURLcode execute_handler(CURL* _curl);
         CURLMcode execute_multi_handler(CURLM* _multi, CURL* _curl);
 
+        void write_output(const char* _data, size_t _size);
+        void write_streamed_output(const char* _data, size_t _size);
         void decompress_output_if_needed();
 
         void load_info(CURL* _curl, CURLcode _resul);
+        void trace_started();
         void write_log(CURLcode res);
 
         core::curl_easy::completion_code execute_request();
@@ -85,6 +94,8 @@ namespace core
 
         bool is_use_curl_decompression() const;
         void set_use_curl_decompression(bool _enable);
+        void set_use_streaming_decompression(bool _enable);
+        void set_response_data_function(http_request_simple::response_data_function _func);
         void set_use_new_connection(bool _use);
 
         const std::string& zstd_request_dict() const;
@@ -103,6 +114,9 @@ namespace core
         std::shared_ptr<tools::binary_stream> header_;
         std::shared_ptr<tools::binary_stream> log_data_;
 
+        // the headers and the post data copy held while the request is alive
+        memory_stats::tagged_size<memory_stats::memory_tag::curl_buffers> buffered_;
+
         int32_t bytes_transferred_pct_;
 
     private:
@@ -152,11 +166,23 @@ namespace core
         data_compression_method compression_method_;
 
         std::chrono::steady_clock::time_point start_time_;
+        const char* trace_name_ = nullptr;
 
         std::string zstd_request_dict_;
         std::string zstd_response_dict_;
         bool use_curl_decompression_;
+        bool use_streaming_decompression_;
+        bool body_started_;
+        std::unique_ptr<tools::gzip_inflater> inflater_;
+        // the raw body behind inflater_, put back into the output if inflating fails
+        std::string compressed_;
+        http_request_simple::response_data_function response_data_func_;
+        // the body goes to response_data_func_ as it arrives, otherwise once decompressed
+        bool response_data_streamed_;
         bool resolve_failed_;
         bool use_new_connection_;
+
+        // the response body as held: inflated plus the raw copy while streaming, decompressed once done
+        memory_stats::tagged_size<memory_stats::memory_tag::curl_buffers> body_buffered_;
     };
 }
@@ -55,6 +55,7 @@ http_request_simple::http_request_simple(proxy_settings _proxy_settings, std::st
     is_send_im_stats_(true),
     multi_(false),
     use_curl_decompression_(false),
+    use_streaming_decompression_(false),
     use_new_connection_(false),
     compression_method_(data_compression_method::none)
 {
@@ -181,6 +182,16 @@ void core::http_request_simple::set_use_curl_decompresion(bool _enable)
     use_curl_decompression_ = _enable;
 }
 
+void core::http_request_simple::set_use_streaming_decompression(bool _enable)
+{
+    use_streaming_decompression_ = _enable;
+}
+
+void core::http_request_simple::set_response_data_function(response_data_function _func)
+{
+    response_data_func_ = std::move(_func);
+}
+
 void core::http_request_simple::set_use_new_connection(bool _use)
 {
     use_new_connection_ = _use;
@@ -230,6 +241,8 @@ curl_easy::completion_code http_request_simple::send_request(bool _post, double&
 
     ctx->set_post_data_compression(compression_method_);
     ctx->set_use_curl_decompression(use_curl_decompression_);
+    ctx->set_use_streaming_decompression(use_streaming_decompression_);
+    ctx->set_response_data_function(response_data_func_);
     ctx->set_use_new_connection(use_new_connection_);
     ctx->set_normalized_url(get_normalized_url());
     if (_post)
@@ -310,6 +323,8 @@ void http_request_simple::send_request_async(bool _post, completion_function _co
 
     ctx->set_post_data_compression(compression_method_);
     ctx->set_use_curl_decompression(use_curl_decompression_);
+    ctx->set_use_streaming_decompression(use_streaming_decompression_);
+    ctx->set_response_data_function(response_data_func_);
 
     if (_post)
     {
@@ -61,10 +61,14 @@ namespace core
 
         using progress_function = std::function<void(int64_t _bytes_total, int64_t _bytes_transferred, int32_t _pct_transferred)>;
 
+        // receives the decompressed response body chunk by chunk on the curl thread
+        using response_data_function = std::function<void(const char* _data, size_t _size)>;
+
     private:
         stop_function stop_func_;
         progress_function progress_func_;
         replace_log_function replace_log_function_;
+        response_data_function response_data_func_;
         std::map<std::string, std::string> post_parameters_;
         std::map<std::string, std::string> post_form_parameters_;
         std::multimap<std::string, std::string> post_form_files_;
@@ -108,6 +112,7 @@ namespace core
         bool is_send_im_stats_;
         bool multi_;
         bool use_curl_decompression_;
+        bool use_streaming_decompression_;
         bool use_new_connection_;
         data_compression_method compression_method_;
 
@@ -177,6 +182,10 @@ namespace core
         void set_timeout(std::chrono::milliseconds _timeout);
 
         void set_use_curl_decompresion(bool _enable);
+        // inflate gzip responses while they are received instead of after the transfer
+        void set_use_streaming_decompression(bool _enable);
+        // the body is still buffered in the response stream as well
+        void set_response_data_function(response_data_function _func);
         void set_use_new_connection(bool _use);
 
         static std::vector<std::unique_ptr<std::mutex>> ssl_sync_objects;
@@ -1,27 +1,48 @@
 #include "stdafx.h"
 #include "network_log.h"
-#include "async_task.h"
 #include "utils.h"
 #include "tools/system.h"
 #include "tools/coretime.h"
 #include "configuration/app_config.h"
+#include "tools/spsc_ring.h"
 
 namespace core
 {
     constexpr int64_t max_file_size = 1024 * 1024 * 10;
     constexpr int64_t max_logs_size = max_file_size * 5;
     constexpr int64_t max_logs_size_full = max_file_size * 50;
+    constexpr size_t thread_ring_capacity = 256;
+    // records reach the file at most two intervals after they were written
+    constexpr auto writer_flush_interval = std::chrono::milliseconds(200);
+
+    class network_log::record_ring : public tools::spsc_ring<network_log_record, thread_ring_capacity>
+    {
+    public:
+        explicit record_ring(uint64_t _owner_id) : owner_id_(_owner_id) {}
+
+        const uint64_t owner_id_;
+    };
 
     network_log::network_log(const boost::filesystem::wpath& _logs_directory)
-        :   write_thread_(std::make_unique<async_executer>("log")),
-            file_context_(std::make_shared<log_file_context>(_logs_directory))
+        :   file_context_(std::make_shared<log_file_context>(_logs_directory)),
+            instance_id_([]() { static std::atomic<uint64_t> last_id = 0; return ++last_id; }()),
+            has_records_(false),
+            stop_(false)
     {
         max_size_ = core::configuration::get_app_config().is_full_log_enabled() ? max_logs_size_full : max_logs_size;
+        writer_thread_ = std::thread([this]() { writer_thread_proc(); });
     }
 
     network_log::~network_log()
     {
-        write_thread_.reset();
+        {
+            std::scoped_lock lock(writer_mutex_);
+            stop_ = true;
+        }
+        writer_cond_.notify_all();
+
+        if (writer_thread_.joinable())
+            writer_thread_.join();
     }
 
     bool create_logs_directory(const boost::filesystem::wpath& _logs_directory)
@@ -148,6 +169,19 @@ namespace core
         }
     }
 
+    network_log::record_ring& network_log::get_thread_ring()
+    {
+        thread_local std::shared_ptr<record_ring> ring;
+        if (!ring || ring->owner_id_ != instance_id_)
+        {
+            ring = std::make_shared<record_ring>(instance_id_);
+
+            std::scoped_lock lock(rings_mutex_);
+            rings_.push_back(ring);
+        }
+        return *ring;
+    }
+
     void network_log::write_data(tools::binary_stream _data)
     {
         if (!_data.available())
@@ -156,74 +190,145 @@ namespace core
             return;
         }
 
-        const auto current_time = std::chrono::time_point_cast<std::chrono::milliseconds>(std::chrono::system_clock::now());
-        const auto current_thread_id = std::this_thread::get_id();
+        network_log_record record;
+        record.time_ = std::chrono::time_point_cast<std::chrono::milliseconds>(std::chrono::system_clock::now());
+        record.thread_id_ = std::this_thread::get_id();
+        record.data_ = std::move(_data);
+
+        if (!get_thread_ring().push(std::move(record)))
+        {
+            std::scoped_lock lock(overflow_mutex_);
+            overflow_.push_back(std::move(record));
+        }
+
+        // the flag is set outside the lock, so the writer may have checked it and not be waiting yet;
+        // taking the lock makes the notification wait until it does
+        if (!has_records_.exchange(true))
+        {
+            std::scoped_lock lock(writer_mutex_);
+            writer_cond_.notify_one();
+        }
+    }
+
+    void network_log::collect_records(std::vector<network_log_record>& _records)
+    {
+        const auto append = [&_records](network_log_record&& _record) { _records.push_back(std::move(_record)); };
+        {
+            std::scoped_lock lock(rings_mutex_);
+            for (const auto& ring : rings_)
+                ring->consume_all(append);
+
+            // rings of finished threads are referenced by the registry only
+            rings_.erase(std::remove_if(rings_.begin(), rings_.end(), [](const auto& _ring) { return _ring.use_count() == 1 && _ring->empty(); }), rings_.end());
+        }
+        {
+            std::scoped_lock lock(overflow_mutex_);
+            for (auto& record : overflow_)
+                append(std::move(record));
+            overflow_.clear();
+        }
+
+        std::stable_sort(_records.begin(), _records.end(), [](const auto& _lhs, const auto& _rhs) { return _lhs.time_ < _rhs.time_; });
+    }
 
-        auto file_context = file_context_;
-        auto file_names_history = &file_names_history_;
+    void network_log::write_records(const std::vector<network_log_record>& _records)
+    {
+        auto& file_context = *file_context_;
+        std::stringstream ss_header;
 
-        auto max_size = max_size_;
-        write_thread_->run_async_function([current_time, current_thread_id, bs_data = std::make_shared<tools::binary_stream>(std::move(_data)), file_context, file_names_history, max_size]()->int32_t
+        for (const auto& record : _records)
         {
-            if (!file_context->file_stream_)
+            if (!file_context.file_stream_)
             {
-                if (file_context->file_index_ < 0)
+                if (file_context.file_index_ < 0)
                 {
-                    if (!create_logs_directory(file_context->logs_directory_))
-                        return -1;
+                    if (!create_logs_directory(file_context.logs_directory_))
+                        return;
 
-                    file_context->file_index_ = get_log_index(file_context->logs_directory_);
+                    file_context.file_index_ = get_log_index(file_context.logs_directory_);
                 }
                 else
                 {
-                    ++file_context->file_index_;
+                    ++file_context.file_index_;
                 }
 
                 std::ios_base::openmode open_mode = std::fstream::binary | std::fstream::out | std::fstream::app;
 
-                const auto file_path = get_file_path(file_context->file_index_, file_context->logs_directory_);
+                const auto file_path = get_file_path(file_context.file_index_, file_context.logs_directory_);
 
-                file_context->file_stream_ = std::make_unique<boost::filesystem::ofstream>(file_path, open_mode);
-                if (!file_context->file_stream_->good())
+                file_context.file_stream_ = std::make_unique<boost::filesystem::ofstream>(file_path, open_mode);
+                if (!file_context.file_stream_->good())
                 {
-                    file_context->file_stream_.reset();
-                    return -1;
+                    file_context.file_stream_.reset();
+                    return;
                 }
                 else
                 {
-                    file_names_history->push(file_path.wstring());
+                    file_names_history_.push(file_path.wstring());
                 }
             }
 
-            std::stringstream ss_header;
-            const auto now_c = std::chrono::system_clock::to_time_t(current_time);
+            ss_header.str(std::string());
+
+            const auto now_c = std::chrono::system_clock::to_time_t(record.time_);
 
             tm now_tm = { 0 };
             tools::time::localtime(&now_c, &now_tm);
 
-            const auto fraction = (current_time.time_since_epoch().count() % 1000);
-            ss_header << '[' << std::put_time<char>(&now_tm, "%c") << '.' << fraction << "].[" << current_thread_id << "]\n";
+            const auto fraction = (record.time_.time_since_epoch().count() % 1000);
+            ss_header << '[' << std::put_time<char>(&now_tm, "%c") << '.' << fraction << "].[" << record.thread_id_ << "]\n";
 
-            uint32_t data_size = bs_data->available();
+            const auto data_size = record.data_.available();
 
             const auto header_string = ss_header.str();
-            file_context->file_stream_->write(header_string.c_str(), header_string.length());
-            file_context->file_stream_->write((const char*) bs_data->read(data_size), data_size);
-            file_context->file_stream_->put('\n');
+            file_context.file_stream_->write(header_string.c_str(), header_string.length());
+            file_context.file_stream_->write(record.data_.read_available(), data_size);
+            file_context.file_stream_->put('\n');
+
+            if (file_context.file_stream_->tellp() > max_file_size)
+            {
+                file_context.file_stream_->close();
+                file_context.file_stream_.reset();
+
+                clean_logs(file_context.logs_directory_, max_size_);
+            }
+        }
+    }
 
-            file_context->file_stream_->flush();
+    void network_log::writer_thread_proc()
+    {
+        core::utils::set_this_thread_name("log");
+
+        std::vector<network_log_record> records;
+        auto last_flush = std::chrono::steady_clock::now();
 
-            auto file_size = file_context->file_stream_->tellp();
-            if (file_size > max_file_size)
+        for (;;)
+        {
+            bool stop = false;
             {
-                file_context->file_stream_->close();
-                file_context->file_stream_.reset();
+                std::unique_lock<std::mutex> lock(writer_mutex_);
+                writer_cond_.wait_for(lock, writer_flush_interval, [this]() { return stop_ || has_records_; });
 
-                clean_logs(file_context->logs_directory_, max_size);
+                stop = stop_;
+                has_records_ = false;
             }
 
-            return 0;
-        });
+            collect_records(records);
+            write_records(records);
+            records.clear();
+
+            // a busy log is flushed once an interval rather than on every batch, an idle one on the next timeout
+            const auto now = std::chrono::steady_clock::now();
+            if (stop || now - last_flush >= writer_flush_interval)
+            {
+                if (file_context_->file_stream_)
+                    file_context_->file_stream_->flush();
+                last_flush = now;
+            }
+
+            if (stop)
+                return;
+        }
     }
 
     void network_log::write_string(std::string_view _text)
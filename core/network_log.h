@@ -5,8 +5,6 @@
 
 namespace core
 {
-    class async_executer;
-
     struct log_file_context
     {
         const boost::filesystem::wpath logs_directory_;
@@ -27,14 +25,42 @@ namespace core
         }
     };
 
+    struct network_log_record
+    {
+        std::chrono::time_point<std::chrono::system_clock, std::chrono::milliseconds> time_;
+        std::thread::id thread_id_;
+        tools::binary_stream data_;
+    };
+
     class network_log
     {
-        std::unique_ptr<async_executer> write_thread_;
+        // callers append raw records to their own thread ring without locking,
+        // the writer thread drains all rings and formats record headers
+        class record_ring;
 
         std::shared_ptr<log_file_context> file_context_;
 
         std::stack<std::wstring> file_names_history_;
 
+        const uint64_t instance_id_;
+
+        std::mutex rings_mutex_;
+        std::vector<std::shared_ptr<record_ring>> rings_;
+
+        std::mutex overflow_mutex_;
+        std::vector<network_log_record> overflow_;
+
+        std::mutex writer_mutex_;
+        std::condition_variable writer_cond_;
+        std::atomic<bool> has_records_;
+        std::atomic<bool> stop_;
+        std::thread writer_thread_;
+
+        record_ring& get_thread_ring();
+        void collect_records(std::vector<network_log_record>& _records);
+        void write_records(const std::vector<network_log_record>& _records);
+        void writer_thread_proc();
+
     public:
 
         network_log(const boost::filesystem::wpath& _logs_directory);
@@ -1,6 +1,7 @@
 #include "stdafx.h"
 
 #include "profiler.h"
+#include "trace.h"
 
 #include "../log/log.h"
 #include "../tools/coretime.h"
@@ -56,6 +57,7 @@ namespace core
     namespace profiler
     {
         auto_stop_watch::auto_stop_watch(const char *_process_name)
+            : trace_scope_(std::string_view(_process_name))
         {
             im_assert(_process_name);
             im_assert(::strlen(_process_name));
@@ -238,6 +240,9 @@ namespace
         auto iter = process_info_accum_.find(_process_id);
         im_assert(iter != process_info_accum_.end());
 
+        if (iter == process_info_accum_.end())
+            return;
+
         iter->second.time_ended_ = _ts;
     }
 
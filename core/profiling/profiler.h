@@ -1,5 +1,7 @@
 #pragma once
 
+#include "trace.h"
+
 namespace core
 {
 
@@ -16,6 +18,8 @@ namespace core
         private:
             int64_t id_;
 
+            trace::scope trace_scope_;
+
         };
 
         void enable(const bool _enable);
@@ -0,0 +1,352 @@
+#include "stdafx.h"
+
+#include "trace.h"
+
+#include "../tools/binary_stream.h"
+
+using namespace core;
+using namespace profiler;
+
+namespace
+{
+    // an event takes 32 bytes, so a chunk is 128KB, a thread holds at most 1MB and all of them 8MB;
+    // events past the limits are counted as dropped
+    constexpr size_t chunk_size = 4 * 1024;
+    constexpr size_t max_events_per_thread = 32 * 1024;
+    constexpr size_t max_chunks = 64;
+
+    enum class event_type : char
+    {
+        begin = 'B',
+        end = 'E',
+        counter = 'C',
+        async_begin = 'b',
+        async_end = 'e'
+    };
+
+    struct event
+    {
+        const char* name_;
+        int64_t ts_;
+        int64_t value_;
+        event_type type_;
+    };
+
+    using chunk = std::array<event, chunk_size>;
+
+    // written only by the owning thread; chunks are added under the mutex so the exporter
+    // can read the first size_ events while the owner keeps appending
+    struct thread_buffer
+    {
+        explicit thread_buffer(uint64_t _tid, uint64_t _generation) : tid_(_tid), generation_(_generation) {}
+
+        const uint64_t tid_;
+        uint64_t generation_;
+        std::string name_;
+        std::vector<std::unique_ptr<chunk>> chunks_;
+        std::atomic<size_t> size_ = 0;
+        std::atomic<size_t> dropped_ = 0;
+        std::mutex mutex_;
+    };
+
+    std::atomic<bool> is_enabled_ = false;
+    std::atomic<uint64_t> generation_ = 0;
+    std::atomic<size_t> chunks_count_ = 0;
+
+    std::mutex registry_mutex_;
+    std::vector<std::shared_ptr<thread_buffer>> registry_;
+    uint64_t last_tid_ = 0;
+
+    std::mutex names_mutex_;
+    std::unordered_set<std::string> names_;
+
+    const auto steady_epoch_ = std::chrono::steady_clock::now();
+    const auto system_epoch_ = std::chrono::system_clock::now();
+
+    int64_t now_us() noexcept
+    {
+        return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - steady_epoch_).count();
+    }
+
+    int64_t from_system_ms(const int64_t _ts_ms) noexcept
+    {
+        const auto system_epoch_us = std::chrono::duration_cast<std::chrono::microseconds>(system_epoch_.time_since_epoch()).count();
+        return _ts_ms * 1000 - system_epoch_us;
+    }
+
+    thread_buffer& get_thread_buffer()
+    {
+        thread_local std::shared_ptr<thread_buffer> buffer;
+        if (!buffer)
+        {
+            std::scoped_lock lock(registry_mutex_);
+            buffer = std::make_shared<thread_buffer>(++last_tid_, generation_.load(std::memory_order_relaxed));
+            registry_.push_back(buffer);
+        }
+        return *buffer;
+    }
+
+    void record(const char* _name, event_type _type, int64_t _value, int64_t _ts)
+    {
+        if (!_name || !is_enabled_.load(std::memory_order_relaxed))
+            return;
+
+        auto& buffer = get_thread_buffer();
+
+        const auto generation = generation_.load(std::memory_order_acquire);
+        if (buffer.generation_ != generation)
+        {
+            std::scoped_lock lock(buffer.mutex_);
+            chunks_count_.fetch_sub(buffer.chunks_.size(), std::memory_order_relaxed);
+            buffer.chunks_.clear();
+            buffer.size_.store(0, std::memory_order_relaxed);
+            buffer.dropped_.store(0, std::memory_order_relaxed);
+            buffer.generation_ = generation;
+        }
+
+        const auto size = buffer.size_.load(std::memory_order_relaxed);
+        if (size >= max_events_per_thread)
+        {
+            buffer.dropped_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        const auto chunk_index = size / chunk_size;
+        if (chunk_index == buffer.chunks_.size())
+        {
+            if (chunks_count_.fetch_add(1, std::memory_order_relaxed) >= max_chunks)
+            {
+                chunks_count_.fetch_sub(1, std::memory_order_relaxed);
+                buffer.dropped_.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+
+            std::scoped_lock lock(buffer.mutex_);
+            buffer.chunks_.push_back(std::make_unique<chunk>());
+        }
+
+        (*buffer.chunks_[chunk_index])[size % chunk_size] = { _name, _ts, _value, _type };
+        buffer.size_.store(size + 1, std::memory_order_release);
+    }
+
+    void write_escaped(std::string& _out, std::string_view _str)
+    {
+        for (const auto c : _str)
+        {
+            switch (c)
+            {
+            case '"':
+                _out += "\\\"";
+                break;
+            case '\\':
+                _out += "\\\\";
+                break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20)
+                {
+                    char buf[8];
+                    snprintf(buf, sizeof(buf), "\\u%04x", static_cast<unsigned>(c));
+                    _out += buf;
+                }
+                else
+                {
+                    _out += c;
+                }
+            }
+        }
+    }
+
+    void write_event(std::string& _out, uint64_t _tid, const event& _event)
+    {
+        _out += "{\"name\":\"";
+        write_escaped(_out, _event.name_);
+        _out += "\",\"ph\":\"";
+        _out += static_cast<char>(_event.type_);
+        _out += "\",\"ts\":";
+        _out += std::to_string(_event.ts_);
+        _out += ",\"pid\":1,\"tid\":";
+        _out += std::to_string(_tid);
+
+        switch (_event.type_)
+        {
+        case event_type::counter:
+            _out += ",\"args\":{\"value\":";
+            _out += std::to_string(_event.value_);
+            _out += '}';
+            break;
+        case event_type::async_begin:
+        case event_type::async_end:
+            _out += ",\"cat\":\"async\",\"id\":";
+            _out += std::to_string(_event.value_);
+            break;
+        default:
+            break;
+        }
+
+        _out += "},\n";
+    }
+
+    void write_metadata(std::string& _out, uint64_t _tid, std::string_view _name, std::string_view _arg_name, std::string_view _value)
+    {
+        _out += "{\"name\":\"";
+        _out += _name;
+        _out += "\",\"ph\":\"M\",\"pid\":1,\"tid\":";
+        _out += std::to_string(_tid);
+        _out += ",\"args\":{\"";
+        _out += _arg_name;
+        _out += "\":";
+        _out += _value;
+        _out += "}},\n";
+    }
+}
+
+namespace core
+{
+    namespace profiler
+    {
+        namespace trace
+        {
+            void set_enabled(const bool _enabled)
+            {
+                is_enabled_ = _enabled;
+            }
+
+            bool is_enabled() noexcept
+            {
+                return is_enabled_.load(std::memory_order_relaxed);
+            }
+
+            // the clock is only read once tracing is on, a disabled event is a single relaxed load
+            void begin(const char* _name)
+            {
+                if (is_enabled())
+                    record(_name, event_type::begin, 0, now_us());
+            }
+
+            void end(const char* _name)
+            {
+                if (is_enabled())
+                    record(_name, event_type::end, 0, now_us());
+            }
+
+            void counter(const char* _name, const int64_t _value)
+            {
+                if (is_enabled())
+                    record(_name, event_type::counter, _value, now_us());
+            }
+
+            void async_begin(const char* _name, const int64_t _id)
+            {
+                if (is_enabled())
+                    record(_name, event_type::async_begin, _id, now_us());
+            }
+
+            void async_end(const char* _name, const int64_t _id)
+            {
+                if (is_enabled())
+                    record(_name, event_type::async_end, _id, now_us());
+            }
+
+            void async_begin(const char* _name, const int64_t _id, const int64_t _ts_ms)
+            {
+                record(_name, event_type::async_begin, _id, from_system_ms(_ts_ms));
+            }
+
+            void async_end(const char* _name, const int64_t _id, const int64_t _ts_ms)
+            {
+                record(_name, event_type::async_end, _id, from_system_ms(_ts_ms));
+            }
+
+            const char* intern(std::string_view _name)
+            {
+                std::scoped_lock lock(names_mutex_);
+                return names_.emplace(_name).first->c_str();
+            }
+
+            void set_thread_name(std::string_view _name)
+            {
+                auto& buffer = get_thread_buffer();
+
+                std::scoped_lock lock(buffer.mutex_);
+                buffer.name_ = _name;
+            }
+
+            void reset()
+            {
+                ++generation_;
+
+                std::scoped_lock lock(registry_mutex_);
+                registry_.erase(std::remove_if(registry_.begin(), registry_.end(), [](const auto& _buffer)
+                {
+                    // the thread has gone and nothing of the current generation can be in it
+                    if (_buffer.use_count() != 1)
+                        return false;
+
+                    chunks_count_.fetch_sub(_buffer->chunks_.size(), std::memory_order_relaxed);
+                    return true;
+                }), registry_.end());
+            }
+
+            std::string export_chrome_json()
+            {
+                std::string out;
+                out += "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+
+                const auto generation = generation_.load(std::memory_order_acquire);
+
+                std::scoped_lock registry_lock(registry_mutex_);
+                for (const auto& buffer : registry_)
+                {
+                    std::scoped_lock lock(buffer->mutex_);
+
+                    if (!buffer->name_.empty())
+                    {
+                        std::string name = "\"";
+                        write_escaped(name, buffer->name_);
+                        name += '"';
+                        write_metadata(out, buffer->tid_, "thread_name", "name", name);
+                    }
+
+                    if (buffer->generation_ != generation)
+                        continue;
+
+                    const auto size = buffer->size_.load(std::memory_order_acquire);
+                    for (size_t i = 0; i < size; ++i)
+                        write_event(out, buffer->tid_, (*buffer->chunks_[i / chunk_size])[i % chunk_size]);
+
+                    if (const auto dropped = buffer->dropped_.load(std::memory_order_relaxed))
+                        write_metadata(out, buffer->tid_, "dropped_events", "count", std::to_string(dropped));
+                }
+
+                // trailing comma of the last event is replaced by the closing bracket
+                if (out.size() > 1 && out[out.size() - 2] == ',')
+                    out.erase(out.size() - 2, 1);
+
+                out += "]}\n";
+                return out;
+            }
+
+            bool save_chrome_json(const std::wstring& _file_name)
+            {
+                return core::tools::binary_stream::save_2_file(export_chrome_json(), _file_name);
+            }
+
+            scope::scope(const char* _name)
+                : name_(is_enabled() ? _name : nullptr)
+            {
+                begin(name_);
+            }
+
+            scope::scope(std::string_view _name)
+                : name_(is_enabled() ? intern(_name) : nullptr)
+            {
+                begin(name_);
+            }
+
+            scope::~scope()
+            {
+                end(name_);
+            }
+        }
+    }
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+namespace core
+{
+    namespace profiler
+    {
+        namespace trace
+        {
+            // per-thread event recorder exportable to the chrome trace event format
+            // (chrome://tracing, ui.perfetto.dev);
+            // recording is a bounds check and a store into a buffer owned by the calling thread,
+            // names must outlive the recorder, use intern() for strings built at runtime
+
+            void set_enabled(const bool _enabled);
+
+            bool is_enabled() noexcept;
+
+            void begin(const char* _name);
+
+            void end(const char* _name);
+
+            void counter(const char* _name, const int64_t _value);
+
+            // async spans may start and finish on different threads, _id pairs them
+            void async_begin(const char* _name, const int64_t _id);
+
+            void async_end(const char* _name, const int64_t _id);
+
+            // the same with a wall clock timestamp in ms, as reported by the gui
+            void async_begin(const char* _name, const int64_t _id, const int64_t _ts_ms);
+
+            void async_end(const char* _name, const int64_t _id, const int64_t _ts_ms);
+
+            const char* intern(std::string_view _name);
+
+            void set_thread_name(std::string_view _name);
+
+            // drops everything recorded so far
+            void reset();
+
+            std::string export_chrome_json();
+
+            bool save_chrome_json(const std::wstring& _file_name);
+
+            class scope : boost::noncopyable
+            {
+            public:
+                explicit scope(const char* _name);
+
+                // interns _name, only when recording is enabled
+                explicit scope(std::string_view _name);
+
+                ~scope();
+
+            private:
+                const char* name_;
+            };
+        }
+    }
+}
@@ -3,6 +3,7 @@
 #include "search_pattern_history.h"
 #include "tools/binary_stream.h"
 #include "tools/system.h"
+#include "tools/unicode.h"
 #include "../common.shared/string_utils.h"
 
 using namespace core;
@@ -160,8 +161,8 @@ void contact_last_patterns::add_pattern(std::string_view _pattern)
     if (_pattern.empty())
         return;
 
-    const auto pattern_lower = ::tools::system::to_lower(_pattern);
-    patterns_.remove_if([&pattern_lower](const auto& p) { return pattern_lower == tools::system::to_lower(p); });
+    const auto pattern_lower = ::tools::unicode::to_lower(_pattern);
+    patterns_.remove_if([&pattern_lower](const auto& p) { return pattern_lower == tools::unicode::to_lower(p); });
     patterns_.push_front(std::string(_pattern));
 
     resize_if_needed();
@@ -175,8 +176,8 @@ void contact_last_patterns::remove_pattern(std::string_view _pattern)
         return;
 
     const auto prev_size = patterns_.size();
-    const auto pattern_lower = ::tools::system::to_lower(_pattern);
-    patterns_.remove_if([&pattern_lower](const auto& p) { return pattern_lower == tools::system::to_lower(p); });
+    const auto pattern_lower = ::tools::unicode::to_lower(_pattern);
+    patterns_.remove_if([&pattern_lower](const auto& p) { return pattern_lower == tools::unicode::to_lower(p); });
 
     if (patterns_.size() != prev_size) //TODO: refactor when c++20 arrives and use return value of remove_if
         save_needed_ = true;
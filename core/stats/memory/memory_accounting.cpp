@@ -0,0 +1,173 @@
+#include "stdafx.h"
+#include "memory_accounting.h"
+#include "namespaces.h"
+
+#include "../../utils.h"
+#include "../../../corelib/collection_helper.h"
+#include "../../../common.shared/string_utils.h"
+
+CORE_MEMORY_STATS_NS_BEGIN
+
+namespace
+{
+    // a cache line per tag, so threads updating different subsystems don't contend
+    struct alignas(64) tag_counters
+    {
+        std::atomic<int64_t> bytes_ = 0;
+        std::atomic<int64_t> peak_bytes_ = 0;
+        std::atomic<int64_t> blocks_ = 0;
+    };
+
+    std::array<tag_counters, memory_tags_count()>& get_counters() noexcept
+    {
+        static std::array<tag_counters, memory_tags_count()> counters;
+        return counters;
+    }
+
+    tag_counters& get_counters(memory_tag _tag) noexcept
+    {
+        im_assert(_tag < memory_tag::max);
+        return get_counters()[static_cast<size_t>(_tag)];
+    }
+}
+
+std::string_view to_string(memory_tag _tag) noexcept
+{
+    switch (_tag)
+    {
+    case memory_tag::archive:
+        return "archive";
+    case memory_tag::contact_list:
+        return "contact_list";
+    case memory_tag::collections:
+        return "collections";
+    case memory_tag::curl_buffers:
+        return "curl_buffers";
+    default:
+        im_assert(!"unknown memory tag");
+        return "unknown";
+    }
+}
+
+void account_allocation(memory_tag _tag, int64_t _bytes) noexcept
+{
+    auto& counters = get_counters(_tag);
+    counters.blocks_.fetch_add(1, std::memory_order_relaxed);
+
+    // the peak line is only written when the high-water mark actually moves
+    const auto bytes = counters.bytes_.fetch_add(_bytes, std::memory_order_relaxed) + _bytes;
+    auto peak = counters.peak_bytes_.load(std::memory_order_relaxed);
+    while (bytes > peak && !counters.peak_bytes_.compare_exchange_weak(peak, bytes, std::memory_order_relaxed))
+        ;
+}
+
+void account_deallocation(memory_tag _tag, int64_t _bytes) noexcept
+{
+    auto& counters = get_counters(_tag);
+    counters.blocks_.fetch_sub(1, std::memory_order_relaxed);
+    counters.bytes_.fetch_sub(_bytes, std::memory_order_relaxed);
+}
+
+tag_usage get_tag_usage(memory_tag _tag) noexcept
+{
+    const auto& counters = get_counters(_tag);
+
+    tag_usage usage;
+    usage.bytes_ = counters.bytes_.load(std::memory_order_relaxed);
+    usage.peak_bytes_ = counters.peak_bytes_.load(std::memory_order_relaxed);
+    usage.blocks_ = counters.blocks_.load(std::memory_order_relaxed);
+    return usage;
+}
+
+accounting_history::accounting_history(size_t _capacity)
+    : capacity_(std::max<size_t>(_capacity, 1))
+{
+}
+
+void accounting_history::push(const accounting_sample& _sample)
+{
+    if (samples_.size() < capacity_)
+    {
+        samples_.push_back(_sample);
+        return;
+    }
+
+    samples_[next_] = _sample;
+    next_ = (next_ + 1) % capacity_;
+}
+
+std::vector<accounting_sample> accounting_history::get_samples() const
+{
+    std::vector<accounting_sample> result;
+    result.reserve(samples_.size());
+    result.insert(result.end(), samples_.begin() + next_, samples_.end());
+    result.insert(result.end(), samples_.begin(), samples_.begin() + next_);
+    return result;
+}
+
+void accounting_history::serialize(coll_helper& _coll) const
+{
+    const auto samples = get_samples();
+
+    ifptr<iarray> samples_array(_coll->create_array());
+    samples_array->reserve(samples.size());
+
+    for (const auto& s : samples)
+    {
+        coll_helper coll_sample(_coll->create_collection(), true);
+        serialize_sample(s, coll_sample);
+
+        ifptr<ivalue> sample_value(_coll->create_value());
+        sample_value->set_as_collection(coll_sample.get());
+        samples_array->push_back(sample_value.get());
+    }
+
+    _coll.set_value_as_array("samples", samples_array.get());
+}
+
+accounting_sample take_accounting_sample()
+{
+    accounting_sample sample;
+    sample.time_ = std::chrono::system_clock::now();
+    sample.process_ram_ = static_cast<int64_t>(utils::get_current_process_ram_usage());
+    for (size_t i = 0; i < memory_tags_count(); ++i)
+        sample.usage_[i] = get_tag_usage(static_cast<memory_tag>(i));
+
+    return sample;
+}
+
+void serialize_sample(const accounting_sample& _sample, coll_helper& _coll)
+{
+    _coll.set_value_as_int64("time", std::chrono::system_clock::to_time_t(_sample.time_));
+    _coll.set_value_as_int64("process_ram", _sample.process_ram_);
+
+    ifptr<iarray> tags_array(_coll->create_array());
+    tags_array->reserve(_sample.usage_.size());
+    for (size_t i = 0; i < _sample.usage_.size(); ++i)
+    {
+        coll_helper coll_tag(_coll->create_collection(), true);
+        coll_tag.set_value_as_string("name", to_string(static_cast<memory_tag>(i)));
+        coll_tag.set_value_as_int64("bytes", _sample.usage_[i].bytes_);
+        coll_tag.set_value_as_int64("peak_bytes", _sample.usage_[i].peak_bytes_);
+        coll_tag.set_value_as_int64("blocks", _sample.usage_[i].blocks_);
+
+        ifptr<ivalue> tag_value(_coll->create_value());
+        tag_value->set_as_collection(coll_tag.get());
+        tags_array->push_back(tag_value.get());
+    }
+    _coll.set_value_as_array("tags", tags_array.get());
+}
+
+std::string format_sample(const accounting_sample& _sample)
+{
+    std::string result = su::concat("memory accounting: process_ram=", std::to_string(_sample.process_ram_));
+    for (size_t i = 0; i < _sample.usage_.size(); ++i)
+    {
+        const auto& usage = _sample.usage_[i];
+        result += su::concat(' ', to_string(static_cast<memory_tag>(i)), '=', std::to_string(usage.bytes_), '/', std::to_string(usage.peak_bytes_));
+    }
+    result += "\r\n";
+    return result;
+}
+
+CORE_MEMORY_STATS_NS_END
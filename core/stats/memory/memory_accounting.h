@@ -0,0 +1,181 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// plain namespaces instead of CORE_MEMORY_STATS_NS_BEGIN: the header is also included from corelib,
+// which has its own namespaces.h
+namespace core
+{
+    class coll_helper;
+
+    namespace memory_stats
+    {
+        // subsystems with live byte counters, a new one goes before max
+        enum class memory_tag
+        {
+            archive,
+            contact_list,
+            collections,
+            curl_buffers,
+
+            max
+        };
+
+        constexpr size_t memory_tags_count() noexcept { return static_cast<size_t>(memory_tag::max); }
+
+        std::string_view to_string(memory_tag _tag) noexcept;
+
+        struct tag_usage
+        {
+            int64_t bytes_ = 0;
+            // the high-water mark since start
+            int64_t peak_bytes_ = 0;
+            int64_t blocks_ = 0;
+        };
+
+        // the counters are relaxed atomics, so they can be updated from any thread;
+        // an allocation raises the peak with a compare-exchange only when it exceeds it
+        void account_allocation(memory_tag _tag, int64_t _bytes) noexcept;
+        void account_deallocation(memory_tag _tag, int64_t _bytes) noexcept;
+
+        tag_usage get_tag_usage(memory_tag _tag) noexcept;
+
+
+        // allocator for the node containers of a subsystem: every block is counted under Tag
+        template <typename T, memory_tag Tag>
+        class counting_allocator
+        {
+        public:
+            using value_type = T;
+
+            template <typename U>
+            struct rebind
+            {
+                using other = counting_allocator<U, Tag>;
+            };
+
+            counting_allocator() noexcept = default;
+
+            template <typename U>
+            counting_allocator(const counting_allocator<U, Tag>&) noexcept {}
+
+            T* allocate(size_t _n)
+            {
+                auto p = std::allocator<T>().allocate(_n);
+                account_allocation(Tag, static_cast<int64_t>(_n * sizeof(T)));
+                return p;
+            }
+
+            void deallocate(T* _p, size_t _n) noexcept
+            {
+                account_deallocation(Tag, static_cast<int64_t>(_n * sizeof(T)));
+                std::allocator<T>().deallocate(_p, _n);
+            }
+
+            template <typename U>
+            bool operator==(const counting_allocator<U, Tag>&) const noexcept { return true; }
+
+            template <typename U>
+            bool operator!=(const counting_allocator<U, Tag>&) const noexcept { return false; }
+        };
+
+
+        // bytes held by an object outside of the containers above (a payload, a buffer);
+        // a copy is counted again, the count is released on destruction
+        template <memory_tag Tag>
+        class tagged_size
+        {
+        public:
+            tagged_size() noexcept = default;
+
+            explicit tagged_size(int64_t _bytes) noexcept
+            {
+                set(_bytes);
+            }
+
+            tagged_size(const tagged_size& _other) noexcept
+            {
+                set(_other.bytes_);
+            }
+
+            tagged_size& operator=(const tagged_size& _other) noexcept
+            {
+                if (this != &_other)
+                    set(_other.bytes_);
+                return *this;
+            }
+
+            ~tagged_size()
+            {
+                set(0);
+            }
+
+            void set(int64_t _bytes) noexcept
+            {
+                if (_bytes == bytes_)
+                    return;
+
+                if (bytes_ > 0)
+                    account_deallocation(Tag, bytes_);
+
+                bytes_ = _bytes;
+
+                if (bytes_ > 0)
+                    account_allocation(Tag, bytes_);
+            }
+
+            void add(int64_t _bytes) noexcept
+            {
+                set(bytes_ + _bytes);
+            }
+
+            int64_t get() const noexcept { return bytes_; }
+
+        private:
+            int64_t bytes_ = 0;
+        };
+
+
+        struct accounting_sample
+        {
+            std::chrono::system_clock::time_point time_;
+            int64_t process_ram_ = 0;
+            std::array<tag_usage, memory_tags_count()> usage_;
+        };
+
+        accounting_sample take_accounting_sample();
+
+        void serialize_sample(const accounting_sample& _sample, coll_helper& _coll);
+
+        // one line for the network log
+        std::string format_sample(const accounting_sample& _sample);
+
+        // the last samples of the counters in a ring buffer; the defaults keep a week
+        // with one sample every 10 minutes
+        class accounting_history
+        {
+        public:
+            explicit accounting_history(size_t _capacity = 7 * 24 * 6);
+
+            void push(const accounting_sample& _sample);
+
+            // the oldest sample first
+            std::vector<accounting_sample> get_samples() const;
+
+            void serialize(coll_helper& _coll) const;
+
+        private:
+            std::vector<accounting_sample> samples_;
+            size_t capacity_;
+            size_t next_ = 0;
+        };
+
+        constexpr std::chrono::minutes accounting_sample_interval() noexcept { return std::chrono::minutes(10); }
+    }
+}
@@ -77,6 +77,18 @@ reports_list memory_stats_collector::generate_instant_reports()
     return result;
 }
 
+accounting_sample memory_stats_collector::sample_accounting()
+{
+    auto sample = take_accounting_sample();
+    accounting_history_.push(sample);
+    return sample;
+}
+
+const accounting_history& memory_stats_collector::get_accounting_history() const
+{
+    return accounting_history_;
+}
+
 void memory_stats_collector::add_request(const request_handle &_req_handle,
                                          const response &_response)
 {
@@ -3,6 +3,7 @@
 #include <memory>
 #include <list>
 #include <unordered_map>
+#include "memory_accounting.h"
 #include "memory_consumption_reporter.h"
 #include "memory_stats_common.h"
 #include "memory_stats_request.h"
@@ -34,6 +35,10 @@ public:
 
     reports_list generate_instant_reports();
 
+    // samples the tagged counters into the history, called every accounting_sample_interval
+    accounting_sample sample_accounting();
+    const accounting_history& get_accounting_history() const;
+
 private:
     void add_request(const request_handle& _req_handle, const response& _response);
 
@@ -42,6 +47,7 @@ private:
     reporters_list reporters_list_;
     async_reporters_list async_reporters_list_;
     request_to_response request_to_response_;
+    accounting_history accounting_history_;
 };
 
 CORE_MEMORY_STATS_NS_END
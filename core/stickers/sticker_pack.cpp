@@ -0,0 +1,200 @@
+#include "stdafx.h"
+
+#include "sticker_pack.h"
+
+#include "../tools/system.h"
+
+namespace
+{
+    constexpr uint32_t pack_magic() noexcept { return 0x4B505453; } // "STPK"
+    constexpr uint32_t pack_version() noexcept { return 1; }
+    constexpr int64_t header_size() noexcept { return 2 * sizeof(uint32_t); }
+    constexpr int64_t record_header_size() noexcept { return 2 * sizeof(uint32_t); }
+    constexpr uint32_t max_key_size() noexcept { return 1024; }
+    constexpr uint32_t max_data_size() noexcept { return 16 * 1024 * 1024; }
+
+    template <typename T>
+    bool read_pod(std::istream& _stream, T& _value)
+    {
+        return !!_stream.read(reinterpret_cast<char*>(&_value), sizeof(_value));
+    }
+
+    template <typename T>
+    void write_pod(std::ostream& _stream, const T& _value)
+    {
+        _stream.write(reinterpret_cast<const char*>(&_value), sizeof(_value));
+    }
+}
+
+namespace core
+{
+    namespace stickers
+    {
+        sticker_pack::sticker_pack(std::wstring _file_name)
+            : file_name_(std::move(_file_name))
+        {
+        }
+
+        std::optional<sticker_pack::slice> sticker_pack::find(std::string_view _key)
+        {
+            if (is_stale())
+                reset();
+
+            load();
+
+            if (const auto it = index_.find(std::string(_key)); it != index_.end())
+                return it->second;
+
+            return std::nullopt;
+        }
+
+        std::optional<sticker_pack::slice> sticker_pack::append(std::string_view _key, std::string_view _data)
+        {
+            if (is_stale())
+                reset();
+
+            load();
+
+            if (read_only_)
+                return std::nullopt;
+
+            if (_key.empty() || _key.size() > max_key_size() || _data.empty() || _data.size() > max_data_size())
+                return std::nullopt;
+
+            if (const auto it = index_.find(std::string(_key)); it != index_.end())
+                return it->second;
+
+            const std::wstring folder_name = boost::filesystem::wpath(file_name_).parent_path().wstring();
+            if (!tools::system::is_exist(folder_name) && !tools::system::create_directory(folder_name))
+                return std::nullopt;
+
+            const auto is_new = (end_ == 0);
+            auto mode = std::ios_base::binary | std::ios_base::out;
+            if (!is_new)
+                mode |= std::ios_base::in;
+
+            auto file = tools::system::open_file_for_write(file_name_, mode);
+            if (!file.is_open())
+            {
+                reset();
+                return std::nullopt;
+            }
+
+            if (is_new)
+            {
+                write_pod(file, pack_magic());
+                write_pod(file, pack_version());
+                end_ = header_size();
+            }
+            else
+            {
+                file.seekp(end_);
+            }
+
+            write_pod(file, uint32_t(_key.size()));
+            write_pod(file, uint32_t(_data.size()));
+            file.write(_key.data(), std::streamsize(_key.size()));
+            file.write(_data.data(), std::streamsize(_data.size()));
+            file.flush();
+            if (!file.good())
+            {
+                // a partly written record is cut by the next load
+                reset();
+                return std::nullopt;
+            }
+
+            const slice s = { end_ + record_header_size() + int64_t(_key.size()), int64_t(_data.size()) };
+            end_ = s.offset_ + s.size_;
+            file_size_ = end_;
+            index_.emplace(_key, s);
+
+            return s;
+        }
+
+        void sticker_pack::load()
+        {
+            if (loaded_)
+                return;
+
+            loaded_ = true;
+
+            if (!tools::system::is_exist(file_name_))
+                return;
+
+            const auto file_size = int64_t(tools::system::get_file_size(file_name_));
+
+            {
+                auto file = tools::system::open_file_for_read(file_name_, std::ios_base::binary);
+                if (!file.is_open())
+                {
+                    // not to be started over on the next append
+                    read_only_ = true;
+                    file_size_ = file_size;
+                    return;
+                }
+
+                uint32_t magic = 0, version = 0;
+                if (read_pod(file, magic) && read_pod(file, version) && magic == pack_magic() && version == pack_version())
+                {
+                    end_ = header_size();
+
+                    std::string key;
+                    uint32_t key_size = 0, data_size = 0;
+                    while (read_pod(file, key_size) && read_pod(file, data_size))
+                    {
+                        if (key_size == 0 || key_size > max_key_size() || data_size > max_data_size())
+                            break;
+
+                        const auto offset = end_ + record_header_size() + key_size;
+                        if (offset + data_size > file_size)
+                            break;
+
+                        key.resize(key_size);
+                        if (!file.read(key.data(), key_size) || !file.seekg(data_size, std::ios_base::cur))
+                            break;
+
+                        index_[key] = { offset, int64_t(data_size) };
+                        end_ = offset + data_size;
+                    }
+                }
+            }
+
+            // the tail of an interrupted append is cut, a pack of an unknown format is started over
+            file_size_ = end_;
+            if (end_ != file_size)
+            {
+                boost::system::error_code error;
+                boost::filesystem::resize_file(boost::filesystem::wpath(file_name_), uint64_t(end_), error);
+                if (error)
+                {
+                    // on windows a file mapped by the gui can be neither truncated nor deleted,
+                    // the records before the tail stay readable and the pack is fixed on a later load
+                    read_only_ = true;
+                    file_size_ = file_size;
+                }
+            }
+        }
+
+        void sticker_pack::reset()
+        {
+            index_.clear();
+            end_ = 0;
+            file_size_ = 0;
+            loaded_ = false;
+            read_only_ = false;
+        }
+
+        bool sticker_pack::is_stale() const
+        {
+            if (!loaded_)
+                return false;
+
+            boost::system::error_code error;
+            const auto file_size = boost::filesystem::file_size(boost::filesystem::wpath(file_name_), error);
+            if (error)
+                return file_size_ != 0;
+
+            return int64_t(file_size) != file_size_;
+        }
+    }
+}
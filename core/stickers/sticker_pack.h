@@ -0,0 +1,43 @@
+#pragma once
+
+namespace core
+{
+    namespace stickers
+    {
+        // stickers of one set in a single file: a header followed by records of a key, a data size and the data;
+        // records are only appended, the index is rebuilt from the record headers when the pack is opened
+        class sticker_pack final
+        {
+        public:
+            struct slice
+            {
+                int64_t offset_ = 0;
+                int64_t size_ = 0;
+            };
+
+            explicit sticker_pack(std::wstring _file_name);
+
+            const std::wstring& get_file_name() const noexcept { return file_name_; }
+
+            std::optional<slice> find(std::string_view _key);
+            std::optional<slice> append(std::string_view _key, std::string_view _data);
+
+        private:
+            void load();
+            void reset();
+            // the file was removed or changed behind the loaded index
+            bool is_stale() const;
+
+            const std::wstring file_name_;
+
+            std::unordered_map<std::string, slice> index_;
+            int64_t end_ = 0;
+            // the size of the file as last seen, past end_ only while read-only
+            int64_t file_size_ = 0;
+            bool loaded_ = false;
+            // a torn tail that could not be cut, e.g. while the gui maps the file on windows,
+            // keeps the pack read-only until the next load
+            bool read_only_ = false;
+        };
+    }
+}
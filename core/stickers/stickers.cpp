@@ -2,6 +2,7 @@
 
 #include "stickers.h"
 #include "suggests.h"
+#include "sticker_pack.h"
 
 #include "../../../corelib/enumerations.h"
 
@@ -36,6 +37,8 @@ namespace
     constexpr std::string_view big_size() noexcept { return "big"; }
     constexpr std::wstring_view meta_file_name() noexcept { return L"meta.js"; }
     constexpr std::wstring_view meta_etag_file_name() noexcept { return L"etag"; }
+    // stickers moved into packs whose own files are removed on the next start
+    constexpr std::wstring_view packed_files_list_name() noexcept { return L"packed.lst"; }
 
     std::wstring get_icon_file_name(const core::tools::filesharing_id& _fs_id, std::string_view _size)
     {
@@ -55,6 +58,17 @@ namespace
         return su::wconcat(icon, L'_', suffix, image_ext());
     }
 
+    std::string make_pack_key(int32_t _sticker_id, const core::tools::filesharing_id& _fs_id, core::sticker_size _size)
+    {
+        if (_fs_id.file_id_.empty())
+            return su::concat(std::to_string(_sticker_id), '/', to_string(_size));
+
+        if (_fs_id.source_id_)
+            return su::concat(_fs_id.file_id_, '_', *_fs_id.source_id_, '/', to_string(_size));
+
+        return su::concat(_fs_id.file_id_, '/', to_string(_size));
+    }
+
     std::wstring g_stickers_path;
 }
 
@@ -794,7 +808,16 @@ namespace core
             return pending_tasks_.size() - prevSize;
         }
 
-        void cache::get_sticker(int64_t _seq, int32_t _set_id, int32_t _sticker_id, const core::tools::filesharing_id& _fs_id, const sticker_size _size, std::wstring& _path)
+        sticker_pack& cache::get_pack(int32_t _set_id)
+        {
+            auto& pack = packs_[_set_id];
+            if (!pack)
+                pack = std::make_unique<sticker_pack>(su::wconcat(g_stickers_path, L'/', std::to_wstring(_set_id), L"/stickers.pack"));
+
+            return *pack;
+        }
+
+        void cache::get_sticker(int64_t _seq, int32_t _set_id, int32_t _sticker_id, const core::tools::filesharing_id& _fs_id, const sticker_size _size, std::wstring& _path, int64_t& _offset, int64_t& _length)
         {
             auto get_iter = [_set_id, _sticker_id, _size, &_fs_id](auto& _list)
             {
@@ -819,6 +842,21 @@ namespace core
                 return;
             }
 
+            // lottie stickers stay in files, the player opens them by path
+            const auto packed = _set_id > 0 && !is_lottie_id(_fs_id.file_id_);
+            const auto pack_key = packed ? make_pack_key(_sticker_id, _fs_id, _size) : std::string();
+            if (packed)
+            {
+                auto& pack = get_pack(_set_id);
+                if (const auto slice = pack.find(pack_key))
+                {
+                    _path = pack.get_file_name();
+                    _offset = slice->offset_;
+                    _length = slice->size_;
+                    return;
+                }
+            }
+
             _path = get_sticker_path(_set_id, _sticker_id, _fs_id, _size);
             if (!tools::system::is_exist(_path))
             {
@@ -828,6 +866,52 @@ namespace core
                 dl_task.set_need_decompress(is_lottie_id(dl_task.get_fs_id().file_id_));
                 pending_tasks_.emplace_back(std::move(dl_task));
             }
+            else if (packed)
+            {
+                // a downloaded sticker moves into the pack of its set
+                core::tools::binary_stream data;
+                if (!data.load_from_file(_path) || data.available() <= 0)
+                    return;
+
+                const auto size = data.available();
+                auto& pack = get_pack(_set_id);
+                if (const auto slice = pack.append(pack_key, std::string_view(data.read(size), size_t(size))))
+                {
+                    // the record is flushed, so the file goes right away; on windows the gui may still hold it
+                    // open by the path it got before, such a file is deleted at the next start
+                    if (!tools::system::delete_file(_path))
+                        add_packed_file(_path);
+
+                    _path = pack.get_file_name();
+                    _offset = slice->offset_;
+                    _length = slice->size_;
+                }
+            }
+        }
+
+        void cache::add_packed_file(const std::wstring& _path)
+        {
+            auto list = tools::system::open_file_for_write(su::wconcat(g_stickers_path, L'/', packed_files_list_name()), std::ios_base::binary | std::ios_base::app);
+            if (list.is_open())
+                list << tools::from_utf16(_path) << '\n';
+        }
+
+        void cache::remove_packed_files()
+        {
+            const auto list_name = su::wconcat(g_stickers_path, L'/', packed_files_list_name());
+            if (!tools::system::is_exist(list_name))
+                return;
+
+            {
+                auto list = tools::system::open_file_for_read(list_name, std::ios_base::binary);
+                for (std::string path; std::getline(list, path);)
+                {
+                    if (const auto file_name = tools::from_utf8(path); !file_name.empty() && tools::system::is_exist(file_name))
+                        tools::system::delete_file(file_name);
+                }
+            }
+
+            tools::system::delete_file(list_name);
         }
 
         void cache::get_set_icon_big(const int64_t _seq, const int32_t _set_id, std::wstring& _path)
@@ -885,6 +969,12 @@ namespace core
             : cache_(std::make_shared<cache>(_stickers_path))
             , thread_(std::make_shared<async_executer>("stickers"))
         {
+            // nothing of this session can hold the files packed during the previous one
+            thread_->run_async_function([stickers_cache = cache_]
+            {
+                stickers_cache->remove_packed_files();
+                return 0;
+            });
         }
 
         std::shared_ptr<result_handler<bool>> face::parse(const std::shared_ptr<core::tools::binary_stream>& _data, bool _insitu)
@@ -921,24 +1011,26 @@ namespace core
             return handler;
         }
 
-        std::shared_ptr<result_handler<std::wstring_view>> face::get_sticker(int64_t _seq, int32_t _set_id, int32_t _sticker_id, const core::tools::filesharing_id& _fs_id, const core::sticker_size _size)
+        std::shared_ptr<result_handler<std::wstring_view, int64_t, int64_t>> face::get_sticker(int64_t _seq, int32_t _set_id, int32_t _sticker_id, const core::tools::filesharing_id& _fs_id, const core::sticker_size _size)
         {
             im_assert(_size > core::sticker_size::min);
             im_assert(_size < core::sticker_size::max);
 
-            auto handler = std::make_shared<result_handler<std::wstring_view>>();
+            auto handler = std::make_shared<result_handler<std::wstring_view, int64_t, int64_t>>();
             auto sticker_path = std::make_shared<std::wstring>();
+            auto offset = std::make_shared<int64_t>(0);
+            auto length = std::make_shared<int64_t>(0);
 
-            thread_->run_async_function([stickers_cache = cache_, sticker_path, _set_id, _sticker_id, _size, _seq, _fs_id = std::move(_fs_id)]
+            thread_->run_async_function([stickers_cache = cache_, sticker_path, offset, length, _set_id, _sticker_id, _size, _seq, _fs_id = std::move(_fs_id)]
             {
-                stickers_cache->get_sticker(_seq, _set_id, _sticker_id, std::move(_fs_id), _size, *sticker_path);
+                stickers_cache->get_sticker(_seq, _set_id, _sticker_id, std::move(_fs_id), _size, *sticker_path, *offset, *length);
 
                 return 0;
 
-            })->on_result_ = [handler, sticker_path](int32_t _error)
+            })->on_result_ = [handler, sticker_path, offset, length](int32_t _error)
             {
                 if (handler->on_result_)
-                    handler->on_result_(*sticker_path);
+                    handler->on_result_(*sticker_path, *offset, *length);
             };
 
             return handler;
@@ -1251,7 +1343,7 @@ namespace core
             }
         }
 
-        static void post_sticker_impl(int64_t _seq, int32_t _set_id, int32_t _sticker_id, const core::tools::filesharing_id& _fs_id, core::sticker_size _size, int _error, std::wstring_view _path)
+        static void post_sticker_impl(int64_t _seq, int32_t _set_id, int32_t _sticker_id, const core::tools::filesharing_id& _fs_id, core::sticker_size _size, int _error, std::wstring_view _path, int64_t _offset, int64_t _length)
         {
             im_assert(_size > sticker_size::min);
             im_assert(_size < sticker_size::max);
@@ -1268,18 +1360,23 @@ namespace core
 
             im_assert(!to_string(_size).empty());
             coll.set_value_as_string(to_string(_size), core::tools::from_utf16(_path));
+            if (_length > 0)
+            {
+                coll.set_value_as_int64("offset", _offset);
+                coll.set_value_as_int64("length", _length);
+            }
 
             g_core->post_message_to_gui("stickers/sticker/get/result", _seq, coll.get());
         }
 
         void post_sticker_fail_2_gui(int64_t _seq, int32_t _set_id, int32_t _sticker_id, const core::tools::filesharing_id& _fs_id, loader_errors _error)
         {
-            post_sticker_impl(_seq, _set_id, _sticker_id, _fs_id, core::sticker_size::small, (int)_error, {});
+            post_sticker_impl(_seq, _set_id, _sticker_id, _fs_id, core::sticker_size::small, (int)_error, {}, 0, 0);
         }
 
-        void post_sticker_2_gui(int64_t _seq, int32_t _set_id, int32_t _sticker_id, const core::tools::filesharing_id& _fs_id, core::sticker_size _size, std::wstring_view _path)
+        void post_sticker_2_gui(int64_t _seq, int32_t _set_id, int32_t _sticker_id, const core::tools::filesharing_id& _fs_id, core::sticker_size _size, std::wstring_view _path, int64_t _offset, int64_t _length)
         {
-            post_sticker_impl(_seq, _set_id, _sticker_id, _fs_id, _size, 0, _path);
+            post_sticker_impl(_seq, _set_id, _sticker_id, _fs_id, _size, 0, _path, _offset, _length);
         }
 
         void post_set_icon_2_gui(int32_t _set_id, std::string_view _message, std::wstring_view _path, int32_t _error)
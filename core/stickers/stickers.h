@@ -19,6 +19,7 @@ namespace core
     namespace stickers
     {
         class suggests;
+        class sticker_pack;
 
         class sticker_params
         {
@@ -231,6 +232,8 @@ namespace core
 
             std::unique_ptr<suggests> suggests_;
 
+            std::unordered_map<int32_t, std::unique_ptr<sticker_pack>> packs_;
+
             int32_t stat_dl_tasks_count_ = 0;
             std::chrono::steady_clock::time_point stat_dl_start_time_;
 
@@ -241,6 +244,10 @@ namespace core
 
             void on_download_tasks_added(int _tasks_count);
 
+            sticker_pack& get_pack(int32_t _set_id);
+            // a packed file that couldn't be deleted, remove_packed_files deletes it
+            void add_packed_file(const std::wstring& _path);
+
         public:
             int make_set_icons_tasks(std::string_view _size);
 
@@ -260,12 +267,15 @@ namespace core
             static std::wstring get_sticker_path(const set& _set, const sticker& _sticker, sticker_size _size);
             static std::wstring get_sticker_path(int32_t _set_id, int32_t _sticker_id, const core::tools::filesharing_id& _fs_id, sticker_size _size);
 
+            void remove_packed_files();
+
             download_tasks take_download_tasks();
             bool have_tasks_to_download() const noexcept;
             int32_t on_task_loaded(const download_task& _task);
             int cancel_download_tasks(std::vector<core::tools::filesharing_id> _fs_ids, sticker_size _size);
 
-            void get_sticker(int64_t _seq, int32_t _set_id, int32_t _sticker_id, const core::tools::filesharing_id& _fs_id, const sticker_size _size, std::wstring& _path);
+            // a zero _length means the whole file at _path
+            void get_sticker(int64_t _seq, int32_t _set_id, int32_t _sticker_id, const core::tools::filesharing_id& _fs_id, const sticker_size _size, std::wstring& _path, int64_t& _offset, int64_t& _length);
             void get_set_icon_big(const int64_t _seq, const int32_t _set_id, std::wstring& _path);
             void clean_set_icon_big(const int32_t _set_id);
 
@@ -300,7 +310,7 @@ namespace core
             std::shared_ptr<result_handler<int>> make_set_icons_tasks(std::string_view _size);
             std::shared_ptr<result_handler<coll_helper>> serialize_meta(coll_helper _coll, std::string_view _size);
             std::shared_ptr<result_handler<coll_helper>> serialize_store(coll_helper _coll);
-            std::shared_ptr<result_handler<std::wstring_view>> get_sticker(
+            std::shared_ptr<result_handler<std::wstring_view, int64_t, int64_t>> get_sticker(
                 int64_t _seq,
                 int32_t _set_id,
                 int32_t _sticker_id,
@@ -335,7 +345,7 @@ namespace core
             std::shared_ptr<result_handler<const bool>> serialize_suggests(coll_helper _coll);
         };
 
-        void post_sticker_2_gui(int64_t _seq, int32_t _set_id, int32_t _sticker_id, const core::tools::filesharing_id& _fs_id, core::sticker_size _size, std::wstring_view _data);
+        void post_sticker_2_gui(int64_t _seq, int32_t _set_id, int32_t _sticker_id, const core::tools::filesharing_id& _fs_id, core::sticker_size _size, std::wstring_view _data, int64_t _offset = 0, int64_t _length = 0);
         void post_sticker_fail_2_gui(int64_t _seq, int32_t _set_id, int32_t _sticker_id, const core::tools::filesharing_id& _fs_id, loader_errors _error);
         void post_set_icon_2_gui(int32_t _set_id, std::string_view _message, std::wstring_view _path, int32_t _error = 0);
     }
@@ -274,6 +274,71 @@ bool core::tools::decompress_gzip(const stream& _bs, binary_stream& _uncompresse
     return decompress_gzip(_bs.get_data(), _bs.available(), _uncompressed_bs);
 }
 
+core::tools::gzip_inflater::gzip_inflater()
+    : buffer_(64 * 1024)
+    , total_out_(0)
+    , finished_(false)
+    , failed_(false)
+{
+    stream_.zalloc = Z_NULL;
+    stream_.zfree = Z_NULL;
+    stream_.opaque = Z_NULL;
+    stream_.avail_in = 0;
+    stream_.next_in = Z_NULL;
+
+    constexpr int window_bits = 15 + 32; // auto with windowbits of 15
+
+    failed_ = inflateInit2(&stream_, window_bits) != Z_OK;
+}
+
+core::tools::gzip_inflater::~gzip_inflater()
+{
+    inflateEnd(&stream_);
+}
+
+bool core::tools::gzip_inflater::write(const char* _data, size_t _size, stream& _output)
+{
+    return write(_data, _size, [&_output](const char* _inflated, size_t _inflated_size) { _output.write(_inflated, static_cast<int64_t>(_inflated_size)); });
+}
+
+bool core::tools::gzip_inflater::write(const char* _data, size_t _size, const std::function<void(const char*, size_t)>& _on_output)
+{
+    if (failed_)
+        return false;
+
+    if (finished_)
+        return true;
+
+    stream_.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(_data));
+    stream_.avail_in = static_cast<unsigned int>(_size);
+
+    do
+    {
+        stream_.next_out = reinterpret_cast<Bytef*>(buffer_.data());
+        stream_.avail_out = static_cast<unsigned int>(buffer_.size());
+
+        const auto ret = inflate(&stream_, Z_NO_FLUSH);
+        if (ret == Z_STREAM_END)
+            finished_ = true;
+        else if (ret != Z_OK && ret != Z_BUF_ERROR)
+            failed_ = true;
+
+        const auto produced = buffer_.size() - stream_.avail_out;
+        total_out_ += produced;
+        if (total_out_ > max_decompress_bytes())
+            failed_ = true;
+
+        if (failed_)
+            return false;
+
+        if (produced)
+            _on_output(buffer_.data(), produced);
+
+    } while (!finished_ && (stream_.avail_in > 0 || stream_.avail_out == 0));
+
+    return true;
+}
+
 #ifndef STRIP_ZSTD
 bool core::tools::compress_zstd(const char* _data, size_t _size, std::string_view _dict, binary_stream& _compressed_bs)
 {
@@ -352,6 +352,32 @@ namespace core
         bool compress_gzip(const stream& _bs, binary_stream& _compressed_bs, int _level = Z_BEST_COMPRESSION);
         bool decompress_gzip(const char* _data, size_t _size, binary_stream& _uncompressed_bs);
         bool decompress_gzip(const stream& _bs, binary_stream& _uncompressed_bs);
+
+        // inflates gzip data arriving in chunks, appending the result to the output stream
+        class gzip_inflater
+        {
+        public:
+            gzip_inflater();
+            ~gzip_inflater();
+
+            gzip_inflater(const gzip_inflater&) = delete;
+            gzip_inflater& operator=(const gzip_inflater&) = delete;
+
+            // appends the inflated data to _output
+            bool write(const char* _data, size_t _size, stream& _output);
+            // hands every inflated chunk to _on_output, nothing is kept
+            bool write(const char* _data, size_t _size, const std::function<void(const char*, size_t)>& _on_output);
+
+            bool is_finished() const noexcept { return finished_; }
+            bool is_failed() const noexcept { return failed_; }
+
+        private:
+            z_stream stream_;
+            std::vector<char> buffer_;
+            size_t total_out_;
+            bool finished_;
+            bool failed_;
+        };
         inline bool is_compressed(const binary_stream& _bs)
         {
             return _bs.is_compressed();
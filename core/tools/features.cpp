@@ -16,7 +16,7 @@
 
 namespace
 {
-    bool myteam_config_or_omicron_feature_enabled(config::features _feature, const char* _omicron_key)
+    bool myteam_config_or_omicron_feature_enabled(config::features _feature, const omicronlib::omicron_key& _omicron_key)
     {
         const auto config_value = config::get().is_on(_feature);
         const auto omicron_value = omicronlib::_o(_omicron_key, config_value);
@@ -211,4 +211,14 @@ namespace features
     {
         return myteam_config_or_omicron_feature_enabled(config::features::antivirus_check_enabled, omicron::keys::antivirus_check_enabled);
     }
+
+    bool is_history_prefetch_enabled()
+    {
+        return omicronlib::_o(omicron::keys::history_prefetch_enabled, true);
+    }
+
+    size_t history_prefetch_chats_count()
+    {
+        return omicronlib::_o(omicron::keys::history_prefetch_chats_count, 5);
+    }
 }
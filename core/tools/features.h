@@ -49,4 +49,7 @@ namespace features
     bool is_restricted_files_enabled();
     bool trust_status_default();
     bool is_antivirus_check_enabled();
+
+    bool is_history_prefetch_enabled();
+    size_t history_prefetch_chats_count();
 }
@@ -0,0 +1,118 @@
+#pragma once
+
+#include "rapidjson/memorystream.h"
+
+namespace core
+{
+    namespace tools
+    {
+        // rapidjson SAX parsing of data arriving in chunks, e.g. a response being received by curl;
+        // every chunk is parsed on the caller's thread up to its last complete token, the rest waits
+        // for the next chunk, so only an unfinished token is ever kept
+        template <typename Handler>
+        class chunked_json_parser
+        {
+        public:
+            explicit chunked_json_parser(Handler& _handler)
+                : handler_(_handler)
+            {
+                reader_.IterativeParseInit();
+            }
+
+            // false once the data is not valid json or the handler stopped parsing
+            bool push(const char* _data, size_t _size)
+            {
+                if (failed_)
+                    return false;
+
+                if (reader_.IterativeParseComplete())
+                {
+                    failed_ = !is_whitespace(std::string_view(_data, _size));
+                    return !failed_;
+                }
+
+                pending_.append(_data, _size);
+
+                // a token is complete once followed by a bracket or once its closing quote is seen;
+                // the parser is never stopped after ',' or ':', rapidjson wants the next token there
+                size_t boundary = 0;
+                for (auto i = scanned_; i < pending_.size(); ++i)
+                {
+                    const auto c = pending_[i];
+                    if (in_string_)
+                    {
+                        if (escaped_)
+                            escaped_ = false;
+                        else if (c == '\\')
+                            escaped_ = true;
+                        else if (c == '"')
+                        {
+                            in_string_ = false;
+                            boundary = i + 1;
+                        }
+                    }
+                    else if (c == '"')
+                    {
+                        in_string_ = true;
+                    }
+                    else if (c == '{' || c == '}' || c == '[' || c == ']')
+                    {
+                        boundary = i + 1;
+                    }
+                }
+                scanned_ = pending_.size();
+
+                if (boundary)
+                    parse(boundary);
+
+                return !failed_;
+            }
+
+            // parses the rest, true if the whole document was parsed
+            bool finish()
+            {
+                if (!failed_)
+                    parse(pending_.size());
+
+                std::string().swap(pending_);
+                return !failed_ && reader_.IterativeParseComplete() && !reader_.HasParseError();
+            }
+
+        private:
+            void parse(size_t _size)
+            {
+                rapidjson::MemoryStream stream(pending_.data(), _size);
+                while (stream.Tell() < _size && !reader_.IterativeParseComplete())
+                {
+                    if (!reader_.template IterativeParseNext<rapidjson::kParseDefaultFlags>(stream, handler_))
+                    {
+                        failed_ = true;
+                        break;
+                    }
+                }
+
+                const auto parsed = stream.Tell();
+                pending_.erase(0, parsed);
+                scanned_ -= std::min(scanned_, parsed);
+
+                // rapidjson only sees up to _size, what follows the document must be whitespace too
+                if (!failed_ && reader_.IterativeParseComplete())
+                    failed_ = !is_whitespace(pending_);
+            }
+
+            static bool is_whitespace(std::string_view _data) noexcept
+            {
+                return _data.find_first_not_of(" \t\r\n") == std::string_view::npos;
+            }
+
+            Handler& handler_;
+            rapidjson::Reader reader_;
+
+            std::string pending_;
+            size_t scanned_ = 0;
+            bool in_string_ = false;
+            bool escaped_ = false;
+            bool failed_ = false;
+        };
+    }
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+namespace core
+{
+    namespace tools
+    {
+        // bounded lock-free queue for exactly one producer thread and one consumer thread
+        template <typename T, size_t Capacity>
+        class spsc_ring
+        {
+            static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "capacity must be a power of two");
+
+        public:
+            // producer side, fails when the ring is full
+            bool push(T&& _value)
+            {
+                const auto head = head_.load(std::memory_order_relaxed);
+                if (head - tail_.load(std::memory_order_acquire) == Capacity)
+                    return false;
+
+                items_[head & (Capacity - 1)] = std::move(_value);
+                head_.store(head + 1, std::memory_order_release);
+                return true;
+            }
+
+            // consumer side, hands every queued item to the callback in order
+            template <typename F>
+            size_t consume_all(F&& _callback)
+            {
+                auto tail = tail_.load(std::memory_order_relaxed);
+                const auto head = head_.load(std::memory_order_acquire);
+                const auto count = head - tail;
+
+                for (; tail != head; ++tail)
+                    _callback(std::move(items_[tail & (Capacity - 1)]));
+
+                tail_.store(tail, std::memory_order_release);
+                return count;
+            }
+
+            bool empty() const noexcept
+            {
+                return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire);
+            }
+
+        private:
+            std::array<T, Capacity> items_;
+
+            alignas(64) std::atomic<size_t> head_ = 0;
+            alignas(64) std::atomic<size_t> tail_ = 0;
+        };
+    }
+}
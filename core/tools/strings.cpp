@@ -1,16 +1,15 @@
 #include "stdafx.h"
 #include "strings.h"
 #include "system.h"
+#include "unicode.h"
 
-#include <codecvt>
-#include <locale>
-#include <string>
+namespace
+{
+    constexpr bool is_utf16_wchar = sizeof(wchar_t) == 2;
 
-#ifdef __linux__
-using converter_t = std::wstring_convert<std::codecvt_utf8<wchar_t>, wchar_t>;
-#else
-using converter_t = std::wstring_convert<std::codecvt_utf8_utf16<wchar_t>, wchar_t>;
-#endif //__linux__
+    constexpr uint64_t ascii_mask = 0x8080808080808080ull;
+    constexpr size_t ascii_block = sizeof(uint64_t);
+}
 
 namespace core
 {
@@ -18,14 +17,79 @@ namespace core
     {
         std::string from_utf16(std::wstring_view _source_16)
         {
-             static converter_t converter;
-             return converter.to_bytes(_source_16.data(), _source_16.data() + _source_16.size());
+            std::string result;
+            result.reserve(_source_16.size());
+
+            const auto size = _source_16.size();
+            for (size_t i = 0; i < size; ++i)
+            {
+                auto c = static_cast<char32_t>(_source_16[i]);
+                if (c < 0x80)
+                {
+                    result += static_cast<char>(c);
+                    continue;
+                }
+
+                if constexpr (is_utf16_wchar)
+                {
+                    if (c >= 0xD800 && c < 0xDC00 && i + 1 < size)
+                    {
+                        const auto low = static_cast<char32_t>(_source_16[i + 1]);
+                        if (low >= 0xDC00 && low < 0xE000)
+                        {
+                            c = 0x10000 + ((c - 0xD800) << 10) + (low - 0xDC00);
+                            ++i;
+                        }
+                    }
+                }
+
+                if ((c >= 0xD800 && c < 0xE000) || c > 0x10FFFF)
+                    c = unicode::replacement_char;
+
+                unicode::append_utf8(result, c);
+            }
+
+            return result;
         }
 
         std::wstring from_utf8(std::string_view _source_8)
         {
-             static converter_t converter;
-             return converter.from_bytes(_source_8.data(), _source_8.data() + _source_8.size());
+            std::wstring result;
+            result.reserve(_source_8.size());
+
+            size_t pos = 0;
+            while (pos < _source_8.size())
+            {
+                // ascii runs are copied a word at a time
+                while (pos + ascii_block <= _source_8.size())
+                {
+                    uint64_t block;
+                    std::memcpy(&block, _source_8.data() + pos, ascii_block);
+                    if (block & ascii_mask)
+                        break;
+
+                    for (size_t i = 0; i < ascii_block; ++i)
+                        result += static_cast<wchar_t>(_source_8[pos + i]);
+                    pos += ascii_block;
+                }
+
+                if (pos == _source_8.size())
+                    break;
+
+                const auto c = unicode::decode_utf8(_source_8, pos);
+                if constexpr (is_utf16_wchar)
+                {
+                    if (c >= 0x10000)
+                    {
+                        result += static_cast<wchar_t>(0xD800 + ((c - 0x10000) >> 10));
+                        result += static_cast<wchar_t>(0xDC00 + ((c - 0x10000) & 0x3FF));
+                        continue;
+                    }
+                }
+                result += static_cast<wchar_t>(c);
+            }
+
+            return result;
         }
 
         bool is_digit(char _c)
@@ -240,8 +304,8 @@ namespace core
 
             std::string_view str(_str, _length);
 
-            auto lower = system::to_lower(str);
-            auto upper = system::to_upper(str);
+            auto lower = unicode::to_lower(str);
+            auto upper = unicode::to_upper(str);
 
             if (lower.empty() || (lower.size() == 1 && lower[0] == '\0'))
                 lower = std::string(str);
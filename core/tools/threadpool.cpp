@@ -5,6 +5,7 @@
 
 #include "../core.h"
 #include "../network_log.h"
+#include "../profiling/trace.h"
 
 #ifndef STRIP_CRASH_HANDLER
 #include "../common.shared/crash_report/crash_reporter.h"
@@ -133,7 +134,10 @@ bool threadpool::run_task_impl()
             g_core->write_string_to_network_log(ss.str());
         }
 
-        next_task.execute();
+        {
+            profiler::trace::scope trace_scope(next_task.get_name().empty() ? std::string_view("async_task") : next_task.get_name());
+            next_task.execute();
+        }
 
         const auto finish_time = std::chrono::steady_clock::now();
 
@@ -0,0 +1,26 @@
+#pragma once
+
+namespace core
+{
+    namespace tools
+    {
+        namespace unicode
+        {
+            constexpr char32_t replacement_char = 0xFFFD;
+
+            // decodes the code point at _pos and moves _pos past it;
+            // a malformed or truncated sequence yields replacement_char and skips a single byte
+            [[nodiscard]] char32_t decode_utf8(std::string_view _str, size_t& _pos) noexcept;
+
+            void append_utf8(std::string& _out, char32_t _c);
+
+            // simple (one to one) case mapping of UnicodeData.txt, so the result never changes length in code points
+            [[nodiscard]] char32_t to_lower(char32_t _c) noexcept;
+            [[nodiscard]] char32_t to_upper(char32_t _c) noexcept;
+
+            // malformed bytes are copied as is
+            [[nodiscard]] std::string to_lower(std::string_view _str);
+            [[nodiscard]] std::string to_upper(std::string_view _str);
+        }
+    }
+}
@@ -4,6 +4,7 @@
 
 #include "tools/system.h"
 #include "tools/coretime.h"
+#include "profiling/trace.h"
 #include "tools/hmac_sha_base64.h"
 #include "../common.shared/version_info.h"
 #include "../common.shared/common_defs.h"
@@ -388,6 +389,7 @@ namespace core
                 set_thread_description_func(GetCurrentThread(), tools::from_utf8(_name).c_str());
         }
 #endif
+            profiler::trace::set_thread_name(_name);
         }
 
         uint64_t get_current_process_ram_usage()
@@ -0,0 +1,461 @@
+#include "stdafx.h"
+
+#include "benchmark.h"
+#include "data_generator.h"
+
+#include "../core/archive/archive_index.h"
+#include "../core/archive/gallery_cache.h"
+#include "../core/archive/kv_store.h"
+#include "../core/archive/messages_data.h"
+#include "../core/archive/storage.h"
+#include "../core/tools/binary_stream.h"
+#include "../core/tools/strings.h"
+#include "../core/tools/unicode.h"
+#include "../common.shared/string_utils.h"
+
+using namespace core;
+using namespace benchmarks;
+
+namespace
+{
+    constexpr size_t messages_count() noexcept { return 1000; }
+    constexpr size_t index_size() noexcept { return 20000; }
+    constexpr std::string_view contact() noexcept { return "benchmark@chat.agent"; }
+    constexpr size_t synced_chats_count() noexcept { return 300; }
+    constexpr size_t gallery_size() noexcept { return 20000; }
+    constexpr size_t gallery_requests_count() noexcept { return 100; }
+    constexpr int gallery_page_size() noexcept { return 50; }
+
+    std::vector<tools::binary_stream> serialize_messages(const archive::history_block& _messages)
+    {
+        std::vector<tools::binary_stream> result(_messages.size());
+        for (size_t i = 0; i < _messages.size(); ++i)
+            _messages[i]->serialize(result[i]);
+        return result;
+    }
+
+    std::shared_ptr<archive::coded_term> make_term(const std::string& _term)
+    {
+        auto last_symb_id = std::make_shared<int32_t>(0);
+
+        auto cterm = std::make_shared<archive::coded_term>();
+        cterm->lower_term = tools::unicode::to_lower(_term);
+        cterm->coded_string = tools::convert_string_to_vector(_term, last_symb_id, cterm->symbs, cterm->symb_indexes, cterm->symb_table);
+        cterm->prefix = std::vector<int32_t>(tools::build_prefix(cterm->coded_string));
+        return cterm;
+    }
+
+    // the index of one chat written to disk once and loaded by the benchmarks
+    struct index_fixture
+    {
+        temp_folder folder_;
+        std::wstring file_name_ = folder_.get_file_name(L"_idx");
+
+        index_fixture()
+        {
+            data_generator generator;
+            archive::archive_index index(file_name_, std::string(contact()));
+
+            constexpr size_t block_size = 1000;
+            for (size_t i = 0; i < index_size(); i += block_size)
+            {
+                auto block = generator.messages(block_size, 1000 + int64_t(i));
+                for (size_t j = 0; j < block.size(); ++j)
+                {
+                    block[j]->set_data_offset(int64_t(i + j) * 256);
+                    block[j]->set_data_size(256);
+                }
+
+                archive::headers_list headers;
+                index.update(block, headers);
+            }
+
+            index.save_all();
+        }
+    };
+
+    // the messages of one chat in the layout of the search buffer
+    struct search_fixture
+    {
+        temp_folder folder_;
+        std::shared_ptr<tools::binary_stream> data_ = std::make_shared<tools::binary_stream>();
+
+        search_fixture()
+        {
+            const auto file_name = folder_.get_file_name(L"_db");
+
+            data_generator generator;
+            archive::messages_data messages(file_name);
+            messages.update(generator.messages(index_size()));
+
+            data_->load_from_file(file_name);
+        }
+
+        size_t search(const std::shared_ptr<archive::coded_term>& _term)
+        {
+            auto contacts = std::make_shared<archive::contact_and_offsets_v>();
+            contacts->emplace_back(std::string(contact()), std::make_shared<int64_t>(0), std::make_shared<int64_t>(0));
+
+            auto archive = std::make_shared<archive::contact_and_msgs>();
+            archive->emplace_back(std::string(contact()), 0);
+            archive->emplace_back(std::string(), data_->all_size());
+
+            search::found_messages found;
+            archive::messages_data::search_in_archive(contacts, _term, archive, data_, found, -1);
+
+            size_t count = 0;
+            for (const auto& [_, messages] : found)
+                count += messages.size();
+            return count;
+        }
+    };
+
+    // the dialog states of the chats in one fetch batch; the text stands in for the last message
+    struct synced_chat
+    {
+        std::string contact_;
+        tools::binary_stream state_;
+    };
+
+    std::vector<synced_chat> make_synced_chats()
+    {
+        data_generator generator;
+
+        std::vector<synced_chat> chats(synced_chats_count());
+        for (auto& chat : chats)
+        {
+            chat.contact_ = generator.aimid();
+            const auto text = generator.message_text();
+            chat.state_.write(text.data(), int64_t(text.size()));
+        }
+        return chats;
+    }
+
+    // a full gallery, mostly images, and the requests of a user scrolling its videos and files
+    struct gallery_fixture
+    {
+        archive::gallery_storage storage_;
+        std::vector<archive::gallery_entry_id> page_starts_;
+        std::vector<int64_t> msg_ids_;
+
+        gallery_fixture()
+        {
+            data_generator generator;
+
+            std::string json = "{\"galleryState\":{},\"tail\":{\"entries\":[";
+            std::vector<archive::gallery_entry_id> ids;
+            for (size_t i = 0; i < gallery_size(); ++i)
+            {
+                const auto roll = generator.number(0, 99);
+                const char* type = roll < 70 ? "image" : roll < 80 ? "video" : roll < 90 ? "link" : roll < 97 ? "file" : "ptt";
+
+                const archive::gallery_entry_id id(1000 + int64_t(i) * 3, int64_t(i));
+                ids.push_back(id);
+
+                if (i > 0)
+                    json += ',';
+                json += su::concat("{\"id\":{\"mid\":", std::to_string(id.msg_id_), ",\"seq\":", std::to_string(id.seq_),
+                    "},\"type\":\"", type, "\",\"url\":\"", generator.url(), "\",\"sender\":\"", generator.aimid(),
+                    "\",\"time\":", std::to_string(1600000000 + i), '}');
+            }
+            json += "]}}";
+
+            rapidjson::Document document;
+            document.Parse(json.c_str());
+            storage_.unserialize(document, false);
+
+            for (size_t i = 0; i < gallery_requests_count(); ++i)
+            {
+                page_starts_.push_back(ids[generator.number(0, int64_t(ids.size()) - 1)]);
+                msg_ids_.push_back(ids[generator.number(0, int64_t(ids.size()) - 1)].msg_id_);
+            }
+        }
+    };
+
+    // a type outside the indexed set sends a request down the former scan of the whole deque,
+    // no item has it so the results are the same
+    const std::vector<std::string>& gallery_types(bool _indexed)
+    {
+        static const std::vector<std::string> indexed = { "video", "file" };
+        static const std::vector<std::string> scanned = { "video", "file", "unindexed" };
+        return _indexed ? indexed : scanned;
+    }
+
+    gallery_fixture& get_gallery_fixture()
+    {
+        static gallery_fixture fixture;
+        return fixture;
+    }
+
+    void get_gallery_pages(state& _state, bool _indexed)
+    {
+        auto& fixture = get_gallery_fixture();
+        const auto& types = gallery_types(_indexed);
+
+        while (_state.keep_running())
+        {
+            for (const auto& from : fixture.page_starts_)
+            {
+                bool exhausted = false;
+                do_not_optimize(fixture.storage_.get_items(from, types, gallery_page_size(), exhausted));
+            }
+        }
+
+        _state.set_items_processed(_state.get_iterations() * int64_t(fixture.page_starts_.size()));
+    }
+
+    void get_gallery_positions(state& _state, bool _indexed)
+    {
+        auto& fixture = get_gallery_fixture();
+        const auto& types = gallery_types(_indexed);
+
+        while (_state.keep_running())
+        {
+            for (const auto msg_id : fixture.msg_ids_)
+            {
+                int index = 0;
+                int total = 0;
+                do_not_optimize(fixture.storage_.get_items(msg_id, types, index, total));
+                do_not_optimize(index + total);
+            }
+        }
+
+        _state.set_items_processed(_state.get_iterations() * int64_t(fixture.msg_ids_.size()));
+    }
+
+    index_fixture& get_index_fixture()
+    {
+        static index_fixture fixture;
+        return fixture;
+    }
+
+    search_fixture& get_search_fixture()
+    {
+        static search_fixture fixture;
+        return fixture;
+    }
+}
+
+CORE_BENCHMARK("archive/history_message/serialize", [](state& _state)
+{
+    const auto messages = data_generator().messages(messages_count());
+
+    tools::binary_stream data;
+    int64_t bytes = 0;
+    while (_state.keep_running())
+    {
+        for (const auto& message : messages)
+        {
+            data.reset();
+            message->serialize(data);
+            bytes += data.available();
+        }
+        do_not_optimize(data);
+    }
+
+    _state.set_bytes_processed(bytes);
+    _state.set_items_processed(_state.get_iterations() * int64_t(messages.size()));
+});
+
+CORE_BENCHMARK("archive/history_message/unserialize", [](state& _state)
+{
+    auto blocks = serialize_messages(data_generator().messages(messages_count()));
+
+    int64_t bytes = 0;
+    while (_state.keep_running())
+    {
+        for (auto& block : blocks)
+        {
+            block.reset_out();
+            bytes += block.available();
+
+            archive::history_message message;
+            do_not_optimize(message.unserialize(block));
+        }
+    }
+
+    _state.set_bytes_processed(bytes);
+    _state.set_items_processed(_state.get_iterations() * int64_t(blocks.size()));
+});
+
+// the same blocks as unserialize, the fields besides the header and the text are skipped
+CORE_BENCHMARK("archive/history_message/unserialize_header_and_text", [](state& _state)
+{
+    auto blocks = serialize_messages(data_generator().messages(messages_count()));
+
+    int64_t bytes = 0;
+    while (_state.keep_running())
+    {
+        for (auto& block : blocks)
+        {
+            block.reset_out();
+            bytes += block.available();
+
+            archive::history_message message;
+            do_not_optimize(message.unserialize_header_and_text(block));
+        }
+    }
+
+    _state.set_bytes_processed(bytes);
+    _state.set_items_processed(_state.get_iterations() * int64_t(blocks.size()));
+});
+
+// what the search scan pays per message: the fields are indexed, the id and the text are read in place
+CORE_BENCHMARK("archive/history_message_view/id_and_text", [](state& _state)
+{
+    auto blocks = serialize_messages(data_generator().messages(messages_count()));
+
+    archive::history_message_view view;
+    int64_t bytes = 0;
+    while (_state.keep_running())
+    {
+        for (auto& block : blocks)
+        {
+            block.reset_out();
+            bytes += block.available();
+
+            if (view.init(block))
+            {
+                do_not_optimize(view.get_msgid());
+                do_not_optimize(view.get_text());
+            }
+        }
+    }
+
+    _state.set_bytes_processed(bytes);
+    _state.set_items_processed(_state.get_iterations() * int64_t(blocks.size()));
+});
+
+CORE_BENCHMARK("archive/archive_index/load_from_local", [](state& _state)
+{
+    const auto& fixture = get_index_fixture();
+
+    while (_state.keep_running())
+    {
+        archive::archive_index index(fixture.file_name_, std::string(contact()));
+        do_not_optimize(index.load_from_local());
+    }
+
+    _state.set_items_processed(_state.get_iterations() * int64_t(index_size()));
+});
+
+CORE_BENCHMARK("archive/archive_index/serialize_from/last_page", [](state& _state)
+{
+    archive::archive_index index(get_index_fixture().file_name_, std::string(contact()));
+    index.load_from_local();
+
+    archive::headers_list headers;
+    while (_state.keep_running())
+    {
+        headers.clear();
+        index.serialize_from(-1, 100, -1, headers);
+        do_not_optimize(headers);
+    }
+
+    _state.set_items_processed(_state.get_iterations() * 100);
+});
+
+CORE_BENCHMARK("archive/archive_index/serialize_from/middle", [](state& _state)
+{
+    archive::archive_index index(get_index_fixture().file_name_, std::string(contact()));
+    index.load_from_local();
+
+    const auto from = index.get_first_msgid() + int64_t(index_size() / 2);
+
+    archive::headers_list headers;
+    while (_state.keep_running())
+    {
+        headers.clear();
+        index.serialize_from(from, 50, 50, headers);
+        do_not_optimize(headers);
+    }
+
+    _state.set_items_processed(_state.get_iterations() * 100);
+});
+
+// a term that is not in the texts: every text is scanned with kmp_strstr to the end
+CORE_BENCHMARK("archive/messages_data/search_in_archive/miss", [](state& _state)
+{
+    auto& fixture = get_search_fixture();
+    const auto term = make_term("nonexistent");
+
+    while (_state.keep_running())
+        do_not_optimize(fixture.search(term));
+
+    _state.set_bytes_processed(_state.get_iterations() * fixture.data_->all_size());
+    _state.set_items_processed(_state.get_iterations() * int64_t(index_size()));
+});
+
+// a frequent word: the matched messages are materialized once the chat is scanned
+CORE_BENCHMARK("archive/messages_data/search_in_archive/hit", [](state& _state)
+{
+    auto& fixture = get_search_fixture();
+    const auto term = make_term("\xd0\x97\xd0\x90\xd0\x92\xd0\xa2\xd0\xa0\xd0\x90"); // ЗАВТРА
+
+    while (_state.keep_running())
+        do_not_optimize(fixture.search(term));
+
+    _state.set_bytes_processed(_state.get_iterations() * fixture.data_->all_size());
+    _state.set_items_processed(_state.get_iterations() * int64_t(index_size()));
+});
+
+// the former way to save the dialog states of a fetch batch: every chat opens, truncates, writes and closes
+// its own file, so a batch costs an open/write/close per chat
+CORE_BENCHMARK("archive/side_files/per_chat_files", [](state& _state)
+{
+    temp_folder folder;
+    auto chats = make_synced_chats();
+
+    std::vector<std::unique_ptr<archive::storage>> files;
+    for (const auto& chat : chats)
+        files.push_back(std::make_unique<archive::storage>(folder.get_file_name(tools::from_utf8(chat.contact_))));
+
+    while (_state.keep_running())
+    {
+        for (size_t i = 0; i < chats.size(); ++i)
+        {
+            archive::storage_mode mode;
+            mode.flags_.write_ = true;
+            mode.flags_.truncate_ = true;
+            if (!files[i]->open(mode))
+                continue;
+
+            int64_t offset = 0;
+            chats[i].state_.reset_out();
+            files[i]->write_data_block(chats[i].state_, offset);
+            files[i]->close();
+        }
+    }
+
+    _state.set_items_processed(_state.get_iterations() * int64_t(chats.size()));
+});
+
+// the same batch through kv_store: the records are buffered and appended by one commit, an open/write/close
+// per batch, with the log rewritten whenever it gets mostly stale; neither path calls fsync
+CORE_BENCHMARK("archive/side_files/kv_store", [](state& _state)
+{
+    temp_folder folder;
+    auto chats = make_synced_chats();
+
+    archive::kv_store store(folder.get_file_name(L"kv.db"));
+
+    while (_state.keep_running())
+    {
+        for (auto& chat : chats)
+        {
+            chat.state_.reset_out();
+            store.put(archive::kv_family::dlg_state, chat.contact_, chat.state_);
+        }
+        do_not_optimize(store.commit());
+    }
+
+    _state.set_items_processed(_state.get_iterations() * int64_t(chats.size()));
+});
+
+// a page of the gallery viewer scrolled from an item
+CORE_BENCHMARK("archive/gallery_storage/get_page/scan", [](state& _state) { get_gallery_pages(_state, false); });
+CORE_BENCHMARK("archive/gallery_storage/get_page/type_index", [](state& _state) { get_gallery_pages(_state, true); });
+
+// the index and the total of an item opened from the chat
+CORE_BENCHMARK("archive/gallery_storage/get_position/scan", [](state& _state) { get_gallery_positions(_state, false); });
+CORE_BENCHMARK("archive/gallery_storage/get_position/type_index", [](state& _state) { get_gallery_positions(_state, true); });
@@ -0,0 +1,342 @@
+#include "stdafx.h"
+
+#include "benchmark.h"
+
+#include "../core/tools/system.h"
+
+using namespace core;
+using namespace benchmarks;
+
+namespace
+{
+    struct benchmark_info
+    {
+        std::string name_;
+        benchmark_function function_;
+    };
+
+    std::vector<benchmark_info>& get_benchmarks()
+    {
+        static std::vector<benchmark_info> benchmarks;
+        return benchmarks;
+    }
+
+    struct options
+    {
+        std::string filter_;
+        std::string out_file_;
+        std::chrono::milliseconds min_time_ = std::chrono::milliseconds(300);
+        int repetitions_ = 3;
+        bool json_ = false;
+        bool list_ = false;
+    };
+
+    struct result
+    {
+        std::string name_;
+        int64_t iterations_ = 0;
+        int repetitions_ = 0;
+        double ns_per_iteration_ = 0;
+        double min_ns_per_iteration_ = 0;
+        double max_ns_per_iteration_ = 0;
+        double bytes_per_second_ = 0;
+        double items_per_second_ = 0;
+    };
+
+    constexpr int64_t max_iterations() noexcept { return 1000 * 1000 * 1000; }
+
+    std::optional<std::string_view> get_option(std::string_view _arg, std::string_view _name)
+    {
+        if (_arg.size() > _name.size() && _arg.substr(0, _name.size()) == _name && _arg[_name.size()] == '=')
+            return _arg.substr(_name.size() + 1);
+
+        return std::nullopt;
+    }
+
+    bool parse_options(int _argc, char* _argv[], options& _options)
+    {
+        for (int i = 1; i < _argc; ++i)
+        {
+            const std::string_view arg = _argv[i];
+
+            if (const auto value = get_option(arg, "--filter"))
+                _options.filter_ = *value;
+            else if (const auto value = get_option(arg, "--out"))
+                _options.out_file_ = *value;
+            else if (const auto value = get_option(arg, "--min_time_ms"))
+                _options.min_time_ = std::chrono::milliseconds(std::max(1, std::atoi(std::string(*value).c_str())));
+            else if (const auto value = get_option(arg, "--repetitions"))
+                _options.repetitions_ = std::max(1, std::atoi(std::string(*value).c_str()));
+            else if (const auto value = get_option(arg, "--format"))
+                _options.json_ = (*value == "json");
+            else if (arg == "--list")
+                _options.list_ = true;
+            else
+                return false;
+        }
+
+        return true;
+    }
+
+    void print_usage()
+    {
+        std::cout << "usage: core_benchmarks [--filter=<substring>] [--min_time_ms=300] [--repetitions=3] [--format=text|json] [--out=<file>] [--list]\n";
+    }
+
+    std::chrono::nanoseconds run_once(const benchmark_info& _benchmark, state& _state)
+    {
+        _benchmark.function_(_state);
+        return _state.get_elapsed();
+    }
+
+    // the iteration count grows until one run takes at least min_time, then the run is repeated
+    result run(const benchmark_info& _benchmark, const options& _options)
+    {
+        int64_t iterations = 1;
+        for (;;)
+        {
+            state s(iterations);
+            const auto elapsed = run_once(_benchmark, s);
+            if (elapsed >= _options.min_time_ || iterations >= max_iterations())
+                break;
+
+            const auto elapsed_ns = std::max<int64_t>(elapsed.count(), 1);
+            const auto min_time_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(_options.min_time_).count();
+            const auto predicted = int64_t(double(iterations) * double(min_time_ns) * 1.4 / double(elapsed_ns));
+            iterations = std::clamp(predicted, iterations + 1, std::min(iterations * 100, max_iterations()));
+        }
+
+        std::vector<double> ns_per_iteration;
+        std::vector<state> states;
+        ns_per_iteration.reserve(_options.repetitions_);
+        states.reserve(_options.repetitions_);
+        for (int i = 0; i < _options.repetitions_; ++i)
+        {
+            auto& s = states.emplace_back(iterations);
+            const auto elapsed = run_once(_benchmark, s);
+            ns_per_iteration.push_back(double(elapsed.count()) / double(iterations));
+        }
+
+        result r;
+        r.name_ = _benchmark.name_;
+        r.iterations_ = iterations;
+        r.repetitions_ = _options.repetitions_;
+
+        auto sorted = ns_per_iteration;
+        std::sort(sorted.begin(), sorted.end());
+        r.ns_per_iteration_ = sorted[sorted.size() / 2];
+        r.min_ns_per_iteration_ = sorted.front();
+        r.max_ns_per_iteration_ = sorted.back();
+
+        // the counters of the median repetition
+        const auto median = std::distance(ns_per_iteration.begin(), std::find(ns_per_iteration.begin(), ns_per_iteration.end(), r.ns_per_iteration_));
+        const auto& s = states[median];
+        const auto seconds = r.ns_per_iteration_ * double(iterations) / 1e9;
+        if (seconds > 0)
+        {
+            r.bytes_per_second_ = double(s.get_bytes_processed()) / seconds;
+            r.items_per_second_ = double(s.get_items_processed()) / seconds;
+        }
+
+        return r;
+    }
+
+    std::string format_rate(double _value, std::string_view _unit)
+    {
+        if (_value <= 0)
+            return std::string();
+
+        constexpr std::array<std::string_view, 4> prefixes = { "", "k", "M", "G" };
+        size_t prefix = 0;
+        while (_value >= 1000 && prefix + 1 < prefixes.size())
+        {
+            _value /= 1000;
+            ++prefix;
+        }
+
+        std::stringstream ss;
+        ss << std::fixed << std::setprecision(2) << _value << ' ' << prefixes[prefix] << _unit << "/s";
+        return ss.str();
+    }
+
+    void write_text(std::ostream& _out, const std::vector<result>& _results)
+    {
+        _out << std::left << std::setw(56) << "benchmark" << std::right << std::setw(16) << "ns/iteration" << std::setw(14) << "iterations" << std::setw(16) << "bytes" << std::setw(16) << "items" << '\n';
+        _out << std::string(118, '-') << '\n';
+
+        for (const auto& r : _results)
+        {
+            _out << std::left << std::setw(56) << r.name_
+                << std::right << std::setw(16) << std::fixed << std::setprecision(1) << r.ns_per_iteration_
+                << std::setw(14) << r.iterations_
+                << std::setw(16) << format_rate(r.bytes_per_second_, "B")
+                << std::setw(16) << format_rate(r.items_per_second_, "")
+                << '\n';
+        }
+    }
+
+    // the layout follows the json of google benchmark, so the usual comparison scripts can read it
+    void write_json(std::ostream& _out, const std::vector<result>& _results)
+    {
+        rapidjson::StringBuffer buffer;
+        rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+
+        writer.StartObject();
+
+        writer.Key("context");
+        writer.StartObject();
+        {
+            const auto now = std::time(nullptr);
+            std::stringstream date;
+            date << std::put_time(std::gmtime(&now), "%Y-%m-%dT%H:%M:%SZ");
+            writer.Key("date");
+            writer.String(date.str().c_str());
+        }
+        writer.Key("library_build_type");
+        writer.String(build::is_debug() ? "debug" : "release");
+        writer.Key("num_cpus");
+        writer.Uint(std::thread::hardware_concurrency());
+#ifdef GIT_COMMIT_HASH
+        writer.Key("git_commit");
+        writer.String(GIT_COMMIT_HASH);
+#endif
+        writer.EndObject();
+
+        writer.Key("benchmarks");
+        writer.StartArray();
+        for (const auto& r : _results)
+        {
+            writer.StartObject();
+            writer.Key("name");
+            writer.String(r.name_.c_str(), rapidjson::SizeType(r.name_.size()));
+            writer.Key("iterations");
+            writer.Int64(r.iterations_);
+            writer.Key("repetitions");
+            writer.Int(r.repetitions_);
+            writer.Key("real_time");
+            writer.Double(r.ns_per_iteration_);
+            writer.Key("min_time");
+            writer.Double(r.min_ns_per_iteration_);
+            writer.Key("max_time");
+            writer.Double(r.max_ns_per_iteration_);
+            writer.Key("time_unit");
+            writer.String("ns");
+            if (r.bytes_per_second_ > 0)
+            {
+                writer.Key("bytes_per_second");
+                writer.Double(r.bytes_per_second_);
+            }
+            if (r.items_per_second_ > 0)
+            {
+                writer.Key("items_per_second");
+                writer.Double(r.items_per_second_);
+            }
+            writer.EndObject();
+        }
+        writer.EndArray();
+
+        writer.EndObject();
+
+        _out << std::string_view(buffer.GetString(), buffer.GetSize()) << '\n';
+    }
+}
+
+state::state(int64_t _iterations)
+    : iterations_(_iterations)
+{
+}
+
+void state::pause_timing()
+{
+    pause_ = std::chrono::steady_clock::now();
+}
+
+void state::resume_timing()
+{
+    paused_ += std::chrono::steady_clock::now() - pause_;
+}
+
+std::chrono::nanoseconds state::get_elapsed() const noexcept
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(finish_ - start_ - paused_);
+}
+
+bool core::benchmarks::register_benchmark(std::string_view _name, benchmark_function _function)
+{
+    get_benchmarks().push_back({ std::string(_name), std::move(_function) });
+    return true;
+}
+
+temp_folder::temp_folder()
+{
+    const auto path = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path(L"core_benchmarks-%%%%-%%%%-%%%%");
+    path_ = path.wstring();
+    tools::system::create_directory(path_);
+}
+
+temp_folder::~temp_folder()
+{
+    boost::system::error_code error;
+    boost::filesystem::remove_all(boost::filesystem::wpath(path_), error);
+}
+
+std::wstring temp_folder::get_file_name(std::wstring_view _name) const
+{
+    std::wstring file_name = path_;
+    file_name += L'/';
+    file_name += _name;
+    return file_name;
+}
+
+int main(int _argc, char* _argv[])
+{
+    options opts;
+    if (!parse_options(_argc, _argv, opts))
+    {
+        print_usage();
+        return 1;
+    }
+
+    auto& benchmarks = get_benchmarks();
+    std::sort(benchmarks.begin(), benchmarks.end(), [](const auto& _l, const auto& _r) { return _l.name_ < _r.name_; });
+
+    std::vector<result> results;
+    for (const auto& b : benchmarks)
+    {
+        if (!opts.filter_.empty() && b.name_.find(opts.filter_) == std::string::npos)
+            continue;
+
+        if (opts.list_)
+        {
+            std::cout << b.name_ << '\n';
+            continue;
+        }
+
+        if (!opts.json_)
+            std::cerr << "running " << b.name_ << std::endl;
+
+        results.push_back(run(b, opts));
+    }
+
+    if (opts.list_)
+        return 0;
+
+    std::ofstream file;
+    if (!opts.out_file_.empty())
+    {
+        file.open(opts.out_file_, std::ios_base::out | std::ios_base::trunc);
+        if (!file.is_open())
+        {
+            std::cerr << "can't open " << opts.out_file_ << std::endl;
+            return 1;
+        }
+    }
+
+    auto& out = file.is_open() ? static_cast<std::ostream&>(file) : std::cout;
+    if (opts.json_)
+        write_json(out, results);
+    else
+        write_text(out, results);
+
+    return 0;
+}
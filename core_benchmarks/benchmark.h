@@ -0,0 +1,90 @@
+#pragma once
+
+namespace core
+{
+    namespace benchmarks
+    {
+        // passed to a benchmark body, which runs the measured code while keep_running() returns true;
+        // preparation done before the loop is not measured
+        class state
+        {
+        public:
+            explicit state(int64_t _iterations);
+
+            bool keep_running()
+            {
+                if (done_ == 0)
+                    start_ = std::chrono::steady_clock::now();
+
+                if (done_ < iterations_)
+                {
+                    ++done_;
+                    return true;
+                }
+
+                finish_ = std::chrono::steady_clock::now();
+                return false;
+            }
+
+            void pause_timing();
+            void resume_timing();
+
+            void set_bytes_processed(int64_t _bytes) noexcept { bytes_ = _bytes; }
+            void set_items_processed(int64_t _items) noexcept { items_ = _items; }
+
+            int64_t get_iterations() const noexcept { return iterations_; }
+            int64_t get_bytes_processed() const noexcept { return bytes_; }
+            int64_t get_items_processed() const noexcept { return items_; }
+
+            std::chrono::nanoseconds get_elapsed() const noexcept;
+
+        private:
+            const int64_t iterations_;
+            int64_t done_ = 0;
+            int64_t bytes_ = 0;
+            int64_t items_ = 0;
+
+            std::chrono::steady_clock::time_point start_;
+            std::chrono::steady_clock::time_point finish_;
+            std::chrono::steady_clock::time_point pause_;
+            std::chrono::nanoseconds paused_ = std::chrono::nanoseconds::zero();
+        };
+
+        using benchmark_function = std::function<void(state&)>;
+
+        bool register_benchmark(std::string_view _name, benchmark_function _function);
+
+        // keeps the compiler from dropping a computation whose result is otherwise unused
+        template <typename T>
+        void do_not_optimize(const T& _value)
+        {
+#if defined(_MSC_VER)
+            static volatile const void* sink;
+            sink = &_value;
+#else
+            asm volatile("" : : "r,m"(_value) : "memory");
+#endif
+        }
+
+        // a folder for benchmarks that need files, removed with its content on destruction
+        class temp_folder
+        {
+        public:
+            temp_folder();
+            ~temp_folder();
+
+            const std::wstring& get_path() const noexcept { return path_; }
+            std::wstring get_file_name(std::wstring_view _name) const;
+
+        private:
+            std::wstring path_;
+        };
+    }
+}
+
+#define CORE_BENCHMARK_CONCAT_IMPL(_a, _b) _a##_b
+#define CORE_BENCHMARK_CONCAT(_a, _b) CORE_BENCHMARK_CONCAT_IMPL(_a, _b)
+
+// registers a benchmark body: CORE_BENCHMARK("tools/binary_stream/write", [](auto& _state) { ... });
+#define CORE_BENCHMARK(_name, _function) \
+    static const bool CORE_BENCHMARK_CONCAT(benchmark_registered_, __LINE__) = core::benchmarks::register_benchmark(_name, _function)
@@ -0,0 +1,106 @@
+#include "stdafx.h"
+
+#include "benchmark.h"
+#include "data_generator.h"
+
+#include "../corelib/collection.h"
+#include "../corelib/collection_helper.h"
+
+using namespace core;
+using namespace benchmarks;
+
+namespace
+{
+    constexpr int32_t items_count() noexcept { return 100; }
+
+    struct item
+    {
+        std::string aimid_;
+        std::string friendly_;
+        std::string text_;
+        int64_t last_msg_id_ = 0;
+        int64_t time_ = 0;
+        int32_t unread_count_ = 0;
+        bool pinned_ = false;
+    };
+
+    std::vector<item> make_items()
+    {
+        data_generator generator;
+
+        std::vector<item> items(items_count());
+        for (auto& i : items)
+        {
+            i.aimid_ = generator.aimid();
+            i.friendly_ = generator.text(1, 3);
+            i.text_ = generator.message_text();
+            i.last_msg_id_ = generator.number(1, std::numeric_limits<int32_t>::max());
+            i.time_ = generator.number(1600000000, 1700000000);
+            i.unread_count_ = int32_t(generator.number(0, 20));
+            i.pinned_ = generator.chance(0.1);
+        }
+        return items;
+    }
+
+    // a collection like the dialog states posted to the gui: an array of flat collections
+    coll_helper make_collection(const std::vector<item>& _items)
+    {
+        coll_helper coll(new collection(), true);
+
+        ifptr<iarray> array(coll->create_array());
+        array->reserve(iarray::size_type(_items.size()));
+        for (const auto& i : _items)
+        {
+            coll_helper item_coll(coll->create_collection(), true);
+            item_coll.set_value_as_string("aimId", i.aimid_);
+            item_coll.set_value_as_string("friendly", i.friendly_);
+            item_coll.set_value_as_string("text", i.text_);
+            item_coll.set_value_as_int64("last_msg_id", i.last_msg_id_);
+            item_coll.set_value_as_int64("time", i.time_);
+            item_coll.set_value_as_int("unreads", i.unread_count_);
+            item_coll.set_value_as_bool("pinned", i.pinned_);
+
+            ifptr<ivalue> value(coll->create_value());
+            value->set_as_collection(item_coll.get());
+            array->push_back(value.get());
+        }
+        coll.set_value_as_array("items", array.get());
+
+        return coll;
+    }
+}
+
+CORE_BENCHMARK("corelib/collection/build", [](state& _state)
+{
+    const auto items = make_items();
+
+    while (_state.keep_running())
+        do_not_optimize(make_collection(items));
+
+    _state.set_items_processed(_state.get_iterations() * items_count());
+});
+
+CORE_BENCHMARK("corelib/collection/read", [](state& _state)
+{
+    const auto coll = make_collection(make_items());
+
+    int64_t sum = 0;
+    while (_state.keep_running())
+    {
+        const auto array = coll.get_value_as_array("items");
+        for (iarray::size_type i = 0, size = array->size(); i < size; ++i)
+        {
+            coll_helper item_coll(array->get_at(i)->get_as_collection(), false);
+            sum += std::string_view(item_coll.get_value_as_string("aimId")).size();
+            sum += std::string_view(item_coll.get_value_as_string("friendly")).size();
+            sum += std::string_view(item_coll.get_value_as_string("text")).size();
+            sum += item_coll.get_value_as_int64("last_msg_id");
+            sum += item_coll.get_value_as_int64("time");
+            sum += item_coll.get_value_as_int("unreads");
+            sum += item_coll.get_value_as_bool("pinned");
+        }
+    }
+    do_not_optimize(sum);
+
+    _state.set_items_processed(_state.get_iterations() * items_count());
+});
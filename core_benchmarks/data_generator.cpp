@@ -0,0 +1,151 @@
+#include "stdafx.h"
+
+#include "data_generator.h"
+
+#include "../common.shared/string_utils.h"
+
+using namespace core;
+using namespace benchmarks;
+
+namespace
+{
+    constexpr std::array<std::string_view, 24> latin_words =
+    {
+        "hello", "meeting", "tomorrow", "the", "and", "project", "release", "please", "check", "build",
+        "thanks", "ok", "review", "deadline", "call", "today", "when", "what", "link", "file",
+        "document", "version", "update", "yes"
+    };
+
+    constexpr std::array<std::string_view, 16> cyrillic_words =
+    {
+        "\xd0\xbf\xd1\x80\xd0\xb8\xd0\xb2\xd0\xb5\xd1\x82", // привет
+        "\xd0\xb7\xd0\xb0\xd0\xb2\xd1\x82\xd1\x80\xd0\xb0", // завтра
+        "\xd0\xb2\xd1\x81\xd1\x82\xd1\x80\xd0\xb5\xd1\x87\xd0\xb0", // встреча
+        "\xd0\xb4\xd0\xb0", // да
+        "\xd0\xbd\xd0\xb5\xd1\x82", // нет
+        "\xd1\x81\xd0\xbf\xd0\xb0\xd1\x81\xd0\xb8\xd0\xb1\xd0\xbe", // спасибо
+        "\xd0\xbf\xd1\x80\xd0\xbe\xd0\xb5\xd0\xba\xd1\x82", // проект
+        "\xd1\x84\xd0\xb0\xd0\xb9\xd0\xbb", // файл
+        "\xd1\x81\xd0\xb5\xd0\xb3\xd0\xbe\xd0\xb4\xd0\xbd\xd1\x8f", // сегодня
+        "\xd0\xb8", // и
+        "\xd0\xb2", // в
+        "\xd0\xba\xd0\xbe\xd0\xb3\xd0\xb4\xd0\xb0", // когда
+        "\xd0\xbe\xd1\x82\xd1\x87\xd0\xb5\xd1\x82", // отчет
+        "\xd1\x80\xd0\xb5\xd0\xbb\xd0\xb8\xd0\xb7", // релиз
+        "\xd1\x81\xd0\xb1\xd0\xbe\xd1\x80\xd0\xba\xd0\xb0", // сборка
+        "\xd1\x85\xd0\xbe\xd1\x80\xd0\xbe\xd1\x88\xd0\xbe", // хорошо
+    };
+
+    constexpr std::array<std::string_view, 6> emoji =
+    {
+        "\xf0\x9f\x98\x80", "\xf0\x9f\x91\x8d", "\xf0\x9f\x94\xa5", "\xe2\x9d\xa4\xef\xb8\x8f", "\xf0\x9f\x98\x82", "\xf0\x9f\x8e\x89"
+    };
+
+    constexpr std::array<std::string_view, 5> hosts =
+    {
+        "https://example.com/", "http://www.example.org/", "https://files.example.net/get/", "www.example.ru/", "https://docs.example.com/d/"
+    };
+}
+
+data_generator::data_generator(uint32_t _seed)
+    : engine_(_seed)
+{
+}
+
+int64_t data_generator::number(int64_t _min, int64_t _max)
+{
+    return std::uniform_int_distribution<int64_t>(_min, _max)(engine_);
+}
+
+bool data_generator::chance(double _probability)
+{
+    return std::bernoulli_distribution(_probability)(engine_);
+}
+
+std::string data_generator::word()
+{
+    const auto kind = number(0, 99);
+    if (kind < 55)
+        return std::string(latin_words[number(0, latin_words.size() - 1)]);
+    if (kind < 95)
+        return std::string(cyrillic_words[number(0, cyrillic_words.size() - 1)]);
+    return std::string(emoji[number(0, emoji.size() - 1)]);
+}
+
+std::string data_generator::url()
+{
+    std::string result(hosts[number(0, hosts.size() - 1)]);
+    const auto length = number(6, 40);
+    for (int64_t i = 0; i < length; ++i)
+        result += char(chance(0.8) ? 'a' + number(0, 25) : '0' + number(0, 9));
+    return result;
+}
+
+std::string data_generator::aimid()
+{
+    if (chance(0.2))
+        return su::concat(std::to_string(number(100000000, 999999999)), "@chat.agent");
+
+    std::string result;
+    const auto length = number(5, 12);
+    for (int64_t i = 0; i < length; ++i)
+        result += char('a' + number(0, 25));
+    return su::concat(result, "@example.com");
+}
+
+std::string data_generator::text(size_t _min_words, size_t _max_words)
+{
+    std::string result;
+    const auto words = number(int64_t(_min_words), int64_t(_max_words));
+    for (int64_t i = 0; i < words; ++i)
+    {
+        if (i > 0)
+            result += ' ';
+
+        if (chance(0.01))
+            result += url();
+        else if (chance(0.01))
+            result += su::concat("@[", aimid(), "]");
+        else
+            result += word();
+    }
+    return result;
+}
+
+std::string data_generator::message_text()
+{
+    const auto kind = number(0, 99);
+    if (kind < 80)
+        return text(1, 12);
+    if (kind < 98)
+        return text(12, 80);
+    return text(200, 800);
+}
+
+archive::history_block data_generator::messages(size_t _count, int64_t _first_id)
+{
+    archive::history_block block;
+    block.reserve(_count);
+
+    auto time = uint64_t(1600000000);
+    int64_t prev_id = -1;
+    for (size_t i = 0; i < _count; ++i)
+    {
+        const auto id = _first_id + int64_t(i);
+        time += uint64_t(number(1, 600));
+
+        auto message = std::make_shared<archive::history_message>();
+        message->set_msgid(id);
+        message->set_prev_msgid(prev_id);
+        message->set_time(time);
+        message->set_outgoing(chance(0.4));
+        message->set_internal_id(su::concat("benchmark-", std::to_string(id)));
+        message->set_sender_friendly(text(1, 2));
+        message->set_text(message_text());
+
+        block.push_back(std::move(message));
+        prev_id = id;
+    }
+
+    return block;
+}
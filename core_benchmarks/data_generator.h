@@ -0,0 +1,37 @@
+#pragma once
+
+#include <random>
+
+#include "../core/archive/history_message.h"
+
+namespace core
+{
+    namespace benchmarks
+    {
+        // synthetic data shaped like a real account: mostly short messages in several scripts,
+        // some long ones, links, mentions and emoji; the seed is fixed so every run sees the same data
+        class data_generator
+        {
+        public:
+            explicit data_generator(uint32_t _seed = 42);
+
+            std::string word();
+            std::string text(size_t _min_words, size_t _max_words);
+
+            // the length of a chat message: 80% short, 18% a paragraph, 2% a long text
+            std::string message_text();
+
+            std::string url();
+            std::string aimid();
+
+            // consecutive messages of one chat starting from _first_id
+            archive::history_block messages(size_t _count, int64_t _first_id = 1000);
+
+            int64_t number(int64_t _min, int64_t _max);
+            bool chance(double _probability);
+
+        private:
+            std::mt19937 engine_;
+        };
+    }
+}
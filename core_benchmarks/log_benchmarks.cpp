@@ -0,0 +1,91 @@
+#include "stdafx.h"
+
+#include "benchmark.h"
+#include "data_generator.h"
+
+#include "../core/network_log.h"
+#include "../core/configuration/app_config.h"
+#include "../common.shared/string_utils.h"
+
+using namespace core;
+using namespace benchmarks;
+
+namespace
+{
+    constexpr int32_t records_per_thread() noexcept { return 1000; }
+
+    // network_log reads the size limits from the app config, the defaults are used here
+    void load_default_app_config(const temp_folder& _folder)
+    {
+        static const auto loaded = (configuration::load_app_config(_folder.get_file_name(L"app.ini")), true);
+        do_not_optimize(loaded);
+    }
+
+    // a request line and a response of the size full logging writes for every packet
+    std::vector<std::string> make_records()
+    {
+        data_generator generator;
+
+        std::vector<std::string> records;
+        records.reserve(records_per_thread());
+        for (int32_t i = 0; i < records_per_thread(); ++i)
+            records.push_back(su::concat("GET https://example.net/api/v92/rapi/getHistory?sn=", generator.aimid(), "\n", generator.message_text(), "\n"));
+        return records;
+    }
+
+    void write_records(network_log& _log, const std::vector<std::string>& _records)
+    {
+        for (const auto& record : _records)
+            _log.write_string(record);
+    }
+
+    // what a thread pays to hand its records over, the writer thread formats and writes them meanwhile
+    void write_from_threads(state& _state, size_t _threads_count)
+    {
+        temp_folder folder;
+        load_default_app_config(folder);
+
+        const auto records = make_records();
+        network_log log(folder.get_path());
+
+        while (_state.keep_running())
+        {
+            std::vector<std::thread> threads;
+            threads.reserve(_threads_count);
+            for (size_t i = 0; i < _threads_count; ++i)
+                threads.emplace_back([&log, &records]() { write_records(log, records); });
+
+            for (auto& thread : threads)
+                thread.join();
+        }
+
+        _state.set_items_processed(_state.get_iterations() * int64_t(_threads_count) * records_per_thread());
+    }
+
+    // from the first write until every record is in the file
+    void write_to_file(state& _state)
+    {
+        temp_folder folder;
+        load_default_app_config(folder);
+
+        const auto records = make_records();
+        int64_t bytes = 0;
+        for (const auto& record : records)
+            bytes += int64_t(record.size());
+
+        while (_state.keep_running())
+        {
+            network_log log(folder.get_path());
+            write_records(log, records);
+        }
+
+        _state.set_bytes_processed(_state.get_iterations() * bytes);
+        _state.set_items_processed(_state.get_iterations() * records_per_thread());
+    }
+}
+
+CORE_BENCHMARK("network_log/write/caller_1_thread", [](state& _state) { write_from_threads(_state, 1); });
+
+CORE_BENCHMARK("network_log/write/caller_4_threads", [](state& _state) { write_from_threads(_state, 4); });
+
+CORE_BENCHMARK("network_log/write/to_file", [](state& _state) { write_to_file(_state); });
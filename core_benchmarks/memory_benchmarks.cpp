@@ -0,0 +1,106 @@
+#include "stdafx.h"
+
+#include "benchmark.h"
+#include "data_generator.h"
+
+#include "../core/stats/memory/memory_accounting.h"
+
+using namespace core;
+using namespace benchmarks;
+using namespace memory_stats;
+
+namespace
+{
+    constexpr int32_t map_items_count() noexcept { return 1000; }
+    constexpr int32_t thread_updates_count() noexcept { return 100000; }
+
+    using std_map = std::map<std::string, size_t>;
+    using counted_map = std::map<std::string, size_t, std::less<std::string>, counting_allocator<std::pair<const std::string, size_t>, memory_tag::collections>>;
+
+    template <typename Map>
+    void fill_map(const std::vector<std::string>& _keys, state& _state)
+    {
+        while (_state.keep_running())
+        {
+            Map map;
+            for (const auto& key : _keys)
+                map.emplace(key, key.size());
+            do_not_optimize(map.size());
+        }
+
+        _state.set_items_processed(_state.get_iterations() * int64_t(_keys.size()));
+    }
+
+    std::vector<std::string> make_keys()
+    {
+        data_generator generator;
+
+        std::vector<std::string> keys;
+        keys.reserve(map_items_count());
+        for (int32_t i = 0; i < map_items_count(); ++i)
+            keys.push_back(generator.aimid());
+        return keys;
+    }
+
+    // every thread updates the counters of _tag_of_thread(i) as a busy subsystem would
+    template <typename TagOfThread>
+    void update_from_threads(state& _state, TagOfThread _tag_of_thread)
+    {
+        const auto threads_count = memory_tags_count();
+
+        while (_state.keep_running())
+        {
+            std::vector<std::thread> threads;
+            threads.reserve(threads_count);
+            for (size_t i = 0; i < threads_count; ++i)
+            {
+                threads.emplace_back([tag = _tag_of_thread(i)]()
+                {
+                    for (int32_t j = 0; j < thread_updates_count(); ++j)
+                    {
+                        account_allocation(tag, 64);
+                        account_deallocation(tag, 64);
+                    }
+                });
+            }
+
+            for (auto& thread : threads)
+                thread.join();
+        }
+
+        _state.set_items_processed(_state.get_iterations() * int64_t(threads_count) * thread_updates_count());
+    }
+}
+
+CORE_BENCHMARK("memory/accounting/allocate_deallocate", [](state& _state)
+{
+    while (_state.keep_running())
+    {
+        account_allocation(memory_tag::collections, 64);
+        account_deallocation(memory_tag::collections, 64);
+    }
+
+    _state.set_items_processed(_state.get_iterations());
+});
+
+CORE_BENCHMARK("memory/accounting/map_std_allocator", [](state& _state)
+{
+    fill_map<std_map>(make_keys(), _state);
+});
+
+CORE_BENCHMARK("memory/accounting/map_counting_allocator", [](state& _state)
+{
+    fill_map<counted_map>(make_keys(), _state);
+});
+
+// each thread on its own tag: with the counters on separate cache lines the threads don't contend
+CORE_BENCHMARK("memory/accounting/threads_distinct_tags", [](state& _state)
+{
+    update_from_threads(_state, [](size_t _i) { return static_cast<memory_tag>(_i); });
+});
+
+// all threads on one tag, the contended baseline for the case above
+CORE_BENCHMARK("memory/accounting/threads_same_tag", [](state& _state)
+{
+    update_from_threads(_state, [](size_t) { return memory_tag::collections; });
+});
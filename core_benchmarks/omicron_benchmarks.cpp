@@ -0,0 +1,104 @@
+#include "stdafx.h"
+
+#include "benchmark.h"
+
+#include "../libomicron/include/omicron/omicron_snapshot.h"
+
+using namespace core;
+using namespace benchmarks;
+
+namespace
+{
+    constexpr int keys_count() noexcept { return 300; }
+    constexpr int looked_up_count() noexcept { return 32; }
+
+    std::string key_name(int _index)
+    {
+        return "icq_feature_key_" + std::to_string(_index);
+    }
+
+    // a config of the size the service sends, the keys looked up are spread over it
+    struct omicron_fixture
+    {
+        rapidjson::Document document_;
+        std::vector<std::string> keys_;
+
+        omicron_fixture()
+        {
+            std::string json = "{";
+            for (int i = 0; i < keys_count(); ++i)
+            {
+                if (i > 0)
+                    json += ',';
+                json += '"' + key_name(i) + "\":" + ((i % 3 == 0) ? std::string("true") : std::to_string(i));
+            }
+            json += '}';
+            document_.Parse(json.c_str());
+
+            for (int i = 0; i < looked_up_count(); ++i)
+                keys_.push_back(key_name(i * keys_count() / looked_up_count()));
+        }
+    };
+
+    const omicron_fixture& get_omicron_fixture()
+    {
+        static const omicron_fixture fixture;
+        return fixture;
+    }
+}
+
+// the former lookup: a linear compare over the config members on every call
+CORE_BENCHMARK("omicron/lookup/find_member", [](state& _state)
+{
+    const auto& fixture = get_omicron_fixture();
+
+    while (_state.keep_running())
+    {
+        for (const auto& key : fixture.keys_)
+        {
+            const auto it = fixture.document_.FindMember(key.c_str());
+            do_not_optimize(it != fixture.document_.MemberEnd() && it->value.IsInt() ? it->value.GetInt() : 0);
+        }
+    }
+
+    _state.set_items_processed(_state.get_iterations() * looked_up_count());
+});
+
+CORE_BENCHMARK("omicron/lookup/snapshot", [](state& _state)
+{
+    const auto& fixture = get_omicron_fixture();
+    const omicronlib::omicron_snapshot snapshot(fixture.document_);
+
+    while (_state.keep_running())
+    {
+        for (const auto& key : fixture.keys_)
+        {
+            const auto value = snapshot.find(key.c_str());
+            do_not_optimize(value && (value->flags_ & omicronlib::snapshot_value::is_int) ? value->int_ : 0);
+        }
+    }
+
+    _state.set_items_processed(_state.get_iterations() * looked_up_count());
+});
+
+// the keys of omicron_keys.h, hashed at compile time, so a lookup is the table probe alone
+CORE_BENCHMARK("omicron/lookup/snapshot_hashed_key", [](state& _state)
+{
+    const auto& fixture = get_omicron_fixture();
+    const omicronlib::omicron_snapshot snapshot(fixture.document_);
+
+    std::vector<omicronlib::omicron_key> keys;
+    for (const auto& key : fixture.keys_)
+        keys.emplace_back(key.c_str());
+
+    while (_state.keep_running())
+    {
+        for (const auto& key : keys)
+        {
+            const auto value = snapshot.find(key);
+            do_not_optimize(value && (value->flags_ & omicronlib::snapshot_value::is_int) ? value->int_ : 0);
+        }
+    }
+
+    _state.set_items_processed(_state.get_iterations() * looked_up_count());
+});
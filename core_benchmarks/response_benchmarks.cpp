@@ -0,0 +1,165 @@
+#include "stdafx.h"
+
+#include "benchmark.h"
+#include "data_generator.h"
+
+#include "../core/connections/wim/response_sax_handler.h"
+#include "../core/tools/binary_stream.h"
+#include "../common.shared/string_utils.h"
+
+using namespace core;
+using namespace benchmarks;
+
+namespace
+{
+    constexpr int32_t events_count() noexcept { return 500; }
+    constexpr size_t chunk_size() noexcept { return 16 * 1024; }
+
+    // a fetch response of a client catching up after a long offline
+    std::string make_fetch_response(data_generator& _generator)
+    {
+        std::string response = "{\"response\":{\"statusCode\":200,\"statusText\":\"OK\",\"data\":{\"events\":[";
+        for (int32_t i = 0; i < events_count(); ++i)
+        {
+            if (i > 0)
+                response += ',';
+
+            response += su::concat("{\"type\":\"histDlgState\",\"seqNum\":", std::to_string(i), ",\"eventData\":{\"sn\":\"", _generator.aimid(),
+                "\",\"lastMsgId\":", std::to_string(_generator.number(1, std::numeric_limits<int32_t>::max())),
+                ",\"unreadCnt\":", std::to_string(_generator.number(0, 20)),
+                ",\"messages\":[{\"msgId\":", std::to_string(_generator.number(1, std::numeric_limits<int32_t>::max())),
+                ",\"time\":", std::to_string(_generator.number(1600000000, 1700000000)),
+                ",\"wid\":\"", std::to_string(_generator.number(1, 1000000)),
+                "\",\"text\":\"", _generator.message_text(), "\"}]}}");
+        }
+        response += "],\"fetchBaseURL\":\"https://example.net/fetchEvents\",\"ts\":1650000000,\"timeToNextFetch\":500}}}";
+        return response;
+    }
+
+    struct response_fixture
+    {
+        std::string data_;
+        tools::binary_stream compressed_;
+
+        response_fixture()
+        {
+            data_generator generator;
+            data_ = make_fetch_response(generator);
+            tools::compress_gzip(data_.data(), data_.size(), compressed_);
+        }
+    };
+
+    const response_fixture& get_response_fixture()
+    {
+        static const response_fixture fixture;
+        return fixture;
+    }
+
+    // what fetch looks up in every event
+    bool touch_event(const rapidjson::Value& _event)
+    {
+        const auto it = _event.FindMember("eventData");
+        do_not_optimize(it);
+        return it != _event.MemberEnd();
+    }
+
+    int32_t parse_dom(char* _json)
+    {
+        rapidjson::Document doc;
+        if (doc.ParseInsitu(_json).HasParseError())
+            return 0;
+
+        int32_t count = 0;
+        for (const auto& event : doc["response"]["data"]["events"].GetArray())
+            count += touch_event(event);
+        return count;
+    }
+}
+
+CORE_BENCHMARK("wim/response/parse_dom", [](state& _state)
+{
+    const auto& fixture = get_response_fixture();
+
+    std::string json;
+    int32_t count = 0;
+    while (_state.keep_running())
+    {
+        json = fixture.data_;
+        count += parse_dom(json.data());
+    }
+    do_not_optimize(count);
+
+    _state.set_bytes_processed(_state.get_iterations() * int64_t(fixture.data_.size()));
+    _state.set_items_processed(_state.get_iterations() * events_count());
+});
+
+CORE_BENCHMARK("wim/response/parse_sax_by_event", [](state& _state)
+{
+    const auto& fixture = get_response_fixture();
+
+    int32_t count = 0;
+    while (_state.keep_running())
+    {
+        wim::response_array_sax_handler handler("events", [&count](const rapidjson::Value& _event) { count += touch_event(_event); return true; });
+        wim::response_sax_filter filter(handler, wim::response_envelope::wim);
+        rapidjson::StringStream stream(fixture.data_.c_str());
+        rapidjson::Reader reader;
+        reader.Parse(stream, filter);
+        do_not_optimize(handler.get_data());
+    }
+    do_not_optimize(count);
+
+    _state.set_bytes_processed(_state.get_iterations() * int64_t(fixture.data_.size()));
+    _state.set_items_processed(_state.get_iterations() * events_count());
+});
+
+// the former path: the whole gzip body is received, inflated into a second buffer and parsed into a DOM
+CORE_BENCHMARK("wim/response/gzip_inflate_then_dom", [](state& _state)
+{
+    const auto& fixture = get_response_fixture();
+
+    int32_t count = 0;
+    while (_state.keep_running())
+    {
+        tools::binary_stream received;
+        const auto data = fixture.compressed_.get_data();
+        const auto size = size_t(fixture.compressed_.available());
+        for (size_t offset = 0; offset < size; offset += chunk_size())
+            received.write(data + offset, int64_t(std::min(chunk_size(), size - offset)));
+
+        tools::binary_stream inflated;
+        tools::decompress_gzip(received, inflated);
+        inflated.write((char) 0);
+        count += parse_dom(inflated.read(inflated.available()));
+    }
+    do_not_optimize(count);
+
+    _state.set_bytes_processed(_state.get_iterations() * int64_t(fixture.data_.size()));
+    _state.set_items_processed(_state.get_iterations() * events_count());
+});
+
+// the streaming path: every received chunk is inflated and parsed right away, nothing is kept
+CORE_BENCHMARK("wim/response/gzip_streamed_sax", [](state& _state)
+{
+    const auto& fixture = get_response_fixture();
+
+    int32_t count = 0;
+    while (_state.keep_running())
+    {
+        wim::response_array_sax_handler handler("events", [&count](const rapidjson::Value& _event) { count += touch_event(_event); return true; });
+        wim::response_stream_parser parser(handler, wim::response_envelope::wim);
+        const auto on_output = [&parser](const char* _data, size_t _size) { parser.push(_data, _size); };
+
+        tools::gzip_inflater inflater;
+        const auto data = fixture.compressed_.get_data();
+        const auto size = size_t(fixture.compressed_.available());
+        for (size_t offset = 0; offset < size; offset += chunk_size())
+            inflater.write(data + offset, std::min(chunk_size(), size - offset), on_output);
+
+        parser.finish();
+    }
+    do_not_optimize(count);
+
+    _state.set_bytes_processed(_state.get_iterations() * int64_t(fixture.data_.size()));
+    _state.set_items_processed(_state.get_iterations() * events_count());
+});
@@ -0,0 +1,147 @@
+#include "stdafx.h"
+
+#include "benchmark.h"
+#include "data_generator.h"
+
+#include "../common.shared/message_processing/message_tokenizer.h"
+#include "../common.shared/url_parser/url_parser.h"
+#include "../core/tools/system.h"
+#include "../core/tools/unicode.h"
+
+using namespace core;
+using namespace benchmarks;
+
+namespace
+{
+    constexpr size_t texts_count() noexcept { return 1000; }
+    constexpr std::string_view files_url() noexcept { return "files.example.net/get"; }
+
+    std::vector<std::string> make_texts()
+    {
+        data_generator generator;
+
+        std::vector<std::string> texts(texts_count());
+        for (auto& text : texts)
+            text = generator.message_text();
+        return texts;
+    }
+
+    int64_t total_size(const std::vector<std::string>& _texts)
+    {
+        return std::accumulate(_texts.begin(), _texts.end(), int64_t(0), [](int64_t _size, const auto& _text) { return _size + int64_t(_text.size()); });
+    }
+
+    // the symbol tables of the archive search map a character at a time
+    std::vector<std::string> make_chars(const std::vector<std::string>& _texts)
+    {
+        std::vector<std::string> chars;
+        for (const auto& text : _texts)
+        {
+            size_t pos = 0;
+            while (pos < text.size())
+            {
+                const auto start = pos;
+                (void)tools::unicode::decode_utf8(text, pos);
+                chars.emplace_back(text, start, pos - start);
+            }
+        }
+        return chars;
+    }
+}
+
+CORE_BENCHMARK("common/url_parser/parse_urls", [](state& _state)
+{
+    const auto texts = make_texts();
+    const std::string files(files_url());
+
+    while (_state.keep_running())
+    {
+        for (const auto& text : texts)
+            do_not_optimize(common::tools::url_parser::parse_urls(text, files));
+    }
+
+    _state.set_bytes_processed(_state.get_iterations() * total_size(texts));
+    _state.set_items_processed(_state.get_iterations() * int64_t(texts.size()));
+});
+
+CORE_BENCHMARK("common/message_tokenizer/tokenize", [](state& _state)
+{
+    const auto texts = make_texts();
+    const std::string files(files_url());
+
+    std::vector<common::tools::tokenizer_string> utf16_texts;
+    utf16_texts.reserve(texts.size());
+    for (const auto& text : texts)
+        utf16_texts.push_back(boost::locale::conv::utf_to_utf<common::tools::tokenizer_char>(text));
+
+    while (_state.keep_running())
+    {
+        for (const auto& text : utf16_texts)
+        {
+            common::tools::message_tokenizer tokenizer(text, files, {});
+            while (tokenizer.has_token())
+            {
+                do_not_optimize(tokenizer.current());
+                tokenizer.next();
+            }
+        }
+    }
+
+    _state.set_bytes_processed(_state.get_iterations() * total_size(texts));
+    _state.set_items_processed(_state.get_iterations() * int64_t(texts.size()));
+});
+
+// the former case mapping: a round trip through a wide string into towupper/CharUpperW/NSString
+CORE_BENCHMARK("tools/unicode/to_upper/system", [](state& _state)
+{
+    const auto texts = make_texts();
+
+    while (_state.keep_running())
+    {
+        for (const auto& text : texts)
+            do_not_optimize(tools::system::to_upper(text));
+    }
+
+    _state.set_bytes_processed(_state.get_iterations() * total_size(texts));
+    _state.set_items_processed(_state.get_iterations() * int64_t(texts.size()));
+});
+
+CORE_BENCHMARK("tools/unicode/to_upper/tables", [](state& _state)
+{
+    const auto texts = make_texts();
+
+    while (_state.keep_running())
+    {
+        for (const auto& text : texts)
+            do_not_optimize(tools::unicode::to_upper(text));
+    }
+
+    _state.set_bytes_processed(_state.get_iterations() * total_size(texts));
+    _state.set_items_processed(_state.get_iterations() * int64_t(texts.size()));
+});
+
+CORE_BENCHMARK("tools/unicode/to_lower_chars/system", [](state& _state)
+{
+    const auto chars = make_chars(make_texts());
+
+    while (_state.keep_running())
+    {
+        for (const auto& c : chars)
+            do_not_optimize(tools::system::to_lower(c));
+    }
+
+    _state.set_items_processed(_state.get_iterations() * int64_t(chars.size()));
+});
+
+CORE_BENCHMARK("tools/unicode/to_lower_chars/tables", [](state& _state)
+{
+    const auto chars = make_chars(make_texts());
+
+    while (_state.keep_running())
+    {
+        for (const auto& c : chars)
+            do_not_optimize(tools::unicode::to_lower(c));
+    }
+
+    _state.set_items_processed(_state.get_iterations() * int64_t(chars.size()));
+});
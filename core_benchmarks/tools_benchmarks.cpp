@@ -0,0 +1,248 @@
+#include "stdafx.h"
+
+#include "benchmark.h"
+#include "data_generator.h"
+
+#include "../core/tools/binary_stream.h"
+#include "../core/tools/threadpool.h"
+#include "../core/tools/tlv.h"
+#include "../common.shared/string_utils.h"
+#ifndef STRIP_ZSTD
+#include "../core/zstd_helper.h"
+#endif
+
+using namespace core;
+using namespace benchmarks;
+
+namespace
+{
+    constexpr int32_t records_count() noexcept { return 10000; }
+    constexpr uint32_t tlv_fields_count() noexcept { return 32; }
+    constexpr int32_t tasks_count() noexcept { return 1000; }
+
+    // fields of the sizes found in the archive: numbers, ids and texts
+    tools::tlvpack make_pack(data_generator& _generator)
+    {
+        tools::tlvpack pack;
+        for (uint32_t type = 1; type <= tlv_fields_count(); ++type)
+        {
+            switch (type % 4)
+            {
+            case 0:
+                pack.push_child(tools::tlv(type, int32_t(_generator.number(0, 1000))));
+                break;
+            case 1:
+                pack.push_child(tools::tlv(type, int64_t(_generator.number(0, std::numeric_limits<int32_t>::max()) * 1000)));
+                break;
+            case 2:
+                pack.push_child(tools::tlv(type, _generator.aimid()));
+                break;
+            default:
+                pack.push_child(tools::tlv(type, _generator.message_text()));
+                break;
+            }
+        }
+        return pack;
+    }
+
+#ifndef STRIP_ZSTD
+    // a fetch response of the size the client receives while syncing
+    std::string make_response(data_generator& _generator)
+    {
+        std::string response = "{\"status\":{\"code\":200},\"response\":{\"data\":{\"events\":[";
+        for (int i = 0; i < 50; ++i)
+        {
+            if (i > 0)
+                response += ',';
+
+            response += su::concat("{\"type\":\"histDlgState\",\"eventData\":{\"sn\":\"", _generator.aimid(),
+                "\",\"lastMsgId\":", std::to_string(_generator.number(1, std::numeric_limits<int32_t>::max())),
+                ",\"unreadCnt\":", std::to_string(_generator.number(0, 20)),
+                ",\"messages\":[{\"msgId\":", std::to_string(_generator.number(1, std::numeric_limits<int32_t>::max())),
+                ",\"time\":", std::to_string(_generator.number(1600000000, 1700000000)),
+                ",\"wid\":\"", std::to_string(_generator.number(1, 1000000)),
+                "\",\"text\":\"", _generator.text(1, 12), "\"}]}}");
+        }
+        response += "]}}}";
+        return response;
+    }
+
+    struct zstd_fixture
+    {
+        temp_folder folder_;
+        std::shared_ptr<zstd_helper> helper_ = std::make_shared<zstd_helper>(folder_.get_path());
+        std::string dict_ = helper_->get_last_response_dict();
+        std::string data_;
+        std::string compressed_;
+
+        zstd_fixture()
+        {
+            data_generator generator;
+            data_ = make_response(generator);
+
+            compressed_.resize(data_.size() * 2);
+            size_t written = 0;
+            helper_->compress(data_.data(), data_.size(), compressed_.data(), compressed_.size(), &written, dict_);
+            compressed_.resize(written);
+        }
+    };
+
+    zstd_fixture& get_zstd_fixture()
+    {
+        static zstd_fixture fixture;
+        return fixture;
+    }
+#endif
+}
+
+CORE_BENCHMARK("tools/binary_stream/write", [](state& _state)
+{
+    tools::binary_stream stream;
+    const std::string text = data_generator().text(8, 8);
+
+    while (_state.keep_running())
+    {
+        stream.reset();
+        for (int32_t i = 0; i < records_count(); ++i)
+        {
+            stream.write<int32_t>(i);
+            stream.write<int64_t>(int64_t(i) << 20);
+            stream.write<uint32_t>(uint32_t(text.size()));
+            stream.write(text.data(), int64_t(text.size()));
+        }
+        do_not_optimize(stream);
+    }
+
+    _state.set_bytes_processed(_state.get_iterations() * stream.available());
+    _state.set_items_processed(_state.get_iterations() * records_count());
+});
+
+CORE_BENCHMARK("tools/binary_stream/read", [](state& _state)
+{
+    tools::binary_stream stream;
+    const std::string text = data_generator().text(8, 8);
+    for (int32_t i = 0; i < records_count(); ++i)
+    {
+        stream.write<int32_t>(i);
+        stream.write<int64_t>(int64_t(i) << 20);
+        stream.write<uint32_t>(uint32_t(text.size()));
+        stream.write(text.data(), int64_t(text.size()));
+    }
+    const auto size = stream.available();
+
+    int64_t sum = 0;
+    while (_state.keep_running())
+    {
+        stream.reset_out();
+        for (int32_t i = 0; i < records_count(); ++i)
+        {
+            sum += stream.read<int32_t>();
+            sum += stream.read<int64_t>();
+            const auto text_size = stream.read<uint32_t>();
+            sum += *stream.read(text_size);
+        }
+    }
+    do_not_optimize(sum);
+
+    _state.set_bytes_processed(_state.get_iterations() * size);
+    _state.set_items_processed(_state.get_iterations() * records_count());
+});
+
+CORE_BENCHMARK("tools/tlvpack/serialize", [](state& _state)
+{
+    data_generator generator;
+    const auto pack = make_pack(generator);
+
+    tools::binary_stream stream;
+    while (_state.keep_running())
+    {
+        stream.reset();
+        pack.serialize(stream);
+        do_not_optimize(stream);
+    }
+
+    _state.set_bytes_processed(_state.get_iterations() * stream.available());
+    _state.set_items_processed(_state.get_iterations() * tlv_fields_count());
+});
+
+CORE_BENCHMARK("tools/tlvpack/unserialize", [](state& _state)
+{
+    data_generator generator;
+    tools::binary_stream stream;
+    make_pack(generator).serialize(stream);
+    const auto size = stream.available();
+
+    while (_state.keep_running())
+    {
+        stream.reset_out();
+
+        tools::tlvpack pack;
+        pack.unserialize(stream);
+        for (uint32_t type = 1; type <= tlv_fields_count(); ++type)
+            do_not_optimize(pack.get_item(type));
+    }
+
+    _state.set_bytes_processed(_state.get_iterations() * size);
+    _state.set_items_processed(_state.get_iterations() * tlv_fields_count());
+});
+
+#ifndef STRIP_ZSTD
+CORE_BENCHMARK("tools/zstd_helper/compress", [](state& _state)
+{
+    const auto& fixture = get_zstd_fixture();
+
+    std::string out(fixture.data_.size() * 2, '\0');
+    while (_state.keep_running())
+    {
+        size_t written = 0;
+        fixture.helper_->compress(fixture.data_.data(), fixture.data_.size(), out.data(), out.size(), &written, fixture.dict_);
+        do_not_optimize(written);
+    }
+
+    _state.set_bytes_processed(_state.get_iterations() * int64_t(fixture.data_.size()));
+});
+
+CORE_BENCHMARK("tools/zstd_helper/decompress", [](state& _state)
+{
+    const auto& fixture = get_zstd_fixture();
+
+    std::string out(fixture.data_.size(), '\0');
+    while (_state.keep_running())
+    {
+        size_t written = 0;
+        fixture.helper_->decompress(fixture.compressed_.data(), fixture.compressed_.size(), out.data(), out.size(), &written, fixture.dict_);
+        do_not_optimize(written);
+    }
+
+    _state.set_bytes_processed(_state.get_iterations() * int64_t(fixture.data_.size()));
+});
+#endif
+
+// a burst of small tasks, like the archive and network callbacks pushed while syncing
+CORE_BENCHMARK("tools/threadpool/dispatch", [](state& _state)
+{
+    tools::threadpool pool("benchmark", std::max(2u, std::thread::hardware_concurrency() / 2));
+
+    std::mutex mutex;
+    std::condition_variable finished;
+    int32_t done = 0;
+
+    while (_state.keep_running())
+    {
+        done = 0;
+        for (int32_t i = 0; i < tasks_count(); ++i)
+        {
+            pool.push_back({ [&mutex, &finished, &done]()
+            {
+                std::scoped_lock lock(mutex);
+                if (++done == tasks_count())
+                    finished.notify_one();
+            } });
+        }
+
+        std::unique_lock lock(mutex);
+        finished.wait(lock, [&done]() { return done == tasks_count(); });
+    }
+
+    _state.set_items_processed(_state.get_iterations() * tasks_count());
+});
@@ -0,0 +1,67 @@
+#include "stdafx.h"
+
+#include "benchmark.h"
+
+#include "../core/profiling/trace.h"
+
+using namespace core;
+using namespace benchmarks;
+
+namespace
+{
+    // a pair is two events, well below the per thread limit, so no iteration runs into dropping
+    constexpr int64_t pairs_per_iteration() noexcept { return 1000; }
+
+    void record_pairs(state& _state, bool _enabled)
+    {
+        profiler::trace::set_enabled(_enabled);
+
+        while (_state.keep_running())
+        {
+            _state.pause_timing();
+            profiler::trace::reset();
+            _state.resume_timing();
+
+            for (int64_t i = 0; i < pairs_per_iteration(); ++i)
+            {
+                profiler::trace::begin("benchmark/span");
+                profiler::trace::end("benchmark/span");
+            }
+        }
+
+        profiler::trace::set_enabled(false);
+        profiler::trace::reset();
+
+        _state.set_items_processed(_state.get_iterations() * pairs_per_iteration() * 2);
+    }
+
+    // scopes named at runtime, as the core dispatcher opens for every gui message
+    void record_interned_scopes(state& _state)
+    {
+        const std::vector<std::string> names = { "archive/messages/get", "dlg_state/hide", "contacts/search", "stickers/get" };
+
+        profiler::trace::set_enabled(true);
+
+        while (_state.keep_running())
+        {
+            _state.pause_timing();
+            profiler::trace::reset();
+            _state.resume_timing();
+
+            for (int64_t i = 0; i < pairs_per_iteration(); ++i)
+                profiler::trace::scope scope{ std::string_view(names[i % names.size()]) };
+        }
+
+        profiler::trace::set_enabled(false);
+        profiler::trace::reset();
+
+        _state.set_items_processed(_state.get_iterations() * pairs_per_iteration() * 2);
+    }
+}
+
+// what every instrumented task pays in a build without dev.trace_events
+CORE_BENCHMARK("profiler/trace/event/disabled", [](state& _state) { record_pairs(_state, false); });
+
+CORE_BENCHMARK("profiler/trace/event/enabled", [](state& _state) { record_pairs(_state, true); });
+
+CORE_BENCHMARK("profiler/trace/scope_interned", [](state& _state) { record_interned_scopes(_state); });
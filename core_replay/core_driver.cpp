@@ -0,0 +1,148 @@
+#include "stdafx.h"
+
+#include "core_driver.h"
+
+#include "../corelib/corelib.h"
+#include "../corelib/collection_helper.h"
+
+using namespace core;
+using namespace replay;
+
+core_driver::core_driver() = default;
+
+core_driver::~core_driver()
+{
+    stop();
+}
+
+void core_driver::set_observer(observer_function _observer)
+{
+    observer_ = std::move(_observer);
+}
+
+bool core_driver::start()
+{
+    if (!get_core_instance(&core_face_) || !core_face_)
+        return false;
+
+    core_connector_ = core_face_->get_core_connector();
+    if (!core_connector_)
+        return false;
+
+    core_connector_->link(this, common::core_gui_settings(48, "replay", "en"));
+    return true;
+}
+
+void core_driver::stop()
+{
+    if (core_connector_)
+    {
+        core_connector_->unlink();
+        core_connector_->release();
+        core_connector_ = nullptr;
+    }
+
+    if (core_face_)
+    {
+        core_face_->release();
+        core_face_ = nullptr;
+    }
+}
+
+int64_t core_driver::post(std::string_view _message, const fill_function& _fill)
+{
+    im_assert(core_connector_);
+
+    ifptr<icore_factory> factory(core_face_->get_factory());
+    coll_helper collection(factory->create_collection(), true);
+    if (_fill)
+        _fill(collection);
+
+    const auto seq = ++seq_;
+    core_connector_->receive(_message, seq, collection.get());
+    return seq;
+}
+
+bool core_driver::wait(const std::function<bool()>& _condition, std::chrono::milliseconds _quiet, std::chrono::milliseconds _timeout)
+{
+    const auto deadline = std::chrono::steady_clock::now() + _timeout;
+
+    std::unique_lock lock(mutex_);
+    while (true)
+    {
+        const auto now = std::chrono::steady_clock::now();
+        if (now >= deadline)
+            return false;
+
+        // the condition may ask the driver itself, so it is checked without the lock
+        lock.unlock();
+        const auto satisfied = _condition();
+        lock.lock();
+
+        if (satisfied)
+        {
+            const auto quiet_until = last_message_time_ + _quiet;
+            if (now >= quiet_until)
+                return true;
+
+            received_.wait_until(lock, std::min(quiet_until, deadline));
+        }
+        else
+        {
+            received_.wait_until(lock, std::min(now + std::chrono::milliseconds(100), deadline));
+        }
+    }
+}
+
+bool core_driver::is_answered(int64_t _seq) const
+{
+    std::scoped_lock lock(mutex_);
+    return answered_.find(_seq) != answered_.end();
+}
+
+std::map<std::string, int64_t> core_driver::get_messages_counts() const
+{
+    std::scoped_lock lock(mutex_);
+    return messages_counts_;
+}
+
+std::chrono::steady_clock::time_point core_driver::get_last_message_time() const
+{
+    std::scoped_lock lock(mutex_);
+    return last_message_time_;
+}
+
+int32_t core_driver::addref()
+{
+    return ++ref_count_;
+}
+
+int32_t core_driver::release()
+{
+    return --ref_count_;
+}
+
+void core_driver::link(iconnector*, const common::core_gui_settings&)
+{
+}
+
+void core_driver::unlink()
+{
+}
+
+void core_driver::receive(std::string_view _message, int64_t _seq, icollection* _data)
+{
+    // the observer goes first, so whatever it records is in place once the seq is seen as answered
+    if (observer_)
+        observer_(_message, _seq, _data);
+
+    {
+        std::scoped_lock lock(mutex_);
+        ++messages_counts_[std::string(_message)];
+        last_message_time_ = std::chrono::steady_clock::now();
+        if (_seq > 0)
+            answered_.insert(_seq);
+    }
+
+    received_.notify_all();
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "../corelib/core_face.h"
+
+namespace core
+{
+    class coll_helper;
+
+    namespace replay
+    {
+        // the gui side of the corelib connection: posts messages to the core
+        // and counts the messages the core sends to the gui
+        class core_driver : public iconnector
+        {
+        public:
+            using fill_function = std::function<void(coll_helper&)>;
+            using observer_function = std::function<void(std::string_view _message, int64_t _seq, icollection* _data)>;
+
+            core_driver();
+            ~core_driver();
+
+            // called on the core thread for every message to the gui, set it before start()
+            void set_observer(observer_function _observer);
+
+            bool start();
+            void stop();
+
+            int64_t post(std::string_view _message, const fill_function& _fill = {});
+
+            // waits until _condition holds and the core has sent nothing to the gui for _quiet;
+            // false on timeout
+            bool wait(const std::function<bool()>& _condition, std::chrono::milliseconds _quiet, std::chrono::milliseconds _timeout);
+
+            bool is_answered(int64_t _seq) const;
+
+            std::map<std::string, int64_t> get_messages_counts() const;
+            std::chrono::steady_clock::time_point get_last_message_time() const;
+
+        private:
+            // ibase interface, the driver is owned by the harness
+            int32_t addref() override;
+            int32_t release() override;
+
+            // iconnector interface
+            void link(iconnector*, const common::core_gui_settings&) override;
+            void unlink() override;
+            void receive(std::string_view _message, int64_t _seq, icollection* _data) override;
+
+        private:
+            icore_interface* core_face_ = nullptr;
+            iconnector* core_connector_ = nullptr;
+
+            observer_function observer_;
+
+            std::atomic<int32_t> ref_count_ = 1;
+            std::atomic<int64_t> seq_ = 0;
+
+            mutable std::mutex mutex_;
+            std::condition_variable received_;
+            std::map<std::string, int64_t> messages_counts_;
+            std::unordered_set<int64_t> answered_;
+            std::chrono::steady_clock::time_point last_message_time_ = std::chrono::steady_clock::now();
+        };
+    }
+}
@@ -0,0 +1,474 @@
+#include "stdafx.h"
+
+#include "core_driver.h"
+#include "metrics.h"
+#include "replay_server.h"
+#include "wim_stand_in.h"
+
+#include "../corelib/collection_helper.h"
+#include "../core/tools/strings.h"
+#include "../core/tools/system.h"
+#include "../core/utils.h"
+
+using namespace core;
+using namespace replay;
+
+namespace
+{
+    struct options
+    {
+        scenario scenario_;
+        int32_t open_chats_ = 10;
+        int32_t scroll_pages_ = 2;
+        int32_t page_size_ = 50;
+        std::string search_ = "deadline";
+        std::wstring profile_;
+        std::chrono::milliseconds quiet_ = std::chrono::milliseconds(500);
+        std::chrono::seconds timeout_ = std::chrono::seconds(120);
+        std::string out_file_;
+        bool json_ = false;
+    };
+
+    std::optional<std::string_view> get_option(std::string_view _arg, std::string_view _name)
+    {
+        if (_arg.size() > _name.size() && _arg.substr(0, _name.size()) == _name && _arg[_name.size()] == '=')
+            return _arg.substr(_name.size() + 1);
+
+        return std::nullopt;
+    }
+
+    int32_t to_int(std::string_view _value, int32_t _min)
+    {
+        return std::max(_min, std::atoi(std::string(_value).c_str()));
+    }
+
+    bool parse_options(int _argc, char* _argv[], options& _options)
+    {
+        for (int i = 1; i < _argc; ++i)
+        {
+            const std::string_view arg = _argv[i];
+
+            if (const auto value = get_option(arg, "--contacts"))
+                _options.scenario_.contacts_ = to_int(*value, 1);
+            else if (const auto value = get_option(arg, "--messages"))
+                _options.scenario_.messages_per_chat_ = to_int(*value, 1);
+            else if (const auto value = get_option(arg, "--seed"))
+                _options.scenario_.seed_ = uint32_t(to_int(*value, 0));
+            else if (const auto value = get_option(arg, "--responses"))
+                _options.scenario_.responses_dir_ = tools::from_utf8(*value);
+            else if (const auto value = get_option(arg, "--open"))
+                _options.open_chats_ = to_int(*value, 0);
+            else if (const auto value = get_option(arg, "--scroll_pages"))
+                _options.scroll_pages_ = to_int(*value, 0);
+            else if (const auto value = get_option(arg, "--search"))
+                _options.search_ = *value;
+            else if (const auto value = get_option(arg, "--profile"))
+                _options.profile_ = tools::from_utf8(*value);
+            else if (const auto value = get_option(arg, "--quiet_ms"))
+                _options.quiet_ = std::chrono::milliseconds(to_int(*value, 1));
+            else if (const auto value = get_option(arg, "--timeout_s"))
+                _options.timeout_ = std::chrono::seconds(to_int(*value, 1));
+            else if (const auto value = get_option(arg, "--format"))
+                _options.json_ = (*value == "json");
+            else if (const auto value = get_option(arg, "--out"))
+                _options.out_file_ = *value;
+            else
+                return false;
+        }
+
+        return true;
+    }
+
+    void print_usage()
+    {
+        std::cout << "usage: core_replay [--contacts=1000] [--messages=100] [--seed=42] [--responses=<dir>] [--open=10] [--scroll_pages=2] "
+            "[--search=deadline] [--profile=<dir>] [--quiet_ms=500] [--timeout_s=120] [--format=text|json] [--out=<file>]\n";
+    }
+
+    // points the core at the stand-in server: the profile is taken from HOME, so the run
+    // neither sees nor touches the profile of the user
+    bool prepare_profile(const std::wstring& _profile, const std::string& _server_address)
+    {
+#ifdef _WIN32
+        // the windows profile comes from the shell folders and can't be redirected
+        (void)_profile;
+        (void)_server_address;
+        return false;
+#else
+        if (!tools::system::create_directory(_profile))
+            return false;
+
+        ::setenv("HOME", tools::from_utf16(_profile).c_str(), 1);
+
+        const auto data_path = utils::get_product_data_path();
+        if (!tools::system::create_directory(data_path))
+            return false;
+
+        const auto ini_path = boost::filesystem::wpath(data_path) / L"app.ini";
+        std::ofstream ini(ini_path.string(), std::ios_base::out | std::ios_base::trunc);
+        if (!ini.is_open())
+            return false;
+
+        ini << "[dev]\n"
+            << "replay_server=" << _server_address << '\n'
+            << "net_compression=false\n";
+
+        return ini.good();
+#endif // _WIN32
+    }
+
+    class temp_profile
+    {
+    public:
+        explicit temp_profile(std::wstring _path)
+            : path_(std::move(_path))
+        {
+        }
+
+        ~temp_profile()
+        {
+            boost::system::error_code error;
+            boost::filesystem::remove_all(path_, error);
+        }
+
+        temp_profile(const temp_profile&) = delete;
+        temp_profile& operator=(const temp_profile&) = delete;
+
+    private:
+        std::wstring path_;
+    };
+
+    // the counters of a phase are the difference between the values at its end and at its start
+    class phase_probe
+    {
+    public:
+        phase_probe(std::string_view _name, const std::wstring& _profile, const replay_server& _server, const core_driver& _driver)
+            : profile_(_profile)
+            , server_(_server)
+            , driver_(_driver)
+        {
+            metrics_.name_ = _name;
+            start_time_ = std::chrono::steady_clock::now();
+            start_cpu_time_ = get_process_cpu_time();
+            start_allocations_ = get_allocation_counters();
+            start_disk_bytes_ = get_folder_size(profile_);
+            start_server_ = server_.get_counters();
+            start_messages_ = driver_.get_messages_counts();
+        }
+
+        phase_metrics finish(bool _completed)
+        {
+            // the end of the phase is the last message to the gui, not the end of the quiet period after it
+            const auto end_time = _completed ? std::max(start_time_, driver_.get_last_message_time()) : std::chrono::steady_clock::now();
+
+            const auto allocations = get_allocation_counters();
+            const auto server = server_.get_counters();
+
+            metrics_.completed_ = _completed;
+            metrics_.wall_time_ = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time_);
+            metrics_.cpu_time_ = std::chrono::duration_cast<std::chrono::milliseconds>(get_process_cpu_time() - start_cpu_time_);
+            metrics_.allocations_ = allocations.count_ - start_allocations_.count_;
+            metrics_.allocated_bytes_ = allocations.bytes_ - start_allocations_.bytes_;
+            metrics_.disk_bytes_ = get_folder_size(profile_) - start_disk_bytes_;
+            metrics_.requests_ = server.requests_ - start_server_.requests_;
+            metrics_.bytes_received_ = server.bytes_received_ - start_server_.bytes_received_;
+            metrics_.bytes_sent_ = server.bytes_sent_ - start_server_.bytes_sent_;
+
+            for (const auto& [name, count] : driver_.get_messages_counts())
+            {
+                const auto it = start_messages_.find(name);
+                const auto delta = count - (it == start_messages_.end() ? 0 : it->second);
+                if (delta > 0)
+                {
+                    metrics_.gui_messages_by_name_[name] = delta;
+                    metrics_.gui_messages_ += delta;
+                }
+            }
+
+            return metrics_;
+        }
+
+    private:
+        const std::wstring& profile_;
+        const replay_server& server_;
+        const core_driver& driver_;
+
+        phase_metrics metrics_;
+        std::chrono::steady_clock::time_point start_time_;
+        std::chrono::microseconds start_cpu_time_;
+        allocation_counters start_allocations_;
+        int64_t start_disk_bytes_ = 0;
+        server_counters start_server_;
+        std::map<std::string, int64_t> start_messages_;
+    };
+
+    void write_text(std::ostream& _out, const std::vector<phase_metrics>& _phases)
+    {
+        _out << std::left << std::setw(12) << "phase" << std::right
+            << std::setw(10) << "wall ms" << std::setw(10) << "cpu ms"
+            << std::setw(12) << "allocs" << std::setw(14) << "alloc bytes"
+            << std::setw(12) << "disk bytes" << std::setw(10) << "requests"
+            << std::setw(12) << "req bytes" << std::setw(12) << "resp bytes"
+            << std::setw(10) << "to gui" << '\n';
+
+        for (const auto& p : _phases)
+        {
+            _out << std::left << std::setw(12) << p.name_ << std::right
+                << std::setw(10) << p.wall_time_.count() << std::setw(10) << p.cpu_time_.count()
+                << std::setw(12) << p.allocations_ << std::setw(14) << p.allocated_bytes_
+                << std::setw(12) << p.disk_bytes_ << std::setw(10) << p.requests_
+                << std::setw(12) << p.bytes_received_ << std::setw(12) << p.bytes_sent_
+                << std::setw(10) << p.gui_messages_
+                << (p.completed_ ? "" : "  timed out") << '\n';
+        }
+
+        for (const auto& p : _phases)
+        {
+            _out << '\n' << p.name_ << " messages to gui:\n";
+            for (const auto& [name, count] : p.gui_messages_by_name_)
+                _out << "    " << std::left << std::setw(48) << name << std::right << count << '\n';
+        }
+    }
+
+    void write_json(std::ostream& _out, const options& _options, const std::vector<phase_metrics>& _phases)
+    {
+        rapidjson::StringBuffer buffer;
+        rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+
+        writer.StartObject();
+
+        writer.Key("scenario");
+        writer.StartObject();
+        writer.Key("contacts");
+        writer.Int(_options.scenario_.contacts_);
+        writer.Key("messages_per_chat");
+        writer.Int(_options.scenario_.messages_per_chat_);
+        writer.Key("open_chats");
+        writer.Int(_options.open_chats_);
+        writer.Key("scroll_pages");
+        writer.Int(_options.scroll_pages_);
+        writer.Key("search");
+        writer.String(_options.search_.c_str(), rapidjson::SizeType(_options.search_.size()));
+        writer.Key("seed");
+        writer.Uint(_options.scenario_.seed_);
+#ifdef GIT_COMMIT_HASH
+        writer.Key("git_commit");
+        writer.String(GIT_COMMIT_HASH);
+#endif
+        writer.EndObject();
+
+        writer.Key("phases");
+        writer.StartArray();
+        for (const auto& p : _phases)
+        {
+            writer.StartObject();
+            writer.Key("name");
+            writer.String(p.name_.c_str(), rapidjson::SizeType(p.name_.size()));
+            writer.Key("completed");
+            writer.Bool(p.completed_);
+            writer.Key("wall_time_ms");
+            writer.Int64(p.wall_time_.count());
+            writer.Key("cpu_time_ms");
+            writer.Int64(p.cpu_time_.count());
+            writer.Key("allocations");
+            writer.Int64(p.allocations_);
+            writer.Key("allocated_bytes");
+            writer.Int64(p.allocated_bytes_);
+            writer.Key("disk_bytes");
+            writer.Int64(p.disk_bytes_);
+            writer.Key("requests");
+            writer.Int64(p.requests_);
+            writer.Key("request_bytes");
+            writer.Int64(p.bytes_received_);
+            writer.Key("response_bytes");
+            writer.Int64(p.bytes_sent_);
+            writer.Key("gui_messages");
+            writer.Int64(p.gui_messages_);
+            writer.Key("gui_messages_by_name");
+            writer.StartObject();
+            for (const auto& [name, count] : p.gui_messages_by_name_)
+            {
+                writer.Key(name.c_str(), rapidjson::SizeType(name.size()));
+                writer.Int64(count);
+            }
+            writer.EndObject();
+            writer.EndObject();
+        }
+        writer.EndArray();
+
+        writer.EndObject();
+
+        _out << std::string_view(buffer.GetString(), buffer.GetSize()) << '\n';
+    }
+}
+
+int main(int _argc, char* _argv[])
+{
+#ifdef _WIN32
+    // the windows profile comes from the shell folders and can't be redirected,
+    // the run would write app.ini and the account into the profile of the user
+    std::cerr << "core_replay doesn't run on windows" << std::endl;
+    return 1;
+#else
+    options opts;
+    if (!parse_options(_argc, _argv, opts))
+    {
+        print_usage();
+        return 1;
+    }
+
+    // a profile made for the run is removed at the exit, the one given with --profile is kept
+    std::optional<temp_profile> profile;
+    if (opts.profile_.empty())
+    {
+        opts.profile_ = (boost::filesystem::temp_directory_path() / boost::filesystem::unique_path(L"core_replay-%%%%-%%%%-%%%%")).wstring();
+        profile.emplace(opts.profile_);
+    }
+
+    wim_stand_in stand_in(opts.scenario_);
+    replay_server server([&stand_in](const http_request& _request) { return stand_in.handle(_request); });
+    if (!server.start())
+    {
+        std::cerr << "can't start the server" << std::endl;
+        return 1;
+    }
+
+    if (!prepare_profile(opts.profile_, server.get_address()))
+    {
+        std::cerr << "can't prepare the profile " << tools::from_utf16(opts.profile_) << std::endl;
+        return 1;
+    }
+
+    std::atomic<bool> login_succeeded = false;
+
+    core_driver driver;
+    driver.set_observer([&login_succeeded](std::string_view _message, int64_t, icollection* _data)
+    {
+        if (_message == "login_result" && _data)
+            login_succeeded = coll_helper(_data, false).get_value_as_bool("result", false);
+    });
+
+    if (!driver.start())
+    {
+        std::cerr << "can't start the core" << std::endl;
+        return 1;
+    }
+
+    const auto counts_of = [&driver](const std::string& _message)
+    {
+        const auto counts = driver.get_messages_counts();
+        const auto it = counts.find(_message);
+        return it == counts.end() ? int64_t(0) : it->second;
+    };
+
+    std::vector<phase_metrics> phases;
+    bool ok = true;
+
+    // login: from the password to the first fetch
+    {
+        phase_probe probe("login", opts.profile_, server, driver);
+        const auto seq = driver.post("login_by_password", [&stand_in](coll_helper& _coll)
+        {
+            _coll.set_value_as_string("login", stand_in.get_login());
+            _coll.set_value_as_string("password", stand_in.get_password());
+            _coll.set_value_as_bool("save_auth_data", true);
+        });
+
+        ok = driver.wait([&]() { return driver.is_answered(seq) && counts_of("login/complete") > 0; }, opts.quiet_, opts.timeout_) && login_succeeded;
+        phases.push_back(probe.finish(ok));
+    }
+
+    // full sync: the contact list and the dialog states of all the chats
+    if (ok)
+    {
+        phase_probe probe("sync", opts.profile_, server, driver);
+        ok = driver.wait([&stand_in]() { return stand_in.is_sync_served(); }, opts.quiet_, opts.timeout_);
+        phases.push_back(probe.finish(ok));
+    }
+
+    // open chats: the latest page, the gallery state and the file metainfo the way the dialog does,
+    // then a few pages up
+    if (ok)
+    {
+        phase_probe probe("open_chats", opts.profile_, server, driver);
+
+        const auto chats = stand_in.get_chats();
+        const auto count = std::min(size_t(opts.open_chats_), chats.size());
+        for (size_t i = 0; i < count && ok; ++i)
+        {
+            const auto& aimid = chats[i];
+
+            driver.post("dialogs/add", [&aimid](coll_helper& _coll) { _coll.set_value_as_string("contact", aimid); });
+
+            const auto request_page = [&driver, &aimid, &opts](int64_t _from, bool _first)
+            {
+                return driver.post("archive/messages/get", [&aimid, &opts, _from, _first](coll_helper& _coll)
+                {
+                    _coll.set_value_as_string("contact", aimid);
+                    _coll.set_value_as_int64("from", _from);
+                    _coll.set_value_as_int64("count_early", opts.page_size_);
+                    _coll.set_value_as_int64("count_later", 0);
+                    _coll.set_value_as_bool("need_prefetch", true);
+                    _coll.set_value_as_bool("is_first_request", _first);
+                    _coll.set_value_as_bool("after_search", false);
+                });
+            };
+
+            const auto seq = request_page(-1, true);
+
+            driver.post("request_gallery_state", [&aimid](coll_helper& _coll) { _coll.set_value_as_string("aimid", aimid); });
+
+            for (const auto& url : stand_in.get_file_urls(aimid, opts.page_size_))
+                driver.post("files/download/metainfo", [&url](coll_helper& _coll) { _coll.set_value_as_string("url", url); });
+
+            ok = driver.wait([&driver, seq]() { return driver.is_answered(seq); }, opts.quiet_, opts.timeout_);
+
+            for (int32_t page = 1; page <= opts.scroll_pages_ && ok; ++page)
+            {
+                if (page * opts.page_size_ >= opts.scenario_.messages_per_chat_)
+                    break;
+
+                const auto from = stand_in.get_last_msg_id() - int64_t(page) * opts.page_size_ + 1;
+                const auto page_seq = request_page(from, false);
+                ok = driver.wait([&driver, page_seq]() { return driver.is_answered(page_seq); }, opts.quiet_, opts.timeout_);
+            }
+        }
+
+        phases.push_back(probe.finish(ok));
+    }
+
+    // search: through the local history of the opened chats
+    if (ok && !opts.search_.empty())
+    {
+        phase_probe probe("search", opts.profile_, server, driver);
+
+        const auto seq = driver.post("dialogs/search/local", [&opts](coll_helper& _coll) { _coll.set_value_as_string("keyword", opts.search_); });
+        ok = driver.wait([&driver, seq]() { return driver.is_answered(seq); }, opts.quiet_, opts.timeout_);
+        phases.push_back(probe.finish(ok));
+
+        driver.post("dialogs/search/local/end");
+    }
+
+    driver.stop();
+    server.stop();
+
+    std::ofstream file;
+    if (!opts.out_file_.empty())
+    {
+        file.open(opts.out_file_, std::ios_base::out | std::ios_base::trunc);
+        if (!file.is_open())
+        {
+            std::cerr << "can't open " << opts.out_file_ << std::endl;
+            return 1;
+        }
+    }
+
+    std::ostream& out = file.is_open() ? static_cast<std::ostream&>(file) : std::cout;
+    if (opts.json_)
+        write_json(out, opts, phases);
+    else
+        write_text(out, phases);
+
+    return ok ? 0 : 2;
+#endif // _WIN32
+}
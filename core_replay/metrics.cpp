@@ -0,0 +1,115 @@
+#include "stdafx.h"
+
+#include "metrics.h"
+
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
+
+using namespace core;
+using namespace replay;
+
+namespace
+{
+    std::atomic<int64_t> allocations_count = 0;
+    std::atomic<int64_t> allocated_bytes = 0;
+}
+
+void* operator new(std::size_t _size)
+{
+    allocations_count.fetch_add(1, std::memory_order_relaxed);
+    allocated_bytes.fetch_add(int64_t(_size), std::memory_order_relaxed);
+
+    if (auto p = std::malloc(_size ? _size : 1))
+        return p;
+
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t _size)
+{
+    return operator new(_size);
+}
+
+void* operator new(std::size_t _size, const std::nothrow_t&) noexcept
+{
+    try
+    {
+        return operator new(_size);
+    }
+    catch (const std::bad_alloc&)
+    {
+        return nullptr;
+    }
+}
+
+void* operator new[](std::size_t _size, const std::nothrow_t&) noexcept
+{
+    return operator new(_size, std::nothrow);
+}
+
+void operator delete(void* _p) noexcept
+{
+    std::free(_p);
+}
+
+void operator delete[](void* _p) noexcept
+{
+    std::free(_p);
+}
+
+void operator delete(void* _p, std::size_t) noexcept
+{
+    std::free(_p);
+}
+
+void operator delete[](void* _p, std::size_t) noexcept
+{
+    std::free(_p);
+}
+
+allocation_counters core::replay::get_allocation_counters() noexcept
+{
+    allocation_counters counters;
+    counters.count_ = allocations_count.load(std::memory_order_relaxed);
+    counters.bytes_ = allocated_bytes.load(std::memory_order_relaxed);
+    return counters;
+}
+
+std::chrono::microseconds core::replay::get_process_cpu_time()
+{
+#ifdef _WIN32
+    FILETIME creation_time, exit_time, kernel_time, user_time;
+    if (!::GetProcessTimes(::GetCurrentProcess(), &creation_time, &exit_time, &kernel_time, &user_time))
+        return std::chrono::microseconds::zero();
+
+    const auto to_100ns = [](const FILETIME& _time) { return (uint64_t(_time.dwHighDateTime) << 32) | _time.dwLowDateTime; };
+    return std::chrono::microseconds((to_100ns(kernel_time) + to_100ns(user_time)) / 10);
+#else
+    rusage usage = {};
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+        return std::chrono::microseconds::zero();
+
+    const auto to_microseconds = [](const timeval& _time) { return int64_t(_time.tv_sec) * 1000000 + _time.tv_usec; };
+    return std::chrono::microseconds(to_microseconds(usage.ru_utime) + to_microseconds(usage.ru_stime));
+#endif
+}
+
+int64_t core::replay::get_folder_size(const std::wstring& _path)
+{
+    int64_t size = 0;
+
+    boost::system::error_code error;
+    for (boost::filesystem::recursive_directory_iterator it(_path, error), end; !error && it != end; it.increment(error))
+    {
+        if (boost::filesystem::is_regular_file(it->status()))
+        {
+            if (const auto file_size = boost::filesystem::file_size(it->path(), error); !error)
+                size += int64_t(file_size);
+
+            error.clear();
+        }
+    }
+
+    return size;
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+namespace core
+{
+    namespace replay
+    {
+        struct allocation_counters
+        {
+            int64_t count_ = 0;
+            int64_t bytes_ = 0;
+        };
+
+        // counted by the replaced global operator new of the harness, so only the allocations
+        // of the code linked into the executable are seen (all of the core with static corelib)
+        allocation_counters get_allocation_counters() noexcept;
+
+        std::chrono::microseconds get_process_cpu_time();
+
+        int64_t get_folder_size(const std::wstring& _path);
+
+        struct phase_metrics
+        {
+            std::string name_;
+            bool completed_ = false;
+
+            std::chrono::milliseconds wall_time_ = std::chrono::milliseconds::zero();
+            std::chrono::milliseconds cpu_time_ = std::chrono::milliseconds::zero();
+
+            int64_t allocations_ = 0;
+            int64_t allocated_bytes_ = 0;
+
+            // growth of the profile folder
+            int64_t disk_bytes_ = 0;
+
+            int64_t requests_ = 0;
+            int64_t bytes_received_ = 0;
+            int64_t bytes_sent_ = 0;
+
+            int64_t gui_messages_ = 0;
+            std::map<std::string, int64_t> gui_messages_by_name_;
+        };
+    }
+}
@@ -0,0 +1,306 @@
+#include "stdafx.h"
+
+#include "replay_server.h"
+
+#include "../common.shared/string_utils.h"
+
+using namespace core;
+using namespace replay;
+
+using boost::asio::ip::tcp;
+
+namespace
+{
+    std::string_view get_reason(int32_t _status) noexcept
+    {
+        switch (_status)
+        {
+        case 200:
+            return "OK";
+        case 404:
+            return "Not Found";
+        case 411:
+            return "Length Required";
+        default:
+            return "Error";
+        }
+    }
+
+    // an accept that keeps failing, e.g. when the process is out of descriptors, is retried
+    // with a growing pause and given up after max_accept_errors in a row
+    constexpr auto min_accept_pause = std::chrono::milliseconds(10);
+    constexpr auto max_accept_pause = std::chrono::seconds(1);
+    constexpr int max_accept_errors = 20;
+
+    std::string take_from_buffer(boost::asio::streambuf& _buffer, size_t _size)
+    {
+        const auto begin = boost::asio::buffers_begin(_buffer.data());
+        std::string result(begin, begin + _size);
+        _buffer.consume(_size);
+        return result;
+    }
+}
+
+std::string_view http_request::get_header(std::string_view _name) const
+{
+    if (const auto it = headers_.find(std::string(_name)); it != headers_.end())
+        return it->second;
+
+    return {};
+}
+
+std::string_view http_request::get_query_param(std::string_view _name) const
+{
+    std::string_view query = query_;
+    while (!query.empty())
+    {
+        const auto end = query.find('&');
+        const auto param = query.substr(0, end);
+        if (const auto eq = param.find('='); eq != std::string_view::npos && param.substr(0, eq) == _name)
+            return param.substr(eq + 1);
+
+        if (end == std::string_view::npos)
+            break;
+
+        query.remove_prefix(end + 1);
+    }
+
+    return {};
+}
+
+replay_server::replay_server(request_handler _handler)
+    : handler_(std::move(_handler))
+    , acceptor_(io_context_)
+{
+}
+
+replay_server::~replay_server()
+{
+    stop();
+}
+
+bool replay_server::start()
+{
+    boost::system::error_code error;
+    const tcp::endpoint endpoint(boost::asio::ip::address_v4::loopback(), 0);
+
+    acceptor_.open(endpoint.protocol(), error);
+    if (!error)
+        acceptor_.bind(endpoint, error);
+    if (!error)
+        acceptor_.listen(boost::asio::socket_base::max_listen_connections, error);
+    if (error)
+        return false;
+
+    port_ = acceptor_.local_endpoint(error).port();
+    if (error)
+        return false;
+
+    accept_thread_ = std::thread([this]() { accept_connections(); });
+    return true;
+}
+
+void replay_server::stop()
+{
+    if (stopped_.exchange(true) || !accept_thread_.joinable())
+        return;
+
+    // a blocking accept is not interrupted by close on every platform, so wake it up with a connection
+    {
+        boost::system::error_code error;
+        tcp::socket socket(io_context_);
+        socket.connect(tcp::endpoint(boost::asio::ip::address_v4::loopback(), port_), error);
+    }
+    accept_thread_.join();
+
+    boost::system::error_code error;
+    acceptor_.close(error);
+
+    std::vector<connection> connections;
+    {
+        std::scoped_lock lock(connections_mutex_);
+        for (auto& c : connections_)
+        {
+            c.socket_->shutdown(tcp::socket::shutdown_both, error);
+            c.socket_->close(error);
+        }
+        connections.swap(connections_);
+    }
+
+    for (auto& c : connections)
+        c.thread_.join();
+}
+
+std::string replay_server::get_address() const
+{
+    return su::concat("127.0.0.1:", std::to_string(port_));
+}
+
+server_counters replay_server::get_counters() const noexcept
+{
+    server_counters counters;
+    counters.requests_ = requests_;
+    counters.bytes_received_ = bytes_received_;
+    counters.bytes_sent_ = bytes_sent_;
+    return counters;
+}
+
+void replay_server::accept_connections()
+{
+    int errors = 0;
+    auto pause = min_accept_pause;
+
+    while (!stopped_)
+    {
+        auto socket = std::make_shared<tcp::socket>(io_context_);
+
+        boost::system::error_code error;
+        acceptor_.accept(*socket, error);
+        if (stopped_)
+            break;
+
+        if (error)
+        {
+            if (++errors >= max_accept_errors)
+            {
+                std::cerr << "replay server: accept failed " << errors << " times, last: " << error.message() << std::endl;
+                break;
+            }
+
+            std::this_thread::sleep_for(pause);
+            pause = std::min<std::chrono::milliseconds>(pause * 2, max_accept_pause);
+            continue;
+        }
+
+        errors = 0;
+        pause = min_accept_pause;
+
+        socket->set_option(tcp::no_delay(true), error);
+
+        auto closed = std::make_shared<std::atomic<bool>>(false);
+
+        std::scoped_lock lock(connections_mutex_);
+        reap_connections();
+        connections_.push_back({ socket, std::thread([this, socket, closed]()
+        {
+            serve(socket);
+            *closed = true;
+        }), closed });
+    }
+}
+
+void replay_server::reap_connections()
+{
+    const auto it = std::partition(connections_.begin(), connections_.end(), [](const connection& _c) { return !*_c.closed_; });
+    for (auto c = it; c != connections_.end(); ++c)
+        c->thread_.join();
+
+    connections_.erase(it, connections_.end());
+}
+
+void replay_server::serve(std::shared_ptr<tcp::socket> _socket)
+{
+    boost::asio::streambuf buffer;
+    while (!stopped_)
+    {
+        http_request request;
+        if (!read_request(*_socket, buffer, request))
+            break;
+
+        ++requests_;
+
+        http_response response;
+        if (request.body_.size() == 0 && !request.get_header("transfer-encoding").empty())
+        {
+            response.status_ = 411;
+            response.content_type_ = "text/plain";
+        }
+        else
+        {
+            response = handler_(request);
+        }
+
+        write_response(*_socket, response);
+
+        if (boost::algorithm::iequals(request.get_header("connection"), "close"))
+            break;
+    }
+
+    boost::system::error_code error;
+    _socket->shutdown(tcp::socket::shutdown_both, error);
+}
+
+bool replay_server::read_request(tcp::socket& _socket, boost::asio::streambuf& _buffer, http_request& _request)
+{
+    boost::system::error_code error;
+    const auto header_size = boost::asio::read_until(_socket, _buffer, "\r\n\r\n", error);
+    if (error)
+        return false;
+
+    std::istringstream lines(take_from_buffer(_buffer, header_size));
+
+    std::string line;
+    if (!std::getline(lines, line))
+        return false;
+
+    std::string target;
+    std::istringstream(line) >> _request.method_ >> target;
+    if (const auto query = target.find('?'); query != std::string::npos)
+    {
+        _request.path_ = target.substr(0, query);
+        _request.query_ = target.substr(query + 1);
+    }
+    else
+    {
+        _request.path_ = std::move(target);
+    }
+
+    while (std::getline(lines, line))
+    {
+        if (!line.empty() && line.back() == '\r')
+            line.pop_back();
+
+        if (line.empty())
+            break;
+
+        if (const auto colon = line.find(':'); colon != std::string::npos)
+            _request.headers_[boost::algorithm::to_lower_copy(line.substr(0, colon))] = boost::algorithm::trim_copy(line.substr(colon + 1));
+    }
+
+    if (boost::algorithm::iequals(_request.get_header("expect"), "100-continue"))
+    {
+        constexpr std::string_view continue_response = "HTTP/1.1 100 Continue\r\n\r\n";
+        boost::asio::write(_socket, boost::asio::buffer(continue_response.data(), continue_response.size()), error);
+        if (error)
+            return false;
+    }
+
+    size_t content_length = 0;
+    if (const auto length = _request.get_header("content-length"); !length.empty())
+        std::from_chars(length.data(), length.data() + length.size(), content_length);
+
+    if (_buffer.size() < content_length)
+        boost::asio::read(_socket, _buffer, boost::asio::transfer_exactly(content_length - _buffer.size()), error);
+    if (error)
+        return false;
+
+    _request.body_ = take_from_buffer(_buffer, content_length);
+
+    bytes_received_ += int64_t(header_size + content_length);
+    return true;
+}
+
+void replay_server::write_response(tcp::socket& _socket, const http_response& _response)
+{
+    const auto head = su::concat("HTTP/1.1 ", std::to_string(_response.status_), ' ', get_reason(_response.status_),
+        "\r\nContent-Type: ", _response.content_type_,
+        "\r\nContent-Length: ", std::to_string(_response.body_.size()),
+        "\r\nConnection: keep-alive\r\n\r\n");
+
+    const std::array<boost::asio::const_buffer, 2> buffers = { boost::asio::buffer(head), boost::asio::buffer(_response.body_) };
+
+    boost::system::error_code error;
+    boost::asio::write(_socket, buffers, error);
+
+    bytes_sent_ += int64_t(head.size() + _response.body_.size());
+}
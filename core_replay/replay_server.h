@@ -0,0 +1,86 @@
+#pragma once
+
+namespace core
+{
+    namespace replay
+    {
+        struct http_request
+        {
+            std::string method_;
+            std::string path_;
+            std::string query_;
+            std::string body_;
+
+            // header names are lower case
+            std::unordered_map<std::string, std::string> headers_;
+
+            std::string_view get_header(std::string_view _name) const;
+            std::string_view get_query_param(std::string_view _name) const;
+        };
+
+        struct http_response
+        {
+            int32_t status_ = 200;
+            std::string content_type_ = "application/json";
+            std::string body_;
+        };
+
+        using request_handler = std::function<http_response(const http_request&)>;
+
+        struct server_counters
+        {
+            int64_t requests_ = 0;
+            int64_t bytes_received_ = 0;
+            int64_t bytes_sent_ = 0;
+        };
+
+        // a plain http/1.1 server on the loopback interface, one thread per keep-alive connection;
+        // the core reaches it through the dev.replay_server option of app.ini
+        class replay_server
+        {
+        public:
+            explicit replay_server(request_handler _handler);
+            ~replay_server();
+
+            bool start();
+            void stop();
+
+            // host:port to put in app.ini
+            std::string get_address() const;
+
+            server_counters get_counters() const noexcept;
+
+        private:
+            void accept_connections();
+            // joins the threads of the closed connections, connections_mutex_ is held
+            void reap_connections();
+            void serve(std::shared_ptr<boost::asio::ip::tcp::socket> _socket);
+            bool read_request(boost::asio::ip::tcp::socket& _socket, boost::asio::streambuf& _buffer, http_request& _request);
+            void write_response(boost::asio::ip::tcp::socket& _socket, const http_response& _response);
+
+        private:
+            request_handler handler_;
+
+            boost::asio::io_context io_context_;
+            boost::asio::ip::tcp::acceptor acceptor_;
+            uint16_t port_ = 0;
+
+            std::thread accept_thread_;
+            std::atomic<bool> stopped_ = false;
+
+            struct connection
+            {
+                std::shared_ptr<boost::asio::ip::tcp::socket> socket_;
+                std::thread thread_;
+                std::shared_ptr<std::atomic<bool>> closed_;
+            };
+
+            std::mutex connections_mutex_;
+            std::vector<connection> connections_;
+
+            std::atomic<int64_t> requests_ = 0;
+            std::atomic<int64_t> bytes_received_ = 0;
+            std::atomic<int64_t> bytes_sent_ = 0;
+        };
+    }
+}
@@ -0,0 +1,637 @@
+#include "stdafx.h"
+
+#include "wim_stand_in.h"
+
+#include "../common.shared/json_helper.h"
+#include "../common.shared/string_utils.h"
+#include "../core/tools/binary_stream.h"
+#include "../core_benchmarks/data_generator.h"
+
+using namespace core;
+using namespace replay;
+
+namespace
+{
+    using json_writer = rapidjson::Writer<rapidjson::StringBuffer>;
+
+    constexpr int64_t first_msg_id() noexcept { return 1000; }
+    constexpr int32_t file_message_percent() noexcept { return 5; }
+    constexpr int32_t next_fetch_timeout_ms() noexcept { return 1000; }
+
+    constexpr std::string_view fetch_base_url() noexcept { return "https://u.icq.net/bos/replay/aim/fetchEvents"; }
+    constexpr std::string_view files_url() noexcept { return "https://files.icq.net/get/"; }
+
+    void write_string(json_writer& _writer, std::string_view _value)
+    {
+        _writer.String(_value.data(), rapidjson::SizeType(_value.size()));
+    }
+
+    void write_member(json_writer& _writer, std::string_view _name, std::string_view _value)
+    {
+        write_string(_writer, _name);
+        write_string(_writer, _value);
+    }
+
+    void write_member(json_writer& _writer, std::string_view _name, const char* _value)
+    {
+        write_member(_writer, _name, std::string_view(_value));
+    }
+
+    void write_member(json_writer& _writer, std::string_view _name, int64_t _value)
+    {
+        write_string(_writer, _name);
+        _writer.Int64(_value);
+    }
+
+    void write_member(json_writer& _writer, std::string_view _name, bool _value)
+    {
+        write_string(_writer, _name);
+        _writer.Bool(_value);
+    }
+
+    template <typename F>
+    std::string wim_response(F&& _write_data)
+    {
+        rapidjson::StringBuffer buffer;
+        json_writer writer(buffer);
+
+        writer.StartObject();
+        write_string(writer, "response");
+        writer.StartObject();
+        write_member(writer, "statusCode", int64_t(200));
+        write_member(writer, "statusText", "OK");
+        write_string(writer, "data");
+        writer.StartObject();
+        _write_data(writer);
+        writer.EndObject();
+        writer.EndObject();
+        writer.EndObject();
+
+        return rapidjson_get_string(buffer);
+    }
+
+    template <typename F>
+    std::string rapi_response(F&& _write_results)
+    {
+        rapidjson::StringBuffer buffer;
+        json_writer writer(buffer);
+
+        writer.StartObject();
+        write_string(writer, "status");
+        writer.StartObject();
+        write_member(writer, "code", int64_t(20000));
+        writer.EndObject();
+        write_string(writer, "results");
+        writer.StartObject();
+        _write_results(writer);
+        writer.EndObject();
+        writer.EndObject();
+
+        return rapidjson_get_string(buffer);
+    }
+
+    std::optional<std::string> read_file(const boost::filesystem::path& _path)
+    {
+        boost::system::error_code error;
+        if (!boost::filesystem::is_regular_file(_path, error))
+            return std::nullopt;
+
+        tools::binary_stream bs;
+        if (!bs.load_from_file(_path.wstring()))
+            return std::nullopt;
+
+        const auto size = bs.available();
+        if (size == 0)
+            return std::string();
+
+        return std::string(bs.read(size), size_t(size));
+    }
+
+    std::string get_file_id(int32_t _index, int64_t _msg_id)
+    {
+        // 'h' is not an image, video or ptt prefix, so the core treats the link as a plain file
+        std::stringstream id;
+        id << 'h' << std::hex << std::setfill('0') << std::setw(8) << _index << std::setw(24) << _msg_id;
+        return id.str();
+    }
+}
+
+wim_stand_in::wim_stand_in(scenario _scenario)
+    : scenario_(std::move(_scenario))
+    , start_time_(std::chrono::system_clock::to_time_t(std::chrono::system_clock::now()))
+{
+}
+
+http_response wim_stand_in::handle(const http_request& _request)
+{
+    const auto endpoint = get_endpoint(_request);
+
+    http_response response;
+    if (auto recorded = get_recorded_response(endpoint))
+    {
+        response.body_ = std::move(*recorded);
+        return response;
+    }
+
+    if (endpoint == "clientLogin")
+        response.body_ = client_login();
+    else if (endpoint == "startSession")
+        response.body_ = start_session();
+    else if (endpoint == "fetchEvents")
+        response.body_ = fetch_events();
+    else if (endpoint == "getHistory")
+        response.body_ = get_history(_request);
+    else if (endpoint == "getEntryGallery")
+        response.body_ = get_entry_gallery(_request);
+    else if (endpoint == "filesInfo")
+        response.body_ = files_info(_request);
+    else if (_request.path_.find("/rapi/") != std::string::npos)
+        response.body_ = rapi_response([](json_writer&) {});
+    else if (_request.path_.find("/wim/") != std::string::npos || _request.path_.find("/aim/") != std::string::npos)
+        response.body_ = wim_response([](json_writer&) {});
+    else
+        response.status_ = 404;
+
+    return response;
+}
+
+std::string wim_stand_in::get_login() const
+{
+    return "replay@icq.net";
+}
+
+std::string wim_stand_in::get_password() const
+{
+    return "replay";
+}
+
+std::vector<std::string> wim_stand_in::get_chats() const
+{
+    std::vector<std::string> chats;
+    chats.reserve(scenario_.contacts_);
+    for (int32_t i = 0; i < scenario_.contacts_; ++i)
+        chats.push_back(get_aimid(i));
+
+    return chats;
+}
+
+std::vector<std::string> wim_stand_in::get_file_urls(const std::string& _aimid, int32_t _count) const
+{
+    std::vector<std::string> urls;
+
+    const auto index = get_index(_aimid);
+    if (index < 0)
+        return urls;
+
+    const auto last_msg_id = get_last_msg_id();
+    for (auto msg_id = last_msg_id; msg_id > last_msg_id - _count && msg_id >= first_msg_id(); --msg_id)
+    {
+        if (is_file_message(index, msg_id))
+            urls.push_back(su::concat(files_url(), get_file_id(index, msg_id)));
+    }
+
+    return urls;
+}
+
+bool wim_stand_in::is_sync_served() const
+{
+    std::scoped_lock lock(mutex_);
+    return dlg_states_sent_ >= scenario_.contacts_;
+}
+
+std::string wim_stand_in::get_endpoint(const http_request& _request) const
+{
+    if (_request.path_.find("/files/info/") != std::string::npos)
+        return "filesInfo";
+
+    std::string_view path = _request.path_;
+    while (!path.empty() && path.back() == '/')
+        path.remove_suffix(1);
+
+    if (const auto slash = path.rfind('/'); slash != std::string_view::npos)
+        path.remove_prefix(slash + 1);
+
+    return std::string(path);
+}
+
+std::optional<std::string> wim_stand_in::get_recorded_response(const std::string& _endpoint)
+{
+    if (scenario_.responses_dir_.empty() || _endpoint.empty())
+        return std::nullopt;
+
+    const boost::filesystem::path dir(scenario_.responses_dir_);
+    const auto numbered = [&dir, &_endpoint](int32_t _n) { return dir / su::concat(_endpoint, '.', std::to_string(_n), ".json"); };
+
+    // the numbered files in order, then the last of them again and again
+    std::scoped_lock lock(mutex_);
+    auto& next = recorded_served_[_endpoint];
+    if (auto response = read_file(numbered(next)))
+    {
+        ++next;
+        return response;
+    }
+
+    if (next > 0)
+        return read_file(numbered(next - 1));
+
+    return read_file(dir / su::concat(_endpoint, ".json"));
+}
+
+std::string wim_stand_in::client_login()
+{
+    return wim_response([this](json_writer& _writer)
+    {
+        write_member(_writer, "hostTime", start_time_);
+        write_member(_writer, "sessionSecret", "replay");
+        write_string(_writer, "token");
+        _writer.StartObject();
+        write_member(_writer, "expiresIn", int64_t(365 * 24 * 60 * 60));
+        write_member(_writer, "a", "replay-token");
+        _writer.EndObject();
+    });
+}
+
+std::string wim_stand_in::start_session()
+{
+    std::string aimsid;
+    int64_t seq = 0;
+    {
+        std::scoped_lock lock(mutex_);
+        aimsid_ = su::concat("replay.", std::to_string(scenario_.seed_));
+        aimsid = aimsid_;
+        seq = fetch_seq_;
+    }
+
+    return wim_response([this, &aimsid, seq](json_writer& _writer)
+    {
+        write_member(_writer, "ts", start_time_);
+        write_member(_writer, "aimsid", aimsid);
+        write_member(_writer, "fetchBaseURL", su::concat(fetch_base_url(), "?aimsid=", aimsid, "&seqNum=", std::to_string(seq)));
+        write_string(_writer, "myInfo");
+        _writer.StartObject();
+        write_member(_writer, "aimId", get_login());
+        _writer.EndObject();
+    });
+}
+
+std::string wim_stand_in::fetch_events()
+{
+    int64_t seq = 0;
+    int32_t first_dlg_state = 0;
+    int32_t dlg_states_count = 0;
+    std::string aimsid;
+    {
+        std::scoped_lock lock(mutex_);
+        seq = fetch_seq_++;
+        aimsid = aimsid_;
+        if (seq > 0)
+        {
+            first_dlg_state = dlg_states_sent_;
+            dlg_states_count = std::min(scenario_.dlg_states_per_fetch_, scenario_.contacts_ - dlg_states_sent_);
+            dlg_states_sent_ += dlg_states_count;
+        }
+    }
+
+    const auto last_msg_id = get_last_msg_id();
+
+    return wim_response([&](json_writer& _writer)
+    {
+        write_member(_writer, "fetchBaseURL", su::concat(fetch_base_url(), "?aimsid=", aimsid, "&seqNum=", std::to_string(seq + 1)));
+        write_member(_writer, "ts", start_time_ + seq);
+        write_member(_writer, "timeToNextFetch", int64_t(dlg_states_count > 0 || seq == 0 ? 0 : next_fetch_timeout_ms()));
+
+        write_string(_writer, "events");
+        _writer.StartArray();
+
+        if (seq == 0)
+        {
+            // the account itself and the contact list come with the first fetch
+            _writer.StartObject();
+            write_member(_writer, "type", "myInfo");
+            write_string(_writer, "eventData");
+            _writer.StartObject();
+            write_member(_writer, "aimId", get_login());
+            write_member(_writer, "friendly", "Replay");
+            write_member(_writer, "state", "online");
+            write_member(_writer, "userType", "icq");
+            _writer.EndObject();
+            _writer.EndObject();
+
+            _writer.StartObject();
+            write_member(_writer, "type", "buddylist");
+            write_string(_writer, "eventData");
+            _writer.StartObject();
+            write_string(_writer, "groups");
+            _writer.StartArray();
+            _writer.StartObject();
+            write_member(_writer, "id", int64_t(1));
+            write_member(_writer, "name", "General");
+            write_string(_writer, "buddies");
+            _writer.StartArray();
+            for (int32_t i = 0; i < scenario_.contacts_; ++i)
+            {
+                _writer.StartObject();
+                write_member(_writer, "aimId", get_aimid(i));
+                write_member(_writer, "friendly", su::concat("Contact ", std::to_string(i)));
+                write_member(_writer, "userType", "icq");
+                write_member(_writer, "state", i % 4 == 0 ? "online" : "offline");
+                _writer.EndObject();
+            }
+            _writer.EndArray();
+            _writer.EndObject();
+            _writer.EndArray();
+            _writer.EndObject();
+            _writer.EndObject();
+        }
+
+        for (auto index = first_dlg_state; index < first_dlg_state + dlg_states_count; ++index)
+        {
+            const auto aimid = get_aimid(index);
+            const auto unread = index % 7 == 0 ? int64_t(index % 20) : int64_t(0);
+
+            _writer.StartObject();
+            write_member(_writer, "type", "histDlgState");
+            write_string(_writer, "eventData");
+            _writer.StartObject();
+            write_member(_writer, "sn", aimid);
+            write_member(_writer, "lastMsgId", last_msg_id);
+            write_member(_writer, "unreadCnt", unread);
+            write_member(_writer, "patchVersion", "1");
+
+            write_string(_writer, "yours");
+            _writer.StartObject();
+            write_member(_writer, "lastRead", last_msg_id - unread);
+            _writer.EndObject();
+
+            write_string(_writer, "theirs");
+            _writer.StartObject();
+            write_member(_writer, "lastRead", last_msg_id);
+            write_member(_writer, "lastDelivered", last_msg_id);
+            _writer.EndObject();
+
+            write_string(_writer, "tail");
+            _writer.StartObject();
+            write_string(_writer, "messages");
+            _writer.StartArray();
+            _writer.StartObject();
+            write_member(_writer, "msgId", last_msg_id);
+            write_member(_writer, "time", get_message_time(index, last_msg_id));
+            write_member(_writer, "outgoing", (last_msg_id - first_msg_id()) % 3 == 0);
+            write_member(_writer, "text", get_message_text(index, last_msg_id));
+            _writer.EndObject();
+            _writer.EndArray();
+            if (last_msg_id > first_msg_id())
+                write_member(_writer, "olderMsgId", last_msg_id - 1);
+            _writer.EndObject();
+
+            write_string(_writer, "persons");
+            _writer.StartArray();
+            _writer.StartObject();
+            write_member(_writer, "sn", aimid);
+            write_member(_writer, "friendly", su::concat("Contact ", std::to_string(index)));
+            _writer.EndObject();
+            _writer.EndArray();
+
+            _writer.EndObject();
+            _writer.EndObject();
+        }
+
+        _writer.EndArray();
+    });
+}
+
+std::string wim_stand_in::get_history(const http_request& _request)
+{
+    rapidjson::Document request;
+    request.Parse(_request.body_.c_str());
+
+    std::string aimid;
+    int64_t from_msg_id = -1;
+    int64_t till_msg_id = -1;
+    int64_t count = 0;
+
+    if (!request.HasParseError())
+    {
+        if (const auto params = request.FindMember("params"); params != request.MemberEnd() && params->value.IsObject())
+        {
+            tools::unserialize_value(params->value, "sn", aimid);
+            tools::unserialize_value(params->value, "fromMsgId", from_msg_id);
+            tools::unserialize_value(params->value, "tillMsgId", till_msg_id);
+            tools::unserialize_value(params->value, "count", count);
+        }
+    }
+
+    const auto index = get_index(aimid);
+    const auto last_msg_id = get_last_msg_id();
+
+    // the ids of the answer in the order the server sends them: newest first for the older pages
+    std::vector<int64_t> ids;
+    if (index >= 0 && count != 0)
+    {
+        const auto from = from_msg_id < 0 || from_msg_id > last_msg_id ? last_msg_id : from_msg_id;
+        if (count < 0)
+        {
+            for (auto id = from; id >= first_msg_id() && int64_t(ids.size()) < -count && id > till_msg_id; --id)
+                ids.push_back(id);
+        }
+        else
+        {
+            for (auto id = from; id <= last_msg_id && int64_t(ids.size()) < count; ++id)
+                ids.push_back(id);
+        }
+    }
+
+    return rapi_response([&](json_writer& _writer)
+    {
+        write_member(_writer, "lastMsgId", last_msg_id);
+        write_member(_writer, "patchVersion", "1");
+        write_member(_writer, "unreadCnt", int64_t(0));
+
+        if (!ids.empty())
+        {
+            const auto oldest = std::min(ids.front(), ids.back());
+            if (oldest > first_msg_id())
+                write_member(_writer, "olderMsgId", oldest - 1);
+        }
+
+        write_string(_writer, "yours");
+        _writer.StartObject();
+        write_member(_writer, "lastRead", last_msg_id);
+        _writer.EndObject();
+
+        write_string(_writer, "theirs");
+        _writer.StartObject();
+        write_member(_writer, "lastRead", last_msg_id);
+        write_member(_writer, "lastDelivered", last_msg_id);
+        _writer.EndObject();
+
+        write_string(_writer, "messages");
+        _writer.StartArray();
+        for (const auto id : ids)
+        {
+            _writer.StartObject();
+            write_member(_writer, "msgId", id);
+            write_member(_writer, "time", get_message_time(index, id));
+            write_member(_writer, "outgoing", (id - first_msg_id()) % 3 == 0);
+            write_member(_writer, "text", get_message_text(index, id));
+            _writer.EndObject();
+        }
+        _writer.EndArray();
+
+        write_string(_writer, "persons");
+        _writer.StartArray();
+        if (index >= 0)
+        {
+            _writer.StartObject();
+            write_member(_writer, "sn", aimid);
+            write_member(_writer, "friendly", su::concat("Contact ", std::to_string(index)));
+            _writer.EndObject();
+        }
+        _writer.EndArray();
+    });
+}
+
+std::string wim_stand_in::get_entry_gallery(const http_request& _request)
+{
+    rapidjson::Document request;
+    request.Parse(_request.body_.c_str());
+
+    std::string aimid;
+    if (!request.HasParseError())
+    {
+        if (const auto params = request.FindMember("params"); params != request.MemberEnd() && params->value.IsObject())
+            tools::unserialize_value(params->value, "sn", aimid);
+    }
+
+    const auto index = get_index(aimid);
+
+    std::vector<int64_t> file_ids;
+    if (index >= 0)
+    {
+        for (auto id = get_last_msg_id(); id >= first_msg_id(); --id)
+        {
+            if (is_file_message(index, id))
+                file_ids.push_back(id);
+        }
+    }
+
+    return rapi_response([&](json_writer& _writer)
+    {
+        write_string(_writer, "galleryState");
+        _writer.StartObject();
+        write_member(_writer, "galleryPatchVersion", "1");
+        write_string(_writer, "lastEntryId");
+        _writer.StartObject();
+        write_member(_writer, "mid", file_ids.empty() ? int64_t(0) : file_ids.front());
+        write_member(_writer, "seq", int64_t(0));
+        _writer.EndObject();
+        write_string(_writer, "itemsCount");
+        _writer.StartObject();
+        write_member(_writer, "image", int64_t(0));
+        write_member(_writer, "video", int64_t(0));
+        write_member(_writer, "file", int64_t(file_ids.size()));
+        write_member(_writer, "link", int64_t(0));
+        write_member(_writer, "ptt", int64_t(0));
+        write_member(_writer, "audio", int64_t(0));
+        _writer.EndObject();
+        _writer.EndObject();
+
+        write_string(_writer, "entries");
+        _writer.StartArray();
+        for (const auto id : file_ids)
+        {
+            _writer.StartObject();
+            write_string(_writer, "id");
+            _writer.StartObject();
+            write_member(_writer, "mid", id);
+            write_member(_writer, "seq", int64_t(0));
+            _writer.EndObject();
+            write_member(_writer, "type", "file");
+            write_member(_writer, "url", su::concat(files_url(), get_file_id(index, id)));
+            write_member(_writer, "sender", (id - first_msg_id()) % 3 == 0 ? get_login() : aimid);
+            write_member(_writer, "outgoing", (id - first_msg_id()) % 3 == 0);
+            write_member(_writer, "time", get_message_time(index, id));
+            write_member(_writer, "caption", "");
+            _writer.EndObject();
+        }
+        _writer.EndArray();
+    });
+}
+
+std::string wim_stand_in::files_info(const http_request& _request)
+{
+    std::string_view id = _request.path_;
+    while (!id.empty() && id.back() == '/')
+        id.remove_suffix(1);
+    if (const auto slash = id.rfind('/'); slash != std::string_view::npos)
+        id.remove_prefix(slash + 1);
+
+    rapidjson::StringBuffer buffer;
+    json_writer writer(buffer);
+
+    writer.StartObject();
+    write_string(writer, "status");
+    writer.StartObject();
+    write_member(writer, "code", int64_t(200));
+    writer.EndObject();
+    write_string(writer, "result");
+    writer.StartObject();
+    write_string(writer, "info");
+    writer.StartObject();
+    write_member(writer, "file_name", su::concat(id, ".txt"));
+    write_member(writer, "file_size", int64_t(1024 + id.size() * 512));
+    write_member(writer, "mime", "text/plain");
+    write_member(writer, "has_previews", false);
+    write_member(writer, "dlink", su::concat("https://files.icq.net/download/", id));
+    write_member(writer, "md5", "");
+    writer.EndObject();
+    write_string(writer, "extra");
+    writer.StartObject();
+    write_member(writer, "file_type", "text");
+    writer.EndObject();
+    writer.EndObject();
+    writer.EndObject();
+
+    return rapidjson_get_string(buffer);
+}
+
+std::string wim_stand_in::get_aimid(int32_t _index) const
+{
+    return std::to_string(700000000 + _index);
+}
+
+int32_t wim_stand_in::get_index(std::string_view _aimid) const
+{
+    int64_t value = 0;
+    if (const auto [p, error] = std::from_chars(_aimid.data(), _aimid.data() + _aimid.size(), value); error != std::errc() || p != _aimid.data() + _aimid.size())
+        return -1;
+
+    const auto index = value - 700000000;
+    return index >= 0 && index < scenario_.contacts_ ? int32_t(index) : -1;
+}
+
+int64_t wim_stand_in::get_last_msg_id() const
+{
+    return first_msg_id() + std::max(scenario_.messages_per_chat_, 1) - 1;
+}
+
+std::string wim_stand_in::get_message_text(int32_t _index, int64_t _msg_id) const
+{
+    if (is_file_message(_index, _msg_id))
+        return su::concat(files_url(), get_file_id(_index, _msg_id));
+
+    // a generator per message keeps the text independent of the order the pages are asked in
+    benchmarks::data_generator generator(scenario_.seed_ ^ uint32_t(_index * 7919) ^ uint32_t(_msg_id * 104729));
+    return generator.message_text();
+}
+
+bool wim_stand_in::is_file_message(int32_t _index, int64_t _msg_id) const
+{
+    return (uint64_t(_index) * 31 + uint64_t(_msg_id)) % 100 < uint64_t(file_message_percent());
+}
+
+int64_t wim_stand_in::get_message_time(int32_t _index, int64_t _msg_id) const
+{
+    // the most recent dialog has the most recent messages, one message a minute
+    return start_time_ - int64_t(_index) * 3600 - (get_last_msg_id() - _msg_id) * 60;
+}
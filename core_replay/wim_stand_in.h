@@ -0,0 +1,75 @@
+#pragma once
+
+#include "replay_server.h"
+
+namespace core
+{
+    namespace replay
+    {
+        struct scenario
+        {
+            int32_t contacts_ = 1000;
+            int32_t messages_per_chat_ = 100;
+            int32_t dlg_states_per_fetch_ = 200;
+            uint32_t seed_ = 42;
+
+            // <endpoint>.json or <endpoint>.<n>.json files served instead of the generated answers,
+            // numbered ones in order with the last one repeated; the endpoint is the last segment
+            // of the path (getHistory, fetchEvents, ...) or filesInfo for the files api
+            std::wstring responses_dir_;
+        };
+
+        // answers the requests of the core the way the server would for an account with
+        // scenario.contacts_ dialogs of scenario.messages_per_chat_ messages each;
+        // everything is generated from the seed, so two runs see the same account
+        class wim_stand_in
+        {
+        public:
+            explicit wim_stand_in(scenario _scenario);
+
+            http_response handle(const http_request& _request);
+
+            std::string get_login() const;
+            std::string get_password() const;
+
+            // dialogs in the order of the recents, the most recent first
+            std::vector<std::string> get_chats() const;
+
+            // file sharing links among the last _count messages of the chat
+            std::vector<std::string> get_file_urls(const std::string& _aimid, int32_t _count) const;
+
+            // all the dialog states are sent with fetchEvents
+            bool is_sync_served() const;
+
+            // the newest message of every chat, older messages have consecutive smaller ids
+            int64_t get_last_msg_id() const;
+
+        private:
+            std::string get_endpoint(const http_request& _request) const;
+            std::optional<std::string> get_recorded_response(const std::string& _endpoint);
+
+            std::string client_login();
+            std::string start_session();
+            std::string fetch_events();
+            std::string get_history(const http_request& _request);
+            std::string get_entry_gallery(const http_request& _request);
+            std::string files_info(const http_request& _request);
+
+            std::string get_aimid(int32_t _index) const;
+            int32_t get_index(std::string_view _aimid) const;
+            std::string get_message_text(int32_t _index, int64_t _msg_id) const;
+            bool is_file_message(int32_t _index, int64_t _msg_id) const;
+            int64_t get_message_time(int32_t _index, int64_t _msg_id) const;
+
+        private:
+            const scenario scenario_;
+            const int64_t start_time_;
+
+            mutable std::mutex mutex_;
+            std::string aimsid_;
+            int64_t fetch_seq_ = 0;
+            int32_t dlg_states_sent_ = 0;
+            std::map<std::string, int32_t> recorded_served_;
+        };
+    }
+}
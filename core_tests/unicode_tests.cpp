@@ -0,0 +1,127 @@
+#include "stdafx.h"
+
+#include <iostream>
+
+#include "../core/tools/strings.h"
+#include "../core/tools/unicode.h"
+
+using namespace core::tools;
+
+namespace
+{
+    int failures = 0;
+
+    void check(bool _condition, const char* _what)
+    {
+        if (!_condition)
+        {
+            std::cout << "FAILED: " << _what << '\n';
+            ++failures;
+        }
+    }
+
+    void test_ascii()
+    {
+        auto letters = true;
+        for (char32_t c = 'A'; c <= 'Z'; ++c)
+            letters = letters && unicode::to_lower(c) == c + 32 && unicode::to_upper(c + 32) == c && unicode::to_upper(c) == c;
+        check(letters, "ascii letters");
+
+        auto others = true;
+        for (char32_t c = 0; c < 0x80; ++c)
+        {
+            if ((c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z'))
+                continue;
+            others = others && unicode::to_lower(c) == c && unicode::to_upper(c) == c;
+        }
+        check(others, "ascii non-letters are unchanged");
+
+        check(unicode::to_lower(std::string_view("Hello, World! 42")) == "hello, world! 42", "ascii string to lower");
+        check(unicode::to_upper(std::string_view("Hello, World! 42")) == "HELLO, WORLD! 42", "ascii string to upper");
+    }
+
+    void test_cyrillic()
+    {
+        auto basic = true;
+        for (char32_t c = 0x0410; c <= 0x042F; ++c) // А-Я
+            basic = basic && unicode::to_lower(c) == c + 0x20 && unicode::to_upper(c + 0x20) == c;
+        check(basic, "cyrillic basic letters");
+
+        auto extended = true;
+        for (char32_t c = 0x0400; c <= 0x040F; ++c) // Ѐ-Џ, Ё among them
+            extended = extended && unicode::to_lower(c) == c + 0x50 && unicode::to_upper(c + 0x50) == c;
+        check(extended, "cyrillic letters with diacritics");
+
+        check(unicode::to_lower(char32_t(0x0401)) == 0x0451 && unicode::to_upper(char32_t(0x0451)) == 0x0401, "yo");
+        check(unicode::to_lower(char32_t(0x0460)) == 0x0461 && unicode::to_upper(char32_t(0x0481)) == 0x0480, "historic cyrillic letters");
+
+        const std::string_view upper = "\xd0\x9f\xd0\xa0\xd0\x98\xd0\x92\xd0\x95\xd0\xa2, \xd0\x81\xd0\x96"; // ПРИВЕТ, ЁЖ
+        const std::string_view lower = "\xd0\xbf\xd1\x80\xd0\xb8\xd0\xb2\xd0\xb5\xd1\x82, \xd1\x91\xd0\xb6"; // привет, ёж
+        check(unicode::to_lower(upper) == lower, "cyrillic string to lower");
+        check(unicode::to_upper(lower) == upper, "cyrillic string to upper");
+    }
+
+    // the mapping is the simple one, so the special cases keep a single code point
+    void test_special_casing()
+    {
+        check(unicode::to_upper(char32_t(0x00DF)) == 0x00DF, "sharp s has no simple upper case");
+        check(unicode::to_lower(char32_t(0x1E9E)) == 0x00DF, "capital sharp s");
+        check(unicode::to_upper(char32_t(0x017F)) == 'S' && unicode::to_lower(char32_t(0x017F)) == 0x017F, "long s");
+        check(unicode::to_lower(char32_t(0x0130)) == 'i', "dotted capital i");
+        check(unicode::to_upper(char32_t(0x0131)) == 'I', "dotless i");
+        check(unicode::to_lower(char32_t(0x0178)) == 0x00FF && unicode::to_upper(char32_t(0x00FF)) == 0x0178, "y with diaeresis");
+        check(unicode::to_upper(char32_t(0x03C2)) == 0x03A3 && unicode::to_lower(char32_t(0x03A3)) == 0x03C3, "final sigma");
+        check(unicode::to_lower(char32_t(0x01C5)) == 0x01C6 && unicode::to_upper(char32_t(0x01C5)) == 0x01C4, "title case dz");
+        check(unicode::to_upper(char32_t(0x0149)) == 0x0149, "n preceded by apostrophe has no simple upper case");
+        check(unicode::to_upper(char32_t(0x1F80)) == 0x1F88 && unicode::to_upper(char32_t(0x1FB3)) == 0x1FBC, "greek with ypogegrammeni");
+        check(unicode::to_upper(char32_t(0x1F88)) == 0x1F88 && unicode::to_lower(char32_t(0x1F88)) == 0x1F80, "greek title case with prosgegrammeni");
+        check(unicode::to_lower(char32_t(0x2126)) == 0x03C9, "ohm sign");
+        check(unicode::to_lower(char32_t(0x212A)) == 'k', "kelvin sign");
+        check(unicode::to_lower(char32_t(0x10400)) == 0x10428 && unicode::to_upper(char32_t(0x10428)) == 0x10400, "deseret, outside the bmp");
+        check(unicode::to_lower(char32_t(0x1F600)) == 0x1F600 && unicode::to_upper(char32_t(0x4E2D)) == 0x4E2D, "uncased code points");
+    }
+
+    void test_utf8()
+    {
+        check(unicode::to_upper(std::string_view("a\xff" "b\xd0")) == "A\xff" "B\xd0", "malformed bytes are copied as is");
+
+        const std::string_view truncated = "\xe2\x82";
+        size_t pos = 0;
+        check(unicode::decode_utf8(truncated, pos) == unicode::replacement_char && pos == 1, "a truncated sequence skips a byte");
+
+        const std::string_view overlong = "\xc0\xaf";
+        pos = 0;
+        check(unicode::decode_utf8(overlong, pos) == unicode::replacement_char && pos == 1, "an overlong sequence");
+
+        const std::string_view surrogate = "\xed\xa0\x80";
+        pos = 0;
+        check(unicode::decode_utf8(surrogate, pos) == unicode::replacement_char, "a surrogate");
+
+        auto round_trip = true;
+        for (const char32_t c : { char32_t(0x7F), char32_t(0x80), char32_t(0x7FF), char32_t(0x800), char32_t(0xFFFF), char32_t(0x10000), char32_t(0x10FFFF) })
+        {
+            std::string encoded;
+            unicode::append_utf8(encoded, c);
+            pos = 0;
+            round_trip = round_trip && unicode::decode_utf8(encoded, pos) == c && pos == encoded.size();
+        }
+        check(round_trip, "encode and decode at the length boundaries");
+
+        const std::string_view mixed = "abc \xd0\xb6 \xe2\x82\xac \xf0\x9f\x98\x80";
+        check(from_utf16(from_utf8(mixed)) == mixed, "utf8 to wide and back");
+        check(from_utf8("a\xff" "b") == L"a\xfffd" L"b", "malformed utf8 to wide yields the replacement character");
+    }
+}
+
+int main()
+{
+    test_ascii();
+    test_cyrillic();
+    test_special_casing();
+    test_utf8();
+
+    if (failures == 0)
+        std::cout << "all unicode tests passed\n";
+
+    return failures == 0 ? 0 : 1;
+}
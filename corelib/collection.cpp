@@ -67,6 +67,7 @@ void core::collection_value::clear()
     case core::vt_string:
         {
             delete [] data__.string_value_;
+            memory_.set(sizeof(collection_value));
         }
         break;
     case core::vt_int:
@@ -125,6 +126,7 @@ void core::collection_value::set_as_string(const char* val, int32_t len)
     clear();
     type_ = collection_value_type::vt_string;
     data__.string_value_ = new char[len + 1];
+    memory_.set(static_cast<int64_t>(sizeof(collection_value)) + len + 1);
     if (len)
         memcpy(data__.string_value_, val, len);
     data__.string_value_[len] = '\0';
@@ -339,16 +341,19 @@ uint8_t* coll_stream::read(int64_t _size)
 void coll_stream::reset()
 {
     stream_.reset();
+    memory_.set(sizeof(coll_stream));
 }
 
 void coll_stream::write(std::istream& _source)
 {
     stream_.write_stream(_source);
+    memory_.set(static_cast<int64_t>(sizeof(coll_stream)) + stream_.all_size());
 }
 
 void coll_stream::write(const uint8_t* _buffer, int64_t _size)
 {
     stream_.write((const char*) _buffer, _size);
+    memory_.set(static_cast<int64_t>(sizeof(coll_stream)) + stream_.all_size());
 }
 
 bool coll_stream::empty() const
@@ -7,6 +7,7 @@
 
 #include "../core/tools/binary_stream.h"
 #include "../core/tools/string_comparator.h"
+#include "../core/stats/memory/memory_accounting.h"
 
 namespace core
 {
@@ -30,6 +31,8 @@ namespace core
 
         } data__;
 
+        memory_stats::tagged_size<memory_stats::memory_tag::collections> memory_{ static_cast<int64_t>(sizeof(collection_value)) };
+
         // ibase interface
         std::atomic<int32_t>        ref_count_;
         virtual int32_t addref() override;
@@ -78,7 +81,8 @@ namespace core
 
     class coll_array : public core::iarray
     {
-        std::vector<ivalue*>        vec_;
+        std::vector<ivalue*, memory_stats::counting_allocator<ivalue*, memory_stats::memory_tag::collections>> vec_;
+        memory_stats::tagged_size<memory_stats::memory_tag::collections> memory_{ static_cast<int64_t>(sizeof(coll_array)) };
 
         // ibase interface
         std::atomic<int32_t>        ref_count_;
@@ -103,6 +107,7 @@ namespace core
         virtual int32_t release() override;
 
         core::tools::binary_stream    stream_;
+        memory_stats::tagged_size<memory_stats::memory_tag::collections> memory_{ static_cast<int64_t>(sizeof(coll_stream)) };
 
         virtual uint8_t* read(int64_t _size) override;
         virtual void write(std::istream& _source) override;
@@ -140,7 +145,9 @@ namespace core
     class collection : public core::icollection
     {
         std::atomic<int32_t> ref_count_;
-        std::map<std::string, core::ivalue*, core::tools::string_comparator> values_;
+        std::map<std::string, core::ivalue*, core::tools::string_comparator,
+            memory_stats::counting_allocator<std::pair<const std::string, core::ivalue*>, memory_stats::memory_tag::collections>> values_;
+        memory_stats::tagged_size<memory_stats::memory_tag::collections> memory_{ static_cast<int64_t>(sizeof(collection)) };
         decltype(values_)::iterator cursor_;
 
         mutable char* log_data_;
@@ -37,6 +37,7 @@ namespace
     constexpr std::string_view c_dev_net_compression = "dev.net_compression";
     constexpr std::string_view c_ssl_verification_enabled = "dev.webview_ssl_check";
     constexpr std::string_view c_dev_watch_gui_memory = "dev.watch_gui_memory";
+    constexpr std::string_view c_dev_trace_events = "dev.trace_events";
     constexpr std::string_view c_gdpr_user_has_agreed = "gdpr.user_has_agreed";
     constexpr std::string_view c_gdpr_agreement_reported_to_server = "gdpr.agreement_reported_to_server";
     constexpr std::string_view c_gdpr_user_has_logged_in_ever = "gdpr.user_has_logged_in_ever";
@@ -67,6 +68,7 @@ AppConfig::AppConfig(const core::coll_helper& collection)
     , IsSslVerificationEnabled_(collection.get<bool>(c_ssl_verification_enabled, true))
     , showSecondsInTimePicker_(collection.get<bool>(c_dev_show_seconds_in_time_picker, false))
     , WatchGuiMemoryEnabled_(collection.get<bool>(c_dev_watch_gui_memory, false))
+    , TraceEventsEnabled_(collection.get<bool>(c_dev_trace_events, false))
     , ShowMsgOptionHasChanged_(false)
     , GDPR_UserHasAgreed_(collection.get<bool>(c_gdpr_user_has_agreed) || config::get().is_on(config::features::auto_accepted_gdpr))
     , GDPR_AgreementReportedToServer_(collection.get<int32_t>(c_gdpr_agreement_reported_to_server) || config::get().is_on(config::features::auto_accepted_gdpr))
@@ -162,6 +164,11 @@ bool AppConfig::WatchGuiMemoryEnabled() const noexcept
     return WatchGuiMemoryEnabled_;
 }
 
+bool AppConfig::TraceEventsEnabled() const noexcept
+{
+    return TraceEventsEnabled_;
+}
+
 bool AppConfig::ShowMsgOptionHasChanged() const noexcept
 {
     return ShowMsgOptionHasChanged_;
@@ -340,6 +347,7 @@ QString AppConfig::toJsonString() const
     doc.AddMember(rapidjson::StringRef(c_sys_crash_handler_enabled.data()), IsSysCrashHandleEnabled(), a);
     doc.AddMember(rapidjson::StringRef(c_dev_net_compression.data()), IsNetCompressionEnabled(), a);
     doc.AddMember(rapidjson::StringRef(c_dev_watch_gui_memory.data()), WatchGuiMemoryEnabled(), a);
+    doc.AddMember(rapidjson::StringRef(c_dev_trace_events.data()), TraceEventsEnabled(), a);
     doc.AddMember(rapidjson::StringRef(c_gdpr_user_has_agreed.data()), GDPR_UserHasAgreed(), a);
     doc.AddMember(rapidjson::StringRef(c_gdpr_agreement_reported_to_server.data()), GDPR_AgreementReportedToServer(), a);
     doc.AddMember(rapidjson::StringRef(c_gdpr_user_has_logged_in_ever.data()), GDPR_UserHasLoggedInEver(), a);
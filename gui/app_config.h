@@ -43,6 +43,7 @@ public:
     bool showSecondsInTimePicker() const noexcept;
 
     bool WatchGuiMemoryEnabled() const noexcept;
+    bool TraceEventsEnabled() const noexcept;
 
     /* Has the option changed during current app session? */
     bool ShowMsgOptionHasChanged() const noexcept;
@@ -104,6 +105,7 @@ private:
     bool showSecondsInTimePicker_;
 
     bool WatchGuiMemoryEnabled_;
+    bool TraceEventsEnabled_;
 
     bool ShowMsgOptionHasChanged_;
 
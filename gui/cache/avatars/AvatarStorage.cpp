@@ -7,16 +7,12 @@
 #include "../../main_window/history_control/HistoryControlPage.h"
 #include "../../utils/gui_coll_helper.h"
 #include "../../utils/utils.h"
+#include "../../utils/memory_utils.h"
 #include "../../utils/InterConnector.h"
 
 namespace
 {
-    QString CreateKey(QStringView _aimId, const int _sizePx)
-    {
-        im_assert(_sizePx > 0);
-        const QStringView aimId = _aimId.isEmpty() ? u"default" : _aimId;
-        return aimId % u'/' % QString::number(_sizePx);
-    }
+    constexpr int64_t memoryBudget() noexcept { return 48 * 1024 * 1024; }
 
     constexpr std::chrono::milliseconds CLEANUP_TIMEOUT = std::chrono::minutes(5);
     constexpr int64_t INITIAL_REQUEST_AVATAR_SEQ = -1;
@@ -50,16 +46,18 @@ namespace Logic
         TimesCache_[_aimId] = QDateTime::currentDateTime();
 
         Out _isDefault = isDefaultAvatar(_aimId);
-        const auto key = CreateKey(_aimId, _sizePx);
+        const auto aimId = internAimId(_aimId);
 
-        auto iterByAimIdAndSize = AvatarsByAimIdAndSize_.find(key);
-        if (iterByAimIdAndSize != AvatarsByAimIdAndSize_.end())
+        if (auto scaled = findCached({ aimId, Shape::Scaled, _sizePx }); !scaled.isNull())
         {
-            return iterByAimIdAndSize->second;
+            ++hits_;
+            touchCached({ aimId, Shape::Base, 0 });
+            return scaled;
         }
+        ++misses_;
 
-        auto iterByAimId = AvatarsByAimId_.find(_aimId);
-        if (iterByAimId == AvatarsByAimId_.end())
+        auto avatarByAimId = findCached({ aimId, Shape::Base, 0 });
+        if (avatarByAimId.isNull())
         {
             auto drawDisplayName = _displayName.trimmed();
             if (drawDisplayName.isEmpty() && !_aimId.isEmpty())
@@ -70,20 +68,15 @@ namespace Logic
             auto defaultAvatar = Utils::getDefaultAvatar(_aimId, drawDisplayName, _sizePx);
             im_assert(!defaultAvatar.isNull());
 
-            const auto result = AvatarsByAimId_.emplace(_aimId, std::move(defaultAvatar));
-            im_assert(result.second);
-
-            iterByAimId = result.first;
+            avatarByAimId = putCached({ aimId, Shape::Base, 0 }, std::move(defaultAvatar));
         }
 
-        const auto &avatarByAimId = iterByAimId->second;
         im_assert(!avatarByAimId.isNull());
 
         const auto regenerateAvatar = ((avatarByAimId.width() < _sizePx) && _isDefault) && _aimId != _displayName;
         if (regenerateAvatar || _regenerate)
         {
-            AvatarsByAimId_.erase(iterByAimId);
-            CleanupSecondaryCaches(_aimId);
+            removeCached(_aimId, true, true);
             return Get(_aimId, _displayName, _sizePx, _isDefault, _regenerate);
         }
 
@@ -95,11 +88,10 @@ namespace Logic
         else
             scaledImage = avatarByAimId.scaledToHeight(_sizePx, Qt::SmoothTransformation);
 
-        const auto result = AvatarsByAimIdAndSize_.emplace(key, std::move(scaledImage));
-        im_assert(result.second);
+        auto result = putCached({ aimId, Shape::Scaled, _sizePx }, std::move(scaledImage));
 
         if (_aimId.isEmpty() || _aimId == u"mail")
-            return result.first->second;
+            return result;
 
         auto requestedAvatarsIter = RequestedAvatars_.find(_aimId);
         if ((requestedAvatarsIter == RequestedAvatars_.end() || (avatarByAimId.width() < _sizePx && avatarByAimId.height() < _sizePx)) && _aimId != Utils::getDefaultCallAvatarId())
@@ -122,21 +114,24 @@ namespace Logic
             Ui::GetDispatcher()->post_message_to_core("avatars/show", collection.get());
         }
 
-        return result.first->second;
+        return result;
     }
 
     void AvatarStorage::SetAvatar(const QString& _aimId, const QPixmap& _pixmap)
     {
         im_assert(!_aimId.isEmpty());
 
-        auto iter = AvatarsByAimId_.find(_aimId);
-        if (iter == AvatarsByAimId_.end())
+        const auto aimId = findAimId(_aimId);
+        if (!aimId)
             return;
 
-        const auto size = iter->second.height();
-        auto scaled = _pixmap.scaled(size, size, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+        const CacheKey key{ *aimId, Shape::Base, 0 };
+        const auto iter = cache_.find(key);
+        if (iter == cache_.end())
+            return;
 
-        iter->second = std::move(scaled);
+        const auto size = iter->second.pixmap_.height();
+        putCached(key, _pixmap.scaled(size, size, Qt::KeepAspectRatio, Qt::SmoothTransformation));
 
         CleanupSecondaryCaches(_aimId);
 
@@ -146,19 +141,18 @@ namespace Logic
         Q_EMIT avatarChanged(_aimId);
     }
 
-    const AvatarStorage::CacheMap &AvatarStorage::GetByAimIdAndSize() const
-    {
-        return AvatarsByAimIdAndSize_;
-    }
-
-    const AvatarStorage::CacheMap &AvatarStorage::GetByAimId() const
-    {
-        return AvatarsByAimId_;
-    }
-
-    const AvatarStorage::CacheMap &AvatarStorage::GetRoundedByAimId() const
+    AvatarStorage::CacheStats AvatarStorage::getCacheStats() const
     {
-        return RoundedAvatarsByAimIdAndSize_;
+        CacheStats stats;
+        stats.bytes_ = cacheSize_;
+        stats.count_ = int64_t(cache_.size());
+        stats.hits_ = hits_;
+        stats.misses_ = misses_;
+        stats.evictions_ = evictions_;
+        stats.baseBytes_ = baseBytes_;
+        stats.scaledBytes_ = scaledBytes_;
+        stats.roundedBytes_ = roundedBytes_;
+        return stats;
     }
 
     bool AvatarStorage::isDefaultAvatar(const QString& _aimId) const
@@ -173,19 +167,19 @@ namespace Logic
 
         if (TimesCache_.find(_aimId) != TimesCache_.end())
         {
-            auto iter = AvatarsByAimId_.find(_aimId);
-            if (iter != AvatarsByAimId_.end() && _aimId != Utils::getDefaultCallAvatarId())
+            const auto aimId = findAimId(_aimId);
+            const auto iter = aimId ? cache_.find({ *aimId, Shape::Base, 0 }) : cache_.end();
+            if (iter != cache_.end() && _aimId != Utils::getDefaultCallAvatarId())
             {
                 Ui::gui_coll_helper collection(Ui::GetDispatcher()->create_collection(), true);
                 collection.set_value_as_qstring("contact", _aimId);
-                collection.set_value_as_int("size", iter->second.height());
+                collection.set_value_as_int("size", iter->second.pixmap_.height());
                 collection.set_value_as_bool("force", true);
                 auto seq = Ui::GetDispatcher()->post_message_to_core("avatars/get", collection.get());
                 requests_.insert(seq);
             }
 
-            AvatarsByAimId_.erase(_aimId);
-            CleanupSecondaryCaches(_aimId, false);
+            removeCached(_aimId, true, false);
             RequestedAvatars_.erase(_aimId);
             LoadedAvatars_.removeAll(_aimId);
             TimesCache_.erase(_aimId);
@@ -289,11 +283,13 @@ namespace Logic
             p.setRenderHints(QPainter::SmoothPixmapTransform | QPainter::Antialiasing);
             p.drawPixmap(scaledImage.rect(), _pixmap, cutArea);
         }
-        AvatarsByAimId_[_aimId] = std::move(scaledImage);
+        putCached({ internAimId(_aimId), Shape::Base, 0 }, std::move(scaledImage));
 
         CleanupSecondaryCaches(_aimId);
 
-        LoadedAvatars_ << _aimId;
+        // an evicted avatar is loaded again with its loaded state kept
+        if (!LoadedAvatars_.contains(_aimId))
+            LoadedAvatars_ << _aimId;
 
         Q_EMIT avatarChanged(_aimId);
     }
@@ -303,9 +299,7 @@ namespace Logic
         if (!isDefaultAvatar(_aimId))
             return;
 
-        if (AvatarsByAimId_.find(_aimId) != AvatarsByAimId_.end())
-            AvatarsByAimId_.erase(_aimId);
-        CleanupSecondaryCaches(_aimId);
+        removeCached(_aimId, true, true);
         Q_EMIT avatarChanged(_aimId);
     }
 
@@ -325,8 +319,7 @@ namespace Logic
                     continue;
                 }
 
-                AvatarsByAimId_.erase(aimId);
-                CleanupSecondaryCaches(aimId);
+                removeCached(aimId, true, true);
                 RequestedAvatars_.erase(aimId);
                 LoadedAvatars_.removeAll(aimId);
                 iter = TimesCache_.erase(iter);
@@ -338,65 +331,174 @@ namespace Logic
         }
     }
 
-    // TODO : use two-step hash here
-    void AvatarStorage::CleanupSecondaryCaches(QStringView _aimId, bool _isRoundedAvatarsClean)
+    void AvatarStorage::CleanupSecondaryCaches(const QString& _aimId, bool _isRoundedAvatarsClean)
+    {
+        removeCached(_aimId, false, _isRoundedAvatarsClean);
+    }
+
+    QPixmap AvatarStorage::GetRounded(const QPixmap& _avatar, const QString& _aimId, bool mini_icons, bool _isDefault)
     {
-        const auto cleanupSecondaryCache = [](CacheMap &cache, QStringView aimid)
+        im_assert(!_avatar.isNull());
+
+        const auto aimId = internAimId(_aimId);
+        const CacheKey key{ aimId, mini_icons ? Shape::RoundedMini : Shape::Rounded, _avatar.width() };
+        if (auto rounded = findCached(key); !rounded.isNull())
         {
-            for (auto i = cache.begin(); i != cache.end(); ++i)
-            {
-                const auto &key = i->first;
-                if (!key.startsWith(aimid))
-                {
-                    continue;
-                }
+            touchCached({ aimId, Shape::Base, 0 });
+            return rounded;
+        }
 
-                for(;;)
-                {
-                    i = cache.erase(i);
-
-                    if (i == cache.end())
-                    {
-                        break;
-                    }
-
-                    const auto &k = i->first;
-                    if (!k.startsWith(aimid))
-                    {
-                        break;
-                    }
-                }
+        return putCached(key, Utils::roundImage(_avatar, _isDefault, mini_icons));
+    }
 
-                break;
-            }
-        };
+    uint32_t AvatarStorage::internAimId(const QString& _aimId)
+    {
+        if (const auto it = aimIds_.constFind(_aimId); it != aimIds_.cend())
+            return it.value();
+
+        uint32_t id = 0;
+        if (!freeAimIds_.empty())
+        {
+            id = freeAimIds_.back();
+            freeAimIds_.pop_back();
+            aimIdsById_[id] = _aimId;
+        }
+        else
+        {
+            id = uint32_t(aimIdsById_.size());
+            aimIdsById_.push_back(_aimId);
+        }
+        aimIds_.insert(_aimId, id);
+        return id;
+    }
 
-        const auto aimid = _aimId.isEmpty() ? QStringView(u"default") : _aimId;
+    std::optional<uint32_t> AvatarStorage::findAimId(const QString& _aimId) const
+    {
+        if (const auto it = aimIds_.constFind(_aimId); it != aimIds_.cend())
+            return it.value();
+        return std::nullopt;
+    }
 
-        if (_isRoundedAvatarsClean)
-            cleanupSecondaryCache(RoundedAvatarsByAimIdAndSize_, aimid);
+    void AvatarStorage::releaseAimIdIfUnused(uint32_t _aimId)
+    {
+        if (const auto it = cache_.lower_bound({ _aimId, Shape::Base, std::numeric_limits<int>::min() }); it != cache_.end() && it->first.aimId_ == _aimId)
+            return;
 
-        cleanupSecondaryCache(AvatarsByAimIdAndSize_, aimid);
+        aimIds_.remove(aimIdsById_[_aimId]);
+        aimIdsById_[_aimId].clear();
+        freeAimIds_.push_back(_aimId);
     }
 
-    QPixmap AvatarStorage::GetRounded(const QPixmap& _avatar, const QString& _aimId, bool mini_icons, bool _isDefault)
+    QPixmap AvatarStorage::findCached(const CacheKey& _key)
     {
-        im_assert(!_avatar.isNull());
+        const auto it = cache_.find(_key);
+        if (it == cache_.end())
+            return QPixmap();
+
+        lru_.splice(lru_.begin(), lru_, it->second.lru_);
+        return it->second.pixmap_;
+    }
 
-        const QString key = CreateKey(_aimId, _avatar.width());
+    void AvatarStorage::touchCached(const CacheKey& _key)
+    {
+        if (const auto it = cache_.find(_key); it != cache_.end())
+            lru_.splice(lru_.begin(), lru_, it->second.lru_);
+    }
 
-        auto i = RoundedAvatarsByAimIdAndSize_.find(key);
-        if (i == RoundedAvatarsByAimIdAndSize_.end())
+    int64_t& AvatarStorage::shapeBytes(Shape _shape)
+    {
+        switch (_shape)
         {
-            auto roundedAvatar = Utils::roundImage(_avatar, _isDefault, mini_icons);
-            i = RoundedAvatarsByAimIdAndSize_
-                .emplace(
-                    key,
-                    std::move(roundedAvatar))
-                .first;
+        case Shape::Base:
+            return baseBytes_;
+        case Shape::Scaled:
+            return scaledBytes_;
+        case Shape::Rounded:
+        case Shape::RoundedMini:
+            break;
         }
+        return roundedBytes_;
+    }
+
+    QPixmap AvatarStorage::putCached(const CacheKey& _key, QPixmap _pixmap)
+    {
+        im_assert(!_pixmap.isNull());
+
+        const auto bytes = Utils::getMemoryFootprint(_pixmap);
 
-        return i->second;
+        auto it = cache_.find(_key);
+        if (it == cache_.end())
+        {
+            lru_.push_front(_key);
+            it = cache_.emplace(_key, CacheEntry{ std::move(_pixmap), bytes, lru_.begin() }).first;
+        }
+        else
+        {
+            cacheSize_ -= it->second.bytes_;
+            shapeBytes(_key.shape_) -= it->second.bytes_;
+            it->second.pixmap_ = std::move(_pixmap);
+            it->second.bytes_ = bytes;
+            lru_.splice(lru_.begin(), lru_, it->second.lru_);
+        }
+        cacheSize_ += bytes;
+        shapeBytes(_key.shape_) += bytes;
+
+        // the result is a copy, so it survives the eviction of its own entry
+        auto result = it->second.pixmap_;
+        evictCached();
+        return result;
+    }
+
+    void AvatarStorage::removeCached(const QString& _aimId, bool _base, bool _rounded)
+    {
+        const auto id = findAimId(_aimId);
+        if (!id)
+            return;
+
+        const auto aimId = *id;
+        for (auto it = cache_.lower_bound({ aimId, Shape::Base, std::numeric_limits<int>::min() }); it != cache_.end() && it->first.aimId_ == aimId;)
+        {
+            const auto shape = it->first.shape_;
+            const auto remove = shape == Shape::Scaled || (_base && shape == Shape::Base) || (_rounded && (shape == Shape::Rounded || shape == Shape::RoundedMini));
+            if (remove)
+                removeCached(it++);
+            else
+                ++it;
+        }
+    }
+
+    void AvatarStorage::removeCached(std::map<CacheKey, CacheEntry>::iterator _it)
+    {
+        const auto key = _it->first;
+        cacheSize_ -= _it->second.bytes_;
+        shapeBytes(key.shape_) -= _it->second.bytes_;
+        lru_.erase(_it->second.lru_);
+        cache_.erase(_it);
+
+        releaseAimIdIfUnused(key.aimId_);
+    }
+
+    void AvatarStorage::evictCached()
+    {
+        // the most recent entry stays even if it alone is over the budget
+        while (cacheSize_ > memoryBudget() && lru_.size() > 1)
+        {
+            const auto key = lru_.back();
+            ++evictions_;
+
+            // the shapes are made from the base and go with it; the avatar stays loaded,
+            // it is requested from the core again the next time it is shown
+            if (key.shape_ == Shape::Base)
+            {
+                const auto aimId = aimIdsById_[key.aimId_];
+                removeCached(aimId, true, true);
+                RequestedAvatars_.erase(aimId);
+            }
+            else
+            {
+                removeCached(cache_.find(key));
+            }
+        }
     }
 
     AvatarStorage* GetAvatarStorage()
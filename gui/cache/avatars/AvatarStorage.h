@@ -35,25 +35,86 @@ namespace Logic
 
         void SetAvatar(const QString& _aimId, const QPixmap& _pixmap);
 
-        using CacheMap = std::map<QString, QPixmap>;
-        const CacheMap& GetByAimIdAndSize() const;
-        const CacheMap& GetByAimId() const;
-        const CacheMap& GetRoundedByAimId() const;
+        struct CacheStats
+        {
+            int64_t bytes_ = 0;
+            int64_t baseBytes_ = 0;
+            int64_t scaledBytes_ = 0;
+            int64_t roundedBytes_ = 0;
+            int64_t count_ = 0;
+            int64_t hits_ = 0;
+            int64_t misses_ = 0;
+            int64_t evictions_ = 0;
+        };
+        CacheStats getCacheStats() const;
 
         bool isDefaultAvatar(const QString& _aimId) const;
 
     private:
         AvatarStorage();
 
-        void CleanupSecondaryCaches(QStringView _aimId, bool _isRoundedAvatarsClean = true);
+        // base is the avatar as loaded (or drawn by default), the other shapes are made from it
+        // and are dropped together with it
+        enum class Shape : uint8_t
+        {
+            Base,
+            Scaled,
+            Rounded,
+            RoundedMini
+        };
+
+        struct CacheKey
+        {
+            uint32_t aimId_ = 0;
+            Shape shape_ = Shape::Base;
+            int size_ = 0;
+
+            bool operator<(const CacheKey& _other) const noexcept
+            {
+                return std::tie(aimId_, shape_, size_) < std::tie(_other.aimId_, _other.shape_, _other.size_);
+            }
+        };
+
+        struct CacheEntry
+        {
+            QPixmap pixmap_;
+            int64_t bytes_ = 0;
+            std::list<CacheKey>::iterator lru_;
+        };
+
+        // the ids are freed with the last entry of the contact and reused
+        uint32_t internAimId(const QString& _aimId);
+        std::optional<uint32_t> findAimId(const QString& _aimId) const;
+        void releaseAimIdIfUnused(uint32_t _aimId);
+
+        QPixmap findCached(const CacheKey& _key);
+        void touchCached(const CacheKey& _key);
+        QPixmap putCached(const CacheKey& _key, QPixmap _pixmap);
+        void removeCached(const QString& _aimId, bool _base, bool _rounded);
+        void removeCached(std::map<CacheKey, CacheEntry>::iterator _it);
+        void evictCached();
+
+        int64_t& shapeBytes(Shape _shape);
+
+        void CleanupSecondaryCaches(const QString& _aimId, bool _isRoundedAvatarsClean = true);
 
         QPixmap GetRounded(const QPixmap& _avatar, const QString& _aimId, bool mini_icons, bool _isDefault);
 
-        CacheMap AvatarsByAimIdAndSize_;
-
-        CacheMap AvatarsByAimId_;
-
-        CacheMap RoundedAvatarsByAimIdAndSize_;
+        // all the shapes of all the avatars, the least recently used ones are evicted
+        // when the memory budget is exceeded
+        std::map<CacheKey, CacheEntry> cache_;
+        std::list<CacheKey> lru_;
+        int64_t cacheSize_ = 0;
+        int64_t baseBytes_ = 0;
+        int64_t scaledBytes_ = 0;
+        int64_t roundedBytes_ = 0;
+        int64_t hits_ = 0;
+        int64_t misses_ = 0;
+        int64_t evictions_ = 0;
+
+        QHash<QString, uint32_t> aimIds_;
+        std::vector<QString> aimIdsById_;
+        std::vector<uint32_t> freeAimIds_;
 
         std::set<QString> RequestedAvatars_;
 
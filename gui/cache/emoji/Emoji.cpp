@@ -292,12 +292,17 @@ namespace Emoji
 
     EmojiCode getEmoji(QStringView _text, qsizetype& _pos)
     {
-        const auto emojiMaxSize = EmojiCode::maxSize();
         if (_pos >= 0)
         {
+            auto firstEnd = _pos;
+            const auto first = readCodepoint(_text, firstEnd);
+            const auto emojiMaxSize = first ? maxEmojiSize(first) : 0;
+            if (emojiMaxSize == 0)
+                return EmojiCode();
+
             size_t i = 0;
             EmojiCode current;
-            std::array<qsizetype, emojiMaxSize> prevPositions = {0};
+            std::array<qsizetype, EmojiCode::maxSize()> prevPositions = {0};
 
             do
             {
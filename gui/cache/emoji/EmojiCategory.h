@@ -2,14 +2,21 @@
 
 namespace Emoji
 {
-    inline QLatin1String peopleCategory() { return ql1s("people"); }
-    inline QLatin1String natureCategory() { return ql1s("nature"); }
-    inline QLatin1String foodCategory() { return ql1s("food"); }
-    inline QLatin1String activityCategory() { return ql1s("activity"); }
-    inline QLatin1String travelCategory() { return ql1s("travel"); }
-    inline QLatin1String objectsCategory() { return ql1s("objects"); }
-    inline QLatin1String symbolsCategory() { return ql1s("symbols"); }
-    inline QLatin1String flagsCategory() { return ql1s("flags"); }
-    inline QLatin1String modifierCategory() { return ql1s("modifier"); }
-    inline QLatin1String regionalCategory() { return ql1s("regional"); }
+    namespace details
+    {
+        // QLatin1String(const char*) counts the length at runtime, the emoji table is constexpr
+        template <int N>
+        constexpr QLatin1String latin1(const char (&_str)[N]) noexcept { return QLatin1String(_str, N - 1); }
+    }
+
+    constexpr QLatin1String peopleCategory() noexcept { return details::latin1("people"); }
+    constexpr QLatin1String natureCategory() noexcept { return details::latin1("nature"); }
+    constexpr QLatin1String foodCategory() noexcept { return details::latin1("food"); }
+    constexpr QLatin1String activityCategory() noexcept { return details::latin1("activity"); }
+    constexpr QLatin1String travelCategory() noexcept { return details::latin1("travel"); }
+    constexpr QLatin1String objectsCategory() noexcept { return details::latin1("objects"); }
+    constexpr QLatin1String symbolsCategory() noexcept { return details::latin1("symbols"); }
+    constexpr QLatin1String flagsCategory() noexcept { return details::latin1("flags"); }
+    constexpr QLatin1String modifierCategory() noexcept { return details::latin1("modifier"); }
+    constexpr QLatin1String regionalCategory() noexcept { return details::latin1("regional"); }
 }
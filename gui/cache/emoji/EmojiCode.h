@@ -64,11 +64,15 @@ namespace Emoji
 
         std::size_t hash() const noexcept
         {
+            // a plain sum collides for every sequence sharing its code points (skin tones, zwj)
             size_t res = 0;
             for (auto n : code)
-                res += n;
-            return std::hash<size_t>()(res);
-            // return std::accumulate(code.begin(), code.end(), res); c++23
+            {
+                if (!n)
+                    break;
+                res ^= std::hash<codePointType>()(n) + 0x9e3779b9 + (res << 6) + (res >> 2);
+            }
+            return res;
         }
 
         constexpr bool contains(codePointType codePoint) const noexcept
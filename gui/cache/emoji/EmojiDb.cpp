@@ -19,12 +19,6 @@ namespace
 {
     using namespace Emoji;
 
-    EmojiRecordVec EmojiIndexByOrder_;
-
-    using EmojiIndex = std::unordered_map<EmojiCode, size_t, EmojiCodeHasher>;
-    EmojiIndex emojiIndexByFullCodepoint_;
-    EmojiIndex emojiIndexByBaseCodepoint_;
-
     using EmojiFlags = std::map<QString, EmojiCode, Utils::StringComparatorInsensitive>;
     EmojiFlags flagEmojis_;
 
@@ -44,20 +38,6 @@ namespace
 
 namespace Emoji
 {
-    EmojiRecord::EmojiRecord(QLatin1String _category, QLatin1String _fileName, QLatin1String _shortName, const int _index, EmojiCode _baseCodePoints, EmojiCode _fullCodePoints)
-        : Category_(_category)
-        , FileName_(_fileName)
-        , ShortName_(_shortName)
-        , Index_(_index)
-        , baseCodePoints_(std::move(_baseCodePoints))
-        , fullCodePoints(std::move(_fullCodePoints))
-    {
-        im_assert(Category_.size() > 0);
-        im_assert(FileName_.size() > 0);
-        im_assert(!baseCodePoints_.isNull());
-        im_assert(!fullCodePoints.isNull());
-    }
-
     bool EmojiRecord::isValid() const noexcept
     {
         return Index_ >= 0;
@@ -69,11 +49,6 @@ namespace Emoji
         return v;
     }
 
-    EmojiRecord::EmojiRecord(QLatin1String _category, QLatin1String _fileName, QLatin1String _shortName, const int _index, EmojiCode _baseCodePoints)
-        : EmojiRecord(std::move(_category), std::move(_fileName), std::move(_shortName), _index, _baseCodePoints, _baseCodePoints)
-    {
-    }
-
     static constexpr bool skipEmoji(const EmojiCode& code) noexcept
     {
         if (code.size() == 1)
@@ -87,40 +62,14 @@ namespace Emoji
         return false;
     }
 
-    namespace
-    {
-        enum class CodePointType
-        {
-            Full,
-            Base
-        };
-    }
-
-    static EmojiIndex makeIndex(const EmojiRecordVec& vector, CodePointType type)
-    {
 #if defined(__APPLE__)
-        static_assert ((canSendEmojiOneOnMac() && canViewEmojiOneOnMac())
-                       || (!canSendEmojiOneOnMac() && canViewEmojiOneOnMac())
-                       || (!canSendEmojiOneOnMac() && !canViewEmojiOneOnMac()), "invariant fail");
-#endif
-        EmojiIndex index;
-        for (size_t i = 0; i < vector.size(); ++i)
-        {
-            const auto& record = vector[i];
-            if (skipEmoji(record.baseCodePoints_))
-                continue;
+    static_assert ((canSendEmojiOneOnMac() && canViewEmojiOneOnMac())
+                   || (!canSendEmojiOneOnMac() && canViewEmojiOneOnMac())
+                   || (!canSendEmojiOneOnMac() && !canViewEmojiOneOnMac()), "invariant fail");
 
-#if defined(__APPLE__)
-            if constexpr (useNativeEmoji())
-            {
-                if (!mac::supportEmoji(record.fullCodePoints) && !canViewEmojiOneOnMac())
-                    continue;
-            }
+    // the static index in EmojiIndexDataNew.cpp holds the emoji unsupported by the system font too
+    static_assert(canViewEmojiOneOnMac(), "filter the emoji index by mac::supportEmoji");
 #endif
-            index.emplace(type == CodePointType::Full ? record.fullCodePoints : record.baseCodePoints_, i);
-        }
-        return index;
-    }
 
     static bool containsSkinTone(const EmojiCode& code) noexcept // c++20: make constexpr
     {
@@ -128,14 +77,14 @@ namespace Emoji
         return std::any_of(std::begin(skinTones), std::end(skinTones), [&code](auto tone) { return code.contains(tone); });
     }
 
-    static bool containsWithGender(const EmojiIndex& index, const EmojiCode& code)
+    static bool containsWithGender(const EmojiCode& code)
     {
         if (code.size() < EmojiCode::maxSize())
         {
             constexpr static EmojiCode::codePointType genders[] = { 0x2640, 0x2642 };
             constexpr static EmojiCode::codePointType genderNeutral = 0x1f9d1;
             const auto containsWithGender = std::any_of(std::begin(genders), std::end(genders),
-                                                        [&index, &code](auto gender) { return index.find(EmojiCode::addCodePoint(code, gender)) != index.end(); });
+                                                        [&code](auto gender) { return isBaseEmojiCode(EmojiCode::addCodePoint(code, gender)); });
             const auto containsGenderNeutral = code.contains(genderNeutral);
 
             return containsWithGender || containsGenderNeutral;
@@ -154,25 +103,22 @@ namespace Emoji
 
     void InitEmojiDb()
     {
-        EmojiIndexByOrder_ = getEmojiVector();
+        im_assert(getEmojiCount() > 0);
 #if defined(__APPLE__)
-        mac::setEmojiVector(EmojiIndexByOrder_);
+        mac::setEmojiRecords(&getEmojiByOrder(0), getEmojiCount());
 #endif
-        im_assert(!EmojiIndexByOrder_.empty());
-
-        emojiIndexByFullCodepoint_ = makeIndex(EmojiIndexByOrder_, CodePointType::Full);
 
-        emojiIndexByBaseCodepoint_ = makeIndex(EmojiIndexByOrder_, CodePointType::Base);
-
-        for (const auto& record : EmojiIndexByOrder_)
+        // the lookups go to the constant tables directly, only the picker is built here
+        for (size_t i = 0; i < getEmojiCount(); ++i)
         {
+            const auto& record = getEmojiByOrder(i);
             if (skipEmoji(record.baseCodePoints_))
                 continue;
 
             if (containsSkinTone(record.baseCodePoints_)) // don't add skin tones to picker
                 continue;
 
-            if (containsWithGender(emojiIndexByBaseCodepoint_, record.baseCodePoints_))
+            if (containsWithGender(record.baseCodePoints_))
                 continue;
 
             if (isHairType(record.baseCodePoints_))
@@ -213,21 +159,20 @@ namespace Emoji
     bool isEmoji(const EmojiCode& _code)
     {
         im_assert(!_code.isNull());
-        im_assert(!emojiIndexByFullCodepoint_.empty() && !emojiIndexByBaseCodepoint_.empty());
-        return std::as_const(emojiIndexByFullCodepoint_).find(_code) != std::as_const(emojiIndexByFullCodepoint_).end()
-            || std::as_const(emojiIndexByBaseCodepoint_).find(_code) != std::as_const(emojiIndexByBaseCodepoint_).end();
+        return findEmoji(_code) != nullptr;
+    }
+
+    size_t maxEmojiSize(EmojiCode::codePointType _codePoint)
+    {
+        return getMaxEmojiSize(_codePoint);
     }
 
     const EmojiRecord& GetEmojiInfoByCodepoint(const EmojiCode& _code)
     {
         im_assert(!_code.isNull());
-        im_assert(!emojiIndexByFullCodepoint_.empty() && !emojiIndexByBaseCodepoint_.empty());
-
-        if (const auto iter = std::as_const(emojiIndexByFullCodepoint_).find(_code); iter != std::as_const(emojiIndexByFullCodepoint_).end())
-            return EmojiIndexByOrder_[iter->second];
 
-        if (const auto iter = std::as_const(emojiIndexByBaseCodepoint_).find(_code); iter != std::as_const(emojiIndexByBaseCodepoint_).end())
-            return EmojiIndexByOrder_[iter->second];
+        if (const auto record = findEmoji(_code))
+            return *record;
 
         return EmojiRecord::invalid();
     }
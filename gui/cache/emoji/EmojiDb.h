@@ -22,8 +22,24 @@ namespace Emoji
     // EmojiRecord don't store fileName string
     struct EmojiRecord
     {
-        EmojiRecord(QLatin1String _category, QLatin1String _fileName, QLatin1String _shortName, const int _index, EmojiCode _baseCodePoints);
-        EmojiRecord(QLatin1String _category, QLatin1String _fileName, QLatin1String _shortName, const int _index, EmojiCode _baseCodePoints, EmojiCode _fullCodePoints);
+        constexpr EmojiRecord(QLatin1String _category, QLatin1String _fileName, QLatin1String _shortName, const int _index, EmojiCode _baseCodePoints, EmojiCode _fullCodePoints)
+            : Category_(_category)
+            , FileName_(_fileName)
+            , ShortName_(_shortName)
+            , Index_(_index)
+            , baseCodePoints_(std::move(_baseCodePoints))
+            , fullCodePoints(std::move(_fullCodePoints))
+        {
+            im_assert(Category_.size() > 0);
+            im_assert(FileName_.size() > 0);
+            im_assert(!baseCodePoints_.isNull());
+            im_assert(!fullCodePoints.isNull());
+        }
+
+        constexpr EmojiRecord(QLatin1String _category, QLatin1String _fileName, QLatin1String _shortName, const int _index, EmojiCode _baseCodePoints)
+            : EmojiRecord(_category, _fileName, _shortName, _index, _baseCodePoints, _baseCodePoints)
+        {
+        }
 
         EmojiRecord(const EmojiRecord&) = default;
         EmojiRecord(EmojiRecord&&) = default;
@@ -50,6 +66,9 @@ namespace Emoji
 
     bool isEmoji(const EmojiCode& _code);
 
+    // length of the longest emoji sequence starting with _codePoint, 0 if none does
+    size_t maxEmojiSize(EmojiCode::codePointType _codePoint);
+
     const EmojiRecord& GetEmojiInfoByCodepoint(const EmojiCode& _code);
 
     const QVector<QLatin1String>& GetEmojiCategories();
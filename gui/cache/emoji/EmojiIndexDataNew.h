@@ -1,11 +1,20 @@
 #pragma once
 
-#include <vector>
-#include <memory>
+#include "EmojiCode.h"
 
 namespace Emoji
 {
     struct EmojiRecord;
 
-    std::vector<EmojiRecord> getEmojiVector();
+    // the records in the order of the picker
+    size_t getEmojiCount() noexcept;
+    const EmojiRecord& getEmojiByOrder(size_t _order) noexcept;
+
+    // the full or the base code points of an emoji, nullptr if _code is not one
+    const EmojiRecord* findEmoji(const EmojiCode& _code) noexcept;
+
+    bool isBaseEmojiCode(const EmojiCode& _code) noexcept;
+
+    // length of the longest emoji sequence starting with _codePoint, 0 if none does
+    size_t getMaxEmojiSize(EmojiCode::codePointType _codePoint) noexcept;
 }
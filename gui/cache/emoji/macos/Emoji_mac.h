@@ -11,6 +11,6 @@ namespace Emoji
     namespace mac {
         QImage getEmoji(const EmojiCode& code, int rectSize);
         bool supportEmoji(const EmojiCode& code);
-        void setEmojiVector(const EmojiRecordVec& vector);
+        void setEmojiRecords(const EmojiRecord* records, size_t count);
     }
 }
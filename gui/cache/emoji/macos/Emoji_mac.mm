@@ -45,12 +45,12 @@ static int getGlyphIndex(const EmojiCode& code)
     }
 }
 
-void setEmojiVector(const EmojiRecordVec& vector)
+void setEmojiRecords(const EmojiRecord* records, size_t count)
 {
     glyphs.clear();
-    for (const auto& record : vector)
+    for (size_t i = 0; i < count; ++i)
     {
-        const auto g = getGlyphIndex(record.fullCodePoints);
+        const auto g = getGlyphIndex(records[i].fullCodePoints);
         if (g)
             glyphs.insert(g);
     }
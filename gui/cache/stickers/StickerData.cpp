@@ -35,6 +35,18 @@ namespace Ui::Stickers
 #endif
     }
 
+    void StickerData::loadFromData(QByteArray& _data)
+    {
+        if (Q_UNLIKELY(!QCoreApplication::instance()))
+            return;
+
+        QPixmap pm;
+        QSize originalSize;
+
+        if (Utils::loadPixmapScaled(_data, QSize(), pm, originalSize) && !pm.isNull() && !!QCoreApplication::instance())
+            setPixmap(std::move(pm));
+    }
+
     void StickerData::setPixmap(QPixmap _pixmap)
     {
         im_assert(!_pixmap.isNull());
@@ -13,6 +13,7 @@ namespace Ui
             bool isValid() const noexcept { return !std::holds_alternative<std::monostate>(data_); }
 
             void loadFromFile(const QString& _path);
+            void loadFromData(QByteArray& _data);
             void setPixmap(QPixmap _image);
 
             const QPixmap& getPixmap() const noexcept;
@@ -502,6 +502,8 @@ void Cache::setStickerData(const core::coll_helper& _coll)
                 data.set_ = std::move(stickerSet);
                 data.fsId_ = std::move(fsId);
                 data.path_ = QString::fromUtf8(path.data(), path.size());
+                data.offset_ = _coll.get_value_as_int64("offset", 0);
+                data.length_ = _coll.get_value_as_int64("length", 0);
                 data.size_ = size;
                 data.id_ = stickerId;
                 data.setId_ = setId;
@@ -682,8 +684,7 @@ void Cache::unserialize_suggests(const core::coll_helper &_coll)
     if (!suggests)
         return;
 
-    suggests_.clear();
-    aliases_.clear();
+    keywords_.clear();
 
     for (core::iarray::size_type i = 0, suggestsSize = suggests->size(); i < suggestsSize; ++i)
     {
@@ -707,7 +708,8 @@ void Cache::unserialize_suggests(const core::coll_helper &_coll)
                 ((collSticker.get_value_as_string("type") == emoji_type) ? SuggestType::suggestEmoji : SuggestType::suggestWord));
         }
 
-        suggests_.emplace(std::move(emoji), std::move(suggest));
+        if (auto& keyword = keywords_.insert(emoji); keyword.stickers_.empty())
+            keyword.stickers_ = std::move(suggest);
     }
 
     core::iarray* aliases = _coll.get_value_as_array("aliases");
@@ -722,8 +724,8 @@ void Cache::unserialize_suggests(const core::coll_helper &_coll)
         if (!emojiArray)
             return;
 
-        auto word = QString::fromUtf8(coll_alias.get_value_as_string("word")).toLower();
-        aliases_[std::move(word)] = Utils::toContainerOfString<EmojiList>(emojiArray);
+        const auto word = QString::fromUtf8(coll_alias.get_value_as_string("word")).toLower();
+        keywords_.insert(word).emoji_ = Utils::toContainerOfString<EmojiList>(emojiArray);
     }
 }
 
@@ -790,7 +792,7 @@ void Cache::addStickerByFsId(const std::vector<Utils::FileSharingId>& _fsIds, co
         if (auto& fsSticker = fsStickers_[id]; !fsSticker)
             fsSticker = createSticker(id);
 
-        auto& infoV = suggests_[_keyword];
+        auto& infoV = keywords_.insert(_keyword).stickers_;
         if (std::none_of(infoV.begin(), infoV.end(), [&id](const auto & x) { return x.fsId_ == id; }))
             infoV.emplace_back(id, _type);
     }
@@ -842,36 +844,36 @@ void Cache::clearSetCache(int _setId)
         set->clearCache();
 }
 
-bool Cache::getSuggest(const QString& _keyword, Suggest& _suggest, const std::set<SuggestType>& _types) const
+bool Cache::getSuggest(const QString& _keyword, Suggest& _suggest, const std::set<SuggestType>& _types, Utils::PrefixTrieState* _state) const
 {
     _suggest.clear();
     if (_types.empty())
         return false;
 
-    QVarLengthArray<QString> keywords;
-    keywords.push_back(_keyword);
+    const auto keyword = keywords_.value(_state ? keywords_.find(_keyword, *_state) : keywords_.find(QStringView(_keyword)));
+    if (!keyword)
+        return false;
 
-    if (_types.find(SuggestType::suggestWord) != _types.end())
+    const auto addStickers = [&_suggest, &_types](const Suggest& _stickers)
     {
-        if (const auto it_alias = aliases_.find(_keyword); it_alias != aliases_.end())
+        for (const auto& sticker : _stickers)
         {
-            for (const auto& _emoji : it_alias->second)
-                keywords.push_back(_emoji);
+            if (_types.find(sticker.type_) != _types.end())
+            {
+                if (std::find(_suggest.begin(), _suggest.end(), sticker) == _suggest.end())
+                    _suggest.push_back(sticker);
+            }
         }
-    }
+    };
 
-    for (const auto& kw : keywords)
+    addStickers(keyword->stickers_);
+
+    if (_types.find(SuggestType::suggestWord) != _types.end())
     {
-        if (auto itSuggest = suggests_.find(kw); itSuggest != suggests_.end())
+        for (const auto& emoji : keyword->emoji_)
         {
-            for (const auto& sticker : itSuggest->second)
-            {
-                if (_types.find(sticker.type_) != _types.end())
-                {
-                    if (std::find(_suggest.begin(), _suggest.end(), sticker) == _suggest.end())
-                        _suggest.push_back(sticker);
-                }
-            }
+            if (const auto aliased = keywords_.value(keywords_.find(QStringView(emoji))))
+                addStickers(aliased->stickers_);
         }
     }
 
@@ -1146,7 +1148,7 @@ bool getSuggest(const QString& _keyword, Suggest& _suggest, std::set<SuggestType
     return getCache().getSuggest(_keyword, _suggest, _types);
 }
 
-bool getSuggestWithSettings(const QString& _keyword, Suggest& _suggest)
+bool getSuggestWithSettings(const QString& _keyword, Suggest& _suggest, Utils::PrefixTrieState* _state)
 {
     std::set<SuggestType> types;
 
@@ -1156,7 +1158,7 @@ bool getSuggestWithSettings(const QString& _keyword, Suggest& _suggest)
     if (get_gui_settings()->get_value<bool>(settings_show_suggests_words, true))
         types.insert(SuggestType::suggestWord);
 
-    return getCache().getSuggest(_keyword, _suggest, types);
+    return getCache().getSuggest(_keyword, _suggest, types, _state);
 }
 
 std::string_view recentsStickerSettingsPath()
@@ -3,6 +3,7 @@
 #include "StickerData.h"
 #include "types/StickerId.h"
 #include "utils/utils.h"
+#include "utils/PrefixTrie.h"
 
 #define UI_STICKERS_NS_BEGIN namespace Ui { namespace Stickers {
 #define UI_STICKERS_NS_END } }
@@ -218,11 +219,17 @@ struct StickerInfo
 
 typedef std::vector<StickerInfo> Suggest;
 
-typedef std::map<QString, Suggest> StickersSuggests;
-
 typedef std::vector<QString> EmojiList;
 
-typedef std::map<QString, EmojiList> SuggestsAliases;
+struct SuggestKeyword
+{
+    Suggest stickers_;
+    // emoji the keyword is an alias of
+    EmojiList emoji_;
+};
+
+// emoji, tags and aliases of all languages
+using SuggestsTrie = Utils::PrefixTrie<SuggestKeyword>;
 
 struct StickerLoadData
 {
@@ -231,6 +238,9 @@ struct StickerLoadData
     setSptr set_;
     Utils::FileSharingId fsId_;
     QString path_;
+    // a slice of a set pack when length_ is set
+    qint64 offset_ = 0;
+    qint64 length_ = 0;
     core::sticker_size size_;
     int id_;
     int setId_;
@@ -281,7 +291,7 @@ public:
     void clearCache();
     void clearSetCache(int _setId);
 
-    bool getSuggest(const QString& _keyword, Suggest& _suggest, const std::set<SuggestType>& _types) const;
+    bool getSuggest(const QString& _keyword, Suggest& _suggest, const std::set<SuggestType>& _types, Utils::PrefixTrieState* _state = nullptr) const;
 
     void requestSearch(const QString& _term);
     void requestStickersMeta();
@@ -307,8 +317,7 @@ private:
     setsIdsArray searchSets_;
     int64_t searchSeqId_ = -1;
 
-    StickersSuggests suggests_;
-    SuggestsAliases aliases_;
+    SuggestsTrie keywords_;
 
     StickerLoadDataV batchloadData_;
     QTimer* batchLoadTimer_ = nullptr;
@@ -382,7 +391,8 @@ void resetCache();
 Cache& getCache();
 
 bool getSuggest(const QString& _keyword, Suggest& _suggest, const std::set<SuggestType>& _types);
-bool getSuggestWithSettings(const QString& _keyword, Suggest& _suggest);
+// _state continues the match of the previous keyword of the same input
+bool getSuggestWithSettings(const QString& _keyword, Suggest& _suggest, Utils::PrefixTrieState* _state = nullptr);
 
 std::string_view recentsStickerSettingsPath();
 
@@ -623,7 +623,7 @@ namespace Ui
                         return;
 
                     QPixmap preview;
-                    Utils::loadPixmap(file.readAll(), Out preview, Utils::Exif::getExifOrientation(filePath));
+                    Utils::loadPixmap(file.readAll(), Out preview);
 
                     if (preview.isNull())
                         return;
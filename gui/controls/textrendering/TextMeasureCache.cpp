@@ -0,0 +1,202 @@
+#include "stdafx.h"
+
+#include "TextMeasureCache.h"
+
+namespace
+{
+    constexpr size_t maxCachedFonts() noexcept { return 64; }
+    constexpr size_t maxCachedWidths() noexcept { return 32 * 1024; }
+    constexpr size_t maxCachedBreaks() noexcept { return 4 * 1024; }
+    constexpr int maxCachedWidthTextLength() noexcept { return 128; }
+    constexpr int maxCachedBreakTextLength() noexcept { return 4 * 1024; }
+
+    struct Key
+    {
+        int font_;
+        int width_;
+        QString text_;
+
+        bool operator==(const Key& _other) const noexcept { return font_ == _other.font_ && width_ == _other.width_ && text_ == _other.text_; }
+    };
+
+    struct KeyHasher
+    {
+        size_t operator()(const Key& _key) const noexcept { return qHash(_key.text_, uint(_key.font_) * 31 + uint(_key.width_)); }
+    };
+
+    template <typename Value>
+    class LruMap
+    {
+    public:
+        explicit LruMap(size_t _maxSize) : maxSize_(_maxSize) {}
+
+        const Value* find(const Key& _key)
+        {
+            const auto it = values_.find(_key);
+            if (it == values_.end())
+                return nullptr;
+
+            lru_.splice(lru_.begin(), lru_, it->second.lru_);
+            return &it->second.value_;
+        }
+
+        void insert(Key _key, Value _value)
+        {
+            lru_.push_front(_key);
+            values_.insert({ std::move(_key), Entry{ std::move(_value), lru_.begin() } });
+
+            if (values_.size() > maxSize_)
+            {
+                values_.erase(lru_.back());
+                lru_.pop_back();
+            }
+        }
+
+        void clear()
+        {
+            values_.clear();
+            lru_.clear();
+        }
+
+    private:
+        struct Entry
+        {
+            Value value_;
+            typename std::list<Key>::iterator lru_;
+        };
+
+        size_t maxSize_;
+        std::list<Key> lru_;
+        std::unordered_map<Key, Entry, KeyHasher> values_;
+    };
+
+    class Cache
+    {
+    public:
+        static Cache& instance()
+        {
+            im_assert(QThread::currentThread() == QCoreApplication::instance()->thread());
+
+            static Cache cache;
+            return cache;
+        }
+
+        double textWidth(const QFont& _font, const QString& _text)
+        {
+            const auto font = fontIndex(_font);
+            if (_text.size() > maxCachedWidthTextLength())
+                return fonts_[font].second.horizontalAdvance(_text);
+
+            Key key{ font, 0, _text };
+            if (const auto width = widths_.find(key))
+                return *width;
+
+            const auto width = fonts_[font].second.horizontalAdvance(_text);
+            widths_.insert(std::move(key), width);
+            return width;
+        }
+
+        int fittingLength(const QFont& _font, const QString& _text, int _width)
+        {
+            const auto font = fontIndex(_font);
+            if (_text.size() > maxCachedBreakTextLength())
+                return measureFittingLength(fonts_[font].second, _text, _width);
+
+            Key key{ font, _width, _text };
+            if (const auto length = breaks_.find(key))
+                return *length;
+
+            const auto length = measureFittingLength(fonts_[font].second, _text, _width);
+            breaks_.insert(std::move(key), length);
+            return length;
+        }
+
+        void clear()
+        {
+            widths_.clear();
+            breaks_.clear();
+            fonts_.clear();
+            lastFont_ = -1;
+        }
+
+    private:
+        Cache()
+            : widths_(maxCachedWidths())
+            , breaks_(maxCachedBreaks())
+        {
+        }
+
+        // a layout measures many words in a row in the same font, and there are only a few fonts in use
+        int fontIndex(const QFont& _font)
+        {
+            if (lastFont_ != -1 && fonts_[lastFont_].first == _font)
+                return lastFont_;
+
+            const auto it = std::find_if(fonts_.begin(), fonts_.end(), [&_font](const auto& _f) { return _f.first == _font; });
+            if (it != fonts_.end())
+            {
+                lastFont_ = int(std::distance(fonts_.begin(), it));
+                return lastFont_;
+            }
+
+            // the keys refer to the fonts by index, so the entries go along with the fonts
+            if (fonts_.size() >= maxCachedFonts())
+                clear();
+
+            fonts_.emplace_back(_font, QFontMetricsF(_font));
+            lastFont_ = int(fonts_.size() - 1);
+            return lastFont_;
+        }
+
+        static int measureFittingLength(const QFontMetricsF& _metrics, const QString& _text, int _width)
+        {
+            QString result;
+            int approxWidth = 0;
+            int i = 0;
+            while (i < _text.size() && approxWidth < _width)
+            {
+                auto c = _text[i++];
+                result += c;
+                approxWidth += _metrics.horizontalAdvance(c);
+            }
+
+            i = result.size();
+            while (std::round(_metrics.horizontalAdvance(result)) < _width && i < _text.size())
+                result.push_back(_text[i++]);
+
+            while (!result.isEmpty() && std::round(_metrics.horizontalAdvance(result)) > _width)
+                result.chop(1);
+
+            return int(result.size());
+        }
+
+        std::vector<std::pair<QFont, QFontMetricsF>> fonts_;
+        int lastFont_ = -1;
+        LruMap<double> widths_;
+        LruMap<int> breaks_;
+    };
+}
+
+namespace Ui
+{
+    namespace TextRendering
+    {
+        namespace TextMeasureCache
+        {
+            double textWidth(const QFont& _font, const QString& _text)
+            {
+                return Cache::instance().textWidth(_font, _text);
+            }
+
+            int fittingLength(const QFont& _font, const QString& _text, int _width)
+            {
+                return Cache::instance().fittingLength(_font, _text, _width);
+            }
+
+            void clear()
+            {
+                Cache::instance().clear();
+            }
+        }
+    }
+}
@@ -0,0 +1,20 @@
+#pragma once
+
+namespace Ui
+{
+    namespace TextRendering
+    {
+        // advances and break positions of the words measured by the text layouts; the same words in the same fonts
+        // repeat across the whole history, so they are measured once and kept in a bounded LRU.
+        // GUI thread only, as everything else in TextRendering
+        namespace TextMeasureCache
+        {
+            double textWidth(const QFont& _font, const QString& _text);
+
+            // the number of leading chars of _text which fit into _width, where a word too long for a line is broken
+            int fittingLength(const QFont& _font, const QString& _text, int _width);
+
+            void clear();
+        }
+    }
+}
@@ -2,6 +2,7 @@
 
 #include "TextRenderingUtils.h"
 #include "TextRendering.h"
+#include "TextMeasureCache.h"
 
 #include "styles/ThemesContainer.h"
 
@@ -42,7 +43,7 @@ namespace Ui
 
         double textWidth(const QFont& _font, const QString& _text)
         {
-            return getMetrics(_font).horizontalAdvance(_text);
+            return TextMeasureCache::textWidth(_font, _text);
         }
 
         double textVisibleWidth(const QFont& _font, const QString& _text)
@@ -153,25 +154,7 @@ namespace Ui
 
         QString elideText(const QFont& _font, const QString& _text, int _width)
         {
-            const auto& metrics = getMetrics(_font);
-            QString result;
-            int approxWidth = 0;
-            int i = 0;
-            while (i < _text.size() && approxWidth < _width)
-            {
-                auto c = _text[i++];
-                result += c;
-                approxWidth += metrics.horizontalAdvance(c);
-            }
-
-            i = result.size();
-            while (roundToInt(metrics.horizontalAdvance(result)) < _width && i < _text.size())
-                result.push_back(_text[i++]);
-
-            while (!result.isEmpty() && roundToInt(metrics.horizontalAdvance(result)) > _width)
-                result.chop(1);
-
-            return result;
+            return _text.left(TextMeasureCache::fittingLength(_font, _text, _width));
         }
 
         Data::FStringView elideText(const QFont& _font, Data::FStringView _text, int _width)
@@ -18,10 +18,13 @@
 #include "utils/InterConnector.h"
 #include "utils/LoadPixmapFromDataTask.h"
 #include "utils/LoadPixmapFromFileTask.h"
+#include "utils/ThumbnailCache.h"
 #include "utils/utils.h"
 #include "utils/features.h"
 #include "utils/gui_metrics.h"
 #include "utils/exif.h"
+#include "utils/async/AsyncTask.h"
+#include "utils/profiling/auto_stop_watch.h"
 #include "cache/stickers/stickers.h"
 #include "utils/log/log.h"
 #include "../common.shared/common_defs.h"
@@ -51,6 +54,43 @@ using namespace Ui;
 
 namespace
 {
+    // batches with this many messages or more are unserialized off the gui thread
+    constexpr int32_t asyncMessagesBatchSize = 20;
+
+    int32_t getMessagesBatchSize(const core::coll_helper& _params)
+    {
+        int32_t size = 0;
+        for (auto name : { "messages", "pending_messages", "intro_messages", "modified", "deleted" })
+        {
+            if (_params.is_value_exist(name))
+                size += _params.get_value_as_array(name)->size();
+        }
+        return size;
+    }
+
+    struct MessagesBatch
+    {
+        Data::MessagesResult result_;
+        std::optional<Data::MessageBuddies> deleted_;
+        Data::IncompleteMessages incomplete_;
+    };
+
+    void unserializeMessagesBatch(core::coll_helper& _params, const QString& _myAimid, Out MessagesBatch& _batch, bool _async)
+    {
+        const auto incomplete = _async ? &_batch.incomplete_ : nullptr;
+
+        _batch.result_ = Data::UnserializeMessageBuddies(&_params, _myAimid, incomplete);
+
+        if (_params.is_value_exist("deleted"))
+        {
+            auto deletedArray = _params.get_value_as_array("deleted");
+            const auto theirs_last_delivered = _params.get_value_as_int64("theirs_last_delivered", -1);
+            const auto theirs_last_read = _params.get_value_as_int64("theirs_last_read", -1);
+
+            _batch.deleted_.emplace();
+            Data::unserializeMessages(deletedArray, _batch.result_.aimId, _myAimid, theirs_last_delivered, theirs_last_read, Out *_batch.deleted_, incomplete);
+        }
+    }
     using highlightsV = std::vector<QString>;
     Ui::highlightsV unserializeHighlights(const core::coll_helper& _helper)
     {
@@ -270,6 +310,9 @@ core_dispatcher::core_dispatcher()
     , connectionState_(Ui::ConnectionState::stateConnecting)
     , typingCheckTimer_(new QTimer(this))
 {
+    messagesDecoder_.setMaxThreadCount(1);
+    messagesDecoder_.setExpiryTimeout(-1);
+
     init();
 }
 
@@ -883,6 +926,8 @@ bool core_dispatcher::init()
     typingCheckTimer_->setInterval(typingCheckInterval.count());
     connect(typingCheckTimer_, &QTimer::timeout, this, &core_dispatcher::onTypingCheckTimer);
 
+    connect(&Utils::InterConnector::instance(), &Utils::InterConnector::logout, this, []() { Utils::ThumbnailCache::clear(); });
+
     return true;
 }
 
@@ -1558,6 +1603,7 @@ void core_dispatcher::getMrimKeyResult(const int64_t _seq, core::coll_helper _pa
 void core_dispatcher::onAppConfig(const int64_t _seq, core::coll_helper _params)
 {
     Ui::SetAppConfig(std::make_unique<AppConfig>(_params));
+    Profiling::set_trace_enabled(GetAppConfig().TraceEventsEnabled());
 
     Q_EMIT appConfig();
 
@@ -1602,7 +1648,10 @@ void core_dispatcher::onMessagesReceivedSenders(const int64_t _seq, core::coll_h
     if (_params.is_value_exist("senders"))
         sendersAimIds = Utils::toContainerOfString<QVector<QString>>(_params.get_value_as_array("senders"));
 
-    Q_EMIT messagesReceived(aimId, sendersAimIds);
+    emitMessagesSignal([this, aimId, sendersAimIds = std::move(sendersAimIds)]()
+    {
+        Q_EMIT messagesReceived(aimId, sendersAimIds);
+    });
 }
 
 void core_dispatcher::onTyping(const int64_t _seq, core::coll_helper _params)
@@ -1743,7 +1792,14 @@ void core_dispatcher::received(const QString& _receivedMessage, const qint64 _se
 
     core::coll_helper collParams(_params, true);
 
-    if (const auto iter_handler = messages_map_.find(_receivedMessage.toStdString()); iter_handler != messages_map_.end())
+    const auto message = _receivedMessage.toStdString();
+
+    // the span is sent to the core with gui timestamps and shows up in its trace as an async span
+    std::optional<Profiling::auto_stop_watch> traceSpan;
+    if (Profiling::is_trace_enabled())
+        traceSpan.emplace(message.c_str());
+
+    if (const auto iter_handler = messages_map_.find(message); iter_handler != messages_map_.end())
         iter_handler->second(_seq, collParams);
 }
 
@@ -1862,6 +1918,9 @@ void core_dispatcher::onImCreated(const int64_t _seq, core::coll_helper _params)
 {
     isImCreated_ = true;
 
+    if (_params.is_value_exist("cache_path"))
+        Utils::ThumbnailCache::setDir(QString::fromUtf8(_params.get_value_as_string("cache_path")) % u"/thumbnails");
+
     Q_EMIT im_created();
 }
 
@@ -1978,29 +2037,79 @@ void core_dispatcher::onArchiveMessages(Ui::MessagesBuddiesOpt _type, const int6
 {
     const auto myAimid = _params.get<QString>("my_aimid");
 
-    auto result = Data::UnserializeMessageBuddies(&_params, myAimid);
-
-    if (!result.introMessages.isEmpty() && !result.messages.isEmpty() && std::as_const(result.messages).front()->Prev_ == std::as_const(result.introMessages).back()->Id_)
+    // small batches are unserialized in place unless earlier batches are still queued in the decoder
+    if (messagesSignals_.empty() && getMessagesBatchSize(_params) < asyncMessagesBatchSize)
     {
-        std::move(result.messages.begin(), result.messages.end(), std::back_inserter(result.introMessages));
-        result.messages = std::move(result.introMessages);
+        QElapsedTimer timer;
+        timer.start();
+
+        MessagesBatch batch;
+        unserializeMessagesBatch(_params, myAimid, Out batch, false);
+        emitArchiveMessages(_type, _seq, batch.result_, batch.deleted_);
+
+        __TRACE("delivery", "messages batch handled on gui thread in " << timer.nsecsElapsed() / 1000 << " us");
+        return;
     }
 
-    Q_EMIT messageBuddies(result.messages, result.aimId, _type, result.havePending, _seq, result.lastMsgId);
+    auto signal = std::make_shared<std::function<void()>>();
+    messagesSignals_.push_back(signal);
 
-    if (_params.is_value_exist("deleted"))
+    auto task = [this, _type, _seq, _params, myAimid, signal]() mutable
     {
-        Data::MessageBuddies deleted;
+        auto batch = std::make_shared<MessagesBatch>();
+        unserializeMessagesBatch(_params, myAimid, Out *batch, true);
+
+        // _params owns the collections the incomplete messages refer to, so it goes back along with them
+        QMetaObject::invokeMethod(this, [this, _type, _seq, _params, myAimid, batch, signal]()
+        {
+            QElapsedTimer timer;
+            timer.start();
+
+            Data::completeMessages(batch->incomplete_, myAimid);
+            *signal = [this, _type, _seq, _params, batch]()
+            {
+                emitArchiveMessages(_type, _seq, batch->result_, batch->deleted_);
+            };
+            flushMessagesSignals();
+
+            __TRACE("delivery", "messages batch handled on gui thread in " << timer.nsecsElapsed() / 1000 << " us");
+        }, Qt::QueuedConnection);
+    };
+    messagesDecoder_.start(std::make_unique<Async::Runnable<decltype(task)>>(std::move(task)).release());
+}
 
-        auto deletedArray = _params.get_value_as_array("deleted");
-        const auto theirs_last_delivered = _params.get_value_as_int64("theirs_last_delivered", -1);
-        const auto theirs_last_read = _params.get_value_as_int64("theirs_last_read", -1);
+void core_dispatcher::emitMessagesSignal(std::function<void()> _emit)
+{
+    if (messagesSignals_.empty())
+        _emit();
+    else
+        messagesSignals_.push_back(std::make_shared<std::function<void()>>(std::move(_emit)));
+}
 
-        Data::unserializeMessages(deletedArray, result.aimId, myAimid, theirs_last_delivered, theirs_last_read, Out deleted);
+void core_dispatcher::flushMessagesSignals()
+{
+    while (!messagesSignals_.empty() && *messagesSignals_.front())
+    {
+        const auto signal = std::move(messagesSignals_.front());
+        messagesSignals_.pop_front();
+        (*signal)();
+    }
+}
 
-        Q_EMIT messagesDeleted(result.aimId, deleted);
+void core_dispatcher::emitArchiveMessages(Ui::MessagesBuddiesOpt _type, const int64_t _seq, Data::MessagesResult& _result, std::optional<Data::MessageBuddies>& _deleted)
+{
+    auto& result = _result;
+    if (!result.introMessages.isEmpty() && !result.messages.isEmpty() && std::as_const(result.messages).front()->Prev_ == std::as_const(result.introMessages).back()->Id_)
+    {
+        std::move(result.messages.begin(), result.messages.end(), std::back_inserter(result.introMessages));
+        result.messages = std::move(result.introMessages);
     }
 
+    Q_EMIT messageBuddies(result.messages, result.aimId, _type, result.havePending, _seq, result.lastMsgId);
+
+    if (_deleted)
+        Q_EMIT messagesDeleted(result.aimId, *_deleted);
+
     if (!result.modifications.isEmpty())
         Q_EMIT messagesModified(result.aimId, result.modifications);
 }
@@ -2090,19 +2199,20 @@ void core_dispatcher::onMessagesReceivedDlgState(const int64_t _seq, core::coll_
 
 void core_dispatcher::onMessagesReceivedServer(const int64_t _seq, core::coll_helper _params)
 {
-    const auto result = Data::UnserializeServerMessagesIds(_params);
-
-    if (!result.AllIds_.isEmpty())
+    emitMessagesSignal([this, _seq, result = Data::UnserializeServerMessagesIds(_params)]()
     {
-        im_assert(std::is_sorted(result.AllIds_.begin(), result.AllIds_.end()));
-        Q_EMIT messageIdsFromServer(result.AllIds_, result.AimId_, _seq);
-    }
+        if (!result.AllIds_.isEmpty())
+        {
+            im_assert(std::is_sorted(result.AllIds_.begin(), result.AllIds_.end()));
+            Q_EMIT messageIdsFromServer(result.AllIds_, result.AimId_, _seq);
+        }
 
-    if (!result.Deleted_.isEmpty())
-        Q_EMIT messagesDeleted(result.AimId_, result.Deleted_);
+        if (!result.Deleted_.isEmpty())
+            Q_EMIT messagesDeleted(result.AimId_, result.Deleted_);
 
-    if (!result.Modifications_.isEmpty())
-        Q_EMIT messagesModified(result.AimId_, result.Modifications_);
+        if (!result.Modifications_.isEmpty())
+            Q_EMIT messagesModified(result.AimId_, result.Modifications_);
+    });
 }
 
 void core_dispatcher::onMessagesReceivedSearch(const int64_t _seq, core::coll_helper _params)
@@ -2112,32 +2222,43 @@ void core_dispatcher::onMessagesReceivedSearch(const int64_t _seq, core::coll_he
 
 void core_dispatcher::onMessagesClear(const int64_t _seq, core::coll_helper _params)
 {
-    Q_EMIT messagesClear(_params.get<QString>("contact"), _seq);
+    emitMessagesSignal([this, _seq, contact = _params.get<QString>("contact")]()
+    {
+        Q_EMIT messagesClear(contact, _seq);
+    });
 }
 
 void core_dispatcher::onMessagesEmpty(const int64_t _seq, core::coll_helper _params)
 {
-    Q_EMIT messagesEmpty(_params.get<QString>("contact"), _seq);
+    emitMessagesSignal([this, _seq, contact = _params.get<QString>("contact")]()
+    {
+        Q_EMIT messagesEmpty(contact, _seq);
+    });
 }
 
 void core_dispatcher::onMessagesReceivedUpdated(const int64_t _seq, core::coll_helper _params)
 {
-    const auto result = Data::UnserializeServerMessagesIds(_params);
-    if (!result.AllIds_.isEmpty())
-        Q_EMIT messageIdsUpdated(result.AllIds_, result.AimId_, _seq);
+    emitMessagesSignal([this, _seq, result = Data::UnserializeServerMessagesIds(_params)]()
+    {
+        if (!result.AllIds_.isEmpty())
+            Q_EMIT messageIdsUpdated(result.AllIds_, result.AimId_, _seq);
 
-    if (!result.Deleted_.isEmpty())
-        Q_EMIT messagesDeleted(result.AimId_, result.Deleted_);
+        if (!result.Deleted_.isEmpty())
+            Q_EMIT messagesDeleted(result.AimId_, result.Deleted_);
 
-    if (!result.Modifications_.isEmpty())
-        Q_EMIT messagesModified(result.AimId_, result.Modifications_);
+        if (!result.Modifications_.isEmpty())
+            Q_EMIT messagesModified(result.AimId_, result.Modifications_);
+    });
 }
 
 void core_dispatcher::onMessagesReceivedPatched(const int64_t _seq, core::coll_helper _params)
 {
     Data::PatchedMessage patches;
     patches.unserialize(_params);
-    Q_EMIT messagesPatched(patches);
+    emitMessagesSignal([this, patches = std::move(patches)]()
+    {
+        Q_EMIT messagesPatched(patches);
+    });
 }
 
 void core_dispatcher::onArchiveMessagesPending(const int64_t _seq, core::coll_helper _params)
@@ -2158,18 +2279,25 @@ void core_dispatcher::onMessagesReceivedContext(const int64_t _seq, core::coll_h
 void core_dispatcher::onMessagesContextError(const int64_t _seq, core::coll_helper _params)
 {
     const auto net_error = _params.get_value_as_bool("is_network_error") ? MessagesNetworkError::Yes : MessagesNetworkError::No;
-    Q_EMIT messageContextError(_params.get<QString>("contact"), _seq, _params.get_value_as_int64("id"), net_error);
+    emitMessagesSignal([this, _seq, net_error, contact = _params.get<QString>("contact"), id = _params.get_value_as_int64("id")]()
+    {
+        Q_EMIT messageContextError(contact, _seq, id, net_error);
+    });
 }
 
 void core_dispatcher::onMessagesLoadAfterSearchError(const int64_t _seq, core::coll_helper _params)
 {
     const auto net_error = _params.get_value_as_bool("is_network_error") ? MessagesNetworkError::Yes : MessagesNetworkError::No;
-    Q_EMIT messageLoadAfterSearchError(_params.get<QString>("contact"),
+    emitMessagesSignal([this,
         _seq,
-        _params.get_value_as_int64("from"),
-        _params.get_value_as_int64("count_later"),
-        _params.get_value_as_int64("count_early"),
-        net_error);
+        net_error,
+        contact = _params.get<QString>("contact"),
+        from = _params.get_value_as_int64("from"),
+        countLater = _params.get_value_as_int64("count_later"),
+        countEarly = _params.get_value_as_int64("count_early")]()
+    {
+        Q_EMIT messageLoadAfterSearchError(contact, _seq, from, countLater, countEarly, net_error);
+    });
 }
 
 void core_dispatcher::onMessagesReceivedMessageStatus(const int64_t _seq, core::coll_helper _params)
@@ -2185,7 +2313,10 @@ void core_dispatcher::onMessagesDelUpTo(const int64_t _seq, core::coll_helper _p
     const auto contact = _params.get<QString>("contact");
     im_assert(!contact.isEmpty());
 
-    Q_EMIT messagesDeletedUpTo(contact, id);
+    emitMessagesSignal([this, contact, id]()
+    {
+        Q_EMIT messagesDeletedUpTo(contact, id);
+    });
 }
 
 void core_dispatcher::onDlgStates(const int64_t _seq, core::coll_helper _params)
@@ -3581,7 +3712,10 @@ void Ui::core_dispatcher::onFilesharingUploadAborted(const int64_t _seq, core::c
 
     message->InternalId_ = QString::fromUtf8(_params.get_value_as_string("id"));
 
-    Q_EMIT messagesDeleted(QString::fromUtf8(_params.get_value_as_string("contact")), { message });
+    emitMessagesSignal([this, message, contact = QString::fromUtf8(_params.get_value_as_string("contact"))]()
+    {
+        Q_EMIT messagesDeleted(contact, { message });
+    });
 }
 
 void core_dispatcher::onPollGetResult(const int64_t _seq, core::coll_helper _params)
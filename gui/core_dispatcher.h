@@ -526,6 +526,11 @@ Q_SIGNALS:
         void invokePreviousState();
 
         void onArchiveMessages(Ui::MessagesBuddiesOpt _type, const int64_t _seq, core::coll_helper _params);
+        void emitArchiveMessages(Ui::MessagesBuddiesOpt _type, const int64_t _seq, Data::MessagesResult& _result, std::optional<Data::MessageBuddies>& _deleted);
+
+        // emits right away if no batch is in the decoder, otherwise after the queued batches
+        void emitMessagesSignal(std::function<void()> _emit);
+        void flushMessagesSignals();
 
         void getCodeByPhoneCall(const QString& _ivr_url);
 
@@ -935,6 +940,14 @@ Q_SIGNALS:
         ConnectionState connectionState_;
 
         QTimer* typingCheckTimer_;
+
+        // unserializes large message batches off the gui thread;
+        // it has a single thread so batches come out in the order they arrived
+        QThreadPool messagesDecoder_;
+
+        // the message signals in the order of the core: a batch in the decoder holds an empty slot,
+        // the signals after it (a clear, a del up to, ids from the server) wait until it is filled
+        std::deque<std::shared_ptr<std::function<void()>>> messagesSignals_;
     };
 
     core_dispatcher* GetDispatcher();
@@ -22,6 +22,10 @@
 
 namespace
 {
+    // the order settles down after a burst of dlg states before it is sent to the core
+    constexpr std::chrono::milliseconds prefetchCandidatesDelay = std::chrono::seconds(2);
+    constexpr int maxPrefetchCandidates = 20;
+
     auto isEqualDlgState = [](const auto& _aimId)
     {
         return [&_aimId](const auto& _dlgState) { return _aimId == _dlgState.AimId_; };
@@ -56,6 +60,7 @@ namespace Logic
         , needToAddFavorites_(true)
         , favoritesLastMessageSeq_(-1)
         , refreshTimer_(nullptr)
+        , prefetchTimer_(new QTimer(this))
     {
         PinnedVisible_ = Ui::get_gui_settings()->get_value(settings_pinned_chats_visible, true);
         UnimportantVisible_ = Ui::get_gui_settings()->get_value(settings_unimportant_visible, true);
@@ -85,6 +90,13 @@ namespace Logic
 
         scheduleRefreshTimer();
 
+        prefetchTimer_->setSingleShot(true);
+        prefetchTimer_->setInterval(prefetchCandidatesDelay);
+        connect(prefetchTimer_, &QTimer::timeout, this, &RecentsModel::sendPrefetchCandidates);
+        connect(this, &RecentsModel::orderChanged, this, &RecentsModel::schedulePrefetchCandidates);
+        connect(this, &RecentsModel::updated, this, &RecentsModel::schedulePrefetchCandidates);
+        connect(this, &RecentsModel::readStateChanged, this, &RecentsModel::schedulePrefetchCandidates);
+
         connect(&Utils::InterConnector::instance(), &Utils::InterConnector::omicronUpdated, this, &RecentsModel::initPinnedItemsIndexes);
         connect(Ui::GetDispatcher(), &Ui::core_dispatcher::externalUrlConfigUpdated, this, &RecentsModel::initPinnedItemsIndexes);
         initPinnedItemsIndexes();
@@ -161,6 +173,13 @@ namespace Logic
 
         updateIndex(_new);
         updateIndex(_prev);
+
+        // the neighbours are the ones opened next by the keyboard shortcuts
+        if (!_new.isEmpty())
+        {
+            hintHistoryPrefetch(nextAimId(_new));
+            hintHistoryPrefetch(prevAimId(_new));
+        }
     }
 
     void RecentsModel::contactAvatarChanged(const QString& _aimid)
@@ -1412,6 +1431,52 @@ namespace Logic
         Q_EMIT updated();
     }
 
+    void RecentsModel::hintHistoryPrefetch(const QString& _aimId)
+    {
+        if (_aimId.isEmpty() || _aimId == lastPrefetchHint_ || ServiceContacts::isServiceContact(_aimId))
+            return;
+
+        lastPrefetchHint_ = _aimId;
+
+        Ui::gui_coll_helper collection(Ui::GetDispatcher()->create_collection(), true);
+        collection.set_value_as_qstring("contact", _aimId);
+        Ui::GetDispatcher()->post_message_to_core("archive/prefetch/hint", collection.get());
+    }
+
+    void RecentsModel::schedulePrefetchCandidates()
+    {
+        if (!prefetchTimer_->isActive())
+            prefetchTimer_->start();
+    }
+
+    void RecentsModel::sendPrefetchCandidates()
+    {
+        Ui::gui_coll_helper collection(Ui::GetDispatcher()->create_collection(), true);
+
+        core::ifptr<core::iarray> contacts(collection->create_array());
+        contacts->reserve(std::min(int(Dialogs_.size()), maxPrefetchCandidates));
+        for (const auto& dlg : Dialogs_)
+        {
+            if (contacts->size() >= maxPrefetchCandidates)
+                break;
+
+            if (isSpecialAndHidden(dlg) || ServiceContacts::isServiceContact(dlg.AimId_))
+                continue;
+
+            core::ifptr<core::icollection> contactCollection(collection->create_collection());
+            Ui::gui_coll_helper coll(contactCollection.get(), false);
+            coll.set_value_as_qstring("contact", dlg.AimId_);
+            coll.set_value_as_int("unread_count", int(dlg.UnreadCount_));
+
+            core::ifptr<core::ivalue> val(collection->create_value());
+            val->set_as_collection(contactCollection.get());
+            contacts->push_back(val.get());
+        }
+        collection.set_value_as_array("contacts", contacts.get());
+
+        Ui::GetDispatcher()->post_message_to_core("archive/prefetch/candidates", collection.get());
+    }
+
     int RecentsModel::dialogsCount() const
     {
         return int(Dialogs_.size());
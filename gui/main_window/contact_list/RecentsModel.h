@@ -141,6 +141,9 @@ namespace Logic
 
         int dialogsCount() const;
 
+        // tells the core the chat may be opened soon, so its history is read ahead
+        void hintHistoryPrefetch(const QString& _aimId);
+
     private:
         int correctIndex(int i) const;
         int getVisibleIndex(int i) const;
@@ -161,6 +164,8 @@ namespace Logic
         int remindersItemIndex() const;
 
         void scheduleRefreshTimer();
+        void schedulePrefetchCandidates();
+        void sendPrefetchCandidates();
         void makeIndexes();
         void requestFavoritesLastMessage();
 
@@ -179,6 +184,8 @@ namespace Logic
 
         std::map<QString, Recents::FriendlyItemText> friendlyTexts_;
         QTimer* refreshTimer_;
+        QTimer* prefetchTimer_;
+        QString lastPrefetchHint_;
 
         std::unordered_map<Data::DlgState::PinnedServiceItemType, size_t> pinnedItemsIndexes_;
 
@@ -61,6 +61,10 @@ namespace
 
     constexpr std::chrono::milliseconds dragActivateDelay = std::chrono::milliseconds(500);
 
+    // the cursor has to rest on a chat this long before its history is prefetched,
+    // so sweeping over the list does not push the top chats out of the warm set
+    constexpr std::chrono::milliseconds prefetchHoverDelay = std::chrono::milliseconds(300);
+
     QString contactForDrop(const QModelIndex& _index)
     {
         if (!_index.isValid())
@@ -159,6 +163,7 @@ namespace Ui
         , transitionLabel_(nullptr)
         , transitionAnim_(nullptr)
         , tooltipTimer_(nullptr)
+        , prefetchHoverTimer_(new QTimer(this))
         , currentTab_(RECENTS)
         , prevTab_(RECENTS)
         , pictureOnlyView_(false)
@@ -281,6 +286,13 @@ namespace Ui
         scrollTimer_->setSingleShot(false);
         connect(scrollTimer_, &QTimer::timeout, this, &RecentsTab::autoScroll);
 
+        prefetchHoverTimer_->setInterval(prefetchHoverDelay);
+        prefetchHoverTimer_->setSingleShot(true);
+        connect(prefetchHoverTimer_, &QTimer::timeout, this, [this]()
+        {
+            Logic::getRecentsModel()->hintHistoryPrefetch(prefetchHoverAimId_);
+        });
+
         connect(GetDispatcher(), &core_dispatcher::messagesReceived, this, &RecentsTab::messagesReceived);
 
         connect(&Utils::InterConnector::instance(), &Utils::InterConnector::unknownsGoSeeThem, this, &RecentsTab::switchToUnknowns);
@@ -1178,6 +1190,9 @@ namespace Ui
     void RecentsTab::leaveEvent(QEvent*)
     {
         hideTooltip();
+
+        prefetchHoverTimer_->stop();
+        prefetchHoverAimId_.clear();
     }
 
     void RecentsTab::setSearchInAllDialogs()
@@ -1374,6 +1389,20 @@ namespace Ui
     {
         setKeyboardFocused(false);
 
+        if (const auto rcntModel = qobject_cast<const Logic::RecentsModel*>(_index.model()); rcntModel && !rcntModel->isServiceItem(_index))
+        {
+            if (auto aimId = Logic::aimIdFromIndex(_index); aimId != prefetchHoverAimId_)
+            {
+                prefetchHoverAimId_ = std::move(aimId);
+                prefetchHoverTimer_->start();
+            }
+        }
+        else
+        {
+            prefetchHoverTimer_->stop();
+            prefetchHoverAimId_.clear();
+        }
+
         if (Statuses::isStatusEnabled())
         {
             const auto model = qobject_cast<Logic::CustomAbstractListModel*>(recentsView_->model());
@@ -210,6 +210,9 @@ namespace Ui
         QTimer* tooltipTimer_;
         QModelIndex tooltipIndex_;
 
+        QTimer* prefetchHoverTimer_;
+        QString prefetchHoverAimId_;
+
         int currentTab_;
         int prevTab_;
         bool pictureOnlyView_;
@@ -55,10 +55,12 @@
 #include "../../styles/ThemeParameters.h"
 #include "../../styles/ThemesContainer.h"
 #include "../../app_config.h"
+#include "../../memory_stats/MessageItemMemMonitor.h"
 
 #include "history/Heads.h"
 #include "history/MessageReader.h"
 #include "history/MessageBuilder.h"
+#include "history/ItemsPool.h"
 #include "history/DateInserter.h"
 
 #include "main_window/smartreply/SmartReplyWidget.h"
@@ -117,6 +119,10 @@ namespace
     constexpr std::chrono::milliseconds getLoaderOverlayDelay() noexcept { return std::chrono::milliseconds(200); }
     constexpr std::chrono::milliseconds overlayUpdateTimeout() noexcept { return std::chrono::milliseconds(500); }
 
+    // the scripted scroll: a page up every step through the history, then as many pages back down
+    constexpr std::chrono::milliseconds scrollTestStepInterval() noexcept { return std::chrono::milliseconds(50); }
+    constexpr int scrollTestPages = 200;
+
     void sendSmartreplyStats(const Data::SmartreplySuggest& _suggest)
     {
         using namespace core::stats;
@@ -391,6 +397,7 @@ namespace Ui
         , heads_(new Heads::HeadContainer(_aimId, this))
         , reader_(new hist::MessageReader(_aimId, this))
         , history_(new hist::History(_aimId, this))
+        , itemsPool_(std::make_unique<hist::ItemsPool>())
         , activeCallPlate_(new ActiveCallPlate(_aimId, this))
     {
         auto layout = Utils::emptyVLayout(this);
@@ -509,6 +516,7 @@ namespace Ui
         });
 
         connect(&Utils::InterConnector::instance(), &Utils::InterConnector::sendBotCommand, this, &HistoryControlPage::sendBotCommand);
+        connect(&Utils::InterConnector::instance(), &Utils::InterConnector::scrollHistoryTest, this, &HistoryControlPage::onScrollTest);
         connect(&Utils::InterConnector::instance(), &Utils::InterConnector::startBot, this, &HistoryControlPage::startBot);
 
         connect(&Utils::InterConnector::instance(), &Utils::InterConnector::multiselectChanged, this, &HistoryControlPage::multiselectChanged);
@@ -789,6 +797,8 @@ namespace Ui
 
     void HistoryControlPage::updateWidgetsTheme()
     {
+        itemsPool_->clear();
+
         messagesArea_->enumerateWidgets([](QWidget *widget, const bool)
         {
             if (auto item = qobject_cast<Ui::HistoryControlPageItem*>(widget))
@@ -959,6 +969,24 @@ namespace Ui
         messagesArea_->removeWidgets(_keys);
     }
 
+    void HistoryControlPage::recycleWidgetsByKeys(const QVector<Logic::MessageKey>& _keys)
+    {
+        for (auto widget : messagesArea_->takeWidgets(_keys))
+        {
+            if (auto item = qobject_cast<Ui::ComplexMessage::ComplexMessageItem*>(widget); item && item->isRecyclable())
+            {
+                disconnect(item, nullptr, this, nullptr);
+                if (itemsPool_->park(item))
+                    continue;
+            }
+
+#ifdef IM_AUTO_TESTING
+            widget->setParent(nullptr);
+#endif //IM_AUTO_TESTING
+            widget->deleteLater();
+        }
+    }
+
     void HistoryControlPage::replaceExistingWidgetByKey(const Logic::MessageKey& _key, std::unique_ptr<QWidget> _widget)
     {
         im_assert(_key.hasId());
@@ -1249,7 +1277,7 @@ namespace Ui
         return { Logic::MessageKey(_id, Logic::control_type::ct_new_messages), hist::MessageBuilder::createNew(_aimId, _width, _parent) };
     }
 
-    static InsertHistMessagesParams::WidgetsList makeWidgets(const QString& _aimId, const Data::MessageBuddies& _messages, int _width, Heads::HeadContainer* headsContainer, std::optional<qint64> _newPlateId, QWidget* _parent)
+    static InsertHistMessagesParams::WidgetsList makeWidgets(const QString& _aimId, const Data::MessageBuddies& _messages, int _width, Heads::HeadContainer* headsContainer, std::optional<qint64> _newPlateId, QWidget* _parent, hist::ItemsPool* _pool = nullptr)
     {
         const auto& heads = headsContainer->headsById();
 
@@ -1257,7 +1285,7 @@ namespace Ui
         widgets.reserve(_messages.size() + (_newPlateId ? 1 : 0));
         for (const auto& msg : _messages)
         {
-            if (auto item = hist::MessageBuilder::makePageItem(*msg, _width, _parent))
+            if (auto item = hist::MessageBuilder::makePageItem(*msg, _width, _parent, _pool))
             {
                 if (const auto it = heads.find(item->getId()); it != heads.end())
                     item->setHeads(it.value());
@@ -1669,7 +1697,7 @@ namespace Ui
 
             keys.erase(lastMessIt);
             cancelWidgetRequests(keys);
-            removeWidgetByKeys(keys);
+            recycleWidgetsByKeys(keys);
         }
     }
 
@@ -1691,7 +1719,7 @@ namespace Ui
 
             keys.erase(lastMessIt);
             cancelWidgetRequests(keys);
-            removeWidgetByKeys(keys);
+            recycleWidgetsByKeys(keys);
         }
     }
 
@@ -1964,6 +1992,7 @@ namespace Ui
         std::scoped_lock lock(*(messagesArea_->getLayout()));
 
         messagesArea_->removeAll();
+        itemsPool_->clear();
 
         setHighlights({});
 
@@ -1989,7 +2018,7 @@ namespace Ui
                 std::scoped_lock lock(*(messagesArea_->getLayout()));
 
                 InsertHistMessagesParams params;
-                params.widgets = makeWidgets(aimId_, buddies, width(), heads_, newPlateId_, messagesArea_);
+                params.widgets = makeWidgets(aimId_, buddies, width(), heads_, newPlateId_, messagesArea_, itemsPool_.get());
                 params.newPlateId = newPlateId_;
 
                 params.updateExistingOnly = false;
@@ -3380,6 +3409,35 @@ namespace Ui
             updateFonts();
     }
 
+    void HistoryControlPage::onScrollTest(const QString& _aimId)
+    {
+        if (aimId_ != _aimId || scrollTestTimer_)
+            return;
+
+        MessageItemMemMonitor::instance().resetItemsRate();
+
+        scrollTestTimer_ = new QTimer(this);
+        scrollTestTimer_->setInterval(scrollTestStepInterval());
+        connect(scrollTestTimer_, &QTimer::timeout, this, [this, step = 0]() mutable
+        {
+            const auto direction = step < scrollTestPages ? ScrollDirection::UP : ScrollDirection::DOWN;
+            messagesArea_->scroll(direction, messagesArea_->height());
+
+            if (++step < scrollTestPages * 2)
+                return;
+
+            scrollTestTimer_->deleteLater();
+            scrollTestTimer_ = nullptr;
+
+            const auto rate = MessageItemMemMonitor::instance().getItemsRate();
+            Log::write_network_log(su::concat("history-scroll-test <", aimId_.toStdString(), "> ", std::to_string(scrollTestPages * 2), " pages"
+                ", items created/s ", std::to_string(qRound(rate.created_)),
+                ", recycled/s ", std::to_string(qRound(rate.recycled_)),
+                ", pooled ", std::to_string(rate.pooled_), "\r\n"));
+        });
+        scrollTestTimer_->start();
+    }
+
     void Ui::HistoryControlPage::onRoleChanged(const QString& _aimId)
     {
         if (aimId_ != _aimId)
@@ -3572,6 +3630,8 @@ namespace Ui
         if (!fontsHaveChanged_)
             return;
 
+        itemsPool_->clear();
+
         messagesArea_->enumerateWidgets([](QWidget *widget, const bool)
         {
             if (auto item = qobject_cast<Ui::HistoryControlPageItem*>(widget))
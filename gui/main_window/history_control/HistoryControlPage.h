@@ -41,6 +41,7 @@ namespace hist
 {
     class MessageReader;
     class History;
+    class ItemsPool;
     enum class scroll_mode_type;
     enum class FetchDirection;
 }
@@ -253,6 +254,7 @@ namespace Ui
 
         void onGlobalThemeChanged();
         void onFontParamsChanged();
+        void onScrollTest(const QString& _aimId);
 
         void onRoleChanged(const QString& _aimId);
         void onMessageBuddies(const Data::MessageBuddies& _buddies, const QString& _aimId, Ui::MessagesBuddiesOpt _option, bool _havePending, qint64 _seq, int64_t _last_msgid);
@@ -476,6 +478,7 @@ namespace Ui
         WidgetRemovalResult removeExistingWidgetByKey(const Logic::MessageKey& _key);
         void cancelWidgetRequests(const QVector<Logic::MessageKey>&);
         void removeWidgetByKeys(const QVector<Logic::MessageKey>&);
+        void recycleWidgetsByKeys(const QVector<Logic::MessageKey>&);
         void replaceExistingWidgetByKey(const Logic::MessageKey& _key, std::unique_ptr<QWidget> _widget);
 
         void loadChatInfo();
@@ -617,6 +620,7 @@ namespace Ui
 
         hist::MessageReader* reader_ = nullptr;
         hist::History* history_ = nullptr;
+        std::unique_ptr<hist::ItemsPool> itemsPool_;
 
         highlightsV highlights_;
 
@@ -650,6 +654,7 @@ namespace Ui
 
         DragOverlayWindow* dragOverlayWindow_ = nullptr;
         QTimer* overlayUpdateTimer_ = nullptr;
+        QTimer* scrollTestTimer_ = nullptr;
 
         friend class MessagesWidgetEventFilter;
     };
@@ -152,6 +152,43 @@ namespace Ui
             Logic::ThreadSubContainer::instance().unsubscribe(getThreadId());
     }
 
+    void HistoryControlPageItem::resetForReuse()
+    {
+        im_assert(!hasThread());
+
+        Selected_ = false;
+        selectedTop_ = false;
+        selectedBottom_ = false;
+        hoveredTop_ = false;
+        hoveredBottom_ = false;
+        intersected_ = false;
+        wasSelected_ = false;
+        prevTo_ = QPoint();
+        prevFrom_ = QPoint();
+
+        heads_.clear();
+
+        lastStatus_ = LastStatus::None;
+        if (lastStatusAnimation_)
+            lastStatusAnimation_->setLastStatus(lastStatus_);
+
+        if (reactions_)
+        {
+            reactions_->deleteControls();
+            reactions_.reset();
+        }
+
+        if (cornerMenuHoverTimer_)
+            cornerMenuHoverTimer_->stop();
+        if (cornerMenu_)
+            cornerMenu_->forceHide();
+
+        prev_ = Logic::MessageKey();
+        next_ = Logic::MessageKey();
+        msg_ = Data::MessageBuddy();
+        initialized_ = false;
+    }
+
     bool HistoryControlPageItem::isOutgoingPosition() const
     {
         return msg_.isOutgoingPosition();
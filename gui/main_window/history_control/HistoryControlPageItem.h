@@ -131,6 +131,9 @@ namespace Ui
 
         virtual void cancelRequests() {}
 
+        // drops per-message state before the widget is bound to another message
+        virtual void resetForReuse();
+
         static QMap<QString, QVariant> makeData(const QString& _command, const QString& _arg = QString());
 
         bool isChainedToPrevMessage() const;
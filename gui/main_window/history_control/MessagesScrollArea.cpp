@@ -610,6 +610,18 @@ namespace Ui
     }
 
     void MessagesScrollArea::removeWidgets(const QVector<Logic::MessageKey>& keys)
+    {
+        const auto widgets = takeWidgets(keys);
+        std::for_each(widgets.begin(), widgets.end(), [](auto w)
+        {
+#ifdef IM_AUTO_TESTING
+            w->setParent(nullptr);
+#endif //IM_AUTO_TESTING
+            w->deleteLater();
+        });
+    }
+
+    std::vector<QWidget*> MessagesScrollArea::takeWidgets(const QVector<Logic::MessageKey>& keys)
     {
         std::vector<QWidget*> widgets;
         widgets.reserve(keys.size());
@@ -622,15 +634,10 @@ namespace Ui
             }
         }
         Layout_->removeWidgets(widgets);
-        std::for_each(widgets.begin(), widgets.end(), [](auto w)
-        {
-#ifdef IM_AUTO_TESTING
-            w->setParent(nullptr);
-#endif //IM_AUTO_TESTING
-            w->deleteLater();
-        });
 
         Q_EMIT widgetRemoved();
+
+        return widgets;
     }
 
     void MessagesScrollArea::removeAll()
@@ -140,6 +140,7 @@ namespace Ui
         void removeWidget(QWidget *widget);
         void cancelWidgetRequests(const QVector<Logic::MessageKey>&);
         void removeWidgets(const QVector<Logic::MessageKey>&);
+        [[nodiscard]] std::vector<QWidget*> takeWidgets(const QVector<Logic::MessageKey>&);
 
         void removeAll();
 
@@ -36,6 +36,11 @@ namespace
 {
     constexpr std::chrono::milliseconds scrollActivityTimeout = std::chrono::seconds(1);
 
+    // on resize only items near the viewport are laid out at once,
+    // the rest is relaid out in slices of this duration, nearest first
+    constexpr std::chrono::milliseconds deferredWidthSlice() { return std::chrono::milliseconds(8); }
+    int deferredWidthMargin() { return Utils::scale_value(400); }
+
     int smartreplyTopMargin() { return Utils::scale_value(16); }
     constexpr std::chrono::milliseconds smartreplyAnimDuration() { return std::chrono::milliseconds(150); }
 
@@ -100,6 +105,7 @@ namespace Ui
         , IsHovered_(false)
         , IsActive_(false)
         , isVisibleEnoughForRead_(false)
+        , IsWidthDirty_(false)
     {
         im_assert(Widget_);
     }
@@ -162,6 +168,10 @@ namespace Ui
         resetScrollActivityTimer_.setInterval(scrollActivityTimeout);
         resetScrollActivityTimer_.setSingleShot(true);
         connect(&resetScrollActivityTimer_, &QTimer::timeout, this, [this]() { scrollActivityFlag_ = false; });
+
+        deferredWidthTimer_.setInterval(0);
+        deferredWidthTimer_.setSingleShot(true);
+        connect(&deferredWidthTimer_, &QTimer::timeout, this, &MessagesScrollAreaLayout::updateDeferredItemsWidth);
     }
 
     MessagesScrollAreaLayout::~MessagesScrollAreaLayout()
@@ -681,6 +691,12 @@ namespace Ui
     void MessagesScrollAreaLayout::unlock()
     {
         updatesLocker_.unlock();
+
+        if (deferredWidthPending_ && !updatesLocker_.isLocked())
+        {
+            deferredWidthPending_ = false;
+            deferredWidthTimer_.start();
+        }
     }
 
     void MessagesScrollAreaLayout::removeWidget(QWidget* widget)
@@ -913,6 +929,8 @@ namespace Ui
 
     void MessagesScrollAreaLayout::applyItemsGeometry()
     {
+        updateNearViewportItemsWidth();
+
         const bool isWindowActive = Utils::InterConnector::instance().getMainWindow()->isActiveWindow();
         const bool isUIActive = Utils::InterConnector::instance().getMainWindow()->isUIActive();
         const bool isUIActiveMainWindow = Utils::InterConnector::instance().getMainWindow()->isUIActiveMainWindow();
@@ -2055,33 +2073,130 @@ namespace Ui
         const bool atBottom = ScrollArea_->isScrollAtBottom();
         const auto widthForItem = getWidthForItem();
 
+        const auto margin = deferredWidthMargin();
+        const auto urgentAbsRect = evalViewportAbsRect().marginsAdded(QMargins(0, margin, 0, margin));
+
         for (auto iter = LayoutItems_.begin(); iter != LayoutItems_.end(); ++iter)
         {
             auto &item = *iter;
+            if (!item->AbsGeometry_.intersects(urgentAbsRect))
+            {
+                item->IsWidthDirty_ = true;
+                hasDeferredWidth_ = true;
+                continue;
+            }
 
-            auto widget = item->Widget_;
+            updateItemWidth(iter, widthForItem, viewportAbsMiddleY);
+        }
 
-            widget->setFixedWidth(widthForItem);
+        if (atBottom)
+            ScrollArea_->scrollToBottom();
+
+        applyItemsGeometry();
+        applyBottomWidgetsGeometry();
+
+        ScrollArea_->updateScrollbar();
 
-            const auto oldGeometry = item->AbsGeometry_;
+        if (hasDeferredWidth_)
+            deferredWidthTimer_.start();
+    }
 
-            const auto newHeight = evaluateWidgetHeight(widget);
+    void MessagesScrollAreaLayout::updateItemWidth(const ItemsInfoIter& _iter, const int _width, const int32_t _viewportAbsMiddleY)
+    {
+        auto &item = *_iter;
+        item->IsWidthDirty_ = false;
 
-            const QRect newGeometry(oldGeometry.topLeft(), QSize(widthForItem, newHeight));
+        auto widget = item->Widget_;
 
-            item->AbsGeometry_ = newGeometry;
+        widget->setFixedWidth(_width);
 
-            const auto deltaY = (newGeometry.height() - oldGeometry.height());
-            if (deltaY != 0)
-            {
-                const auto changeAboveViewportMiddle = (oldGeometry.bottom() < viewportAbsMiddleY);
+        const auto oldGeometry = item->AbsGeometry_;
 
-                const auto slideOp = (
-                    changeAboveViewportMiddle ? SlideOp::SlideUp : SlideOp::SlideDown
-                );
+        const auto newHeight = evaluateWidgetHeight(widget);
 
-                slideItemsApart(iter, deltaY, slideOp);
-            }
+        const QRect newGeometry(oldGeometry.topLeft(), QSize(_width, newHeight));
+
+        item->AbsGeometry_ = newGeometry;
+
+        const auto deltaY = (newGeometry.height() - oldGeometry.height());
+        if (deltaY != 0)
+        {
+            const auto changeAboveViewportMiddle = (oldGeometry.bottom() < _viewportAbsMiddleY);
+
+            const auto slideOp = (
+                changeAboveViewportMiddle ? SlideOp::SlideUp : SlideOp::SlideDown
+            );
+
+            slideItemsApart(_iter, deltaY, slideOp);
+        }
+    }
+
+    void MessagesScrollAreaLayout::updateNearViewportItemsWidth()
+    {
+        if (!hasDeferredWidth_)
+            return;
+
+        // scrolling may bring a deferred item in before its slice comes, it is laid out before it is shown
+        const auto margin = deferredWidthMargin();
+        const auto urgentAbsRect = evalViewportAbsRect().marginsAdded(QMargins(0, margin, 0, margin));
+        const auto viewportAbsMiddleY = evalViewportAbsMiddleY();
+        const auto widthForItem = getWidthForItem();
+
+        for (auto iter = LayoutItems_.begin(); iter != LayoutItems_.end(); ++iter)
+        {
+            if ((*iter)->IsWidthDirty_ && (*iter)->AbsGeometry_.intersects(urgentAbsRect))
+                updateItemWidth(iter, widthForItem, viewportAbsMiddleY);
+        }
+    }
+
+    void MessagesScrollAreaLayout::updateDeferredItemsWidth()
+    {
+        if (updatesLocker_.isLocked())
+        {
+            deferredWidthPending_ = true;
+            return;
+        }
+
+        std::scoped_lock locker(*this);
+
+        const auto viewportAbsRect = evalViewportAbsRect();
+        const auto distance = [&viewportAbsRect](const QRect& _r)
+        {
+            if (_r.bottom() < viewportAbsRect.top())
+                return viewportAbsRect.top() - _r.bottom();
+            return std::max(0, _r.top() - viewportAbsRect.bottom());
+        };
+
+        std::vector<std::pair<int, size_t>> dirty;
+        for (size_t i = 0; i < LayoutItems_.size(); ++i)
+        {
+            if (LayoutItems_[i]->IsWidthDirty_)
+                dirty.emplace_back(distance(LayoutItems_[i]->AbsGeometry_), i);
+        }
+
+        if (dirty.empty())
+        {
+            hasDeferredWidth_ = false;
+            return;
+        }
+
+        std::sort(dirty.begin(), dirty.end());
+
+        const auto viewportAbsMiddleY = evalViewportAbsMiddleY();
+        const bool atBottom = ScrollArea_->isScrollAtBottom();
+        const auto widthForItem = getWidthForItem();
+
+        QElapsedTimer elapsed;
+        elapsed.start();
+
+        auto done = size_t(0);
+        for (const auto& item : dirty)
+        {
+            updateItemWidth(LayoutItems_.begin() + item.second, widthForItem, viewportAbsMiddleY);
+            ++done;
+
+            if (elapsed.elapsed() >= deferredWidthSlice().count())
+                break;
         }
 
         if (atBottom)
@@ -2091,6 +2206,10 @@ namespace Ui
         applyBottomWidgetsGeometry();
 
         ScrollArea_->updateScrollbar();
+
+        hasDeferredWidth_ = (done < dirty.size());
+        if (hasDeferredWidth_)
+            deferredWidthTimer_.start();
     }
 
     void MessagesScrollAreaLayout::updateItemsGeometry()
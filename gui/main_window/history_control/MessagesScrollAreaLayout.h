@@ -237,6 +237,8 @@ namespace Ui
             QRect visibleRect_;
 
             bool isVisibleEnoughForRead_;
+
+            bool IsWidthDirty_;
         };
 
         using ItemInfoUptr = std::unique_ptr<ItemInfo>;
@@ -328,6 +330,10 @@ namespace Ui
 
         int getWidthForItem() const;
 
+        void updateItemWidth(const ItemsInfoIter& _iter, const int _width, const int32_t _viewportAbsMiddleY);
+        void updateDeferredItemsWidth();
+        void updateNearViewportItemsWidth();
+
         int getXForItem() const;
 
         void updateItemsPropsDirect();
@@ -363,6 +369,11 @@ namespace Ui
         bool isInitState_; // we have no user action yet
 
         QTimer resetScrollActivityTimer_;
+        QTimer deferredWidthTimer_;
+        // some items still have the width of before the last resize
+        bool hasDeferredWidth_ = false;
+        // the timer fired while the layout was locked, it is restarted on unlock
+        bool deferredWidthPending_ = false;
         bool scrollActivityFlag_;
 
         Heads::HeadContainer* heads_;
@@ -3782,6 +3782,86 @@ void ComplexMessageItem::cancelRequests()
         b->cancelRequests();
 }
 
+bool ComplexMessageItem::isRecyclable() const
+{
+    if (isHeadless() || Blocks_.empty() || hasButtons() || hasReactions() || hasThread() || isSelected())
+        return false;
+
+    if (!snippetsWaitingForInitialization_.empty() || !snippetsWaitingForMeta_.empty())
+        return false;
+
+    return std::all_of(Blocks_.begin(), Blocks_.end(), [](const auto _block) { return _block->getContentType() == IItemBlock::ContentType::Text; });
+}
+
+void ComplexMessageItem::resetForReuse()
+{
+    if (shareButtonAnimation_)
+        shareButtonAnimation_->stop();
+
+    if (timeAnimation_)
+        timeAnimation_->stop();
+
+    if (shareButton_)
+        shareButton_->hide();
+
+    if (!isHeadless())
+        Logic::GetStatusContainer()->setAvatarVisible(SenderAimid_, false);
+
+    for (auto block : Blocks_)
+        block->clearSelection();
+
+    hoveredBlock_ = nullptr;
+    hoveredSharingBlock_ = nullptr;
+    MenuBlock_ = nullptr;
+    MouseLeftPressedOverAvatar_ = false;
+    MouseLeftPressedOverSender_ = false;
+    MouseRightPressedOverItem_ = false;
+    bubbleHovered_ = false;
+    bQuoteAnimation_ = false;
+    bObserveToSize_ = false;
+    PressPoint_ = QPoint();
+    Avatar_ = QPixmap();
+
+    HistoryControlPageItem::resetForReuse();
+
+    hide();
+}
+
+void ComplexMessageItem::rebind(const Data::MessageBuddy& _msg, const std::vector<Data::FString>& _texts, TextRendering::EmojiSizeType _emojiSizeType)
+{
+    im_assert(ChatAimid_ == _msg.AimId_);
+    im_assert(_texts.size() == Blocks_.size());
+
+    Date_ = _msg.GetDate();
+    Id_ = _msg.Id_;
+    PrevId_ = _msg.Prev_;
+    internalId_ = _msg.InternalId_;
+    version_ = common::tools::patch_version();
+    IsOutgoing_ = _msg.IsOutgoing();
+    deliveredToServer_ = _msg.IsDeliveredToServer();
+    SenderAimid_ = _msg.getSender();
+    SourceText_ = _msg.GetSourceText();
+    mentions_ = _msg.Mentions_;
+    Time_ = -1;
+    hasTrailingLink_ = false;
+    hasLinkInText_ = false;
+    hideEdit_ = false;
+    Url_.clear();
+    Description_ = Data::FString();
+
+    setBuddy(_msg);
+
+    SenderAimidForDisplay_ = Logic::getContactListModel()->isChannel(ChatAimid_) ? ChatAimid_ : _msg.getSender();
+    SenderFriendly_ = Logic::GetFriendlyContainer()->getFriendly(_msg.Chat_ ? SenderAimid_ : (_msg.IsOutgoing() ? Ui::MyInfo()->aimId() : _msg.AimId_));
+
+    auto text = _texts.begin();
+    for (auto block : Blocks_)
+        static_cast<TextBlock*>(block)->rebind(*text++, _emojiSizeType);
+
+    fillFilesPlaceholderMap();
+    updateTimeWidgetUnderlay();
+}
+
 void ComplexMessageItem::setUrlAndDescription(const QString& _url, const QString& _description)
 {
     Url_ = _url;
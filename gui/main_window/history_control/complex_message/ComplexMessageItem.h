@@ -262,6 +262,13 @@ public:
 
     virtual void cancelRequests() override;
 
+    /// only items built of text blocks without plates can be bound to another message
+    bool isRecyclable() const;
+
+    void resetForReuse() override;
+
+    void rebind(const Data::MessageBuddy& _msg, const std::vector<Data::FString>& _texts, TextRendering::EmojiSizeType _emojiSizeType);
+
     void setUrlAndDescription(const QString& _url, const QString& _description);
 
     void setUrlAndDescription(const QString& _url, const Data::FString& _description);
@@ -697,6 +697,91 @@ namespace ComplexMessageItemBuilder
         return complexItem;
     }
 
+    ItemShape getItemShape(const ComplexMessageItem& _item)
+    {
+        ItemShape shape;
+        shape.outgoing_ = _item.isOutgoing();
+
+        const auto& blocks = _item.getBlocks();
+        shape.blocks_.reserve(blocks.size());
+        for (auto block : blocks)
+            shape.blocks_.push_back(block->getContentType());
+
+        return shape;
+    }
+
+    std::optional<RecyclableContent> parseRecyclableContent(const Data::MessageBuddy& _msg)
+    {
+        const auto plain = _msg.Quotes_.isEmpty()
+            && !_msg.GetSticker()
+            && !_msg.GetFileSharing()
+            && !_msg.sharedContact_
+            && !_msg.geo_
+            && !_msg.poll_
+            && !_msg.task_
+            && _msg.buttons_.empty()
+            && _msg.GetDescription().isEmpty()
+            && !GetAppConfig().IsShowMsgIdsEnabled();
+
+        if (!plain)
+            return std::nullopt;
+
+        const auto isNotAuth = Logic::getRecentsModel()->isSuspicious(_msg.AimId_);
+        const bool allowSnippet = config::get().is_on(config::features::snippet_in_chat) && (_msg.IsOutgoing() || !isNotAuth);
+
+        const auto parsedMsg = parseText(_msg.getFormattedText(), allowSnippet, false);
+        if (parsedMsg.snippetsCount != 0 || parsedMsg.mediaCount != 0)
+            return std::nullopt;
+
+        RecyclableContent content;
+        content.shape_.outgoing_ = _msg.IsOutgoing();
+        content.hasTrailingLink_ = parsedMsg.hasTrailingLink;
+        content.hasLinkInText_ = parsedMsg.linkInsideText;
+
+        for (const auto& chunk : parsedMsg.chunks)
+        {
+            switch (chunk.Type_)
+            {
+                case TextChunk::Type::Text:
+                case TextChunk::Type::GenericLink:
+                    if (auto plainText = chunk.getPlainText(); !plainText.trimmed().isEmpty())
+                        content.texts_.emplace_back(plainText.toString());
+                    break;
+
+                case TextChunk::Type::FormattedText:
+                    if (auto text = chunk.getFView(); !text.trimmed().isEmpty())
+                        content.texts_.push_back(text.toFString());
+                    break;
+
+                case TextChunk::Type::Junk:
+                    break;
+
+                default:
+                    return std::nullopt;
+            }
+        }
+
+        if (content.texts_.empty())
+            return std::nullopt;
+
+        content.shape_.blocks_.assign(content.texts_.size(), IItemBlock::ContentType::Text);
+        return content;
+    }
+
+    void rebindComplexItem(ComplexMessageItem& _item, const Data::MessageBuddy& _msg, const RecyclableContent& _content)
+    {
+        im_assert(getItemShape(_item).blocks_ == _content.shape_.blocks_);
+
+        const auto bigEmojiAllowed = Ui::get_gui_settings()->get_value<bool>(settings_allow_big_emoji, settings_allow_big_emoji_default());
+        const auto emojiSizeType = bigEmojiAllowed ? TextRendering::EmojiSizeType::ALLOW_BIG : TextRendering::EmojiSizeType::REGULAR;
+
+        _item.rebind(_msg, _content.texts_, emojiSizeType);
+        _item.setHasTrailingLink(_content.hasTrailingLink_);
+        _item.setHasLinkInText(_content.hasLinkInText_);
+        _item.setHideEdit(_msg.hideEdit());
+        _item.setIsUnsupported(_msg.isUnsupported());
+    }
+
 }
 
 UI_COMPLEX_MESSAGE_NS_END
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "../../../namespaces.h"
+#include "IItemBlock.h"
 
 UI_COMPLEX_MESSAGE_NS_BEGIN
 
@@ -16,6 +17,29 @@ namespace ComplexMessageItemBuilder
 
     std::unique_ptr<ComplexMessageItem> makeComplexItem(QWidget *_parent, const Data::MessageBuddy& _msg, ForcePreview _forcePreview);
 
+    struct ItemShape
+    {
+        std::vector<IItemBlock::ContentType> blocks_;
+        bool outgoing_ = false;
+
+        bool operator<(const ItemShape& _other) const { return std::tie(outgoing_, blocks_) < std::tie(_other.outgoing_, _other.blocks_); }
+    };
+
+    ItemShape getItemShape(const ComplexMessageItem& _item);
+
+    /// parsed message which can be bound to an existing item of the same shape
+    struct RecyclableContent
+    {
+        ItemShape shape_;
+        std::vector<Data::FString> texts_;
+        bool hasTrailingLink_ = false;
+        bool hasLinkInText_ = false;
+    };
+
+    std::optional<RecyclableContent> parseRecyclableContent(const Data::MessageBuddy& _msg);
+
+    void rebindComplexItem(ComplexMessageItem& _item, const Data::MessageBuddy& _msg, const RecyclableContent& _content);
+
 }
 
 UI_COMPLEX_MESSAGE_NS_END
@@ -207,6 +207,22 @@ void TextBlock::updateWith(IItemBlock* _other)
     GenericBlock::updateWith(_other);
 }
 
+void TextBlock::rebind(const Data::FString& _text, TextRendering::EmojiSizeType _emojiSizeType)
+{
+    if (TripleClickTimer_)
+        TripleClickTimer_->stop();
+
+    if (isTooltipActivated())
+        hideTooltip();
+
+    Testing::setAccessibleName(this, u"AS HistoryPage messageText " % QString::number(getParentComplexMessage()->getId()));
+
+    emojiSizeType_ = _emojiSizeType;
+    needSpellCheck_ = false;
+    setSourceText(_text);
+    reinit();
+}
+
 void TextBlock::drawBlock(QPainter& p, const QRect&, const QColor&)
 {
     if (!textUnit_)
@@ -110,6 +110,8 @@ public:
 
     void updateWith(IItemBlock* _other) override;
 
+    void rebind(const Data::FString& _text, TextRendering::EmojiSizeType _emojiSizeType);
+
 protected:
     void drawBlock(QPainter &p, const QRect& _rect, const QColor& _quoteColor) override;
 
@@ -0,0 +1,85 @@
+#include "ItemsPool.h"
+
+#include "../complex_message/ComplexMessageItem.h"
+#include "../../../memory_stats/MessageItemMemMonitor.h"
+
+namespace
+{
+    void deleteItemLater(std::unique_ptr<Ui::ComplexMessage::ComplexMessageItem> _item)
+    {
+        if (_item)
+            _item.release()->deleteLater();
+    }
+}
+
+namespace hist
+{
+    ItemsPool::ItemsPool() = default;
+
+    ItemsPool::~ItemsPool()
+    {
+        clear();
+    }
+
+    bool ItemsPool::park(Ui::ComplexMessage::ComplexMessageItem* _item)
+    {
+        im_assert(_item);
+        if (!_item || !_item->isRecyclable())
+            return false;
+
+        if (size_ >= MessageItemMemMonitor::instance().pooledItemsLimit())
+            return false;
+
+        QObject::disconnect(_item, &Ui::ComplexMessage::ComplexMessageItem::removeMe, nullptr, nullptr);
+        _item->cancelRequests();
+        _item->resetForReuse();
+
+        items_[Ui::ComplexMessage::ComplexMessageItemBuilder::getItemShape(*_item)].emplace_back(_item);
+        ++size_;
+        MessageItemMemMonitor::instance().onItemParked();
+
+        return true;
+    }
+
+    std::unique_ptr<Ui::ComplexMessage::ComplexMessageItem> ItemsPool::take(const Data::MessageBuddy& _msg)
+    {
+        if (items_.empty())
+            return nullptr;
+
+        const auto content = Ui::ComplexMessage::ComplexMessageItemBuilder::parseRecyclableContent(_msg);
+        if (!content)
+            return nullptr;
+
+        const auto it = items_.find(content->shape_);
+        if (it == items_.end() || it->second.empty())
+            return nullptr;
+
+        auto item = std::move(it->second.back());
+        it->second.pop_back();
+        if (it->second.empty())
+            items_.erase(it);
+
+        --size_;
+        MessageItemMemMonitor::instance().onItemUnparked();
+
+        Ui::ComplexMessage::ComplexMessageItemBuilder::rebindComplexItem(*item, _msg, *content);
+        MessageItemMemMonitor::instance().onItemRecycled();
+
+        return item;
+    }
+
+    void ItemsPool::clear()
+    {
+        for (auto& [_, items] : items_)
+        {
+            for (auto& item : items)
+            {
+                deleteItemLater(std::move(item));
+                MessageItemMemMonitor::instance().onItemUnparked();
+            }
+        }
+
+        items_.clear();
+        size_ = 0;
+    }
+}
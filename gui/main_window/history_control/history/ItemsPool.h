@@ -0,0 +1,44 @@
+#pragma once
+
+#include "../complex_message/ComplexMessageItemBuilder.h"
+
+namespace Data
+{
+    class MessageBuddy;
+}
+
+namespace Ui::ComplexMessage
+{
+    class ComplexMessageItem;
+}
+
+namespace hist
+{
+    // keeps unloaded message widgets hidden so they can be bound to another message
+    // of the same shape instead of constructing a new widget tree while scrolling
+    class ItemsPool
+    {
+    public:
+        ItemsPool();
+        ~ItemsPool();
+
+        ItemsPool(const ItemsPool&) = delete;
+        ItemsPool& operator=(const ItemsPool&) = delete;
+
+        // takes ownership of the item on success
+        bool park(Ui::ComplexMessage::ComplexMessageItem* _item);
+
+        std::unique_ptr<Ui::ComplexMessage::ComplexMessageItem> take(const Data::MessageBuddy& _msg);
+
+        void clear();
+
+        size_t size() const noexcept { return size_; }
+
+    private:
+        using ItemShape = Ui::ComplexMessage::ComplexMessageItemBuilder::ItemShape;
+        using ItemsVector = std::vector<std::unique_ptr<Ui::ComplexMessage::ComplexMessageItem>>;
+
+        std::map<ItemShape, ItemsVector> items_;
+        size_t size_ = 0;
+    };
+}
@@ -18,13 +18,15 @@
 #include "../../../my_info.h"
 #include "../../../core_dispatcher.h"
 #include "History.h"
+#include "ItemsPool.h"
+#include "memory_stats/MessageItemMemMonitor.h"
 #include "utils/features.h"
 #include "spellcheck/Spellchecker.h"
 #include "../../../gui_settings.h"
 
 namespace hist::MessageBuilder
 {
-    std::unique_ptr<Ui::HistoryControlPageItem> makePageItem(const Data::MessageBuddy& _msg, int _itemWidth, QWidget* _parent)
+    std::unique_ptr<Ui::HistoryControlPageItem> makePageItem(const Data::MessageBuddy& _msg, int _itemWidth, QWidget* _parent, ItemsPool* _pool)
     {
         if (_msg.IsEmpty())
             return nullptr;
@@ -85,7 +87,14 @@ namespace hist::MessageBuilder
             return item;
         }
 
-        auto item = Ui::ComplexMessage::ComplexMessageItemBuilder::makeComplexItem(_parent, _msg, Ui::ComplexMessage::ComplexMessageItemBuilder::ForcePreview::No);
+        auto item = _pool ? _pool->take(_msg) : nullptr;
+        const auto recycled = item != nullptr;
+        if (!recycled)
+        {
+            item = Ui::ComplexMessage::ComplexMessageItemBuilder::makeComplexItem(_parent, _msg, Ui::ComplexMessage::ComplexMessageItemBuilder::ForcePreview::No);
+            MessageItemMemMonitor::instance().onItemCreated();
+        }
+
         item->setContact(_msg.AimId_);
         item->setTime(_msg.GetTime());
         item->setHasAvatar(_msg.HasAvatar());
@@ -106,24 +115,27 @@ namespace hist::MessageBuilder
         if (_itemWidth > 0)
             item->setFixedWidth(_itemWidth);
 
-        QObject::connect(Logic::GetFriendlyContainer(), &Logic::FriendlyContainer::friendlyChanged, item.get(),
-            [item = item.get()](const QString& _aimId, const QString& _friendly)
+        if (!recycled)
         {
-            item->updateFriendly(_aimId, _friendly);
-        });
-
-        if (Features::isSpellCheckEnabled()/* && item->isEditable()*/)
-        {
-            QObject::connect(Ui::get_gui_settings(), &Ui::qt_gui_settings::changed, item.get(), [item = item.get()](const QString& _text)
+            QObject::connect(Logic::GetFriendlyContainer(), &Logic::FriendlyContainer::friendlyChanged, item.get(),
+                [item = item.get()](const QString& _aimId, const QString& _friendly)
             {
-                if (_text == ql1s(settings_spell_check))
-                    item->updateStyle();
+                item->updateFriendly(_aimId, _friendly);
             });
 
-            QObject::connect(&spellcheck::Spellchecker::instance(), &spellcheck::Spellchecker::dictionaryChanged, item.get(), [item = item.get()]()
+            if (Features::isSpellCheckEnabled()/* && item->isEditable()*/)
             {
-                item->updateStyle();
-            });
+                QObject::connect(Ui::get_gui_settings(), &Ui::qt_gui_settings::changed, item.get(), [item = item.get()](const QString& _text)
+                {
+                    if (_text == ql1s(settings_spell_check))
+                        item->updateStyle();
+                });
+
+                QObject::connect(&spellcheck::Spellchecker::instance(), &spellcheck::Spellchecker::dictionaryChanged, item.get(), [item = item.get()]()
+                {
+                    item->updateStyle();
+                });
+            }
         }
 
         QObject::connect(
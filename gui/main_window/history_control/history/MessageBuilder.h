@@ -11,9 +11,14 @@ namespace Ui
     enum class MessagesBuddiesOpt;
 }
 
+namespace hist
+{
+    class ItemsPool;
+}
+
 namespace hist::MessageBuilder
 {
-    [[nodiscard]] std::unique_ptr<Ui::HistoryControlPageItem> makePageItem(const Data::MessageBuddy& _msg, int _itemWidth, QWidget* _parent);
+    [[nodiscard]] std::unique_ptr<Ui::HistoryControlPageItem> makePageItem(const Data::MessageBuddy& _msg, int _itemWidth, QWidget* _parent, ItemsPool* _pool = nullptr);
 
     [[nodiscard]] Ui::MediaWithText formatRecentsText(const Data::MessageBuddy &buddy);
 
@@ -555,7 +555,7 @@ namespace Ui
             return;
 
         Stickers::Suggest suggest;
-        if (!Stickers::getSuggestWithSettings(suggestText, suggest))
+        if (!Stickers::getSuggestWithSettings(suggestText, suggest, &suggestState_))
         {
             if (suggestRequested_)
                 return;
@@ -570,7 +570,7 @@ namespace Ui
             )
         {
             requestStickerSuggests();
-            Stickers::getSuggestWithSettings(suggestText, suggest);
+            Stickers::getSuggestWithSettings(suggestText, suggest, &suggestState_);
         }
 
         if (suggest.empty())
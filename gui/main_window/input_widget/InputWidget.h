@@ -8,6 +8,7 @@
 #include "InputWidgetState.h"
 
 #include "main_window/EscapeCancellable.h"
+#include "utils/PrefixTrie.h"
 
 namespace Emoji
 {
@@ -434,6 +435,7 @@ namespace Ui
         bool setFocusToSubmit_ = false;
 
         bool suggestRequested_ = false;
+        Utils::PrefixTrieState suggestState_;
         std::vector<Utils::FileSharingId> lastRequestedSuggests_;
 
         Utils::CallLinkCreator* callLinkCreator_ = nullptr;
@@ -76,6 +76,8 @@ namespace Ui
 {
     constexpr int32_t maxQueueSize(1024 * 1024 * 15);
     constexpr int32_t minFramesCount(25);
+    constexpr int32_t maxVideoDecodeWorkers(4);
+    constexpr size_t maxPooledFrames(8);
 
     static ffmpeg::AVPacket flush_pkt_data;
     bool isFlushPacket(const ffmpeg::AVPacket& _packet)
@@ -91,6 +93,10 @@ namespace Ui
 
     constexpr int64_t empty_pts = -1000000;
 
+    // swscale context initialization rewrites library-wide conversion tables,
+    // so the decode workers and first frame readers create contexts one at a time
+    static std::mutex swsInitMutex;
+
     bool ThreadMessagesQueue::getMessage(ThreadMessage& _message, std::function<bool()> _isQuit, int32_t _wait_timeout)
     {
         condition_.tryAcquire(1, _wait_timeout);
@@ -255,6 +261,12 @@ namespace Ui
         : quit_(false)
         , curr_id_(0)
     {
+        const auto workers = std::clamp(QThread::idealThreadCount() / 2, 1, maxVideoDecodeWorkers);
+        videoThreadMessagesQueues_.reserve(workers);
+        for (auto i = 0; i < workers; ++i)
+            videoThreadMessagesQueues_.push_back(std::make_unique<ThreadMessagesQueue>());
+        videoWorkersLoad_.resize(workers, 0);
+
         QObject::connect(this, &VideoContext::audioQuit, this, &VideoContext::onAudioQuit);
         QObject::connect(this, &VideoContext::videoQuit, this, &VideoContext::onVideoQuit);
         QObject::connect(this, &VideoContext::demuxQuit, this, &VideoContext::onDemuxQuit);
@@ -298,8 +310,9 @@ namespace Ui
     void VideoContext::deleteVideo(uint32_t _videoId)
     {
         {
-            std::scoped_lock lock(mediaDataMutex_);
+            std::scoped_lock lock(videoWorkersMutex_, mediaDataMutex_);
             mediaData_.erase(_videoId);
+            releaseVideoWorker(_videoId);
         }
 
         {
@@ -310,6 +323,46 @@ namespace Ui
         getMediaContainer()->stopMedia(_videoId);
     }
 
+    size_t VideoContext::getVideoWorkersCount() const
+    {
+        return videoThreadMessagesQueues_.size();
+    }
+
+    size_t VideoContext::getVideoWorker(uint32_t _videoId)
+    {
+        std::scoped_lock lock(videoWorkersMutex_);
+
+        if (const auto it = videoWorkers_.find(_videoId); it != videoWorkers_.end())
+            return it->second;
+
+        // stray messages of deleted videos must not be counted as load;
+        // deleteVideo drops the media under videoWorkersMutex_ too, so it can't go away before the binding is made
+        if (!getMediaData(_videoId))
+            return 0;
+
+        const auto leastLoaded = std::min_element(videoWorkersLoad_.begin(), videoWorkersLoad_.end());
+        ++(*leastLoaded);
+
+        const auto worker = size_t(std::distance(videoWorkersLoad_.begin(), leastLoaded));
+        videoWorkers_[_videoId] = worker;
+        return worker;
+    }
+
+    void VideoContext::releaseVideoWorker(uint32_t _videoId)
+    {
+        if (const auto it = videoWorkers_.find(_videoId); it != videoWorkers_.end())
+        {
+            --videoWorkersLoad_[it->second];
+            videoWorkers_.erase(it);
+        }
+    }
+
+    void VideoContext::setVideoVisible(uint32_t _videoId, bool _visible)
+    {
+        if (auto media = getMediaData(_videoId))
+            media->visible_ = _visible;
+    }
+
     ffmpeg::AVStream* VideoContext::openStream(int32_t _type, ffmpeg::AVFormatContext* _context)
     {
         ffmpeg::AVStream* stream = 0;
@@ -665,7 +718,10 @@ namespace Ui
                         av_image_fill_arrays(frameRGB->data, frameRGB->linesize, &scaledBuffer[0], ffmpeg::AV_PIX_FMT_RGBA, scaledSize.width(), scaledSize.height(), align);
 
                         ffmpeg::SwsContext* swsContext = nullptr;
-                        swsContext = sws_getCachedContext(swsContext, frame->width, frame->height, ffmpeg::AVPixelFormat(frame->format), scaledSize.width(), scaledSize.height(), ffmpeg::AV_PIX_FMT_RGBA, SWS_POINT, 0, 0, 0);
+                        {
+                            std::scoped_lock lock(swsInitMutex);
+                            swsContext = sws_getCachedContext(swsContext, frame->width, frame->height, ffmpeg::AVPixelFormat(frame->format), scaledSize.width(), scaledSize.height(), ffmpeg::AV_PIX_FMT_RGBA, SWS_POINT, 0, 0, 0);
+                        }
 
                         ffmpeg::sws_scale(swsContext, frame->data, frame->linesize, 0, frame->height, frameRGB->data, frameRGB->linesize);
 
@@ -1250,6 +1306,12 @@ namespace Ui
         }
     }
 
+    static void updateDecodeLatency(MediaData& _media, int64_t _startTime)
+    {
+        const auto elapsed = ffmpeg::av_gettime() - _startTime;
+        _media.decodeLatencyUs_ = (_media.decodeLatencyUs_ * 7 + elapsed) / 8;
+    }
+
     static void stopPttIfNeeded(const MediaData& _media)
     {
         if (!_media.mute_ && _media.volume_ > 0)
@@ -1446,7 +1508,14 @@ namespace Ui
 
     void VideoContext::postVideoThreadMessage(const ThreadMessage& _message, bool _forward, bool _clear_others)
     {
-        videoThreadMessagesQueue_.pushMessage(_message, _forward, _clear_others);
+        if (_message.message_ == thread_message_type::tmt_wake_up)
+        {
+            for (auto& queue : videoThreadMessagesQueues_)
+                queue->pushMessage(_message, _forward, _clear_others);
+            return;
+        }
+
+        videoThreadMessagesQueues_[getVideoWorker(_message.videoId_)]->pushMessage(_message, _forward, _clear_others);
     }
 
     void VideoContext::postDemuxThreadMessage(const ThreadMessage& _message, bool _forward, bool _clear_others)
@@ -1471,7 +1540,8 @@ namespace Ui
 
     void VideoContext::clearMessageQueue()
     {
-        videoThreadMessagesQueue_.clear();
+        for (auto& queue : videoThreadMessagesQueues_)
+            queue->clear();
         audioThreadMessageQueue_.clear();
         demuxThreadMessageQueue_.clear();
     }
@@ -1486,14 +1556,14 @@ namespace Ui
         _media.audioData_.state_ = _state;
     }
 
-    bool VideoContext::getVideoThreadMessage(ThreadMessage& _message, int32_t _waitTimeout)
+    bool VideoContext::getVideoThreadMessage(size_t _worker, ThreadMessage& _message, int32_t _waitTimeout)
     {
-        return videoThreadMessagesQueue_.getMessage(_message, [this] {return isQuit(); }, _waitTimeout);
+        return videoThreadMessagesQueues_[_worker]->getMessage(_message, [this] {return isQuit(); }, _waitTimeout);
     }
 
-    bool VideoContext::getAllVideoThreadMessages(ThreadMessageList& _messages, int32_t _waitTimeout)
+    bool VideoContext::getAllVideoThreadMessages(size_t _worker, ThreadMessageList& _messages, int32_t _waitTimeout)
     {
-        return videoThreadMessagesQueue_.getAllMessages(_messages, [this] {return isQuit(); }, _waitTimeout);
+        return videoThreadMessagesQueues_[_worker]->getAllMessages(_messages, [this] {return isQuit(); }, _waitTimeout);
     }
 
     bool VideoContext::updateScaleContext(MediaData& _media, const QSize _sz)
@@ -2029,10 +2099,11 @@ namespace Ui
     //////////////////////////////////////////////////////////////////////////
     // VideoDecodeThread
     //////////////////////////////////////////////////////////////////////////
-    VideoDecodeThread::VideoDecodeThread(VideoContext& _ctx)
+    VideoDecodeThread::VideoDecodeThread(VideoContext& _ctx, size_t _worker)
         : ctx_(_ctx)
+        , worker_(_worker)
     {
-        setObjectName(qsl("VideoDecode"));
+        setObjectName(qsl("VideoDecode%1").arg(_worker));
     }
 
     void VideoDecodeThread::run()
@@ -2054,10 +2125,20 @@ namespace Ui
 
         while (!ctx_.isQuit())
         {
-            if (!ctx_.getAllVideoThreadMessages(messages, waitMsgTimeout))
+            if (!ctx_.getAllVideoThreadMessages(worker_, messages, waitMsgTimeout))
                 continue;
 
-            qCDebug(ffmpegPlayer) << "video decode processing" << messages.size() << "messages";
+            // frames of visible players are decoded first, per-video message order is kept
+            std::stable_partition(messages.begin(), messages.end(), [&videoData](const ThreadMessage& _msg)
+            {
+                const auto it = videoData.find(_msg.videoId_);
+                if (it == videoData.end())
+                    return true;
+                const auto media = it->second.media_.lock();
+                return !media || media->visible_;
+            });
+
+            qCDebug(ffmpegPlayer) << "video decode" << worker_ << "processing" << messages.size() << "messages";
             for (auto& msg : messages)
             {
                 const auto videoId = msg.videoId_;
@@ -2097,6 +2178,7 @@ namespace Ui
                 {
                     case thread_message_type::tmt_quit:
                     {
+                        releaseFrames(data);
                         videoData.erase(it);
                         ctx_.freeScaleContext(media);
 
@@ -2126,7 +2208,9 @@ namespace Ui
                         }
                         else
                         {
+                            const auto startTime = ffmpeg::av_gettime();
                             renderVideoFrame(data, media, frame, av_packet, videoId);
+                            updateDecodeLatency(media, startTime);
                         }
                         break;
                     }
@@ -2141,7 +2225,10 @@ namespace Ui
                 Q_EMIT ctx_.nextframeReady(rdata.videoId_, rdata.frame_, currentTimeInSeconds(), false);
 
                 if (auto media = rdata.media_.lock())
+                {
                     media->lottieRenderer_.setFrame(rdata.frameNo_, rdata.frame_);
+                    updateDecodeLatency(*media, rdata.startTime_);
+                }
             }
             lottieData.clear();
         }
@@ -2175,11 +2262,12 @@ namespace Ui
             qCDebug(ffmpegPlayer) << "lottie render" << frameNo << "/" << (totalFrames - 1);
 
             const auto scaledSize = ctx_.getTargetSize(_media);
-            QImage lastFrame = getLastFrame(_data);
+            QImage lastFrame = getLastFrame(_data, scaledSize, QImage::Format_ARGB32_Premultiplied);
             if (lastFrame.isNull() || lastFrame.size() != scaledSize || !lastFrame.isDetached())
                 lastFrame = QImage(scaledSize, QImage::Format_ARGB32_Premultiplied);
 
             LottieRenderData rdata;
+            rdata.startTime_ = ffmpeg::av_gettime();
             rdata.frame_ = std::move(lastFrame);
             rdata.videoId_ = _videoId;
             rdata.frameNo_ = frameNo;
@@ -2247,7 +2335,7 @@ namespace Ui
             if (scaledSize.height() == 0)
                 scaledSize.setHeight(1);
 
-            auto lastFrame = getLastFrame(_data);
+            auto lastFrame = getLastFrame(_data, scaledSize, QImage::Format_ARGB32);
 
             int align = 256;
             if constexpr (platform::is_windows()) // spike for opengl
@@ -2271,6 +2359,8 @@ namespace Ui
             if ((_media.needUpdateSwsContext_) || (_frame->format != -1 && _frame->format != _media.codecContext_->pix_fmt) || !_media.swsContext_)
             {
                 _media.needUpdateSwsContext_ = false;
+
+                std::scoped_lock lock(swsInitMutex);
                 _media.swsContext_ = sws_getCachedContext(
                     _media.swsContext_,
                     _frame->width,
@@ -2298,15 +2388,40 @@ namespace Ui
         }
     }
 
-    QImage VideoDecodeThread::getLastFrame(VideoData& _data) const
+    QImage VideoDecodeThread::getLastFrame(VideoData& _data, const QSize& _size, QImage::Format _format)
     {
-        QImage lastFrame = _data.emptyFrames_.empty() ? QImage() : std::move(_data.emptyFrames_.front());
         if (!_data.emptyFrames_.empty())
+        {
+            QImage lastFrame = std::move(_data.emptyFrames_.front());
             _data.emptyFrames_.pop_front();
+            return lastFrame;
+        }
+
+        const auto it = std::find_if(framePool_.begin(), framePool_.end(), [&_size, _format](const QImage& _frame)
+        {
+            return _frame.size() == _size && _frame.format() == _format;
+        });
+        if (it == framePool_.end())
+            return QImage();
 
+        QImage lastFrame = std::move(*it);
+        framePool_.erase(it);
         return lastFrame;
     }
 
+    void VideoDecodeThread::releaseFrames(VideoData& _data)
+    {
+        for (auto& frame : _data.emptyFrames_)
+        {
+            if (framePool_.size() >= maxPooledFrames)
+                break;
+
+            if (!frame.isNull() && frame.isDetached())
+                framePool_.push_back(std::move(frame));
+        }
+        _data.emptyFrames_.clear();
+    }
+
     bool VideoDecodeThread::processDataMessage(VideoData& _data, ThreadMessage& _msg) const
     {
         switch (_msg.message_)
@@ -2762,6 +2877,7 @@ namespace Ui
         timer_->stop();
 
         decodedFrames_.clear();
+        nextFrameDeadline_.reset();
 
         if (!continius_)
             stopped_ = true;
@@ -2806,6 +2922,19 @@ namespace Ui
         }
     }
 
+    void FFMpegPlayer::countMissedFrames(MediaData& _media)
+    {
+        if (!nextFrameDeadline_)
+            return;
+
+        const auto now = std::chrono::steady_clock::now();
+        while (*nextFrameDeadline_ < now)
+        {
+            ++_media.droppedFrames_;
+            *nextFrameDeadline_ += frameInterval_;
+        }
+    }
+
     void FFMpegPlayer::onTimer()
     {
         qCDebug(ffmpegPlayer) << "real timer time = " << int((std::chrono::system_clock::now() - prev_frame_time_) / std::chrono::milliseconds(1));
@@ -2847,6 +2976,8 @@ namespace Ui
         {
             if (getStarted())
             {
+                countMissedFrames(*media);
+
                 const int interval = std::min(100., (media->frameLastDelay_ > 0. ? media->frameLastDelay_ : 0.1) * 1000.0 + 0.5);
                 qCDebug(ffmpegPlayer) << "!!! decoded frames empty, timer restart" << interval << "id" << mediaId_;
                 timer_->start(interval);
@@ -2927,6 +3058,16 @@ namespace Ui
             timer_->setInterval(timeout);
         }
 
+        if (seek_request_id_ || timeout <= 0)
+        {
+            nextFrameDeadline_.reset();
+        }
+        else
+        {
+            frameInterval_ = std::chrono::milliseconds(timeout);
+            nextFrameDeadline_ = std::chrono::steady_clock::now() + frameInterval_;
+        }
+
         qCDebug(ffmpegPlayer) << "seek" << seek_request_id_ << "delay" << delay << "timeout is =" << timeout;
 
         decodedFrames_.pop_front();
@@ -3022,6 +3163,7 @@ namespace Ui
         auto& media = *media_ptr;
 
         setStarted(_init);
+        nextFrameDeadline_.reset();
 
         if (state_ == decode_thread_state::dts_none)
         {
@@ -3104,6 +3246,7 @@ namespace Ui
         }
 
         timer_->stop();
+        nextFrameDeadline_.reset();
 
         Q_EMIT paused();
     }
@@ -3126,6 +3269,7 @@ namespace Ui
         //qDebug() << "media->syncWithAudio_ = " << media->syncWithAudio_;
 
         decodedFrames_.clear();
+        nextFrameDeadline_.reset();
 
         ThreadMessage msg(mediaId_, thread_message_type::tmt_seek_position);
         msg.x_ = (int32_t)_position;
@@ -3224,6 +3368,10 @@ namespace Ui
                 {
                     Q_EMIT mouseLeaveEvent(QPrivateSignal());
                 }
+                else if (QEvent::Show == _event->type() || QEvent::Hide == _event->type())
+                {
+                    getMediaContainer()->ctx_.setVideoVisible(mediaId_, QEvent::Show == _event->type());
+                }
                 else if (QEvent::MouseMove == _event->type())
                 {
                     const auto currentTime = std::chrono::system_clock::now();
@@ -3416,9 +3564,13 @@ namespace Ui
         : is_decods_inited_(false)
         , is_demux_inited_(false)
         , demuxThread_(ctx_)
-        , videoDecodeThread_(ctx_)
         , audioDecodeThread_(ctx_)
-    {}
+    {
+        const auto workers = ctx_.getVideoWorkersCount();
+        videoDecodeThreads_.reserve(workers);
+        for (size_t i = 0; i < workers; ++i)
+            videoDecodeThreads_.push_back(std::make_unique<VideoDecodeThread>(ctx_, i));
+    }
 
     MediaContainer::~MediaContainer()
     {
@@ -3443,7 +3595,8 @@ namespace Ui
 
     void MediaContainer::VideoDecodeThreadStart(uint32_t _mediaId)
     {
-        videoDecodeThread_.start();
+        for (auto& thread : videoDecodeThreads_)
+            thread->start();
     }
 
     void MediaContainer::AudioDecodeThreadStart(uint32_t _mediaId)
@@ -3616,7 +3769,8 @@ namespace Ui
 
     void MediaContainer::VideoDecodeThreadWait()
     {
-        videoDecodeThread_.wait();
+        for (auto& thread : videoDecodeThreads_)
+            thread->wait();
     }
 
     void MediaContainer::AudioDecodeThreadWait()
@@ -216,6 +216,11 @@ namespace Ui
         bool isLottie_ = false;
         LottieHandle lottieRenderer_;
 
+        // decode scheduler state, shared between the player and the decode worker
+        std::atomic<bool> visible_ = true;
+        std::atomic<int64_t> decodeLatencyUs_ = 0;
+        std::atomic<int64_t> droppedFrames_ = 0;
+
         MediaData();
 
         bool hasVideo() const { return !!videoStream_ || lottieRenderer_; }
@@ -253,6 +258,7 @@ namespace Ui
     {
         int videoId_ = -1;
         int frameNo_ = -1;
+        int64_t startTime_ = 0;
         QImage frame_;
         std::future<rlottie::Surface> fut_;
         std::weak_ptr<MediaData> media_;
@@ -296,8 +302,6 @@ namespace Ui
         void onDemuxQuit(uint32_t _videoId);
         void onStreamsClosed(uint32_t _videoId);
 
-    public:
-        ThreadMessagesQueue videoThreadMessagesQueue_;
     private:
 
         std::atomic<bool> quit_;
@@ -312,12 +316,21 @@ namespace Ui
         ThreadMessagesQueue demuxThreadMessageQueue_;
         ThreadMessagesQueue audioThreadMessageQueue_;
 
+        // one queue per video decode worker, a video sticks to its worker until deleted
+        std::vector<std::unique_ptr<ThreadMessagesQueue>> videoThreadMessagesQueues_;
+        std::unordered_map<uint32_t, size_t> videoWorkers_;
+        std::vector<int32_t> videoWorkersLoad_;
+        mutable std::mutex videoWorkersMutex_;
+
     private:
 
         static ffmpeg::AVStream* openStream(int32_t _type, ffmpeg::AVFormatContext* _context);
         static void closeStream(ffmpeg::AVStream* _stream);
         void sendCloseStreams(uint32_t _videoId);
 
+        size_t getVideoWorker(uint32_t _videoId);
+        void releaseVideoWorker(uint32_t _videoId); // with videoWorkersMutex_ locked
+
     public:
 
         VideoContext();
@@ -407,9 +420,12 @@ namespace Ui
 
         void updateScaledVideoSize(uint32_t _videoId, const QSize& _sz);
 
+        size_t getVideoWorkersCount() const;
+        void setVideoVisible(uint32_t _videoId, bool _visible);
+
         void postVideoThreadMessage(const ThreadMessage& _message, bool _forward, bool _clear_others = false);
-        bool getVideoThreadMessage(ThreadMessage& _message, int32_t _waitTimeout);
-        bool getAllVideoThreadMessages(ThreadMessageList& _messages, int32_t _waitTimeout);
+        bool getVideoThreadMessage(size_t _worker, ThreadMessage& _message, int32_t _waitTimeout);
+        bool getAllVideoThreadMessages(size_t _worker, ThreadMessageList& _messages, int32_t _waitTimeout);
 
         void postDemuxThreadMessage(const ThreadMessage& _message, bool _forward, bool _clear_others = false);
         bool getDemuxThreadMessage(ThreadMessage& _message, int32_t _waitTimeout);
@@ -477,19 +493,25 @@ namespace Ui
 
         VideoContext& ctx_;
 
+        const size_t worker_;
+
+        // frames released by finished videos, reused by any video of this worker
+        std::vector<QImage> framePool_;
+
     protected:
 
         virtual void run() override;
 
         LottieRenderData renderLottieFrame(VideoData& _data, MediaData& _media, int32_t _videoId);
         void renderVideoFrame(VideoData& _data, MediaData& _media, ffmpeg::AVFrame* _frame, ffmpeg::AVPacket& _av_packet, int32_t _videoId);
-        QImage getLastFrame(VideoData& _data) const;
+        QImage getLastFrame(VideoData& _data, const QSize& _size, QImage::Format _format);
+        void releaseFrames(VideoData& _data);
 
         bool processDataMessage(VideoData& _data, ThreadMessage& _msg) const;
 
     public:
 
-        explicit VideoDecodeThread(VideoContext& _ctx);
+        VideoDecodeThread(VideoContext& _ctx, size_t _worker);
     };
 
 
@@ -566,7 +588,7 @@ namespace Ui
         std::unordered_set<uint32_t> active_video_ids_;
 
         DemuxThread demuxThread_;
-        VideoDecodeThread videoDecodeThread_;
+        std::vector<std::unique_ptr<VideoDecodeThread>> videoDecodeThreads_;
         AudioDecodeThread audioDecodeThread_;
 
         void DemuxThreadWait();
@@ -630,6 +652,10 @@ namespace Ui
 
         std::chrono::system_clock::time_point prev_frame_time_;
 
+        // when the next frame is due while playing; unset while paused, seeking or before the first frame
+        std::optional<std::chrono::steady_clock::time_point> nextFrameDeadline_;
+        std::chrono::steady_clock::duration frameInterval_ = {};
+
         std::chrono::system_clock::time_point lastEmitMouseMove_;
 
         QMetaObject::Connection openStreamsConnection_;
@@ -648,6 +674,7 @@ namespace Ui
 
         void updateVideoPosition(const DecodedFrame& _frame);
         bool canPause() const;
+        void countMissedFrames(MediaData& _media);
 
     Q_SIGNALS:
 
@@ -0,0 +1,184 @@
+#include "stdafx.h"
+
+#include "LottieFrameCache.h"
+
+namespace
+{
+    // encoded frame is a sequence of chunks, each starts with a control word:
+    // a run of one repeated pixel (flag set, pixel follows) or a literal span (pixels follow)
+    constexpr uint32_t runFlag = 0x80000000;
+    constexpr uint32_t maxChunk = runFlag - 1;
+    constexpr size_t minRun = 3;
+
+    std::vector<uint32_t> encode(const uint32_t* _pixels, size_t _count)
+    {
+        std::vector<uint32_t> out;
+        out.reserve(_count / 4);
+
+        size_t literalStart = 0;
+        const auto flushLiteral = [&out, &literalStart, _pixels](size_t _end)
+        {
+            if (_end > literalStart)
+            {
+                out.push_back(uint32_t(_end - literalStart));
+                out.insert(out.end(), _pixels + literalStart, _pixels + _end);
+            }
+        };
+
+        size_t i = 0;
+        while (i < _count)
+        {
+            size_t run = 1;
+            while (i + run < _count && run < maxChunk && _pixels[i + run] == _pixels[i])
+                ++run;
+
+            if (run >= minRun)
+            {
+                flushLiteral(i);
+                out.push_back(runFlag | uint32_t(run));
+                out.push_back(_pixels[i]);
+                literalStart = i + run;
+            }
+            i += run;
+        }
+        flushLiteral(_count);
+
+        out.shrink_to_fit();
+        return out;
+    }
+
+    bool decode(const std::vector<uint32_t>& _data, uint32_t* _pixels, size_t _count)
+    {
+        size_t pos = 0;
+        size_t written = 0;
+        while (pos < _data.size())
+        {
+            const auto control = _data[pos++];
+            const size_t n = control & maxChunk;
+            if (written + n > _count)
+                return false;
+
+            if (control & runFlag)
+            {
+                std::fill_n(_pixels + written, n, _data[pos++]);
+            }
+            else
+            {
+                std::copy_n(_data.data() + pos, n, _pixels + written);
+                pos += n;
+            }
+            written += n;
+        }
+        return written == _count;
+    }
+
+    int64_t footprint(const std::vector<uint32_t>& _data) noexcept
+    {
+        return int64_t(_data.capacity() * sizeof(uint32_t));
+    }
+}
+
+namespace Ui
+{
+    LottieFrameCache& LottieFrameCache::instance()
+    {
+        static LottieFrameCache cache;
+        return cache;
+    }
+
+    size_t LottieFrameCache::KeyHasher::operator()(const Key& _key) const noexcept
+    {
+        size_t h = std::hash<const void*>()(_key.animation_);
+        h ^= std::hash<int>()(_key.frameNo_) + 0x9e3779b9 + (h << 6) + (h >> 2);
+        h ^= std::hash<int>()((_key.width_ << 16) ^ _key.height_) + 0x9e3779b9 + (h << 6) + (h >> 2);
+        return h;
+    }
+
+    bool LottieFrameCache::get(const LottieWrapper* _animation, int _frameNo, QSize _size, uint32_t* _buffer, size_t _bytesPerLine)
+    {
+        if (_bytesPerLine != size_t(_size.width()) * sizeof(uint32_t))
+            return false;
+
+        EncodedFrame data;
+        {
+            std::scoped_lock lock(mutex_);
+            const auto it = frames_.find({ _animation, _frameNo, _size.width(), _size.height() });
+            if (it == frames_.end())
+                return false;
+
+            lru_.splice(lru_.begin(), lru_, it->second.lru_);
+            data = it->second.data_;
+        }
+
+        return decode(*data, _buffer, size_t(_size.width()) * _size.height());
+    }
+
+    void LottieFrameCache::put(const LottieWrapper* _animation, int _frameNo, const QImage& _frame)
+    {
+        if (_frame.isNull() || _frame.format() != QImage::Format_ARGB32_Premultiplied || _frame.bytesPerLine() != _frame.width() * int(sizeof(uint32_t)))
+            return;
+
+        const Key key = { _animation, _frameNo, _frame.width(), _frame.height() };
+        {
+            std::scoped_lock lock(mutex_);
+            if (frames_.find(key) != frames_.end())
+                return;
+        }
+
+        auto data = std::make_shared<const std::vector<uint32_t>>(encode(reinterpret_cast<const uint32_t*>(_frame.constBits()), size_t(_frame.width()) * _frame.height()));
+
+        std::scoped_lock lock(mutex_);
+        if (frames_.find(key) != frames_.end())
+            return;
+
+        size_ += footprint(*data);
+        lru_.push_front(key);
+        frames_.insert({ key, Entry{ std::move(data), lru_.begin() } });
+
+        evict();
+    }
+
+    void LottieFrameCache::remove(const LottieWrapper* _animation)
+    {
+        std::scoped_lock lock(mutex_);
+        for (auto it = frames_.begin(); it != frames_.end();)
+        {
+            if (it->first.animation_ == _animation)
+            {
+                size_ -= footprint(*it->second.data_);
+                lru_.erase(it->second.lru_);
+                it = frames_.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+    }
+
+    int64_t LottieFrameCache::memoryUsage() const
+    {
+        std::scoped_lock lock(mutex_);
+        return size_;
+    }
+
+    int64_t LottieFrameCache::frameCount() const
+    {
+        std::scoped_lock lock(mutex_);
+        return int64_t(frames_.size());
+    }
+
+    void LottieFrameCache::evict()
+    {
+        while (size_ > memoryBudget() && !lru_.empty())
+        {
+            const auto it = frames_.find(lru_.back());
+            if (it != frames_.end())
+            {
+                size_ -= footprint(*it->second.data_);
+                frames_.erase(it);
+            }
+            lru_.pop_back();
+        }
+    }
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+namespace Ui
+{
+    struct LottieWrapper;
+
+    // process-wide store of rendered lottie frames;
+    // frames are kept run-length encoded and shared by all handles of the same animation,
+    // least recently used frames are evicted when the memory budget is exceeded
+    class LottieFrameCache
+    {
+    public:
+        static LottieFrameCache& instance();
+        LottieFrameCache(LottieFrameCache const&) = delete;
+        LottieFrameCache& operator=(LottieFrameCache const&) = delete;
+
+        // decodes the frame into a premultiplied ARGB32 buffer of the given size
+        bool get(const LottieWrapper* _animation, int _frameNo, QSize _size, uint32_t* _buffer, size_t _bytesPerLine);
+        void put(const LottieWrapper* _animation, int _frameNo, const QImage& _frame);
+        void remove(const LottieWrapper* _animation);
+
+        int64_t memoryUsage() const;
+        int64_t frameCount() const;
+
+        static constexpr int64_t memoryBudget() noexcept { return 64 * 1024 * 1024; }
+
+    private:
+        LottieFrameCache() = default;
+
+        struct Key
+        {
+            const LottieWrapper* animation_ = nullptr;
+            int frameNo_ = 0;
+            int width_ = 0;
+            int height_ = 0;
+
+            bool operator==(const Key& _other) const noexcept
+            {
+                return animation_ == _other.animation_ && frameNo_ == _other.frameNo_ && width_ == _other.width_ && height_ == _other.height_;
+            }
+        };
+
+        struct KeyHasher
+        {
+            size_t operator()(const Key& _key) const noexcept;
+        };
+
+        using EncodedFrame = std::shared_ptr<const std::vector<uint32_t>>;
+
+        struct Entry
+        {
+            EncodedFrame data_;
+            std::list<Key>::iterator lru_;
+        };
+
+        void evict();
+
+    private:
+        std::unordered_map<Key, Entry, KeyHasher> frames_;
+        std::list<Key> lru_;
+        int64_t size_ = 0;
+        mutable std::mutex mutex_;
+    };
+}
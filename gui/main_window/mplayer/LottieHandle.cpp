@@ -1,6 +1,7 @@
 #include "stdafx.h"
 
 #include "LottieHandle.h"
+#include "LottieFrameCache.h"
 #include "utils/async/AsyncTask.h"
 
 namespace
@@ -10,6 +11,13 @@ namespace
 
 namespace Ui
 {
+    LottieWrapper::~LottieWrapper()
+    {
+#ifdef LOTTIE_FRAME_CACHE
+        LottieFrameCache::instance().remove(this);
+#endif
+    }
+
     LottieHandleCache& LottieHandleCache::instance()
     {
         static LottieHandleCache cache;
@@ -85,15 +93,15 @@ namespace Ui
     std::future<rlottie::Surface> LottieHandle::renderFrame(int _frameNo, rlottie::Surface _surface)
     {
 #ifdef LOTTIE_FRAME_CACHE
-        if (const auto& img = std::as_const(frames_[_frameNo]); !img.isNull() && img.size() == QSize(_surface.width(), _surface.height()))
+        if (isValid())
         {
-            std::packaged_task<rlottie::Surface()> render([&img, _surface = std::move(_surface)]()
+            const QSize size(int(_surface.width()), int(_surface.height()));
+            if (LottieFrameCache::instance().get(handle_.get(), _frameNo, size, _surface.buffer(), _surface.bytesPerLine()))
             {
-                memcpy(_surface.buffer(), img.bits(), _surface.bytesPerLine() * _surface.height());
-                return _surface;
-            });
-            render();
-            return render.get_future();
+                std::promise<rlottie::Surface> cached;
+                cached.set_value(std::move(_surface));
+                return cached.get_future();
+            }
         }
 #endif
 
@@ -136,21 +144,16 @@ namespace Ui
     void LottieHandle::setFrame(int _frameNo, const QImage& _frame)
     {
 #ifdef LOTTIE_FRAME_CACHE
-        if (_frameNo < 0 && _frameNo >= int(frames_.size()))
+        if (!isValid() || _frameNo < 0 || _frameNo >= int(handle_->ptr_->totalFrame()))
             return;
 
-        if (auto& frame = frames_[_frameNo]; frame.isNull())
-            frame = _frame;
+        LottieFrameCache::instance().put(handle_.get(), _frameNo, _frame);
 #endif
     }
 
     LottieHandle::LottieHandle(wrapperSptr _handle)
         : handle_(std::move(_handle))
     {
-#ifdef LOTTIE_FRAME_CACHE
-        if (isValid())
-            frames_.resize(handle_->ptr_->totalFrame());
-#endif
     }
 
     LottieHandle::~LottieHandle()
@@ -10,6 +10,8 @@ namespace Ui
     {
         std::mutex mutex_;
         std::shared_ptr<rlottie::Animation> ptr_;
+
+        ~LottieWrapper();
     };
     using wrapperSptr = std::shared_ptr<LottieWrapper>;
 
@@ -56,10 +58,6 @@ namespace Ui
     private:
         wrapperSptr handle_;
 
-#ifdef LOTTIE_FRAME_CACHE
-        std::vector<QImage> frames_;
-#endif
-
         friend class Ui::FFmpegPlayerMemMonitor;
     };
 
@@ -119,6 +119,8 @@ namespace Ui
         Testing::setAccessibleName(clearAvatarsBtn_, qsl("AS AdditionalSettingsPage logMessageModelButton"));
         logMemorySnapshot_ = setupButton(defaultIconName, QT_TRANSLATE_NOOP("popup_window", "Log Memory Report"));
         Testing::setAccessibleName(logMemorySnapshot_, qsl("AS AdditionalSettingsPage logMemoryReport"));
+        scrollHistoryTest_ = setupButton(defaultIconName, QT_TRANSLATE_NOOP("popup_window", "Log history scroll test"));
+        Testing::setAccessibleName(scrollHistoryTest_, qsl("AS AdditionalSettingsPage scrollHistoryTest"));
 
         if constexpr (environment::is_develop())
         {
@@ -145,6 +147,11 @@ namespace Ui
             GuiMemoryMonitor::instance().writeLogMemoryReport({});
         });
 
+        connect(scrollHistoryTest_, &QPushButton::clicked, this, []() {
+            if (const auto contact = Logic::getContactListModel()->selectedContact(); !contact.isEmpty())
+                Q_EMIT Utils::InterConnector::instance().scrollHistoryTest(contact);
+        });
+
         connect(clearCacheBtn_, &QPushButton::clicked, this, [this]() {
             GetDispatcher()->post_message_to_core("remove_content_cache", nullptr, this,
                                                   [](core::icollection* _coll)
@@ -53,6 +53,7 @@ namespace Ui
         Ui::CustomButton* clearAvatarsBtn_ = nullptr;
         Ui::CustomButton* logCurrentMessagesModel_ = nullptr;
         Ui::CustomButton* logMemorySnapshot_ = nullptr;
+        Ui::CustomButton* scrollHistoryTest_ = nullptr;
         Ui::SidebarCheckboxButton* fullLogModeCheckbox_ = nullptr;
         Ui::SidebarCheckboxButton* updatebleCheckbox_ = nullptr;
         Ui::SidebarCheckboxButton* devShowMsgIdsCheckbox_ = nullptr;
@@ -3,6 +3,7 @@
 #include "../utils/QObjectWatcher.h"
 #include "../utils/memory_utils.h"
 #include "../main_window/mplayer/FFMpegPlayer.h"
+#include "../main_window/mplayer/LottieFrameCache.h"
 
 namespace  Ui {
 
@@ -73,6 +74,12 @@ FFmpegPlayerMemMonitor::FFMpegStats FFmpegPlayerMemMonitor::getCurrentStats()
             info.decodedFramesPixmapSize_ += Utils::getMemoryFootprint(player->firstFrame_->image_);
         }
 
+        if (auto media = getMediaContainer()->ctx_.getMediaData(player->mediaId_))
+        {
+            info.decodeLatencyUs_ = media->decodeLatencyUs_;
+            info.droppedFrames_ = media->droppedFrames_;
+        }
+
         stats.push_back(info);
     }
 
@@ -90,19 +97,7 @@ int64_t FFmpegPlayerMemMonitor::getLottieStats() const
     }
 
 #ifdef LOTTIE_FRAME_CACHE
-    {
-        auto& ctx = getMediaContainer()->ctx_;
-        std::scoped_lock lock(ctx.mediaDataMutex_);
-        for (const auto& [id, media_ptr] : ctx.mediaData_)
-        {
-            if (!media_ptr || !media_ptr->lottieRenderer_)
-                continue;
-
-            for (const auto& f : media_ptr->lottieRenderer_.frames_)
-                if (!f.isNull())
-                    total += Utils::getMemoryFootprint(f);
-        }
-    }
+    total += LottieFrameCache::instance().memoryUsage();
 #endif // LOTTIE_FRAME_CACHE
 
     return total;
@@ -21,6 +21,8 @@ public:
         uint32_t mediaId_ = std::numeric_limits<uint32_t>::max();
         int64_t decodedFramesCount_ = 0;
         int64_t decodedFramesPixmapSize_ = 0;
+        int64_t decodeLatencyUs_ = 0;
+        int64_t droppedFrames_ = 0;
     };
 
     using FFMpegStats = std::vector<FFMpegPlayerInfo> ;
@@ -11,6 +11,12 @@
 
 #include "../utils/memory_utils.h"
 
+namespace
+{
+    constexpr size_t maxPooledItems = 64;
+    constexpr size_t maxPooledItemsWatched = 16;
+}
+
 
 MessageItemMemMonitor& MessageItemMemMonitor::instance()
 {
@@ -115,6 +121,53 @@ MessageItemMemMonitor::CategoriesArray MessageItemMemMonitor::getMessageItemsFoo
 MessageItemMemMonitor::MessageItemMemMonitor(QObject *parent)
     : QObject(parent)
 {
+    rateTimer_.start();
+}
+
+void MessageItemMemMonitor::onItemCreated()
+{
+    ++createdItems_;
+}
+
+void MessageItemMemMonitor::onItemRecycled()
+{
+    ++recycledItems_;
+}
+
+void MessageItemMemMonitor::onItemParked()
+{
+    ++pooledItems_;
+}
+
+void MessageItemMemMonitor::onItemUnparked()
+{
+    im_assert(pooledItems_ > 0);
+    --pooledItems_;
+}
+
+MessageItemMemMonitor::ItemsRate MessageItemMemMonitor::getItemsRate() const
+{
+    const auto elapsedSec = std::max(rateTimer_.elapsed(), qint64(1)) / 1000.;
+
+    ItemsRate rate;
+    rate.created_ = createdItems_ / elapsedSec;
+    rate.recycled_ = recycledItems_ / elapsedSec;
+    rate.pooled_ = pooledItems_;
+
+    return rate;
+}
+
+void MessageItemMemMonitor::resetItemsRate()
+{
+    createdItems_ = 0;
+    recycledItems_ = 0;
+    rateTimer_.restart();
+}
+
+size_t MessageItemMemMonitor::pooledItemsLimit() const
+{
+    // while items are watched their footprint is reported, keep the hidden part small
+    return messageItemsWatcher_ ? maxPooledItemsWatched : maxPooledItems;
 }
 
 Utils::QObjectWatcher *MessageItemMemMonitor::messageItemsWatcher()
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <QObject>
+#include <QElapsedTimer>
 #include <vector>
 #include <array>
 
@@ -41,6 +42,24 @@ public:
     bool watchComplexMsgItem(Ui::ComplexMessage::ComplexMessageItem *_msgItem);
     CategoriesArray getMessageItemsFootprint();
 
+    struct ItemsRate
+    {
+        double created_ = 0.;
+        double recycled_ = 0.;
+        qint64 pooled_ = 0;
+    };
+
+    void onItemCreated();
+    void onItemRecycled();
+    void onItemParked();
+    void onItemUnparked();
+
+    /// items per second since resetItemsRate, reading doesn't reset the counters
+    ItemsRate getItemsRate() const;
+    void resetItemsRate();
+
+    size_t pooledItemsLimit() const;
+
 private:
     MessageItemMemMonitor(QObject *parent);
     Utils::QObjectWatcher *messageItemsWatcher();
@@ -53,4 +72,9 @@ private:
 
 private:
     Utils::QObjectWatcher *messageItemsWatcher_ = nullptr;
+
+    qint64 createdItems_ = 0;
+    qint64 recycledItems_ = 0;
+    qint64 pooledItems_ = 0;
+    QElapsedTimer rateTimer_;
 };
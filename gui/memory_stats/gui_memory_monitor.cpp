@@ -21,8 +21,6 @@ namespace
 {
 const Memory_Stats::NameString_t ReporteeName("GuiMemoryMonitor");
 
-qint64 calculateFootprintFor(const Logic::AvatarStorage::CacheMap& cacheMap);
-
 constexpr std::chrono::milliseconds sendStatInterval = std::chrono::hours(1);
 constexpr std::chrono::milliseconds sendStatIntervalDebug = std::chrono::minutes(1);
 constexpr int64_t memoryLimitStep = 200 * (1 << 20);
@@ -133,24 +131,21 @@ void GuiMemoryMonitor::onRequestFinished(const Memory_Stats::RequestHandle &_req
 
 Memory_Stats::MemoryStatsReport GuiMemoryMonitor::getAvatarsReport()
 {
-    qint64 total = 0;
-
-    qint64 totalByAimId = calculateFootprintFor(Logic::GetAvatarStorage()->GetByAimId());
-    total += totalByAimId;
-
-    qint64 totalByAimIdAndSize = calculateFootprintFor(Logic::GetAvatarStorage()->GetByAimIdAndSize());
-    total += totalByAimIdAndSize;
-
-    qint64 totalRounded = calculateFootprintFor(Logic::GetAvatarStorage()->GetRoundedByAimId());
-    total += totalRounded;
+    const auto stats = Logic::GetAvatarStorage()->getCacheStats();
 
     Memory_Stats::MemoryStatsReport report(ReporteeName,
-                                           total,
+                                           stats.bytes_,
                                            Memory_Stats::StatType::CachedAvatars);
 
-    report.addSubcategory("by_aim_id", totalByAimId);
-    report.addSubcategory("by_aim_id_and_size", totalByAimIdAndSize);
-    report.addSubcategory("rounded", totalRounded);
+    report.addSubcategory("by_aim_id", stats.baseBytes_);
+    report.addSubcategory("by_aim_id_and_size", stats.scaledBytes_);
+    report.addSubcategory("rounded", stats.roundedBytes_);
+
+    // counters rather than sizes, the report has no other place for them
+    report.addSubcategory("pixmaps_count", stats.count_);
+    report.addSubcategory("hits_count", stats.hits_);
+    report.addSubcategory("misses_count", stats.misses_);
+    report.addSubcategory("evictions_count", stats.evictions_);
 
     return report;
 }
@@ -284,6 +279,11 @@ Memory_Stats::MemoryStatsReport GuiMemoryMonitor::getPreviewsReport()
     report.addSubcategory("quote blocks (" + std::to_string(categoriesArray[6].first) + ")",
             categoriesArray[6].second);
 
+    const auto itemsRate = MessageItemMemMonitor::instance().getItemsRate();
+    report.addSubcategory("pooled items (" + std::to_string(itemsRate.pooled_) + ")", 0);
+    report.addSubcategory("items created/s (" + std::to_string(qRound(itemsRate.created_)) + ")", 0);
+    report.addSubcategory("items recycled/s (" + std::to_string(qRound(itemsRate.recycled_)) + ")", 0);
+
     return report;
 }
 
@@ -296,9 +296,11 @@ Memory_Stats::MemoryStatsReport GuiMemoryMonitor::getVideoPlayersReport()
 #ifndef STRIP_AV_MEDIA
     for (auto &videoStat: Ui::FFmpegPlayerMemMonitor::instance().getCurrentStats())
     {
-        QString format(qsl("Player:\nmedia_id = %1\ndecodedFrames(%2):\n\t\t\t"));
+        QString format(qsl("Player:\nmedia_id = %1\ndecode latency = %2us, dropped = %3\ndecodedFrames(%4):\n\t\t\t"));
 
         result.addSubcategory(format.arg(videoStat.mediaId_)
+                              .arg(videoStat.decodeLatencyUs_)
+                              .arg(videoStat.droppedFrames_)
                               .arg(videoStat.decodedFramesCount_).toStdString(),
                               videoStat.decodedFramesPixmapSize_);
     }
@@ -450,18 +452,3 @@ void GuiMemoryMonitor::writeLogMemoryReport(std::function<void()> _onComplete)
 
 //    return report;
 //}
-
-namespace
-{
-qint64 calculateFootprintFor(const Logic::AvatarStorage::CacheMap& cacheMap)
-{
-    qint64 result = 0;
-
-    for (auto it = cacheMap.begin(); it != cacheMap.end(); it++)
-    {
-        result += Utils::getMemoryFootprint(it->second);
-    }
-
-    return result;
-}
-}
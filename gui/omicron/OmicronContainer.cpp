@@ -5,10 +5,6 @@
 #include "../../corelib/collection_helper.h"
 #include "../utils/gui_coll_helper.h"
 
-#include "../common.shared/json_unserialize_helpers.h"
-
-#include <rapidjson/writer.h>
-#include <rapidjson/stringbuffer.h>
 #include <rapidjson/document.h>
 
 namespace Omicron
@@ -23,174 +19,132 @@ namespace Omicron
     {
         if (_collection.is_value_exist("data"))
         {
-            auto newData = std::make_shared<rapidjson::Document>(rapidjson::kObjectType);
-            if (newData->Parse(_collection.get_value_as_string("data")).HasParseError())
+            rapidjson::Document data(rapidjson::kObjectType);
+            if (data.Parse(_collection.get_value_as_string("data")).HasParseError())
                 return;
 
-            {
-                std::scoped_lock lock(dataLock_);
-                data_.swap(newData);
-                init_ = true;
-            }
+            auto snapshot = std::make_unique<const Snapshot>(data);
+
+            std::scoped_lock lock(snapshotsMutex_);
+            auto retired = std::move(snapshots_[nextSnapshot_]);
+            snapshots_[nextSnapshot_] = std::move(snapshot);
+            snapshot_.store(snapshots_[nextSnapshot_].get(), std::memory_order_release);
+            nextSnapshot_ = (nextSnapshot_ + 1) % snapshots_.size();
         }
     }
 
     void OmicronContainer::cleanup()
     {
-        std::scoped_lock lock(dataLock_);
-        init_ = false;
-        data_.reset();
+        snapshot_.store(nullptr, std::memory_order_release);
     }
 
-    bool OmicronContainer::boolValue(std::string_view _keyName, bool _defaultValue) const
+    bool OmicronContainer::boolValue(const omicronlib::omicron_key& _key, bool _defaultValue) const
     {
-        if (init_)
-        {
-            const auto data = getData();
-            const auto it = data->FindMember(common::json::make_string_ref(_keyName));
-            if (it != data->MemberEnd() && it->value.IsBool())
-                return it->value.GetBool();
-        }
+        if (const auto [snapshot, index] = findValue(_key, omicronlib::snapshot_value::is_bool); snapshot)
+            return snapshot->values_.value_at(index).bool_;
 
         return _defaultValue;
     }
 
-    int OmicronContainer::intValue(std::string_view _keyName, int _defaultValue) const
+    int OmicronContainer::intValue(const omicronlib::omicron_key& _key, int _defaultValue) const
     {
-        if (init_)
-        {
-            const auto data = getData();
-            const auto it = data->FindMember(common::json::make_string_ref(_keyName));
-            if (it != data->MemberEnd() && it->value.IsInt())
-                return it->value.GetInt();
-        }
+        if (const auto [snapshot, index] = findValue(_key, omicronlib::snapshot_value::is_int); snapshot)
+            return snapshot->values_.value_at(index).int_;
 
         return _defaultValue;
     }
 
-    unsigned int OmicronContainer::uintValue(std::string_view _keyName, unsigned int _defaultValue) const
+    unsigned int OmicronContainer::uintValue(const omicronlib::omicron_key& _key, unsigned int _defaultValue) const
     {
-        if (init_)
-        {
-            const auto data = getData();
-            const auto it = data->FindMember(common::json::make_string_ref(_keyName));
-            if (it != data->MemberEnd() && it->value.IsInt())
-                return it->value.GetUint();
-        }
+        if (const auto [snapshot, index] = findValue(_key, omicronlib::snapshot_value::is_int); snapshot)
+            return snapshot->values_.value_at(index).uint_;
 
         return _defaultValue;
     }
 
-    int64_t OmicronContainer::int64Value(std::string_view _keyName, int64_t _defaultValue) const
+    int64_t OmicronContainer::int64Value(const omicronlib::omicron_key& _key, int64_t _defaultValue) const
     {
-        if (init_)
-        {
-            const auto data = getData();
-            const auto it = data->FindMember(common::json::make_string_ref(_keyName));
-            if (it != data->MemberEnd() && it->value.IsInt64())
-                return it->value.GetInt64();
-        }
+        if (const auto [snapshot, index] = findValue(_key, omicronlib::snapshot_value::is_int64); snapshot)
+            return snapshot->values_.value_at(index).int64_;
 
         return _defaultValue;
     }
 
-    uint64_t OmicronContainer::uint64Value(std::string_view _keyName, uint64_t _defaultValue) const
+    uint64_t OmicronContainer::uint64Value(const omicronlib::omicron_key& _key, uint64_t _defaultValue) const
     {
-        if (init_)
-        {
-            const auto data = getData();
-            const auto it = data->FindMember(common::json::make_string_ref(_keyName));
-            if (it != data->MemberEnd() && it->value.IsInt64())
-                return it->value.GetUint64();
-        }
+        if (const auto [snapshot, index] = findValue(_key, omicronlib::snapshot_value::is_int64); snapshot)
+            return snapshot->values_.value_at(index).uint64_;
 
         return _defaultValue;
     }
 
-    double OmicronContainer::doubleValue(std::string_view _keyName, double _defaultValue) const
+    double OmicronContainer::doubleValue(const omicronlib::omicron_key& _key, double _defaultValue) const
     {
-        if (init_)
-        {
-            const auto data = getData();
-            const auto it = data->FindMember(common::json::make_string_ref(_keyName));
-            if (it != data->MemberEnd() && it->value.IsDouble())
-                return it->value.GetDouble();
-        }
+        if (const auto [snapshot, index] = findValue(_key, omicronlib::snapshot_value::is_double); snapshot)
+            return snapshot->values_.value_at(index).double_;
 
         return _defaultValue;
     }
 
-    std::string OmicronContainer::stringValue(std::string_view _keyName, const std::string& _defaultValue) const
+    std::string OmicronContainer::stringValue(const omicronlib::omicron_key& _key, const std::string& _defaultValue) const
     {
-        if (init_)
-        {
-            const auto data = getData();
-            const auto it = data->FindMember(common::json::make_string_ref(_keyName));
-            if (it != data->MemberEnd() && it->value.IsString())
-                return std::string(it->value.GetString(), it->value.GetStringLength());
-        }
+        if (const auto [snapshot, index] = findValue(_key, omicronlib::snapshot_value::is_string); snapshot)
+            return snapshot->values_.value_at(index).string_;
 
         return _defaultValue;
     }
 
-    QString OmicronContainer::stringValue(std::string_view _keyName, const QString& _defaultValue) const
+    QString OmicronContainer::stringValue(const omicronlib::omicron_key& _key, const QString& _defaultValue) const
     {
-        if (init_)
-        {
-            const auto data = getData();
-            const auto it = data->FindMember(common::json::make_string_ref(_keyName));
-            if (it != data->MemberEnd() && it->value.IsString())
-                return QString::fromUtf8(it->value.GetString(), it->value.GetStringLength());
-        }
+        if (const auto [snapshot, index] = findValue(_key, omicronlib::snapshot_value::is_string); snapshot)
+            return snapshot->qstrings_[index];
 
         return _defaultValue;
     }
 
-    std::string OmicronContainer::jsonValue(std::string_view _keyName, const std::string& _defaultValue) const
+    std::string OmicronContainer::jsonValue(const omicronlib::omicron_key& _key, const std::string& _defaultValue) const
     {
-        if (init_)
-        {
-            const auto data = getData();
-            const auto it = data->FindMember(common::json::make_string_ref(_keyName));
-            if (it != data->MemberEnd() && (it->value.IsObject() || it->value.IsArray()))
-            {
-                rapidjson::StringBuffer buffer;
-                rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
-                it->value.Accept(writer);
-                return std::string(buffer.GetString(), buffer.GetSize());
-            }
-        }
+        if (const auto [snapshot, index] = findValue(_key, omicronlib::snapshot_value::is_json); snapshot)
+            return snapshot->values_.value_at(index).string_;
 
         return _defaultValue;
     }
 
-    QString OmicronContainer::jsonValue(std::string_view _keyName, const QString& _defaultValue) const
+    QString OmicronContainer::jsonValue(const omicronlib::omicron_key& _key, const QString& _defaultValue) const
     {
-        if (init_)
-        {
-            const auto data = getData();
-            const auto it = data->FindMember(common::json::make_string_ref(_keyName));
-            if (it != data->MemberEnd() && (it->value.IsObject() || it->value.IsArray()))
-            {
-                rapidjson::StringBuffer buffer;
-                rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
-                it->value.Accept(writer);
-                return QString::fromUtf8(buffer.GetString(), buffer.GetSize());
-            }
-        }
+        if (const auto [snapshot, index] = findValue(_key, omicronlib::snapshot_value::is_json); snapshot)
+            return snapshot->qstrings_[index];
 
         return _defaultValue;
     }
 
     OmicronContainer::OmicronContainer()
-        : init_(false)
-        , data_(std::make_shared<rapidjson::Document>(rapidjson::kObjectType))
+        : snapshot_(nullptr)
     {
     }
 
-    std::shared_ptr<const rapidjson::Document> OmicronContainer::getData() const
+    OmicronContainer::Snapshot::Snapshot(const rapidjson::Value& _data)
+        : values_(_data)
     {
-        std::scoped_lock lock(dataLock_);
-        return data_;
+        qstrings_.resize(values_.size());
+        for (size_t i = 0; i < values_.size(); ++i)
+        {
+            const auto& value = values_.value_at(i);
+            if (value.flags_ & (omicronlib::snapshot_value::is_string | omicronlib::snapshot_value::is_json))
+                qstrings_[i] = QString::fromStdString(value.string_);
+        }
+    }
+
+    std::pair<const OmicronContainer::Snapshot*, size_t> OmicronContainer::findValue(const omicronlib::omicron_key& _key, unsigned int _typeFlags) const
+    {
+        const auto snapshot = snapshot_.load(std::memory_order_acquire);
+        if (!snapshot)
+            return { nullptr, 0 };
+
+        const auto index = snapshot->values_.find_index(_key);
+        if (index == snapshot->values_.size() || !(snapshot->values_.value_at(index).flags_ & _typeFlags))
+            return { nullptr, 0 };
+
+        return { snapshot, index };
     }
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <rapidjson/document.h>
+#include "../../libomicron/include/omicron/omicron_snapshot.h"
 
 #include "omicron_helper.h"
 
@@ -14,38 +15,37 @@ namespace Omicron
         void unserialize(core::coll_helper _collection);
         void cleanup();
 
-        bool boolValue(std::string_view _keyName, bool _defaultValue) const;
-        int intValue(std::string_view _keyName, int _defaultValue) const;
-        unsigned int uintValue(std::string_view _keyName, unsigned int _defaultValue) const;
-        int64_t int64Value(std::string_view _keyName, int64_t _defaultValue) const;
-        uint64_t uint64Value(std::string_view _keyName, uint64_t _defaultValue) const;
-        double doubleValue(std::string_view _keyName, double _defaultValue) const;
-        std::string stringValue(std::string_view _keyName, const std::string& _defaultValue) const;
-        QString stringValue(std::string_view _keyName, const QString& _defaultValue) const;
-        std::string jsonValue(std::string_view _keyName, const std::string& _defaultValue) const;
-        QString jsonValue(std::string_view _keyName, const QString& _defaultValue) const;
+        bool boolValue(const omicronlib::omicron_key& _key, bool _defaultValue) const;
+        int intValue(const omicronlib::omicron_key& _key, int _defaultValue) const;
+        unsigned int uintValue(const omicronlib::omicron_key& _key, unsigned int _defaultValue) const;
+        int64_t int64Value(const omicronlib::omicron_key& _key, int64_t _defaultValue) const;
+        uint64_t uint64Value(const omicronlib::omicron_key& _key, uint64_t _defaultValue) const;
+        double doubleValue(const omicronlib::omicron_key& _key, double _defaultValue) const;
+        std::string stringValue(const omicronlib::omicron_key& _key, const std::string& _defaultValue) const;
+        QString stringValue(const omicronlib::omicron_key& _key, const QString& _defaultValue) const;
+        std::string jsonValue(const omicronlib::omicron_key& _key, const std::string& _defaultValue) const;
+        QString jsonValue(const omicronlib::omicron_key& _key, const QString& _defaultValue) const;
 
     private:
-        class SpinLock
+        // the typed values of one data update, converted once and never changed afterwards
+        struct Snapshot
         {
-            std::atomic_flag locked = ATOMIC_FLAG_INIT;
-        public:
-            void lock()
-            {
-                while (locked.test_and_set(std::memory_order_acquire)) { ; }
-            }
-            void unlock()
-            {
-                locked.clear(std::memory_order_release);
-            }
+            explicit Snapshot(const rapidjson::Value& _data);
+
+            omicronlib::omicron_snapshot values_;
+            std::vector<QString> qstrings_; // string and json values by the index in values_
         };
 
-        std::atomic<bool> init_;
-        std::shared_ptr<rapidjson::Document> data_;
-        mutable SpinLock dataLock_;
+        // readers use the current snapshot without locking, so a replaced one is kept for a few more updates;
+        // the data changes a few times a day at most
+        std::atomic<const Snapshot*> snapshot_;
+        std::array<std::unique_ptr<const Snapshot>, 8> snapshots_;
+        size_t nextSnapshot_ = 0;
+        std::mutex snapshotsMutex_;
 
     private:
         OmicronContainer();
-        std::shared_ptr<const rapidjson::Document> getData() const;
+        // the snapshot and the index of the value, or no snapshot if there is no value of these types
+        std::pair<const Snapshot*, size_t> findValue(const omicronlib::omicron_key& _key, unsigned int _typeFlags) const;
     };
 }
@@ -20,53 +20,53 @@ namespace Omicron
         OmicronContainer::instance().cleanup();
     }
 
-    bool _o(std::string_view _keyName, bool _defaultValue)
+    bool _o(const omicronlib::omicron_key& _key, bool _defaultValue)
     {
-        return OmicronContainer::instance().boolValue(_keyName, _defaultValue);
+        return OmicronContainer::instance().boolValue(_key, _defaultValue);
     }
 
-    int _o(std::string_view _keyName, int _defaultValue)
+    int _o(const omicronlib::omicron_key& _key, int _defaultValue)
     {
-        return OmicronContainer::instance().intValue(_keyName, _defaultValue);
+        return OmicronContainer::instance().intValue(_key, _defaultValue);
     }
 
-    unsigned int _o(std::string_view _keyName, unsigned int _defaultValue)
+    unsigned int _o(const omicronlib::omicron_key& _key, unsigned int _defaultValue)
     {
-        return OmicronContainer::instance().uintValue(_keyName, _defaultValue);
+        return OmicronContainer::instance().uintValue(_key, _defaultValue);
     }
 
-    int64_t _o(std::string_view _keyName, int64_t _defaultValue)
+    int64_t _o(const omicronlib::omicron_key& _key, int64_t _defaultValue)
     {
-        return OmicronContainer::instance().int64Value(_keyName, _defaultValue);
+        return OmicronContainer::instance().int64Value(_key, _defaultValue);
     }
 
-    uint64_t _o(std::string_view _keyName, uint64_t _defaultValue)
+    uint64_t _o(const omicronlib::omicron_key& _key, uint64_t _defaultValue)
     {
-        return OmicronContainer::instance().uint64Value(_keyName, _defaultValue);
+        return OmicronContainer::instance().uint64Value(_key, _defaultValue);
     }
 
-    double _o(std::string_view _keyName, double _defaultValue)
+    double _o(const omicronlib::omicron_key& _key, double _defaultValue)
     {
-        return OmicronContainer::instance().doubleValue(_keyName, _defaultValue);
+        return OmicronContainer::instance().doubleValue(_key, _defaultValue);
     }
 
-    std::string _o(std::string_view _keyName, const std::string& _defaultValue)
+    std::string _o(const omicronlib::omicron_key& _key, const std::string& _defaultValue)
     {
-        return OmicronContainer::instance().stringValue(_keyName, _defaultValue);
+        return OmicronContainer::instance().stringValue(_key, _defaultValue);
     }
 
-    QString _o(std::string_view _keyName, const QString& _defaultValue)
+    QString _o(const omicronlib::omicron_key& _key, const QString& _defaultValue)
     {
-        return OmicronContainer::instance().stringValue(_keyName, _defaultValue);
+        return OmicronContainer::instance().stringValue(_key, _defaultValue);
     }
 
-    std::string _o_json(std::string_view _keyName, const std::string& _defaultValue)
+    std::string _o_json(const omicronlib::omicron_key& _key, const std::string& _defaultValue)
     {
-        return OmicronContainer::instance().jsonValue(_keyName, _defaultValue);
+        return OmicronContainer::instance().jsonValue(_key, _defaultValue);
     }
 
-    QString _o_json(std::string_view _keyName, const QString& _defaultValue)
+    QString _o_json(const omicronlib::omicron_key& _key, const QString& _defaultValue)
     {
-        return OmicronContainer::instance().jsonValue(_keyName, _defaultValue);
+        return OmicronContainer::instance().jsonValue(_key, _defaultValue);
     }
 }
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "../../libomicron/include/omicron/omicron_key.h"
+
 namespace core
 {
     class coll_helper;
@@ -11,15 +13,15 @@ namespace Omicron
 
     void cleanup();
 
-    bool _o(std::string_view _keyName, bool _defaultValue);
-    int _o(std::string_view _keyName, int _defaultValue);
-    unsigned int _o(std::string_view _keyName, unsigned int _defaultValue);
-    int64_t _o(std::string_view _keyName, int64_t _defaultValue);
-    uint64_t _o(std::string_view _keyName, uint64_t _defaultValue);
-    double _o(std::string_view _keyName, double _defaultValue);
-    std::string _o(std::string_view _keyName, const std::string& _defaultValue);
-    QString _o(std::string_view _keyName, const QString& _defaultValue);
+    bool _o(const omicronlib::omicron_key& _key, bool _defaultValue);
+    int _o(const omicronlib::omicron_key& _key, int _defaultValue);
+    unsigned int _o(const omicronlib::omicron_key& _key, unsigned int _defaultValue);
+    int64_t _o(const omicronlib::omicron_key& _key, int64_t _defaultValue);
+    uint64_t _o(const omicronlib::omicron_key& _key, uint64_t _defaultValue);
+    double _o(const omicronlib::omicron_key& _key, double _defaultValue);
+    std::string _o(const omicronlib::omicron_key& _key, const std::string& _defaultValue);
+    QString _o(const omicronlib::omicron_key& _key, const QString& _defaultValue);
 
-    std::string _o_json(std::string_view _keyName, const std::string&  _defaultValue);
-    QString _o_json(std::string_view _keyName, const QString& _defaultValue);
+    std::string _o_json(const omicronlib::omicron_key& _key, const std::string&  _defaultValue);
+    QString _o_json(const omicronlib::omicron_key& _key, const QString& _defaultValue);
 }
@@ -1135,7 +1135,7 @@ namespace Data
         }
     }
 
-    MessagesResult UnserializeMessageBuddies(core::coll_helper* helper, const QString &myAimid)
+    MessagesResult UnserializeMessageBuddies(core::coll_helper* helper, const QString &myAimid, IncompleteMessages* _incomplete)
     {
         im_assert(!myAimid.isEmpty());
 
@@ -1154,26 +1154,26 @@ namespace Data
             if (helper->is_value_exist("messages"))
             {
                 auto msgArray = helper->get_value_as_array("messages");
-                unserializeMessages(msgArray, aimId, myAimid, theirs_last_delivered, theirs_last_read, Out messages);
+                unserializeMessages(msgArray, aimId, myAimid, theirs_last_delivered, theirs_last_read, Out messages, _incomplete);
             }
 
             if (helper->is_value_exist("pending_messages"))
             {
                 havePending = true;
                 auto msgArray = helper->get_value_as_array("pending_messages");
-                unserializeMessages(msgArray, aimId, myAimid, theirs_last_delivered, theirs_last_read, Out messages);
+                unserializeMessages(msgArray, aimId, myAimid, theirs_last_delivered, theirs_last_read, Out messages, _incomplete);
             }
 
             if (helper->is_value_exist("intro_messages"))
             {
                 auto introArray = helper->get_value_as_array("intro_messages");
-                unserializeMessages(introArray, aimId, myAimid, theirs_last_delivered, theirs_last_read, Out introMessages);
+                unserializeMessages(introArray, aimId, myAimid, theirs_last_delivered, theirs_last_read, Out introMessages, _incomplete);
             }
 
             if (helper->is_value_exist("modified"))
             {
                 auto modificationsArray = helper->get_value_as_array("modified");
-                unserializeMessages(modificationsArray, aimId, myAimid, theirs_last_delivered, theirs_last_read, Out modifications);
+                unserializeMessages(modificationsArray, aimId, myAimid, theirs_last_delivered, theirs_last_read, Out modifications, _incomplete);
             }
 
             if (helper->is_value_exist("last_msg_in_index"))
@@ -1183,12 +1183,66 @@ namespace Data
         return { std::move(aimId), std::move(messages), std::move(introMessages), std::move(modifications), lastMsgId, havePending };
     }
 
+    static void completeMessage(Data::MessageBuddy& _message, const core::coll_helper& _msgColl, const QString& _myAimid)
+    {
+        if (_msgColl.is_value_exist("chat_event"))
+        {
+            im_assert(!_message.IsChatEvent());
+
+            core::coll_helper chat_event(_msgColl.get_value_as_collection("chat_event"), false);
+
+            _message.SetType(core::message_type::chat_event);
+
+            _message.SetChatEvent(
+                HistoryControl::ChatEventInfo::make(
+                    chat_event,
+                    _message.IsOutgoing(),
+                    _myAimid,
+                    _message.AimId_
+                )
+            );
+        }
+
+        if (_msgColl->is_value_exist("quotes"))
+        {
+            core::iarray* quotes = _msgColl.get_value_as_array("quotes");
+            const auto size = quotes->size();
+            _message.Quotes_.reserve(size);
+            for (auto i = 0; i < size; ++i)
+            {
+                Data::Quote q;
+                q.unserialize(quotes->get_at(i)->get_as_collection());
+                q.quoterId_ = _message.Chat_ ? _message.GetChatSender() : _message.AimId_;
+                _message.Quotes_.push_back(std::move(q));
+            }
+        }
+
+        if (_msgColl->is_value_exist("mentions"))
+        {
+            core::iarray* ment = _msgColl.get_value_as_array("mentions");
+            for (auto i = 0; i < ment->size(); ++i)
+            {
+                const auto coll = ment->get_at(i)->get_as_collection();
+                core::coll_helper ment_helper(coll, false);
+                auto currentAimId = QString::fromUtf8(ment_helper.get_value_as_string("sn"));
+
+                if (!currentAimId.isEmpty())
+                {
+                    const auto friendly = Logic::GetFriendlyContainer()->getFriendly(currentAimId);
+                    _message.Mentions_.emplace(std::move(currentAimId), friendly);
+                }
+
+            }
+        }
+    }
+
     Data::MessageBuddySptr unserializeMessage(
         const core::coll_helper& _msgColl,
         const QString& _aimId,
         const QString& _myAimid,
         const qint64 _theirs_last_delivered,
-        const qint64 _theirs_last_read)
+        const qint64 _theirs_last_read,
+        IncompleteMessages* _incomplete)
     {
         auto message = std::make_shared<Data::MessageBuddy>();
 
@@ -1282,55 +1336,10 @@ namespace Data
             );
         }
 
-        if (_msgColl.is_value_exist("chat_event"))
-        {
-            im_assert(!message->IsChatEvent());
-
-            core::coll_helper chat_event(_msgColl.get_value_as_collection("chat_event"), false);
-
-            message->SetType(core::message_type::chat_event);
-
-            message->SetChatEvent(
-                HistoryControl::ChatEventInfo::make(
-                    chat_event,
-                    message->IsOutgoing(),
-                    _myAimid,
-                    message->AimId_
-                )
-            );
-        }
-
-        if (_msgColl->is_value_exist("quotes"))
-        {
-            core::iarray* quotes = _msgColl.get_value_as_array("quotes");
-            const auto size = quotes->size();
-            message->Quotes_.reserve(size);
-            for (auto i = 0; i < size; ++i)
-            {
-                Data::Quote q;
-                q.unserialize(quotes->get_at(i)->get_as_collection());
-                q.quoterId_ = message->Chat_ ? message->GetChatSender() : message->AimId_;
-                message->Quotes_.push_back(std::move(q));
-            }
-        }
-
-        if (_msgColl->is_value_exist("mentions"))
-        {
-            core::iarray* ment = _msgColl.get_value_as_array("mentions");
-            for (auto i = 0; i < ment->size(); ++i)
-            {
-                const auto coll = ment->get_at(i)->get_as_collection();
-                core::coll_helper ment_helper(coll, false);
-                auto currentAimId = QString::fromUtf8(ment_helper.get_value_as_string("sn"));
-
-                if (!currentAimId.isEmpty())
-                {
-                    const auto friendly = Logic::GetFriendlyContainer()->getFriendly(currentAimId);
-                    message->Mentions_.emplace(std::move(currentAimId), friendly);
-                }
-
-            }
-        }
+        if (_incomplete)
+            _incomplete->emplace_back(message, _msgColl);
+        else
+            completeMessage(*message, _msgColl, _myAimid);
 
         if (_msgColl->is_value_exist(c_coll_format) && !message->GetText().isEmpty())
         {
@@ -1767,7 +1776,8 @@ namespace Data
         const QString& _myAimid,
         const qint64 _theirs_last_delivered,
         const qint64 _theirs_last_read,
-        Out Data::MessageBuddies &messages)
+        Out Data::MessageBuddies &messages,
+        IncompleteMessages* _incomplete)
     {
         im_assert(!_aimId.isEmpty());
         im_assert(!_myAimid.isEmpty());
@@ -1788,10 +1798,18 @@ namespace Data
                 false
             );
 
-            messages.push_back(Data::unserializeMessage(value, _aimId, _myAimid, _theirs_last_delivered, _theirs_last_read));
+            messages.push_back(Data::unserializeMessage(value, _aimId, _myAimid, _theirs_last_delivered, _theirs_last_read, _incomplete));
         }
     }
 
+    void completeMessages(const IncompleteMessages& _messages, const QString& _myAimid)
+    {
+        Utils::ensureMainThread();
+
+        for (const auto& [message, collection] : _messages)
+            completeMessage(*message, collection, _myAimid);
+    }
+
     CallInfo::CallInfo()
         : count_(1)
     {
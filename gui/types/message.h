@@ -740,7 +740,12 @@ namespace Data
         bool havePending;
     };
 
-    MessagesResult UnserializeMessageBuddies(core::coll_helper* helper, const QString &myAimid);
+    // messages unserialized off the gui thread, together with their collections (not owned, so the root
+    // collection of the batch must outlive them); chat events, quotes and mentions need gui-thread containers
+    // (friendly names, the contact list) and are filled in later by completeMessages
+    using IncompleteMessages = std::vector<std::pair<MessageBuddySptr, core::coll_helper>>;
+
+    MessagesResult UnserializeMessageBuddies(core::coll_helper* helper, const QString &myAimid, IncompleteMessages* _incomplete = nullptr);
 
     void unserializeMessages(
         core::iarray* _msgArray,
@@ -748,7 +753,8 @@ namespace Data
         const QString& _myAimid,
         const qint64 _theirs_last_delivered,
         const qint64 _theirs_last_read,
-        Out Data::MessageBuddies& _messages);
+        Out Data::MessageBuddies& _messages,
+        IncompleteMessages* _incomplete = nullptr);
 
 
     Data::MessageBuddySptr unserializeMessage(
@@ -756,7 +762,10 @@ namespace Data
         const QString& _aimId,
         const QString& _myAimid,
         const qint64 _theirs_last_delivered,
-        const qint64 _theirs_last_read);
+        const qint64 _theirs_last_read,
+        IncompleteMessages* _incomplete = nullptr);
+
+    void completeMessages(const IncompleteMessages& _messages, const QString& _myAimid);
 
     struct ServerMessagesIds
     {
@@ -205,6 +205,7 @@ namespace Utils
 
         void historyControlReady(const QString&, qint64 _message_id, const Data::DlgState&, qint64 _last_read_msg, bool _isFirstRequest);
         void logHistory(const QString&);
+        void scrollHistoryTest(const QString&);
         void chatEvents(const QString&, const QVector<HistoryControl::ChatEventInfoSptr>&) const;
 
         void imageCropDialogIsShown(QWidget *);
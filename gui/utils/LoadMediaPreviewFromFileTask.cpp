@@ -27,11 +27,13 @@ void LoadMediaPreviewFromFileTask::run()
         return;
     }
 
-    QPixmap preview;
     QSize originalSize;
 
     QImageReader reader(path_);
+    reader.setAutoTransform(true);
     originalSize = reader.size();
+    if (const auto tr = reader.transformation(); tr == QImageIOHandler::TransformationRotate90 || tr == QImageIOHandler::TransformationRotate270)
+        originalSize.transpose();
 
     const auto cropThreshold = Ui::MessageStyle::Preview::mediaCropThreshold();
     auto maxSize = Utils::scale_bitmap(QSize(Ui::MessageStyle::Preview::getImageWidthMax(), Ui::MessageStyle::Preview::getImageHeightMax()));
@@ -40,7 +42,9 @@ void LoadMediaPreviewFromFileTask::run()
     if (std::min(scaledSize.width(), scaledSize.height()) < cropThreshold)
         maxSize = originalSize;
 
-    Utils::loadPixmapScaled(path_, maxSize, preview, originalSize, Utils::PanoramicCheck::no);
+    QImage image;
+    loadImageScaledCached(path_, maxSize, Out image, Out originalSize);
+    auto preview = QPixmap::fromImage(std::move(image));
 
     if (Q_LIKELY(QCoreApplication::instance()))
         Q_EMIT loaded(preview, originalSize);
@@ -27,16 +27,18 @@ namespace Utils
             Q_EMIT loadedSignal(QPixmap(), QSize());
             return;
         }
-        QPixmap preview;
+        QImage image;
         QSize originalImageSize;
 
-        if (!Utils::loadPixmapScaled(path_, maxSize_, preview, originalImageSize, Utils::PanoramicCheck::no))
+        if (!loadImageScaledCached(path_, maxSize_, Out image, Out originalImageSize))
         {
             if (Q_LIKELY(QCoreApplication::instance()))
                 Q_EMIT loadedSignal(QPixmap(), QSize());
             return;
         }
 
+        auto preview = QPixmap::fromImage(std::move(image));
+
         im_assert(!preview.isNull());
 
         if (Q_LIKELY(QCoreApplication::instance()))
@@ -66,7 +68,7 @@ namespace Utils
         QImage preview;
         QSize originalImageSize;
 
-        Utils::loadImageScaled(path_, maxSize_, preview, originalImageSize, Utils::PanoramicCheck::no);
+        loadImageScaledCached(path_, maxSize_, Out preview, Out originalImageSize);
 
         im_assert(!preview.isNull());
 
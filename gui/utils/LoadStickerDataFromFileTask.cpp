@@ -14,12 +14,38 @@ namespace Utils
     {
         if (!loadData_.empty())
         {
+            // stickers of a set share one pack file, it is opened once per batch and read by mapped slices
+            std::map<QString, std::unique_ptr<QFile>> packs;
+
             for (auto& p : loadData_)
             {
                 if (Ui::ComplexMessage::isLottieFileSharingId(p.fsId_.fileId))
+                {
                     p.data_ = Ui::Stickers::StickerData::makeLottieData(p.path_);
+                }
+                else if (p.length_ > 0)
+                {
+                    auto& pack = packs[p.path_];
+                    if (!pack)
+                    {
+                        pack = std::make_unique<QFile>(p.path_);
+                        pack->open(QIODevice::ReadOnly);
+                    }
+
+                    if (!pack->isOpen())
+                        continue;
+
+                    if (auto slice = pack->map(p.offset_, p.length_))
+                    {
+                        auto data = QByteArray::fromRawData(reinterpret_cast<const char*>(slice), int(p.length_));
+                        p.data_.loadFromData(data);
+                        pack->unmap(slice);
+                    }
+                }
                 else
+                {
                     p.data_.loadFromFile(p.path_);
+                }
             }
 
             Q_EMIT loadedBatch(std::move(loadData_), QPrivateSignal());
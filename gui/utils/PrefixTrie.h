@@ -0,0 +1,108 @@
+#pragma once
+
+namespace Utils
+{
+    // where the matching of a text stopped, to continue from there when the text grows
+    struct PrefixTrieState
+    {
+        QString text_;
+        int32_t node_ = -1;
+        uint64_t generation_ = 0;
+    };
+
+    // generations are unique across all the tries, so a state kept while a trie is rebuilt
+    // or replaced by another one never matches it and never refers to nodes of the former trie
+    inline uint64_t nextPrefixTrieGeneration() noexcept
+    {
+        static std::atomic<uint64_t> generation = 0;
+        return ++generation;
+    }
+
+    // keys are sequences of UTF-16 code units, every node holds a Value (default constructed when unused);
+    // node ids stay valid until clear(), a matching state can be kept between calls and advanced as the text grows
+    template <typename Value>
+    class PrefixTrie
+    {
+    public:
+        using Node = int32_t;
+        static constexpr Node noNode = -1;
+
+        using State = PrefixTrieState;
+
+        PrefixTrie() { clear(); }
+
+        void clear()
+        {
+            nodes_.clear();
+            nodes_.emplace_back();
+            generation_ = nextPrefixTrieGeneration();
+        }
+
+        Value& insert(QStringView _key)
+        {
+            Node node = 0;
+            for (const auto c : _key)
+            {
+                auto& children = nodes_[node].children_;
+                const auto it = std::lower_bound(children.begin(), children.end(), c.unicode(), [](const auto& _child, char16_t _c) { return _child.first < _c; });
+                if (it != children.end() && it->first == c.unicode())
+                {
+                    node = it->second;
+                    continue;
+                }
+
+                const auto child = Node(nodes_.size());
+                children.insert(it, { c.unicode(), child });
+                nodes_.emplace_back();
+                node = child;
+
+                // a key that did not exist can make a dead state alive
+                generation_ = nextPrefixTrieGeneration();
+            }
+            return nodes_[node].value_;
+        }
+
+        Node walk(Node _node, QStringView _text) const
+        {
+            for (const auto c : _text)
+            {
+                if (_node == noNode)
+                    break;
+
+                const auto& children = nodes_[_node].children_;
+                const auto it = std::lower_bound(children.begin(), children.end(), c.unicode(), [](const auto& _child, char16_t _c) { return _child.first < _c; });
+                _node = (it != children.end() && it->first == c.unicode()) ? it->second : noNode;
+            }
+            return _node;
+        }
+
+        Node find(QStringView _key) const { return walk(0, _key); }
+
+        // continues from the previous text when _text extends it
+        Node find(const QString& _text, State& _state) const
+        {
+            if (_state.generation_ == generation_ && _text.startsWith(_state.text_))
+                _state.node_ = walk(_state.node_, QStringView(_text).mid(_state.text_.size()));
+            else
+                _state.node_ = find(QStringView(_text));
+
+            _state.text_ = _text;
+            _state.generation_ = generation_;
+            return _state.node_;
+        }
+
+        const Value* value(Node _node) const { return _node == noNode ? nullptr : &nodes_[_node].value_; }
+
+        size_t nodesCount() const noexcept { return nodes_.size(); }
+
+    private:
+        struct Entry
+        {
+            Value value_ = {};
+            std::vector<std::pair<char16_t, Node>> children_;
+        };
+
+        std::vector<Entry> nodes_;
+        uint64_t generation_ = 0;
+    };
+}
@@ -0,0 +1,168 @@
+#include "stdafx.h"
+
+#include "ThumbnailCache.h"
+#include "async/AsyncTask.h"
+
+#include <QSaveFile>
+#include <QStandardPaths>
+
+namespace
+{
+    constexpr quint32 cacheMagic = 0x54484D42; // THMB
+    constexpr quint32 cacheVersion = 1;
+    constexpr qint64 maxCacheSize = 128 * 1024 * 1024;
+    constexpr qint64 minCachedFileSize = 256 * 1024;
+    constexpr int trimEveryNthStore = 64;
+    constexpr int jpegQuality = 90;
+
+    std::atomic<int> storesSinceTrim = { 0 };
+
+    std::mutex dirMutex;
+    QString cacheDir;
+
+    // loads run on the thread pool, the folder may be changed on the gui thread meanwhile
+    QString getDir()
+    {
+        std::scoped_lock lock(dirMutex);
+        return cacheDir;
+    }
+
+    QString entryPath(const QString& _dir, const QFileInfo& _file, const QSize& _maxSize)
+    {
+        QCryptographicHash hash(QCryptographicHash::Sha1);
+        hash.addData(_file.absoluteFilePath().toUtf8());
+        hash.addData(QByteArray::number(_file.size()));
+        hash.addData(QByteArray::number(_file.lastModified().toMSecsSinceEpoch()));
+
+        return _dir % QChar(u'/') % QString::fromLatin1(hash.result().toHex())
+            % QChar(u'_') % QString::number(_maxSize.width()) % QChar(u'x') % QString::number(_maxSize.height());
+    }
+
+    void trim(const QString& _dir)
+    {
+        QDir dir(_dir);
+        auto entries = dir.entryInfoList(QDir::Files, QDir::Time | QDir::Reversed);
+
+        qint64 total = 0;
+        for (const auto& entry : std::as_const(entries))
+            total += entry.size();
+
+        for (const auto& entry : std::as_const(entries))
+        {
+            if (total <= maxCacheSize)
+                break;
+
+            total -= entry.size();
+            QFile::remove(entry.absoluteFilePath());
+        }
+    }
+}
+
+namespace Utils::ThumbnailCache
+{
+    void setDir(const QString& _dir)
+    {
+        // the previews were kept outside the profiles before
+        static std::once_flag legacyRemoved;
+        std::call_once(legacyRemoved, []()
+        {
+            Async::runAsync([dir = QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + ql1s("/thumbnails")]() { QDir(dir).removeRecursively(); });
+        });
+
+        if (!_dir.isEmpty())
+            QDir().mkpath(_dir);
+
+        std::scoped_lock lock(dirMutex);
+        cacheDir = _dir;
+    }
+
+    bool isWorthProbing(const QFileInfo& _file, const QSize& _maxSize)
+    {
+        return _maxSize.isValid() && _file.size() >= minCachedFileSize;
+    }
+
+    bool isWorthCaching(const QSize& _maxSize, const QSize& _originalSize)
+    {
+        constexpr auto minDownscaleFactor = 2;
+        return _maxSize.isValid()
+            && (_originalSize.width() >= _maxSize.width() * minDownscaleFactor || _originalSize.height() >= _maxSize.height() * minDownscaleFactor);
+    }
+
+    bool load(const QFileInfo& _file, const QSize& _maxSize, Out QImage& _image, Out QSize& _originalSize)
+    {
+        const auto dir = getDir();
+        if (dir.isEmpty() || !_file.exists())
+            return false;
+
+        QFile file(entryPath(dir, _file, _maxSize));
+        if (!file.open(QIODevice::ReadOnly))
+            return false;
+
+        QDataStream stream(&file);
+        quint32 magic = 0;
+        quint32 version = 0;
+        stream >> magic >> version;
+        if (magic != cacheMagic || version != cacheVersion)
+            return false;
+
+        QSize originalSize;
+        QByteArray encoded;
+        stream >> originalSize >> encoded;
+        if (stream.status() != QDataStream::Ok || encoded.isEmpty())
+            return false;
+
+        QImage image;
+        if (!image.loadFromData(encoded))
+            return false;
+
+        _image = std::move(image);
+        _originalSize = originalSize;
+        return true;
+    }
+
+    void store(const QFileInfo& _file, const QSize& _maxSize, const QImage& _image, const QSize& _originalSize)
+    {
+        if (_image.isNull())
+            return;
+
+        const auto dir = getDir();
+        if (dir.isEmpty() || !_file.exists())
+            return;
+
+        QByteArray encoded;
+        {
+            QBuffer buffer(&encoded);
+            buffer.open(QIODevice::WriteOnly);
+            const auto hasAlpha = _image.hasAlphaChannel();
+            if (!_image.save(&buffer, hasAlpha ? "png" : "jpg", hasAlpha ? -1 : jpegQuality))
+                return;
+        }
+
+        QSaveFile file(entryPath(dir, _file, _maxSize));
+        if (!file.open(QIODevice::WriteOnly))
+            return;
+
+        QDataStream stream(&file);
+        stream << cacheMagic << cacheVersion << _originalSize << encoded;
+        if (stream.status() != QDataStream::Ok || !file.commit())
+            return;
+
+        if (++storesSinceTrim >= trimEveryNthStore)
+        {
+            storesSinceTrim = 0;
+            trim(dir);
+        }
+    }
+
+    void clear()
+    {
+        QString dir;
+        {
+            std::scoped_lock lock(dirMutex);
+            std::swap(dir, cacheDir);
+        }
+
+        if (!dir.isEmpty())
+            Async::runAsync([dir = std::move(dir)]() { QDir(dir).removeRecursively(); });
+    }
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+namespace Utils
+{
+    // persistent cache of downscaled previews of local image files, kept in the cache folder of the profile;
+    // entries are keyed by the file identity (path, size, modification time) and the requested size
+    namespace ThumbnailCache
+    {
+        // the folder is set when the profile is loaded, the cache is off until then
+        void setDir(const QString& _dir);
+
+        // small files decode faster than an entry is looked up, they are neither looked up nor stored
+        bool isWorthProbing(const QFileInfo& _file, const QSize& _maxSize);
+
+        bool isWorthCaching(const QSize& _maxSize, const QSize& _originalSize);
+
+        bool load(const QFileInfo& _file, const QSize& _maxSize, Out QImage& _image, Out QSize& _originalSize);
+
+        void store(const QFileInfo& _file, const QSize& _maxSize, const QImage& _image, const QSize& _originalSize);
+
+        // removes the entries of the profile and turns the cache off, called on logout
+        void clear();
+    }
+}
@@ -15,6 +15,18 @@
 
 namespace Utils
 {
+    /// Implementations of the blur passes, the best one the cpu supports is picked at runtime
+    enum class StackBlurKernel
+    {
+        Scalar,
+        Sse2,
+        Avx2
+    };
+
+    bool isStackBlurKernelSupported(StackBlurKernel _kernel) noexcept;
+
+    StackBlurKernel bestStackBlurKernel() noexcept;
+
     /// Stackblur algorithm body
     void stackblurJob(unsigned char* src,   ///< input image data
         const unsigned int w,               ///< image width
@@ -23,7 +35,8 @@ namespace Utils
         const int cores,                    ///< total number of working threads
         const int core,                     ///< current thread number
         const int step,                     ///< step of processing (1,2)
-        unsigned char* stack                ///< stack buffer
+        unsigned char* stack,               ///< stack buffer
+        const StackBlurKernel kernel        ///< implementation of the passes
     );
 
     /// Stackblur algorithm by Mario Klingemann
@@ -41,6 +54,15 @@ namespace Utils
         const int coreCount = -1        ///< core count, -1 = auto multithreading
     );
 
+    /// Stackblur with the given implementation, which has to be supported, for the tests and benchmarks
+    void stackblur(unsigned char* src,  ///< input image data
+        const unsigned int w,           ///< image width
+        const unsigned int h,           ///< image height
+        const unsigned int radius,      ///< blur intensity (should be in 2..254 range)
+        const int coreCount,            ///< core count, -1 = auto multithreading
+        const StackBlurKernel kernel    ///< implementation of the passes
+    );
+
     class StackBlurTask : public QRunnable
     {
     public:
@@ -52,8 +74,10 @@ namespace Utils
         int core_;
         int step_;
         unsigned char* stack_;
+        StackBlurKernel kernel_;
+        QSemaphore* done_ = nullptr;
 
-        StackBlurTask(unsigned char* _src, unsigned int _w, unsigned int _h, unsigned int _radius, int _cores, int _core, int _step, unsigned char* _stack)
+        StackBlurTask(unsigned char* _src, unsigned int _w, unsigned int _h, unsigned int _radius, int _cores, int _core, int _step, unsigned char* _stack, StackBlurKernel _kernel)
             : src_(_src)
             , w_(_w)
             , h_(_h)
@@ -62,12 +86,15 @@ namespace Utils
             , core_(_core)
             , step_(_step)
             , stack_(_stack)
+            , kernel_(_kernel)
         {
         }
 
         void run() override
         {
-            stackblurJob(src_, w_, h_, radius_, cores_, core_, step_, stack_);
+            stackblurJob(src_, w_, h_, radius_, cores_, core_, step_, stack_, kernel_);
+            if (done_)
+                done_->release();
         }
     };
 
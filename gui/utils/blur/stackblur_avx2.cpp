@@ -0,0 +1,98 @@
+#include "stdafx.h"
+#include "stackblur_p.h"
+
+// Built with avx2 code generation (see set_avx2_sources), called only once stackblur.cpp saw avx2 in the cpu.
+// Nothing from the other headers is used here, an inline function built for avx2 must not reach the linker.
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+
+namespace
+{
+    // two pixels, _offset_ bytes apart, in the low and the high half of a register; they belong to two
+    // neighbouring lines, so blurLine with this kernel blurs both lines at once
+    struct Avx2Kernel
+    {
+        using Channels = __m256i;
+
+        static constexpr unsigned int entrySize = 8;
+
+        size_t offset_;
+
+        static Channels zero() noexcept { return _mm256_setzero_si256(); }
+
+        static Channels load(const unsigned char* _entry) noexcept
+        {
+            return _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(_entry)));
+        }
+
+        // the pixels are returned from the register, a load of the entry just stored would wait for the store
+        Channels push(unsigned char* _entry, const unsigned char* _p) const noexcept
+        {
+            int first;
+            int second;
+            std::memcpy(&first, _p, sizeof(first));
+            std::memcpy(&second, _p + offset_, sizeof(second));
+            const auto pixels = _mm_unpacklo_epi32(_mm_cvtsi32_si128(first), _mm_cvtsi32_si128(second));
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(_entry), pixels);
+            return _mm256_cvtepu8_epi32(pixels);
+        }
+
+        static Channels add(Channels _a, Channels _b) noexcept { return _mm256_add_epi32(_a, _b); }
+
+        static Channels sub(Channels _a, Channels _b) noexcept { return _mm256_sub_epi32(_a, _b); }
+
+        // _k <= 255, so a 16 bit multiply-add of the low halves is exact
+        static Channels mulSmall(Channels _pixel, unsigned int _k) noexcept { return _mm256_madd_epi16(_pixel, _mm256_set1_epi32(int(_k))); }
+
+        void store(unsigned char* _p, Channels _sum, unsigned int _mul, unsigned int _shr) const noexcept
+        {
+            const auto mul = _mm256_set1_epi32(int(_mul));
+            const auto shr = _mm_cvtsi32_si128(int(_shr));
+            const auto low = _mm256_set1_epi64x(0xff);
+            const auto even = _mm256_and_si256(_mm256_srl_epi64(_mm256_mul_epu32(_sum, mul), shr), low);
+            const auto odd = _mm256_and_si256(_mm256_srl_epi64(_mm256_mul_epu32(_mm256_srli_epi64(_sum, 32), mul), shr), low);
+            auto res = _mm256_or_si256(even, _mm256_slli_epi64(odd, 32));
+            res = _mm256_packus_epi16(_mm256_packus_epi32(res, res), res);
+
+            const int first = _mm_cvtsi128_si32(_mm256_castsi256_si128(res));
+            const int second = _mm_cvtsi128_si32(_mm256_extracti128_si256(res, 1));
+            std::memcpy(_p, &first, sizeof(first));
+            std::memcpy(_p + offset_, &second, sizeof(second));
+        }
+    };
+}
+
+namespace Utils
+{
+    bool isStackblurAvx2Built() noexcept
+    {
+        return true;
+    }
+
+    void stackblurLinesAvx2(unsigned char* _first, const unsigned int _lines, const size_t _lineOffset, const unsigned int _count, const unsigned int _stride, const unsigned int _radius, unsigned char* _stack)
+    {
+        const Avx2Kernel kernel = { _lineOffset };
+
+        unsigned int i = 0;
+        for (; i + 1 < _lines; i += 2)
+            blurLine(kernel, _first + _lineOffset * i, _count, _stride, _radius, _stack);
+
+        if (i < _lines)
+            blurLine(Sse2Kernel(), _first + _lineOffset * i, _count, _stride, _radius, _stack);
+    }
+}
+#else
+namespace Utils
+{
+    bool isStackblurAvx2Built() noexcept
+    {
+        return false;
+    }
+
+    void stackblurLinesAvx2(unsigned char*, const unsigned int, const size_t, const unsigned int, const unsigned int, const unsigned int, unsigned char*)
+    {
+        im_assert(!"stackblur: built without avx2");
+    }
+}
+#endif
@@ -0,0 +1,239 @@
+#pragma once
+
+// The parts of the stack blur shared by the kernels of every instruction set. stackblur_avx2.cpp includes this
+// file too and is built for avx2, so everything here stays in an anonymous namespace: no inline function
+// built for avx2 can be linked into the code that runs on a cpu without it.
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define STACKBLUR_USE_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace
+{
+    constexpr unsigned short const stackblur_mul[] =
+    {
+            512,512,456,512,328,456,335,512,405,328,271,456,388,335,292,512,
+            454,405,364,328,298,271,496,456,420,388,360,335,312,292,273,512,
+            482,454,428,405,383,364,345,328,312,298,284,271,259,496,475,456,
+            437,420,404,388,374,360,347,335,323,312,302,292,282,273,265,512,
+            497,482,468,454,441,428,417,405,394,383,373,364,354,345,337,328,
+            320,312,305,298,291,284,278,271,265,259,507,496,485,475,465,456,
+            446,437,428,420,412,404,396,388,381,374,367,360,354,347,341,335,
+            329,323,318,312,307,302,297,292,287,282,278,273,269,265,261,512,
+            505,497,489,482,475,468,461,454,447,441,435,428,422,417,411,405,
+            399,394,389,383,378,373,368,364,359,354,350,345,341,337,332,328,
+            324,320,316,312,309,305,301,298,294,291,287,284,281,278,274,271,
+            268,265,262,259,257,507,501,496,491,485,480,475,470,465,460,456,
+            451,446,442,437,433,428,424,420,416,412,408,404,400,396,392,388,
+            385,381,377,374,370,367,363,360,357,354,350,347,344,341,338,335,
+            332,329,326,323,320,318,315,312,310,307,304,302,299,297,294,292,
+            289,287,285,282,280,278,275,273,271,269,267,265,263,261,259
+    };
+
+    constexpr unsigned char const stackblur_shr[] =
+    {
+            9, 11, 12, 13, 13, 14, 14, 15, 15, 15, 15, 16, 16, 16, 16, 17,
+            17, 17, 17, 17, 17, 17, 18, 18, 18, 18, 18, 18, 18, 18, 18, 19,
+            19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 20, 20, 20,
+            20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 21,
+            21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21,
+            21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 22, 22, 22, 22, 22, 22,
+            22, 22, 22, 22, 22, 22, 22, 22, 22, 22, 22, 22, 22, 22, 22, 22,
+            22, 22, 22, 22, 22, 22, 22, 22, 22, 22, 22, 22, 22, 22, 22, 23,
+            23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23,
+            23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23,
+            23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23,
+            23, 23, 23, 23, 23, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24,
+            24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24,
+            24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24,
+            24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24,
+            24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24
+    };
+
+    constexpr auto precomputedArraySize = 255;
+    static_assert(std::size(stackblur_mul) == precomputedArraySize);
+    static_assert(std::size(stackblur_shr) == precomputedArraySize);
+
+    // the four channel sums of a pixel are kept together, in one sse2 register where available;
+    // sums never exceed 255 * 255 * 255, the scaling product is computed in 64 bits
+    struct ScalarKernel
+    {
+        struct Channels
+        {
+            uint32_t c_[4];
+        };
+
+        // bytes of a stack entry
+        static constexpr unsigned int entrySize = 4;
+
+        static Channels zero() noexcept { return { { 0, 0, 0, 0 } }; }
+
+        static Channels load(const unsigned char* _entry) noexcept { return { { _entry[0], _entry[1], _entry[2], _entry[3] } }; }
+
+        // copies the pixel at _p to a stack entry and returns it
+        static Channels push(unsigned char* _entry, const unsigned char* _p) noexcept
+        {
+            std::memcpy(_entry, _p, entrySize);
+            return load(_p);
+        }
+
+        static Channels add(Channels _a, Channels _b) noexcept
+        {
+            for (int i = 0; i < 4; ++i)
+                _a.c_[i] += _b.c_[i];
+            return _a;
+        }
+
+        static Channels sub(Channels _a, Channels _b) noexcept
+        {
+            for (int i = 0; i < 4; ++i)
+                _a.c_[i] -= _b.c_[i];
+            return _a;
+        }
+
+        static Channels mulSmall(Channels _pixel, unsigned int _k) noexcept
+        {
+            for (int i = 0; i < 4; ++i)
+                _pixel.c_[i] *= _k;
+            return _pixel;
+        }
+
+        static void store(unsigned char* _p, Channels _sum, unsigned int _mul, unsigned int _shr) noexcept
+        {
+            for (int i = 0; i < 4; ++i)
+                _p[i] = static_cast<unsigned char>((uint64_t(_sum.c_[i]) * _mul) >> _shr);
+        }
+    };
+
+#ifdef STACKBLUR_USE_SSE2
+    struct Sse2Kernel
+    {
+        using Channels = __m128i;
+
+        static constexpr unsigned int entrySize = 4;
+
+        static Channels zero() noexcept { return _mm_setzero_si128(); }
+
+        static Channels load(const unsigned char* _entry) noexcept
+        {
+            int v;
+            std::memcpy(&v, _entry, sizeof(v));
+            const auto zero = _mm_setzero_si128();
+            return _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(v), zero), zero);
+        }
+
+        static Channels push(unsigned char* _entry, const unsigned char* _p) noexcept
+        {
+            std::memcpy(_entry, _p, entrySize);
+            return load(_p);
+        }
+
+        static Channels add(Channels _a, Channels _b) noexcept { return _mm_add_epi32(_a, _b); }
+
+        static Channels sub(Channels _a, Channels _b) noexcept { return _mm_sub_epi32(_a, _b); }
+
+        // _k <= 255, so a 16 bit multiply-add of the low halves is exact
+        static Channels mulSmall(Channels _pixel, unsigned int _k) noexcept { return _mm_madd_epi16(_pixel, _mm_set1_epi32(int(_k))); }
+
+        static void store(unsigned char* _p, Channels _sum, unsigned int _mul, unsigned int _shr) noexcept
+        {
+            const auto mul = _mm_set1_epi32(int(_mul));
+            const auto shr = _mm_cvtsi32_si128(int(_shr));
+            const auto even = _mm_srl_epi64(_mm_mul_epu32(_sum, mul), shr);
+            const auto odd = _mm_srl_epi64(_mm_mul_epu32(_mm_srli_epi64(_sum, 32), mul), shr);
+            auto res = _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(3, 1, 2, 0)), _mm_shuffle_epi32(odd, _MM_SHUFFLE(3, 1, 2, 0)));
+            res = _mm_and_si128(res, _mm_set1_epi32(0xff));
+            res = _mm_packus_epi16(_mm_packs_epi32(res, res), res);
+            const int v = _mm_cvtsi128_si32(res);
+            std::memcpy(_p, &v, sizeof(v));
+        }
+    };
+#endif
+
+    /// blurs _count pixels starting at _line and spaced by _stride bytes, in place;
+    /// a kernel may blur more lines at once, it finds the others from _line itself
+    template <typename Kernel>
+    void blurLine(const Kernel& _kernel, unsigned char* _line, const unsigned int _count, const unsigned int _stride, const unsigned int _radius, unsigned char* _stack)
+    {
+        constexpr auto entrySize = Kernel::entrySize;
+        const unsigned int last = _count - 1;
+        const unsigned int div = (_radius * 2) + 1;
+        const unsigned int mulSum = stackblur_mul[_radius];
+        const unsigned int shrSum = stackblur_shr[_radius];
+
+        auto sum = _kernel.zero();
+        auto sumIn = _kernel.zero();
+        auto sumOut = _kernel.zero();
+
+        const unsigned char* src = _line;
+        for (unsigned int i = 0; i <= _radius; ++i)
+        {
+            const auto pixel = _kernel.push(_stack + entrySize * i, src);
+            sum = _kernel.add(sum, _kernel.mulSmall(pixel, i + 1));
+            sumOut = _kernel.add(sumOut, pixel);
+        }
+
+        for (unsigned int i = 1; i <= _radius; ++i)
+        {
+            if (i <= last)
+                src += _stride;
+            const auto pixel = _kernel.push(_stack + entrySize * (i + _radius), src);
+            sum = _kernel.add(sum, _kernel.mulSmall(pixel, _radius + 1 - i));
+            sumIn = _kernel.add(sumIn, pixel);
+        }
+
+        unsigned int sp = _radius;
+        unsigned int xp = _radius < last ? _radius : last;
+        src = _line + size_t(xp) * _stride;
+        unsigned char* dst = _line;
+        for (unsigned int x = 0; x < _count; ++x)
+        {
+            _kernel.store(dst, sum, mulSum, shrSum);
+            dst += _stride;
+
+            sum = _kernel.sub(sum, sumOut);
+
+            unsigned int stackStart = sp + div - _radius;
+            if (stackStart >= div)
+                stackStart -= div;
+            unsigned char* stackPtr = _stack + entrySize * stackStart;
+
+            sumOut = _kernel.sub(sumOut, _kernel.load(stackPtr));
+
+            if (xp < last)
+            {
+                src += _stride;
+                ++xp;
+            }
+
+            sumIn = _kernel.add(sumIn, _kernel.push(stackPtr, src));
+            sum = _kernel.add(sum, sumIn);
+
+            ++sp;
+            if (sp >= div)
+                sp = 0;
+
+            const auto out = _kernel.load(_stack + entrySize * sp);
+            sumOut = _kernel.add(sumOut, out);
+            sumIn = _kernel.sub(sumIn, out);
+        }
+    }
+
+    /// blurs _lines lines, _lineOffset bytes apart, with blurLine
+    template <typename Kernel>
+    void blurLines(unsigned char* _first, const unsigned int _lines, const size_t _lineOffset, const unsigned int _count, const unsigned int _stride, const unsigned int _radius, unsigned char* _stack)
+    {
+        for (unsigned int i = 0; i < _lines; ++i)
+            blurLine(Kernel(), _first + _lineOffset * i, _count, _stride, _radius, _stack);
+    }
+}
+
+namespace Utils
+{
+    /// stackblur_avx2.cpp: false if it was built without avx2
+    bool isStackblurAvx2Built() noexcept;
+
+    /// stackblur_avx2.cpp: blurLines with the lines taken in pairs, the stack has to hold 8 bytes per entry
+    void stackblurLinesAvx2(unsigned char* _first, const unsigned int _lines, const size_t _lineOffset, const unsigned int _count, const unsigned int _stride, const unsigned int _radius, unsigned char* _stack);
+}
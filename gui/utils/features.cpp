@@ -16,7 +16,7 @@
 namespace
 {
 
-    bool myteamConfigOrOmicronFeatureEnabled(config::features _feature, const char* _omicron_key)
+    bool myteamConfigOrOmicronFeatureEnabled(config::features _feature, const omicronlib::omicron_key& _omicron_key)
     {
         const auto config_value = config::get().is_on(_feature);
         const auto omicron_value = Omicron::_o(_omicron_key, config_value);
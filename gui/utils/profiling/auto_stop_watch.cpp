@@ -12,16 +12,32 @@ namespace
 #else
     std::atomic<qint64> process_uid_ = { std::numeric_limits<int32_t>::max() };
 #endif
+
+    std::atomic<bool> is_trace_enabled_ = false;
 }
 
 namespace Profiling
 {
 
+    void set_trace_enabled(const bool _enabled)
+    {
+        is_trace_enabled_ = _enabled;
+    }
+
+    bool is_trace_enabled() noexcept
+    {
+        return is_trace_enabled_.load(std::memory_order_relaxed);
+    }
+
     auto_stop_watch::auto_stop_watch(const char *_process_name)
+        : id_(-1)
     {
         im_assert(_process_name);
         im_assert(::strlen(_process_name));
 
+        if (!build::is_debug() && !is_trace_enabled())
+            return;
+
         id_ = ++process_uid_;
         im_assert(id_ > 0);
 
@@ -37,6 +53,9 @@ namespace Profiling
 
     auto_stop_watch::~auto_stop_watch()
     {
+        if (id_ < 0)
+            return;
+
         Ui::gui_coll_helper collection(Ui::GetDispatcher()->create_collection(), true);
         collection.set_value_as_string("name", name_);
         collection.set_value_as_int64("id", id_);
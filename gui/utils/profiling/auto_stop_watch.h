@@ -3,6 +3,12 @@
 namespace Profiling
 {
 
+    // the core records the spans into its trace when dev.trace_events is on,
+    // and into the profiler stats in debug builds; otherwise nothing is sent
+    void set_trace_enabled(const bool _enabled);
+
+    bool is_trace_enabled() noexcept;
+
     class auto_stop_watch
     {
     public:
@@ -13,6 +13,7 @@
 #include "profiling/auto_stop_watch.h"
 #include "translit.h"
 #include "PhoneFormatter.h"
+#include "ThumbnailCache.h"
 #include "../gui_settings.h"
 #include "../core_dispatcher.h"
 #include "../cache/countries.h"
@@ -2513,29 +2514,32 @@ namespace Utils
         if (!file.open(QIODevice::ReadOnly))
             return false;
 
-        return loadPixmap(file.readAll(), _pixmap, Utils::Exif::getExifOrientation(_path));
+        return loadPixmap(file.readAll(), _pixmap);
     }
 
-    bool loadPixmap(const QByteArray& _data, Out QPixmap& _pixmap, Exif::ExifOrientation _orientation)
+    static bool renderSvg(const QByteArray& _data, Out QPixmap& _pixmap)
     {
-        im_assert(!_data.isEmpty());
-
-        static QMimeDatabase db;
-        if (db.mimeTypeForData(_data).preferredSuffix() == u"svg")
-        {
-            QSvgRenderer renderer;
-            if (!renderer.load(_data))
-                return false;
+        QSvgRenderer renderer;
+        if (!renderer.load(_data))
+            return false;
 
-            _pixmap = QPixmap(renderer.defaultSize());
-            _pixmap.fill(Qt::white);
+        _pixmap = QPixmap(renderer.defaultSize());
+        _pixmap.fill(Qt::white);
 
-            QPainter p(&_pixmap);
-            renderer.render(&p);
-            return !_pixmap.isNull();
-        }
+        QPainter p(&_pixmap);
+        renderer.render(&p);
+        return !_pixmap.isNull();
+    }
 
+    enum class AutoTransform
+    {
+        No,
+        Yes
+    };
 
+    // what loading did before the format was sniffed: any plugin that takes the data, then the forced formats
+    static bool decodePixmapUnhinted(const QByteArray& _data, Out QPixmap& _pixmap)
+    {
         constexpr std::array<const char*, 4> availableFormats = { nullptr, "png", "jpg", "webp" };
 
         for (auto fmt : availableFormats)
@@ -2543,15 +2547,60 @@ namespace Utils
             _pixmap.loadFromData(_data, fmt);
 
             if (!_pixmap.isNull())
-            {
-                Exif::applyExifOrientation(_orientation, InOut _pixmap);
                 return true;
-            }
         }
 
         return false;
     }
 
+    // sniffs the format once and decodes with a single reader, the data the sniffing misses is loaded unhinted
+    static bool decodePixmap(const QByteArray& _data, Out QPixmap& _pixmap, AutoTransform _autoTransform)
+    {
+        im_assert(!_data.isEmpty());
+
+        QBuffer buffer;
+        buffer.setData(_data);
+        buffer.open(QIODevice::ReadOnly);
+
+        QImageReader reader(&buffer);
+        reader.setDecideFormatFromContent(true);
+        reader.setAutoTransform(_autoTransform == AutoTransform::Yes);
+
+        const auto format = reader.format();
+        if (format.startsWith("svg"))
+            return renderSvg(_data, _pixmap);
+
+        if (format.isEmpty())
+        {
+            static QMimeDatabase db;
+            if (db.mimeTypeForData(_data).preferredSuffix() == u"svg")
+                return renderSvg(_data, _pixmap);
+
+            return decodePixmapUnhinted(_data, _pixmap);
+        }
+
+        QImage image;
+        if (!reader.read(&image))
+            return decodePixmapUnhinted(_data, _pixmap);
+
+        _pixmap = QPixmap::fromImage(std::move(image));
+        return !_pixmap.isNull();
+    }
+
+    bool loadPixmap(const QByteArray& _data, Out QPixmap& _pixmap)
+    {
+        return decodePixmap(_data, _pixmap, AutoTransform::Yes);
+    }
+
+    bool loadPixmap(const QByteArray& _data, Out QPixmap& _pixmap, Exif::ExifOrientation _orientation)
+    {
+        if (!decodePixmap(_data, _pixmap, AutoTransform::No))
+            return false;
+
+        Exif::applyExifOrientation(_orientation, InOut _pixmap);
+        return true;
+    }
+
     bool loadPixmapScaled(const QString& _path, const QSize& _maxSize,  Out QPixmap& _pixmap, Out QSize& _originalSize, const PanoramicCheck _checkPanoramic)
     {
         QImage image;
@@ -2632,6 +2681,22 @@ namespace Utils
         return true;
     }
 
+    bool loadImageScaledCached(const QString& _path, const QSize& _maxSize, Out QImage& _image, Out QSize& _originalSize)
+    {
+        const QFileInfo file(_path);
+        const auto useCache = ThumbnailCache::isWorthProbing(file, _maxSize);
+        if (useCache && ThumbnailCache::load(file, _maxSize, Out _image, Out _originalSize))
+            return true;
+
+        if (!loadImageScaled(_path, _maxSize, Out _image, Out _originalSize, PanoramicCheck::no))
+            return false;
+
+        if (useCache && ThumbnailCache::isWorthCaching(_maxSize, _originalSize))
+            ThumbnailCache::store(file, _maxSize, _image, _originalSize);
+
+        return true;
+    }
+
     bool loadPixmapScaled(QByteArray& _data, const QSize& _maxSize, Out QPixmap& _pixmap, Out QSize& _originalSize)
     {
         QImage image;
@@ -2660,6 +2725,7 @@ namespace Utils
 
         QImageReader reader;
         reader.setDecideFormatFromContent(true);
+        reader.setAutoTransform(true);
         reader.setDevice(&buffer);
 
         if (!reader.canRead())
@@ -2669,6 +2735,10 @@ namespace Utils
 
         _originalSize = imageSize;
 
+        if (const auto tr = reader.transformation(); tr == QImageIOHandler::TransformationRotate90 || tr == QImageIOHandler::TransformationRotate270)
+            _originalSize.transpose();
+
+        // jpeg handler decodes at reduced DCT scale when the scaled size is set before read()
         if (_maxSize.isValid() && (_maxSize.width() < imageSize.width() || _maxSize.height() < imageSize.height()))
         {
             imageSize.scale(_maxSize, Qt::KeepAspectRatio);
@@ -429,6 +429,9 @@ namespace Utils
 
     bool loadPixmap(const QString& _path, Out QPixmap& _pixmap);
 
+    // EXIF orientation is read from the same buffer
+    bool loadPixmap(const QByteArray& _data, Out QPixmap& _pixmap);
+
     bool loadPixmap(const QByteArray& _data, Out QPixmap& _pixmap, Exif::ExifOrientation _orientation);
 
     enum class PanoramicCheck
@@ -440,6 +443,9 @@ namespace Utils
 
     bool loadImageScaled(const QString& _path, const QSize& _maxSize, Out QImage& _image, Out QSize& _originalSize, const PanoramicCheck _checkPanoramic = PanoramicCheck::yes);
 
+    // the same for previews of large files, goes through ThumbnailCache
+    bool loadImageScaledCached(const QString& _path, const QSize& _maxSize, Out QImage& _image, Out QSize& _originalSize);
+
     bool loadPixmapScaled(QByteArray& _data, const QSize& _maxSize, Out QPixmap& _pixmap, Out QSize& _originalSize);
 
     bool loadImageScaled(QByteArray& _data, const QSize& _maxSize, Out QImage& _image, Out QSize& _originalSize);
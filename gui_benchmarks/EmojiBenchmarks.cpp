@@ -0,0 +1,205 @@
+#include "stdafx.h"
+
+#include "../core_benchmarks/benchmark.h"
+#include "../gui/cache/emoji/EmojiDb.h"
+#include "../gui/cache/emoji/EmojiIndexDataNew.h"
+
+using namespace core::benchmarks;
+using namespace Emoji;
+
+namespace
+{
+    constexpr int textLength = 100000;
+
+    constexpr bool isKeycapBase(const EmojiCode& _code) noexcept
+    {
+        if (_code.size() != 1)
+            return false;
+        const auto c = _code.codepointAt(0);
+        return (c >= '0' && c <= '9') || c == '#' || c == '*';
+    }
+
+    // the indexes InitEmojiDb built from a copy of the table before the lookups went to the constant tables
+    struct HashIndex
+    {
+        std::vector<EmojiRecord> records_;
+        std::unordered_map<EmojiCode, size_t, EmojiCodeHasher> index_;
+        std::unordered_map<EmojiCode::codePointType, size_t> maxSizes_;
+
+        HashIndex()
+        {
+            records_.reserve(getEmojiCount());
+            for (size_t i = 0; i < getEmojiCount(); ++i)
+                records_.push_back(getEmojiByOrder(i));
+
+            std::unordered_map<EmojiCode, size_t, EmojiCodeHasher> byBase;
+            for (size_t i = 0; i < records_.size(); ++i)
+            {
+                const auto& record = records_[i];
+                if (isKeycapBase(record.baseCodePoints_))
+                    continue;
+                index_.emplace(record.fullCodePoints, i);
+                byBase.emplace(record.baseCodePoints_, i);
+            }
+            index_.insert(byBase.begin(), byBase.end());
+
+            for (const auto& item : index_)
+            {
+                auto& maxSize = maxSizes_[item.first.codepointAt(0)];
+                maxSize = std::max(maxSize, item.first.size());
+            }
+        }
+
+        size_t maxSize(EmojiCode::codePointType _codePoint) const
+        {
+            const auto iter = maxSizes_.find(_codePoint);
+            return iter == maxSizes_.end() ? 0 : iter->second;
+        }
+
+        const EmojiRecord* find(const EmojiCode& _code) const
+        {
+            const auto iter = index_.find(_code);
+            return iter == index_.end() ? nullptr : &records_[iter->second];
+        }
+    };
+
+    struct StaticIndex
+    {
+        size_t maxSize(EmojiCode::codePointType _codePoint) const { return getMaxEmojiSize(_codePoint); }
+        const EmojiRecord* find(const EmojiCode& _code) const { return findEmoji(_code); }
+    };
+
+    // every emoji of the table and as many single code points that are not
+    const std::vector<EmojiCode>& lookupKeys()
+    {
+        static const auto result = []()
+        {
+            std::vector<EmojiCode> keys;
+            for (size_t i = 0; i < getEmojiCount(); ++i)
+            {
+                keys.push_back(getEmojiByOrder(i).fullCodePoints);
+                keys.push_back(EmojiCode(EmojiCode::codePointType(0x400 + i % 0x100)));
+            }
+            std::shuffle(keys.begin(), keys.end(), std::mt19937(42));
+            return keys;
+        }();
+        return result;
+    }
+
+    // a chat text: latin and cyrillic words, an emoji every 50 code points or so
+    const std::vector<EmojiCode::codePointType>& chatText()
+    {
+        static const auto result = []()
+        {
+            std::mt19937 generator(42);
+            std::uniform_int_distribution<int> kind(0, 49);
+            std::uniform_int_distribution<int> letter(0, 25);
+            std::uniform_int_distribution<size_t> emoji(0, getEmojiCount() - 1);
+
+            std::vector<EmojiCode::codePointType> text;
+            text.reserve(textLength);
+            while (text.size() < textLength)
+            {
+                switch (kind(generator))
+                {
+                case 0:
+                {
+                    const auto& code = getEmojiByOrder(emoji(generator)).fullCodePoints;
+                    for (size_t i = 0; i < code.size(); ++i)
+                        text.push_back(code.codepointAt(i));
+                    break;
+                }
+                case 1:
+                case 2:
+                case 3:
+                case 4:
+                case 5:
+                case 6:
+                case 7:
+                    text.push_back(' ');
+                    break;
+                default:
+                    text.push_back(EmojiCode::codePointType(text.size() % 3 ? 'a' + letter(generator) : 0x430 + letter(generator)));
+                }
+            }
+            return text;
+        }();
+        return result;
+    }
+
+    template <typename Index>
+    void lookup(state& _state, const Index& _index)
+    {
+        const auto& keys = lookupKeys();
+
+        size_t found = 0;
+        while (_state.keep_running())
+        {
+            for (const auto& key : keys)
+                found += _index.find(key) != nullptr;
+        }
+
+        do_not_optimize(found);
+        _state.set_items_processed(_state.get_iterations() * int64_t(keys.size()));
+    }
+
+    // what Emoji::getEmoji does for every code point of a message being laid out
+    template <typename Index>
+    void scan(state& _state, const Index& _index)
+    {
+        const auto& text = chatText();
+
+        size_t found = 0;
+        while (_state.keep_running())
+        {
+            for (size_t pos = 0; pos < text.size(); ++pos)
+            {
+                const auto maxSize = std::min(_index.maxSize(text[pos]), text.size() - pos);
+                if (maxSize == 0)
+                    continue;
+
+                EmojiCode current;
+                for (size_t i = 0; i < maxSize; ++i)
+                    current = EmojiCode::addCodePoint(current, text[pos + i]);
+
+                for (auto size = maxSize; size > 0; --size, current = current.chopped(1))
+                {
+                    if (_index.find(current))
+                    {
+                        ++found;
+                        pos += size - 1;
+                        break;
+                    }
+                }
+            }
+        }
+
+        do_not_optimize(found);
+        _state.set_items_processed(_state.get_iterations() * int64_t(text.size()));
+    }
+
+    // what InitEmojiDb paid before the first emoji could be looked up, the constant tables need no startup work
+    void buildHashIndex(state& _state)
+    {
+        while (_state.keep_running())
+        {
+            HashIndex index;
+            do_not_optimize(index.index_.size());
+        }
+        _state.set_items_processed(_state.get_iterations() * int64_t(getEmojiCount()));
+    }
+
+    const HashIndex& hashIndex()
+    {
+        static const HashIndex index;
+        return index;
+    }
+}
+
+CORE_BENCHMARK("gui/emoji/startup/hash_index", [](state& _state) { buildHashIndex(_state); });
+
+CORE_BENCHMARK("gui/emoji/lookup/hash_index", [](state& _state) { lookup(_state, hashIndex()); });
+CORE_BENCHMARK("gui/emoji/lookup/static_index", [](state& _state) { lookup(_state, StaticIndex()); });
+
+CORE_BENCHMARK("gui/emoji/scan/hash_index", [](state& _state) { scan(_state, hashIndex()); });
+CORE_BENCHMARK("gui/emoji/scan/static_index", [](state& _state) { scan(_state, StaticIndex()); });
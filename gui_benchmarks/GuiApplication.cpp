@@ -0,0 +1,44 @@
+#include "stdafx.h"
+
+#include "GuiApplication.h"
+
+#include <QTemporaryDir>
+#include <QtPlugin>
+
+#ifdef IM_QT_STATIC
+
+#ifdef _WIN32
+    Q_IMPORT_PLUGIN(QWindowsIntegrationPlugin)
+#endif //_WIN32
+
+#ifdef __linux__
+    Q_IMPORT_PLUGIN(QXcbIntegrationPlugin)
+#endif //__linux__
+
+#ifdef __APPLE__
+    Q_IMPORT_PLUGIN(QCocoaIntegrationPlugin)
+#endif //__APPLE__
+
+    Q_IMPORT_PLUGIN(QJpegPlugin)
+#endif
+
+namespace Benchmarks
+{
+    QGuiApplication& guiApplication()
+    {
+        static int argc = 1;
+        static char name[] = "gui_benchmarks";
+        static char* argv[] = { name, nullptr };
+
+        // never destroyed, the benchmarks registered in other translation units may outlive it otherwise
+        static auto app = new QGuiApplication(argc, argv);
+        return *app;
+    }
+
+    const QString& tempDir()
+    {
+        static const QTemporaryDir dir(QDir::tempPath() % u"/gui_benchmarks-XXXXXX");
+        static const QString path = dir.path();
+        return path;
+    }
+}
@@ -0,0 +1,10 @@
+#pragma once
+
+namespace Benchmarks
+{
+    // the application the measured gui code expects, created on the first call and kept until exit
+    QGuiApplication& guiApplication();
+
+    // a folder for the sample files, removed with its content on exit
+    const QString& tempDir();
+}
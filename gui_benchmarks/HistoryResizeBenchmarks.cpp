@@ -0,0 +1,132 @@
+#include "stdafx.h"
+
+#include "GuiApplication.h"
+
+#include "../core_benchmarks/benchmark.h"
+#include "../gui/controls/textrendering/TextMeasureCache.h"
+
+using namespace core::benchmarks;
+using namespace Ui::TextRendering;
+
+namespace
+{
+    constexpr int messagesCount = 2000;
+    constexpr int vocabularySize = 3000;
+    constexpr int viewportHeight = 800;
+    // the margin MessagesScrollAreaLayout lays out at once around the viewport, unscaled
+    constexpr int urgentMargin = 400;
+    constexpr int messagePadding = 16;
+    constexpr std::array<int, 2> widths = { 480, 720 };
+
+    // 2k loaded messages of a chat, each a list of words as the text blocks wrap them
+    struct History
+    {
+        QFont font_;
+        std::vector<std::vector<QString>> messages_;
+    };
+
+    const History& history()
+    {
+        static const auto result = []()
+        {
+            Benchmarks::guiApplication();
+
+            static const auto letters = qsl("abcdefghijklmnopqrstuvwxyzабвгдеёжзийклмнопрстуфхцчшщъыьэюя");
+
+            std::mt19937 generator(42);
+            std::uniform_int_distribution<int> length(1, 12);
+            std::uniform_int_distribution<int> letter(0, int(letters.size()) - 1);
+
+            std::vector<QString> vocabulary;
+            vocabulary.reserve(vocabularySize);
+            for (int i = 0; i < vocabularySize; ++i)
+            {
+                QString word;
+                for (auto j = length(generator); j > 0; --j)
+                    word += letters[letter(generator)];
+                vocabulary.push_back(std::move(word));
+            }
+
+            History history;
+            history.font_ = QFont(qsl("Sans Serif"), 15);
+
+            std::geometric_distribution<int> wordIndex(0.01);
+            std::geometric_distribution<int> wordsCount(0.05);
+            history.messages_.resize(messagesCount);
+            for (auto& message : history.messages_)
+            {
+                for (auto j = wordsCount(generator) + 1; j > 0; --j)
+                    message.push_back(vocabulary[std::min(wordIndex(generator), vocabularySize - 1)]);
+            }
+            return history;
+        }();
+        return result;
+    }
+
+    // what a text block does for a new width: wraps the words, breaking those longer than a line
+    int messageHeight(const History& _history, const std::vector<QString>& _message, int _width)
+    {
+        const auto spaceWidth = TextMeasureCache::textWidth(_history.font_, qsl(" "));
+        const auto lineHeight = QFontMetrics(_history.font_).lineSpacing();
+
+        auto lines = 1;
+        auto x = 0.0;
+        for (const auto& word : _message)
+        {
+            const auto wordWidth = TextMeasureCache::textWidth(_history.font_, word);
+            if (x > 0 && x + spaceWidth + wordWidth > _width)
+            {
+                ++lines;
+                x = 0;
+            }
+
+            if (wordWidth > _width)
+            {
+                lines += int(word.size()) / std::max(1, TextMeasureCache::fittingLength(_history.font_, word, _width));
+                continue;
+            }
+
+            x += (x > 0 ? spaceWidth : 0) + wordWidth;
+        }
+        return lines * lineHeight + messagePadding;
+    }
+
+    // a resize of the history scrolled to the bottom; _nearViewportOnly lays out the messages MessagesScrollAreaLayout
+    // handles before the resize is painted, the others go to the deferred slices
+    void resize(state& _state, bool _nearViewportOnly)
+    {
+        const auto& h = history();
+        TextMeasureCache::clear();
+
+        std::vector<int> heights(h.messages_.size());
+        for (size_t i = 0; i < h.messages_.size(); ++i)
+            heights[i] = messageHeight(h, h.messages_[i], widths.front());
+
+        int64_t laidOut = 0;
+        size_t widthIndex = 0;
+        while (_state.keep_running())
+        {
+            widthIndex = (widthIndex + 1) % widths.size();
+            const auto width = widths[widthIndex];
+
+            // the newest message is at the bottom of the viewport
+            auto bottom = 0;
+            for (size_t i = 0; i < h.messages_.size(); ++i)
+            {
+                const auto top = bottom - heights[i];
+                if (_nearViewportOnly && bottom < -(viewportHeight + urgentMargin))
+                    break;
+
+                heights[i] = messageHeight(h, h.messages_[i], width);
+                bottom = top;
+                ++laidOut;
+            }
+        }
+
+        do_not_optimize(heights.data());
+        _state.set_items_processed(laidOut);
+    }
+}
+
+CORE_BENCHMARK("gui/history/resize/2000_messages/all", [](state& _state) { resize(_state, false); });
+CORE_BENCHMARK("gui/history/resize/2000_messages/near_viewport", [](state& _state) { resize(_state, true); });
@@ -0,0 +1,72 @@
+#include "stdafx.h"
+
+#include "../core_benchmarks/benchmark.h"
+#include "../gui/utils/blur/stackblur.h"
+
+using namespace core::benchmarks;
+using namespace Utils;
+
+namespace
+{
+    // a file preview blurred at the radius of the file sharing blocks, the input background and a wallpaper
+    struct Case
+    {
+        const char* name_;
+        unsigned int w_;
+        unsigned int h_;
+        unsigned int radius_;
+    };
+
+    constexpr Case cases[] =
+    {
+        { "preview_320x240_r150", 320, 240, 150 },
+        { "input_bg_1280x720_r75", 1280, 720, 75 },
+        { "wallpaper_1920x1080_r75", 1920, 1080, 75 },
+    };
+
+    struct Kernel
+    {
+        const char* name_;
+        StackBlurKernel kernel_;
+    };
+
+    constexpr Kernel kernels[] =
+    {
+        { "scalar", StackBlurKernel::Scalar },
+        { "sse2", StackBlurKernel::Sse2 },
+        { "avx2", StackBlurKernel::Avx2 },
+    };
+
+    void blur(state& _state, const Case& _case, StackBlurKernel _kernel, int _cores)
+    {
+        std::mt19937 generator(42);
+        std::uniform_int_distribution<int> value(0, 255);
+
+        std::vector<unsigned char> image(size_t(_case.w_) * _case.h_ * 4);
+        for (auto& c : image)
+            c = static_cast<unsigned char>(value(generator));
+
+        // the blur is in place, blurring the result again costs the same
+        while (_state.keep_running())
+            stackblur(image.data(), _case.w_, _case.h_, _case.radius_, _cores, _kernel);
+
+        do_not_optimize(image.data());
+        _state.set_bytes_processed(_state.get_iterations() * int64_t(image.size()));
+    }
+
+    // a kernel the cpu can't run is not registered
+    const bool registered = []()
+    {
+        for (const auto& c : cases)
+        {
+            for (const auto& k : kernels)
+            {
+                if (isStackBlurKernelSupported(k.kernel_))
+                    register_benchmark(std::string("gui/blur/stackblur/") + k.name_ + '/' + c.name_, [&c, &k](state& _state) { blur(_state, c, k.kernel_, 1); });
+            }
+
+            register_benchmark(std::string("gui/blur/stackblur/best_all_cores/") + c.name_, [&c](state& _state) { blur(_state, c, bestStackBlurKernel(), -1); });
+        }
+        return true;
+    }();
+}
@@ -0,0 +1,144 @@
+#include "stdafx.h"
+
+#include "GuiApplication.h"
+
+#include "../core_benchmarks/benchmark.h"
+#include "../gui/controls/textrendering/TextMeasureCache.h"
+
+using namespace core::benchmarks;
+using namespace Ui::TextRendering;
+
+namespace
+{
+    constexpr int messagesCount = 2000;
+    constexpr int vocabularySize = 3000;
+    constexpr int linkEveryNthMessage = 20;
+
+    // a chat as the layouts see it: the words of its messages, with a few common words making up most of the text
+    // as in a real history, and links too long for a line
+    struct Chat
+    {
+        QFont font_;
+        std::vector<QString> words_;
+        std::vector<QString> longWords_;
+    };
+
+    QString randomWord(std::mt19937& _generator, int _minLength, int _maxLength)
+    {
+        static const auto letters = qsl("abcdefghijklmnopqrstuvwxyzабвгдеёжзийклмнопрстуфхцчшщъыьэюя");
+        std::uniform_int_distribution<int> length(_minLength, _maxLength);
+        std::uniform_int_distribution<int> letter(0, int(letters.size()) - 1);
+
+        QString word;
+        for (auto i = length(_generator); i > 0; --i)
+            word += letters[letter(_generator)];
+        return word;
+    }
+
+    const Chat& chat()
+    {
+        static const auto result = []()
+        {
+            Benchmarks::guiApplication();
+
+            std::mt19937 generator(42);
+            std::vector<QString> vocabulary;
+            vocabulary.reserve(vocabularySize);
+            for (int i = 0; i < vocabularySize; ++i)
+                vocabulary.push_back(randomWord(generator, 1, 12));
+
+            Chat chat;
+            chat.font_ = QFont(qsl("Sans Serif"), 15);
+
+            std::geometric_distribution<int> wordIndex(0.01);
+            std::uniform_int_distribution<int> wordsCount(1, 30);
+            for (int i = 0; i < messagesCount; ++i)
+            {
+                for (auto j = wordsCount(generator); j > 0; --j)
+                    chat.words_.push_back(vocabulary[std::min(wordIndex(generator), vocabularySize - 1)]);
+
+                if (i % linkEveryNthMessage == 0)
+                    chat.longWords_.push_back(u"https://example.net/" % randomWord(generator, 40, 160));
+            }
+            return chat;
+        }();
+        return result;
+    }
+
+    // the former path: every word of every layout is measured
+    void measureWordsDirect(state& _state)
+    {
+        const auto& c = chat();
+        const QFontMetricsF metrics(c.font_);
+
+        while (_state.keep_running())
+        {
+            for (const auto& word : c.words_)
+                do_not_optimize(metrics.horizontalAdvance(word));
+        }
+        _state.set_items_processed(_state.get_iterations() * int64_t(c.words_.size()));
+    }
+
+    // the first layout of the chat
+    void measureWordsCold(state& _state)
+    {
+        const auto& c = chat();
+
+        while (_state.keep_running())
+        {
+            _state.pause_timing();
+            TextMeasureCache::clear();
+            _state.resume_timing();
+
+            for (const auto& word : c.words_)
+                do_not_optimize(TextMeasureCache::textWidth(c.font_, word));
+        }
+        _state.set_items_processed(_state.get_iterations() * int64_t(c.words_.size()));
+    }
+
+    // relayouts, e.g. on a resize of the window
+    void measureWordsWarm(state& _state)
+    {
+        const auto& c = chat();
+        TextMeasureCache::clear();
+
+        while (_state.keep_running())
+        {
+            for (const auto& word : c.words_)
+                do_not_optimize(TextMeasureCache::textWidth(c.font_, word));
+        }
+        _state.set_items_processed(_state.get_iterations() * int64_t(c.words_.size()));
+    }
+
+    void breakLongWords(state& _state, int _width, bool _warm)
+    {
+        const auto& c = chat();
+        TextMeasureCache::clear();
+
+        while (_state.keep_running())
+        {
+            if (!_warm)
+            {
+                _state.pause_timing();
+                TextMeasureCache::clear();
+                _state.resume_timing();
+            }
+
+            for (const auto& word : c.longWords_)
+                do_not_optimize(TextMeasureCache::fittingLength(c.font_, word, _width));
+        }
+        _state.set_items_processed(_state.get_iterations() * int64_t(c.longWords_.size()));
+    }
+}
+
+CORE_BENCHMARK("gui/text/measure_words/direct", [](state& _state) { measureWordsDirect(_state); });
+CORE_BENCHMARK("gui/text/measure_words/cold", [](state& _state) { measureWordsCold(_state); });
+CORE_BENCHMARK("gui/text/measure_words/warm", [](state& _state) { measureWordsWarm(_state); });
+
+CORE_BENCHMARK("gui/text/break_long_words/cold/240", [](state& _state) { breakLongWords(_state, 240, false); });
+CORE_BENCHMARK("gui/text/break_long_words/cold/480", [](state& _state) { breakLongWords(_state, 480, false); });
+CORE_BENCHMARK("gui/text/break_long_words/cold/960", [](state& _state) { breakLongWords(_state, 960, false); });
+
+CORE_BENCHMARK("gui/text/break_long_words/warm/240", [](state& _state) { breakLongWords(_state, 240, true); });
+CORE_BENCHMARK("gui/text/break_long_words/warm/480", [](state& _state) { breakLongWords(_state, 480, true); });
+CORE_BENCHMARK("gui/text/break_long_words/warm/960", [](state& _state) { breakLongWords(_state, 960, true); });
@@ -0,0 +1,152 @@
+#include "stdafx.h"
+
+#include "GuiApplication.h"
+
+#include "../core_benchmarks/benchmark.h"
+#include "../gui/utils/ThumbnailCache.h"
+
+#include <QImageReader>
+
+using namespace core::benchmarks;
+
+namespace
+{
+    constexpr QSize previewSize() noexcept { return QSize(300, 300); }
+
+    // a camera photo, a resized one and a small picture; the noise keeps the jpeg from being trivial
+    struct Sample
+    {
+        QString name_;
+        QSize size_;
+    };
+
+    const std::array<Sample, 3>& samples()
+    {
+        static const std::array<Sample, 3> result = {{
+            { qsl("photo_12mp.jpg"), QSize(4032, 3024) },
+            { qsl("photo_2mp.jpg"), QSize(1600, 1200) },
+            { qsl("picture.jpg"), QSize(480, 360) },
+        }};
+        return result;
+    }
+
+    QString makeSample(const Sample& _sample)
+    {
+        const auto path = Benchmarks::tempDir() % u'/' % _sample.name_;
+        if (QFile::exists(path))
+            return path;
+
+        std::mt19937 generator(42);
+        std::uniform_int_distribution<int> noise(-12, 12);
+
+        QImage image(_sample.size_, QImage::Format_RGB32);
+        for (int y = 0; y < image.height(); ++y)
+        {
+            auto line = reinterpret_cast<QRgb*>(image.scanLine(y));
+            for (int x = 0; x < image.width(); ++x)
+            {
+                const auto r = std::clamp(x * 255 / image.width() + noise(generator), 0, 255);
+                const auto g = std::clamp(y * 255 / image.height() + noise(generator), 0, 255);
+                const auto b = std::clamp(128 + noise(generator), 0, 255);
+                line[x] = qRgb(r, g, b);
+            }
+        }
+
+        image.save(path, "jpg", 90);
+        return path;
+    }
+
+    const QString& samplePath(size_t _index)
+    {
+        static const auto paths = []()
+        {
+            Benchmarks::guiApplication();
+
+            std::vector<QString> result;
+            for (const auto& sample : samples())
+                result.push_back(makeSample(sample));
+            return result;
+        }();
+        return paths[_index];
+    }
+
+    // the former path: the whole image is decoded and scaled down afterwards
+    void decodeFull(state& _state, size_t _sample)
+    {
+        const auto& path = samplePath(_sample);
+
+        while (_state.keep_running())
+        {
+            QImageReader reader(path);
+            reader.setAutoTransform(true);
+            auto image = reader.read().scaled(previewSize(), Qt::KeepAspectRatio);
+            do_not_optimize(image);
+        }
+        _state.set_items_processed(_state.get_iterations());
+    }
+
+    // the jpeg handler decodes at a reduced DCT scale once the scaled size is set before read()
+    void decodeScaled(state& _state, size_t _sample)
+    {
+        const auto& path = samplePath(_sample);
+
+        while (_state.keep_running())
+        {
+            QImageReader reader(path);
+            reader.setAutoTransform(true);
+            reader.setScaledSize(reader.size().scaled(previewSize(), Qt::KeepAspectRatio));
+            auto image = reader.read();
+            do_not_optimize(image);
+        }
+        _state.set_items_processed(_state.get_iterations());
+    }
+
+    void cacheHit(state& _state, size_t _sample)
+    {
+        const QFileInfo file(samplePath(_sample));
+        Utils::ThumbnailCache::setDir(Benchmarks::tempDir() % u"/thumbnails");
+
+        QImageReader reader(file.filePath());
+        const auto originalSize = reader.size();
+        reader.setScaledSize(originalSize.scaled(previewSize(), Qt::KeepAspectRatio));
+        Utils::ThumbnailCache::store(file, previewSize(), reader.read(), originalSize);
+
+        while (_state.keep_running())
+        {
+            QImage image;
+            QSize size;
+            Utils::ThumbnailCache::load(file, previewSize(), Out image, Out size);
+            do_not_optimize(image);
+        }
+        _state.set_items_processed(_state.get_iterations());
+    }
+
+    // what every small image paid before the file size was checked first
+    void cacheMiss(state& _state, size_t _sample)
+    {
+        const QFileInfo file(samplePath(_sample));
+        Utils::ThumbnailCache::setDir(Benchmarks::tempDir() % u"/thumbnails");
+
+        while (_state.keep_running())
+        {
+            QImage image;
+            QSize size;
+            const auto loaded = Utils::ThumbnailCache::load(file, QSize(1, 1), Out image, Out size);
+            do_not_optimize(loaded);
+        }
+        _state.set_items_processed(_state.get_iterations());
+    }
+}
+
+CORE_BENCHMARK("gui/thumbnails/decode_full/photo_12mp", [](state& _state) { decodeFull(_state, 0); });
+CORE_BENCHMARK("gui/thumbnails/decode_full/photo_2mp", [](state& _state) { decodeFull(_state, 1); });
+CORE_BENCHMARK("gui/thumbnails/decode_full/picture", [](state& _state) { decodeFull(_state, 2); });
+
+CORE_BENCHMARK("gui/thumbnails/decode_scaled/photo_12mp", [](state& _state) { decodeScaled(_state, 0); });
+CORE_BENCHMARK("gui/thumbnails/decode_scaled/photo_2mp", [](state& _state) { decodeScaled(_state, 1); });
+CORE_BENCHMARK("gui/thumbnails/decode_scaled/picture", [](state& _state) { decodeScaled(_state, 2); });
+
+CORE_BENCHMARK("gui/thumbnails/cache_hit/photo_12mp", [](state& _state) { cacheHit(_state, 0); });
+CORE_BENCHMARK("gui/thumbnails/cache_hit/photo_2mp", [](state& _state) { cacheHit(_state, 1); });
+
+CORE_BENCHMARK("gui/thumbnails/cache_miss/picture", [](state& _state) { cacheMiss(_state, 2); });
@@ -0,0 +1,200 @@
+#include "stdafx.h"
+
+#include <iostream>
+
+#include "../gui/main_window/mplayer/LottieFrameCache.h"
+
+using namespace Ui;
+
+namespace
+{
+    int failures = 0;
+
+    void check(bool _condition, const std::string& _what)
+    {
+        if (!_condition)
+        {
+            std::cout << "FAILED: " << _what << '\n';
+            ++failures;
+        }
+    }
+
+    // the cache only compares the animation pointers, any distinct addresses do
+    const int animations[4] = {};
+
+    const LottieWrapper* animation(int _i)
+    {
+        return reinterpret_cast<const LottieWrapper*>(&animations[_i]);
+    }
+
+    QImage frame(int _w, int _h, const std::vector<uint32_t>& _pixels)
+    {
+        QImage image(_w, _h, QImage::Format_ARGB32_Premultiplied);
+        std::copy(_pixels.begin(), _pixels.end(), reinterpret_cast<uint32_t*>(image.bits()));
+        return image;
+    }
+
+    std::vector<uint32_t> noise(size_t _count, unsigned int _seed)
+    {
+        std::mt19937 generator(_seed);
+        std::vector<uint32_t> pixels(_count);
+        for (auto& p : pixels)
+            p = generator();
+        return pixels;
+    }
+
+    // puts the pixels as a frame and reads them back
+    bool roundTrip(int _w, int _h, const std::vector<uint32_t>& _pixels)
+    {
+        auto& cache = LottieFrameCache::instance();
+        cache.put(animation(0), 0, frame(_w, _h, _pixels));
+
+        std::vector<uint32_t> decoded(_pixels.size() + 1, 0xdeadbeef);
+        const auto found = cache.get(animation(0), 0, QSize(_w, _h), decoded.data(), size_t(_w) * sizeof(uint32_t));
+        cache.remove(animation(0));
+
+        // the pixel past the frame is a guard, decoding must not write it
+        return found && std::equal(_pixels.begin(), _pixels.end(), decoded.begin()) && decoded.back() == 0xdeadbeef;
+    }
+
+    void test_runs()
+    {
+        check(roundTrip(64, 64, std::vector<uint32_t>(64 * 64, 0xff102030)), "one run");
+        check(roundTrip(64, 64, std::vector<uint32_t>(64 * 64, 0)), "one transparent run");
+
+        std::vector<uint32_t> stripes(48 * 32);
+        for (size_t i = 0; i < stripes.size(); ++i)
+            stripes[i] = (i / 48) % 2 ? 0xffffffff : 0xff000000;
+        check(roundTrip(48, 32, stripes), "a run per line");
+    }
+
+    void test_literals()
+    {
+        check(roundTrip(64, 64, noise(64 * 64, 1)), "noise");
+
+        // runs of two pixels are shorter than a run chunk, they stay in the literal spans
+        std::vector<uint32_t> pairs(30 * 10);
+        for (size_t i = 0; i < pairs.size(); ++i)
+            pairs[i] = uint32_t(i / 2);
+        check(roundTrip(30, 10, pairs), "pairs");
+    }
+
+    void test_runs_between_literals()
+    {
+        // runs of exactly the minimal length, at the start, in the middle and at the end of the frame
+        std::vector<uint32_t> pixels;
+        const auto add = [&pixels](uint32_t _pixel, size_t _count) { pixels.insert(pixels.end(), _count, _pixel); };
+        add(7, 3);
+        add(1, 1);
+        add(2, 1);
+        add(8, 4);
+        add(3, 1);
+        add(9, 2);
+        add(4, 1);
+        add(10, 3);
+        check(roundTrip(int(pixels.size()), 1, pixels), "runs and literals");
+
+        auto mixed = noise(37 * 23, 2);
+        std::fill(mixed.begin() + 100, mixed.begin() + 400, 0x80808080);
+        std::fill(mixed.end() - 5, mixed.end(), 0);
+        check(roundTrip(37, 23, mixed), "noise with runs");
+    }
+
+    void test_single_pixels()
+    {
+        check(roundTrip(1, 1, { 0xff00ff00 }), "1x1");
+        check(roundTrip(1, 2, { 5, 5 }), "1x2 run below the minimum");
+        check(roundTrip(3, 1, { 5, 5, 5 }), "3x1 minimal run");
+    }
+
+    void test_odd_sizes()
+    {
+        for (const auto& [w, h] : { std::pair(1, 13), std::pair(13, 1), std::pair(7, 3), std::pair(17, 19), std::pair(101, 33) })
+        {
+            const auto name = std::to_string(w) + 'x' + std::to_string(h);
+
+            auto pixels = noise(size_t(w) * h, unsigned(w * 31 + h));
+            for (size_t i = 0; i < pixels.size(); ++i)
+            {
+                if ((i / 5) % 3 == 0)
+                    pixels[i] = 0xffabcdef;
+            }
+            check(roundTrip(w, h, pixels), name);
+            check(roundTrip(w, h, std::vector<uint32_t>(size_t(w) * h, 0x11223344)), name + " plain");
+        }
+    }
+
+    void test_mismatches()
+    {
+        auto& cache = LottieFrameCache::instance();
+        cache.put(animation(1), 3, frame(8, 8, noise(64, 3)));
+
+        std::vector<uint32_t> decoded(64 * 4);
+        check(!cache.get(animation(1), 4, QSize(8, 8), decoded.data(), 8 * sizeof(uint32_t)), "another frame");
+        check(!cache.get(animation(2), 3, QSize(8, 8), decoded.data(), 8 * sizeof(uint32_t)), "another animation");
+        check(!cache.get(animation(1), 3, QSize(16, 4), decoded.data(), 16 * sizeof(uint32_t)), "another size");
+        check(!cache.get(animation(1), 3, QSize(8, 8), decoded.data(), 16 * sizeof(uint32_t)), "padded lines");
+        check(cache.get(animation(1), 3, QSize(8, 8), decoded.data(), 8 * sizeof(uint32_t)), "the frame");
+
+        // a frame in another format is not cached
+        QImage rgb(8, 8, QImage::Format_RGB32);
+        cache.put(animation(1), 5, rgb);
+        check(!cache.get(animation(1), 5, QSize(8, 8), decoded.data(), 8 * sizeof(uint32_t)), "rgb32 frame");
+
+        cache.remove(animation(1));
+        check(!cache.get(animation(1), 3, QSize(8, 8), decoded.data(), 8 * sizeof(uint32_t)), "removed");
+        check(cache.frameCount() == 0 && cache.memoryUsage() == 0, "nothing left after remove");
+    }
+
+    void test_budget_eviction()
+    {
+        auto& cache = LottieFrameCache::instance();
+
+        // noise doesn't compress, a frame costs a bit more than its pixels
+        constexpr int w = 1024;
+        constexpr int h = 512;
+        constexpr int64_t frameBytes = int64_t(w) * h * sizeof(uint32_t);
+        const int frames = int(LottieFrameCache::memoryBudget() / frameBytes) + 4;
+
+        std::vector<std::vector<uint32_t>> pixels;
+        for (int i = 0; i < frames; ++i)
+            pixels.push_back(noise(size_t(w) * h, unsigned(100 + i)));
+
+        std::vector<uint32_t> decoded(size_t(w) * h);
+        const auto get = [&cache, &decoded](int _frameNo) { return cache.get(animation(3), _frameNo, QSize(w, h), decoded.data(), w * sizeof(uint32_t)); };
+
+        for (int i = 0; i < frames; ++i)
+        {
+            cache.put(animation(3), i, frame(w, h, pixels[i]));
+            check(cache.memoryUsage() <= LottieFrameCache::memoryBudget(), "budget kept after frame " + std::to_string(i));
+
+            // the first frame is used all along, the least recently used ones go instead of it
+            if (i > 0)
+                check(get(0), "used frame kept after frame " + std::to_string(i));
+        }
+
+        check(!get(1), "the least recently used frame is evicted");
+        check(get(frames - 1) && decoded == pixels[frames - 1], "the last frame is intact");
+        check(get(0) && decoded == pixels[0], "the used frame is intact");
+        check(cache.frameCount() < frames, "some frames evicted");
+
+        cache.remove(animation(3));
+        check(cache.frameCount() == 0 && cache.memoryUsage() == 0, "nothing left after remove");
+    }
+}
+
+int main()
+{
+    test_runs();
+    test_literals();
+    test_runs_between_literals();
+    test_single_pixels();
+    test_odd_sizes();
+    test_mismatches();
+    test_budget_eviction();
+
+    if (failures == 0)
+        std::cout << "all lottie frame cache tests passed\n";
+
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,201 @@
+#include "stdafx.h"
+
+#include <iostream>
+
+#include "../gui/utils/blur/stackblur.h"
+
+using namespace Utils;
+
+namespace
+{
+    int failures = 0;
+
+    void check(bool _condition, const std::string& _what)
+    {
+        if (!_condition)
+        {
+            std::cout << "FAILED: " << _what << '\n';
+            ++failures;
+        }
+    }
+
+    std::string kernelName(StackBlurKernel _kernel)
+    {
+        switch (_kernel)
+        {
+        case StackBlurKernel::Scalar:
+            return "scalar";
+        case StackBlurKernel::Sse2:
+            return "sse2";
+        case StackBlurKernel::Avx2:
+            return "avx2";
+        }
+        return "unknown";
+    }
+
+    std::string caseName(StackBlurKernel _kernel, unsigned int _w, unsigned int _h, unsigned int _radius)
+    {
+        return kernelName(_kernel) + ' ' + std::to_string(_w) + 'x' + std::to_string(_h) + " radius " + std::to_string(_radius);
+    }
+
+    std::vector<unsigned char> noise(unsigned int _w, unsigned int _h, unsigned int _seed)
+    {
+        std::mt19937 generator(_seed);
+        std::uniform_int_distribution<int> value(0, 255);
+
+        std::vector<unsigned char> image(size_t(_w) * _h * 4);
+        for (auto& c : image)
+            c = static_cast<unsigned char>(value(generator));
+        return image;
+    }
+
+    // a pass of the stack blur by its definition: every pixel is the mean of its neighbours up to the radius,
+    // weighted by radius + 1 - distance, with the edge pixels repeated
+    std::vector<unsigned char> referencePass(const std::vector<unsigned char>& _image, unsigned int _w, unsigned int _h, unsigned int _radius, bool _horizontal)
+    {
+        auto result = _image;
+        const auto count = _horizontal ? _w : _h;
+        const auto lines = _horizontal ? _h : _w;
+        const auto weights = uint64_t(_radius + 1) * (_radius + 1);
+
+        for (unsigned int line = 0; line < lines; ++line)
+        {
+            for (unsigned int i = 0; i < count; ++i)
+            {
+                for (int channel = 0; channel < 4; ++channel)
+                {
+                    uint64_t sum = 0;
+                    for (int k = -int(_radius); k <= int(_radius); ++k)
+                    {
+                        const auto pos = unsigned(std::clamp(int(i) + k, 0, int(count) - 1));
+                        const auto x = _horizontal ? pos : line;
+                        const auto y = _horizontal ? line : pos;
+                        sum += (_radius + 1 - unsigned(std::abs(k))) * _image[(size_t(y) * _w + x) * 4 + channel];
+                    }
+
+                    const auto x = _horizontal ? i : line;
+                    const auto y = _horizontal ? line : i;
+                    result[(size_t(y) * _w + x) * 4 + channel] = static_cast<unsigned char>(sum / weights);
+                }
+            }
+        }
+        return result;
+    }
+
+    // the algorithm divides by a multiply and a shift, which may be off by one from the exact mean
+    bool closeTo(const std::vector<unsigned char>& _image, const std::vector<unsigned char>& _reference)
+    {
+        for (size_t i = 0; i < _image.size(); ++i)
+        {
+            if (std::abs(int(_image[i]) - int(_reference[i])) > 1)
+                return false;
+        }
+        return true;
+    }
+
+    std::vector<unsigned char> blurPass(std::vector<unsigned char> _image, unsigned int _w, unsigned int _h, unsigned int _radius, int _step, StackBlurKernel _kernel)
+    {
+        std::vector<unsigned char> stack((_radius * 2 + 1) * 8);
+        stackblurJob(_image.data(), _w, _h, _radius, 1, 0, _step, stack.data(), _kernel);
+        return _image;
+    }
+
+    std::vector<unsigned char> blur(std::vector<unsigned char> _image, unsigned int _w, unsigned int _h, unsigned int _radius, int _cores, StackBlurKernel _kernel)
+    {
+        stackblur(_image.data(), _w, _h, _radius, _cores, _kernel);
+        return _image;
+    }
+
+    std::vector<StackBlurKernel> supportedKernels()
+    {
+        std::vector<StackBlurKernel> kernels;
+        for (const auto kernel : { StackBlurKernel::Scalar, StackBlurKernel::Sse2, StackBlurKernel::Avx2 })
+        {
+            if (isStackBlurKernelSupported(kernel))
+                kernels.push_back(kernel);
+        }
+        return kernels;
+    }
+
+    // odd sizes leave a single line to the kernels that blur lines in pairs, sizes below the radius repeat the edges
+    constexpr std::pair<unsigned int, unsigned int> sizes[] = { { 1, 1 }, { 1, 9 }, { 9, 1 }, { 2, 3 }, { 17, 13 }, { 64, 48 }, { 301, 199 } };
+    constexpr unsigned int radii[] = { minRadius(), 3, 10, 75, maxRadius() };
+
+    void test_passes_against_definition()
+    {
+        for (const auto kernel : supportedKernels())
+        {
+            for (const auto& [w, h] : sizes)
+            {
+                const auto image = noise(w, h, w * 31 + h);
+                for (const auto radius : radii)
+                {
+                    const auto name = caseName(kernel, w, h, radius);
+                    check(closeTo(blurPass(image, w, h, radius, 1, kernel), referencePass(image, w, h, radius, true)), name + ": horizontal pass");
+                    check(closeTo(blurPass(image, w, h, radius, 2, kernel), referencePass(image, w, h, radius, false)), name + ": vertical pass");
+                }
+            }
+        }
+    }
+
+    void test_kernels_match_scalar()
+    {
+        for (const auto kernel : supportedKernels())
+        {
+            if (kernel == StackBlurKernel::Scalar)
+                continue;
+
+            for (const auto& [w, h] : sizes)
+            {
+                const auto image = noise(w, h, w * 17 + h);
+                for (const auto radius : radii)
+                    check(blur(image, w, h, radius, 1, kernel) == blur(image, w, h, radius, 1, StackBlurKernel::Scalar), caseName(kernel, w, h, radius) + ": bit-exact with scalar");
+            }
+        }
+    }
+
+    void test_threads_match_single_thread()
+    {
+        constexpr unsigned int w = 301;
+        constexpr unsigned int h = 199;
+        const auto image = noise(w, h, 7);
+
+        for (const auto kernel : supportedKernels())
+        {
+            for (const auto cores : { 2, 3, 8 })
+                check(blur(image, w, h, 10, cores, kernel) == blur(image, w, h, 10, 1, kernel), caseName(kernel, w, h, 10) + ": " + std::to_string(cores) + " threads");
+        }
+    }
+
+    void test_plain_image_is_unchanged()
+    {
+        constexpr unsigned int w = 40;
+        constexpr unsigned int h = 30;
+
+        for (const auto kernel : supportedKernels())
+        {
+            for (const unsigned char value : { 0, 1, 128, 254, 255 })
+            {
+                const std::vector<unsigned char> image(size_t(w) * h * 4, value);
+                for (const auto radius : radii)
+                {
+                    const auto blurred = blur(image, w, h, radius, 1, kernel);
+                    check(closeTo(blurred, image), caseName(kernel, w, h, radius) + ": plain " + std::to_string(value));
+                }
+            }
+        }
+    }
+}
+
+int main()
+{
+    test_passes_against_definition();
+    test_kernels_match_scalar();
+    test_threads_match_single_thread();
+    test_plain_image_is_unchanged();
+
+    if (failures == 0)
+        std::cout << "all stackblur tests passed\n";
+
+    return failures == 0 ? 0 : 1;
+}
@@ -6,6 +6,7 @@
 #pragma once
 
 #include "omicron_conf.h"
+#include "omicron_key.h"
 
 namespace omicronlib
 {
@@ -79,21 +80,21 @@ namespace omicronlib
 
     //!@name Get a value from the omicron service.
     /*!
-        Functions from this group try to get the value of the required parameter \a _key_name with type as in \a _default_value.
-        If the \a _key_name with the required type is not found the user will get the default value \a _default_value.
-        \param[in] _key_name A parameter name.
+        Functions from this group try to get the value of the required parameter \a _key with type as in \a _default_value.
+        If the \a _key with the required type is not found the user will get the default value \a _default_value.
+        \param[in] _key A parameter name, the constants of omicron_keys.h are hashed at compile time.
         \param[in] _default_value A default value.
         \return A value with the same type as in \a _default_value.
     */
     //@{
-    bool _o(const char* _key_name, bool _default_value);
-    int _o(const char* _key_name, int _default_value);
-    unsigned int _o(const char* _key_name, unsigned int _default_value);
-    int64_t _o(const char* _key_name, int64_t _default_value);
-    uint64_t _o(const char* _key_name, uint64_t _default_value);
-    double _o(const char* _key_name, double _default_value);
-    std::string _o(const char* _key_name, const char* _default_value);
-    std::string _o(const char* _key_name, std::string _default_value);
-    json_string _o(const char* _key_name, json_string _default_value);
+    bool _o(const omicron_key& _key, bool _default_value);
+    int _o(const omicron_key& _key, int _default_value);
+    unsigned int _o(const omicron_key& _key, unsigned int _default_value);
+    int64_t _o(const omicron_key& _key, int64_t _default_value);
+    uint64_t _o(const omicron_key& _key, uint64_t _default_value);
+    double _o(const omicron_key& _key, double _default_value);
+    std::string _o(const omicron_key& _key, const char* _default_value);
+    std::string _o(const omicron_key& _key, std::string _default_value);
+    json_string _o(const omicron_key& _key, json_string _default_value);
     //@}
 }
@@ -0,0 +1,44 @@
+/*! \file omicron_key.h
+    \brief Omicron key with a precomputed hash (header).
+*/
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+namespace omicronlib
+{
+    //! FNV-1a hash of a key, the snapshot tables are built with it.
+    constexpr size_t hash_key(std::string_view _key_name) noexcept
+    {
+        uint64_t hash = 14695981039346656037ull;
+        for (const auto c : _key_name)
+        {
+            hash ^= static_cast<unsigned char>(c);
+            hash *= 1099511628211ull;
+        }
+        return static_cast<size_t>(hash);
+    }
+
+    //! A key of the omicron data and its hash.
+    /*!
+        The keys declared as constexpr (see omicron_keys.h) are hashed at compile time,
+        so a lookup by them is a table probe only. Keys built from a string at runtime are hashed once here.
+    */
+    class omicron_key
+    {
+    public:
+        constexpr omicron_key(const char* _name) noexcept
+            : name_(_name ? _name : "")
+            , hash_(hash_key(name_))
+        {
+        }
+
+        constexpr std::string_view name() const noexcept { return name_; }
+        constexpr size_t hash() const noexcept { return hash_; }
+
+    private:
+        std::string_view name_;
+        size_t hash_;
+    };
+}
@@ -0,0 +1,92 @@
+/*! \file omicron_snapshot.h
+    \brief Typed snapshot of omicron data (header).
+
+    Used by the library for lookups and by clients which receive the omicron data from another process.
+*/
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <rapidjson/document.h>
+
+#include "omicron_key.h"
+
+namespace omicronlib
+{
+    //! A value of the omicron data converted to all the types it can be read as.
+    struct snapshot_value
+    {
+        enum type_flags : unsigned int
+        {
+            is_bool = 1 << 0,
+            is_int = 1 << 1,
+            is_int64 = 1 << 2,
+            is_double = 1 << 3,
+            is_string = 1 << 4,
+            is_json = 1 << 5
+        };
+
+        unsigned int flags_ = 0;
+        bool bool_ = false;
+        int int_ = 0;
+        unsigned int uint_ = 0;
+        int64_t int64_ = 0;
+        uint64_t uint64_ = 0;
+        double double_ = 0.;
+        std::string string_; // a string value or an object/array serialized to json
+    };
+
+    //! Immutable typed copy of the omicron "config" object.
+    /*!
+        Values are converted once when new data arrives, a lookup hashes the key into a flat open addressing table.
+        For duplicate keys the first one is found, as with rapidjson FindMember.
+    */
+    class omicron_snapshot
+    {
+    public:
+        explicit omicron_snapshot(const rapidjson::Value& _config);
+
+        //! Find a value by a null-terminated key.
+        /*!
+            \return The value or nullptr if there is no such key.
+        */
+        const snapshot_value* find(const char* _key_name) const;
+
+        //! Find a value by a key hashed beforehand.
+        /*!
+            \return The value or nullptr if there is no such key.
+        */
+        const snapshot_value* find(const omicron_key& _key) const;
+
+        //! Find the index of a value by a key which is not necessarily null-terminated.
+        /*!
+            \return The index in [0, size()) or size() if there is no such key.
+        */
+        size_t find_index(const char* _key_name, size_t _key_size) const;
+
+        //! Find the index of a value by a key hashed beforehand.
+        /*!
+            \return The index in [0, size()) or size() if there is no such key.
+        */
+        size_t find_index(const omicron_key& _key) const;
+
+        size_t size() const noexcept { return entries_.size(); }
+        const snapshot_value& value_at(size_t _index) const { return entries_[_index].value_; }
+
+    private:
+        size_t find_index(size_t _hash, const char* _key_name, size_t _key_size) const;
+
+        struct entry
+        {
+            std::string name_;
+            size_t hash_;
+            snapshot_value value_;
+        };
+
+        std::vector<entry> entries_;
+        std::vector<uint32_t> table_; // entry index + 1, zero marks an empty slot
+        size_t mask_;
+    };
+}
@@ -45,48 +45,48 @@ namespace omicronlib
         return omicron_impl::instance().add_fingerprint(std::move(_name), std::move(_value));
     }
 
-    bool _o(const char* _key_name, bool _default_value)
+    bool _o(const omicron_key& _key, bool _default_value)
     {
-        return omicron_impl::instance().bool_value(_key_name, _default_value);
+        return omicron_impl::instance().bool_value(_key, _default_value);
     }
 
-    int _o(const char* _key_name, int _default_value)
+    int _o(const omicron_key& _key, int _default_value)
     {
-        return omicron_impl::instance().int_value(_key_name, _default_value);
+        return omicron_impl::instance().int_value(_key, _default_value);
     }
 
-    unsigned int _o(const char* _key_name, unsigned int _default_value)
+    unsigned int _o(const omicron_key& _key, unsigned int _default_value)
     {
-        return omicron_impl::instance().uint_value(_key_name, _default_value);
+        return omicron_impl::instance().uint_value(_key, _default_value);
     }
 
-    int64_t _o(const char* _key_name, int64_t _default_value)
+    int64_t _o(const omicron_key& _key, int64_t _default_value)
     {
-        return omicron_impl::instance().int64_value(_key_name, _default_value);
+        return omicron_impl::instance().int64_value(_key, _default_value);
     }
 
-    uint64_t _o(const char* _key_name, uint64_t _default_value)
+    uint64_t _o(const omicron_key& _key, uint64_t _default_value)
     {
-        return omicron_impl::instance().uint64_value(_key_name, _default_value);
+        return omicron_impl::instance().uint64_value(_key, _default_value);
     }
 
-    double _o(const char* _key_name, double _default_value)
+    double _o(const omicron_key& _key, double _default_value)
     {
-        return omicron_impl::instance().double_value(_key_name, _default_value);
+        return omicron_impl::instance().double_value(_key, _default_value);
     }
 
-    std::string _o(const char* _key_name, const char* _default_value)
+    std::string _o(const omicron_key& _key, const char* _default_value)
     {
-        return omicron_impl::instance().string_value(_key_name, _default_value);
+        return omicron_impl::instance().string_value(_key, _default_value);
     }
 
-    std::string _o(const char* _key_name, std::string _default_value)
+    std::string _o(const omicron_key& _key, std::string _default_value)
     {
-        return omicron_impl::instance().string_value(_key_name, std::move(_default_value));
+        return omicron_impl::instance().string_value(_key, std::move(_default_value));
     }
 
-    json_string _o(const char* _key_name, json_string _default_value)
+    json_string _o(const omicron_key& _key, json_string _default_value)
     {
-        return omicron_impl::instance().json_value(_key_name, std::move(_default_value));
+        return omicron_impl::instance().json_value(_key, std::move(_default_value));
     }
 }
@@ -7,6 +7,7 @@
 
 #include <omicron/omicron_conf.h>
 #include <omicron/omicron.h>
+#include <omicron/omicron_snapshot.h>
 
 #include "omicron_impl.h"
 
@@ -86,6 +87,8 @@ namespace omicronlib
         return *instance;
     }
 
+    omicron_impl::~omicron_impl() = default;
+
     omicron_code omicron_impl::init(const omicron_config& _conf, const std::wstring& _file_name)
     {
         config_ = make_unique<omicron_config>(_conf);
@@ -190,6 +193,7 @@ namespace omicronlib
 
         config_.reset();
         json_data_.reset();
+        snapshot_ = nullptr;
 
         last_update_status_ = OMICRON_NOT_INITIALIZED;
     }
@@ -210,111 +214,66 @@ namespace omicronlib
             config_->add_fingerprint(std::move(_name), std::move(_value));
     }
 
-    bool omicron_impl::bool_value(const char* _key_name, bool _default_value) const
+    bool omicron_impl::bool_value(const omicron_key& _key, bool _default_value) const
     {
-        if (is_json_data_init_)
-        {
-            const auto json_data = get_json_data();
-            const auto it = json_data->FindMember(_key_name);
-            if (it != json_data->MemberEnd() && it->value.IsBool())
-                return it->value.GetBool();
-        }
+        if (const auto value = find_value(_key, snapshot_value::is_bool))
+            return value->bool_;
 
         return _default_value;
     }
 
-    int omicron_impl::int_value(const char* _key_name, int _default_value) const
+    int omicron_impl::int_value(const omicron_key& _key, int _default_value) const
     {
-        if (is_json_data_init_)
-        {
-            const auto json_data = get_json_data();
-            const auto it = json_data->FindMember(_key_name);
-            if (it != json_data->MemberEnd() && it->value.IsInt())
-                return it->value.GetInt();
-        }
+        if (const auto value = find_value(_key, snapshot_value::is_int))
+            return value->int_;
 
         return _default_value;
     }
 
-    unsigned int omicron_impl::uint_value(const char* _key_name, unsigned int _default_value) const
+    unsigned int omicron_impl::uint_value(const omicron_key& _key, unsigned int _default_value) const
     {
-        if (is_json_data_init_)
-        {
-            const auto json_data = get_json_data();
-            const auto it = json_data->FindMember(_key_name);
-            if (it != json_data->MemberEnd() && it->value.IsInt())
-                return it->value.GetUint();
-        }
+        if (const auto value = find_value(_key, snapshot_value::is_int))
+            return value->uint_;
 
         return _default_value;
     }
 
-    int64_t omicron_impl::int64_value(const char* _key_name, int64_t _default_value) const
+    int64_t omicron_impl::int64_value(const omicron_key& _key, int64_t _default_value) const
     {
-        if (is_json_data_init_)
-        {
-            const auto json_data = get_json_data();
-            const auto it = json_data->FindMember(_key_name);
-            if (it != json_data->MemberEnd() && it->value.IsInt64())
-                return it->value.GetInt64();
-        }
+        if (const auto value = find_value(_key, snapshot_value::is_int64))
+            return value->int64_;
 
         return _default_value;
     }
 
-    uint64_t omicron_impl::uint64_value(const char* _key_name, uint64_t _default_value) const
+    uint64_t omicron_impl::uint64_value(const omicron_key& _key, uint64_t _default_value) const
     {
-        if (is_json_data_init_)
-        {
-            const auto json_data = get_json_data();
-            const auto it = json_data->FindMember(_key_name);
-            if (it != json_data->MemberEnd() && it->value.IsInt64())
-                return it->value.GetUint64();
-        }
+        if (const auto value = find_value(_key, snapshot_value::is_int64))
+            return value->uint64_;
 
         return _default_value;
     }
 
-    double omicron_impl::double_value(const char* _key_name, double _default_value) const
+    double omicron_impl::double_value(const omicron_key& _key, double _default_value) const
     {
-        if (is_json_data_init_)
-        {
-            const auto json_data = get_json_data();
-            const auto it = json_data->FindMember(_key_name);
-            if (it != json_data->MemberEnd() && it->value.IsDouble())
-                return it->value.GetDouble();
-        }
+        if (const auto value = find_value(_key, snapshot_value::is_double))
+            return value->double_;
 
         return _default_value;
     }
 
-    std::string omicron_impl::string_value(const char* _key_name, std::string _default_value) const
+    std::string omicron_impl::string_value(const omicron_key& _key, std::string _default_value) const
     {
-        if (is_json_data_init_)
-        {
-            const auto json_data = get_json_data();
-            const auto it = json_data->FindMember(_key_name);
-            if (it != json_data->MemberEnd() && it->value.IsString())
-                return std::string(it->value.GetString(), it->value.GetStringLength());
-        }
+        if (const auto value = find_value(_key, snapshot_value::is_string))
+            return value->string_;
 
         return _default_value;
     }
 
-    json_string omicron_impl::json_value(const char* _key_name, json_string _default_value) const
+    json_string omicron_impl::json_value(const omicron_key& _key, json_string _default_value) const
     {
-        if (is_json_data_init_)
-        {
-            const auto json_data = get_json_data();
-            const auto it = json_data->FindMember(_key_name);
-            if (it != json_data->MemberEnd() && (it->value.IsObject() || it->value.IsArray()))
-            {
-                rapidjson::StringBuffer buffer;
-                rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
-                it->value.Accept(writer);
-                return json_string(buffer.GetString(), buffer.GetSize());
-            }
-        }
+        if (const auto value = find_value(_key, snapshot_value::is_json))
+            return json_string(value->string_.data(), value->string_.size());
 
         return _default_value;
     }
@@ -322,6 +281,7 @@ namespace omicronlib
     omicron_impl::omicron_impl()
         : is_json_data_init_(false)
         , json_data_(std::make_shared<rapidjson::Document>(rapidjson::kObjectType))
+        , snapshot_(nullptr)
         , is_schedule_stop_(false)
         , is_updating_(false)
         , last_update_time_(std::chrono::system_clock::now())
@@ -396,6 +356,27 @@ namespace omicronlib
         return json_data_;
     }
 
+    const snapshot_value* omicron_impl::find_value(const omicron_key& _key, unsigned int _type_flags) const
+    {
+        const auto snapshot = snapshot_.load(std::memory_order_acquire);
+        if (!snapshot)
+            return nullptr;
+
+        const auto value = snapshot->find(_key);
+        return value && (value->flags_ & _type_flags) ? value : nullptr;
+    }
+
+    void omicron_impl::publish_snapshot(std::unique_ptr<const omicron_snapshot> _snapshot)
+    {
+        std::lock_guard<std::mutex> lock(snapshots_mutex_);
+
+        // the slot holds the snapshot published retained_snapshots() updates ago, it is freed once the new one is published
+        auto retired = std::move(snapshots_[next_snapshot_]);
+        snapshots_[next_snapshot_] = std::move(_snapshot);
+        snapshot_.store(snapshots_[next_snapshot_].get(), std::memory_order_release);
+        next_snapshot_ = (next_snapshot_ + 1) % snapshots_.size();
+    }
+
     std::string omicron_impl::get_json_data_string() const
     {
         if (is_json_data_init_)
@@ -512,6 +493,8 @@ namespace omicronlib
         auto new_json_data = std::make_shared<rapidjson::Document>(rapidjson::kObjectType);
         new_json_data->CopyFrom(it_config->value, new_json_data->GetAllocator());
 
+        std::unique_ptr<const omicron_snapshot> new_snapshot(new omicron_snapshot(*new_json_data));
+
         config_.swap(new_config);
 
         {
@@ -519,6 +502,8 @@ namespace omicronlib
             json_data_.swap(new_json_data);
         }
 
+        publish_snapshot(std::move(new_snapshot));
+
         if (!is_json_data_init_)
             is_json_data_init_ = true;
 
@@ -3,6 +3,12 @@
 namespace omicronlib
 {
     class omicron_config;
+    class omicron_snapshot;
+    struct snapshot_value;
+
+    // readers use the current snapshot without holding a reference, so a replaced snapshot lives on
+    // for this many updates; new data arrives a few times a day at most, no lookup takes that long
+    constexpr size_t retained_snapshots() noexcept { return 8; }
 
     namespace build
     {
@@ -20,6 +26,7 @@ namespace omicronlib
     {
     public:
         static omicron_impl& instance();
+        ~omicron_impl();
 
         omicron_code init(const omicron_config& _conf, const std::wstring& _file_name = {});
         bool start_auto_updater();
@@ -32,14 +39,14 @@ namespace omicronlib
         void add_fingerprint(std::string _name, std::string _value);
 
         // instance methods
-        bool bool_value(const char* _key_name, bool _default_value) const;
-        int int_value(const char* _key_name, int _default_value) const;
-        unsigned int uint_value(const char* _key_name, unsigned int _default_value) const;
-        int64_t int64_value(const char* _key_name, int64_t _default_value) const;
-        uint64_t uint64_value(const char* _key_name, uint64_t _default_value) const;
-        double double_value(const char* _key_name, double _default_value) const;
-        std::string string_value(const char* _key_name, std::string _default_value) const;
-        json_string json_value(const char* _key_name, json_string _default_value) const;
+        bool bool_value(const omicron_key& _key, bool _default_value) const;
+        int int_value(const omicron_key& _key, int _default_value) const;
+        unsigned int uint_value(const omicron_key& _key, unsigned int _default_value) const;
+        int64_t int64_value(const omicron_key& _key, int64_t _default_value) const;
+        uint64_t uint64_value(const omicron_key& _key, uint64_t _default_value) const;
+        double double_value(const omicron_key& _key, double _default_value) const;
+        std::string string_value(const omicron_key& _key, std::string _default_value) const;
+        json_string json_value(const omicron_key& _key, json_string _default_value) const;
 
     private:
         class spin_lock
@@ -62,6 +69,12 @@ namespace omicronlib
         std::shared_ptr<rapidjson::Document> json_data_;
         mutable spin_lock data_spin_lock_;
 
+        // readers use the current snapshot without locking, the last retained_snapshots() ones are kept in a ring
+        std::atomic<const omicron_snapshot*> snapshot_;
+        std::array<std::unique_ptr<const omicron_snapshot>, retained_snapshots()> snapshots_;
+        size_t next_snapshot_ = 0;
+        std::mutex snapshots_mutex_;
+
         std::atomic<bool> is_schedule_stop_;
         std::mutex schedule_mutex_;
         std::condition_variable schedule_condition_;
@@ -83,6 +96,8 @@ namespace omicronlib
         bool save(const std::string& _data) const;
 
         std::shared_ptr<const rapidjson::Document> get_json_data() const;
+        const snapshot_value* find_value(const omicron_key& _key, unsigned int _type_flags) const;
+        void publish_snapshot(std::unique_ptr<const omicron_snapshot> _snapshot);
         std::string get_json_data_string() const;
 
         omicron_code get_omicron_data(bool _is_save = true);
@@ -0,0 +1,135 @@
+#include "stdafx.h"
+
+#include <omicron/omicron_snapshot.h>
+
+namespace
+{
+    omicronlib::snapshot_value make_value(const rapidjson::Value& _json)
+    {
+        using value = omicronlib::snapshot_value;
+
+        // the same type checks and conversions the lookups did on the document
+        value result;
+        if (_json.IsBool())
+        {
+            result.flags_ |= value::is_bool;
+            result.bool_ = _json.GetBool();
+        }
+        if (_json.IsInt())
+        {
+            result.flags_ |= value::is_int;
+            result.int_ = _json.GetInt();
+            result.uint_ = static_cast<unsigned int>(result.int_);
+        }
+        if (_json.IsInt64())
+        {
+            result.flags_ |= value::is_int64;
+            result.int64_ = _json.GetInt64();
+            result.uint64_ = static_cast<uint64_t>(result.int64_);
+        }
+        if (_json.IsDouble())
+        {
+            result.flags_ |= value::is_double;
+            result.double_ = _json.GetDouble();
+        }
+        if (_json.IsString())
+        {
+            result.flags_ |= value::is_string;
+            result.string_.assign(_json.GetString(), _json.GetStringLength());
+        }
+        else if (_json.IsObject() || _json.IsArray())
+        {
+            result.flags_ |= value::is_json;
+
+            rapidjson::StringBuffer buffer;
+            rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+            _json.Accept(writer);
+            result.string_.assign(buffer.GetString(), buffer.GetSize());
+        }
+
+        return result;
+    }
+}
+
+namespace omicronlib
+{
+    omicron_snapshot::omicron_snapshot(const rapidjson::Value& _config)
+        : mask_(0)
+    {
+        if (!_config.IsObject())
+            return;
+
+        entries_.reserve(_config.MemberCount());
+        for (auto it = _config.MemberBegin(), end = _config.MemberEnd(); it != end; ++it)
+        {
+            if (!it->name.IsString())
+                continue;
+
+            entry e;
+            e.name_.assign(it->name.GetString(), it->name.GetStringLength());
+            e.hash_ = hash_key(e.name_);
+            e.value_ = make_value(it->value);
+            entries_.push_back(std::move(e));
+        }
+
+        size_t capacity = 4;
+        while (capacity < entries_.size() * 2)
+            capacity <<= 1;
+
+        table_.assign(capacity, 0);
+        mask_ = capacity - 1;
+
+        // members are inserted in document order, so for duplicate names the first one wins as with FindMember
+        for (size_t i = 0; i < entries_.size(); ++i)
+        {
+            auto pos = entries_[i].hash_ & mask_;
+            while (table_[pos] != 0)
+                pos = (pos + 1) & mask_;
+
+            table_[pos] = static_cast<uint32_t>(i + 1);
+        }
+    }
+
+    const snapshot_value* omicron_snapshot::find(const char* _key_name) const
+    {
+        if (entries_.empty() || !_key_name)
+            return nullptr;
+
+        return find(omicron_key(_key_name));
+    }
+
+    const snapshot_value* omicron_snapshot::find(const omicron_key& _key) const
+    {
+        const auto index = find_index(_key);
+        return index < entries_.size() ? &entries_[index].value_ : nullptr;
+    }
+
+    size_t omicron_snapshot::find_index(const char* _key_name, size_t _key_size) const
+    {
+        if (entries_.empty() || !_key_name)
+            return entries_.size();
+
+        return find_index(hash_key(std::string_view(_key_name, _key_size)), _key_name, _key_size);
+    }
+
+    size_t omicron_snapshot::find_index(const omicron_key& _key) const
+    {
+        if (entries_.empty())
+            return entries_.size();
+
+        return find_index(_key.hash(), _key.name().data(), _key.name().size());
+    }
+
+    size_t omicron_snapshot::find_index(size_t _hash, const char* _key_name, size_t _key_size) const
+    {
+        for (auto pos = _hash & mask_; table_[pos] != 0; pos = (pos + 1) & mask_)
+        {
+            const auto index = table_[pos] - 1;
+            const auto& e = entries_[index];
+            if (e.hash_ == _hash && e.name_.size() == _key_size && std::memcmp(e.name_.data(), _key_name, _key_size) == 0)
+                return index;
+        }
+
+        return entries_.size();
+    }
+}
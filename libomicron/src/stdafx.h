@@ -16,6 +16,7 @@
 #include <cctype>
 #include <cstdio>
 #include <cstdint>
+#include <cstring>
 #include <ctime>
 #include <iostream>
 #include <sstream>
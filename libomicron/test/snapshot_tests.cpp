@@ -0,0 +1,138 @@
+#include <cstring>
+#include <iostream>
+#include <string>
+
+#include <omicron/omicron_snapshot.h>
+
+using namespace omicronlib;
+
+namespace
+{
+    int failures = 0;
+
+    void check(bool _condition, const char* _what)
+    {
+        if (!_condition)
+        {
+            std::cout << "FAILED: " << _what << '\n';
+            ++failures;
+        }
+    }
+
+    omicron_snapshot make_snapshot(const char* _json, rapidjson::Document& _document)
+    {
+        _document.Parse(_json);
+        return omicron_snapshot(_document);
+    }
+
+    void test_types()
+    {
+        rapidjson::Document document;
+        const auto snapshot = make_snapshot(
+            "{ \"icq_bool\" : true, \"icq_int\" : -7, \"icq_int64\" : 8589934592, \"icq_float\" : 1.25,"
+            "  \"icq_string\" : \"bar\", \"icq_json\" : { \"a\" : [1, 2] }, \"icq_array\" : [\"x\"] }", document);
+
+        check(snapshot.size() == 7, "all the members are in the snapshot");
+
+        const auto b = snapshot.find("icq_bool");
+        check(b && b->flags_ == snapshot_value::is_bool && b->bool_, "bool");
+
+        const auto i = snapshot.find("icq_int");
+        check(i && (i->flags_ & snapshot_value::is_int) && i->int_ == -7, "int");
+        check(i && (i->flags_ & snapshot_value::is_int64) && i->int64_ == -7, "int is readable as int64");
+        check(i && !(i->flags_ & snapshot_value::is_double), "int is not a double, as with rapidjson IsDouble");
+
+        const auto i64 = snapshot.find("icq_int64");
+        check(i64 && !(i64->flags_ & snapshot_value::is_int) && i64->int64_ == 8589934592ll, "int64 out of the int range");
+
+        const auto d = snapshot.find("icq_float");
+        check(d && d->flags_ == snapshot_value::is_double && d->double_ == 1.25, "double");
+
+        const auto s = snapshot.find("icq_string");
+        check(s && s->flags_ == snapshot_value::is_string && s->string_ == "bar", "string");
+
+        const auto j = snapshot.find("icq_json");
+        check(j && j->flags_ == snapshot_value::is_json && j->string_ == "{\"a\":[1,2]}", "object as json");
+
+        const auto a = snapshot.find("icq_array");
+        check(a && a->flags_ == snapshot_value::is_json && a->string_ == "[\"x\"]", "array as json");
+    }
+
+    void test_lookups()
+    {
+        rapidjson::Document document;
+        const auto snapshot = make_snapshot("{ \"key\" : 1, \"key_longer\" : 2, \"key\" : 3 }", document);
+
+        check(snapshot.find("missing") == nullptr, "a missing key");
+        check(snapshot.find("ke") == nullptr, "a prefix of a key");
+        check(snapshot.find(nullptr) == nullptr, "a null key");
+
+        const auto dup = snapshot.find("key");
+        check(dup && dup->int_ == 1, "the first of duplicate keys wins");
+
+        // a key cut out of a longer buffer
+        const char buffer[] = "key_longer_and_more";
+        const auto index = snapshot.find_index(buffer, 3);
+        check(index < snapshot.size() && snapshot.value_at(index).int_ == 1, "a not null-terminated key");
+
+        const auto longer = snapshot.find_index(buffer, std::strlen("key_longer"));
+        check(longer < snapshot.size() && snapshot.value_at(longer).int_ == 2, "a not null-terminated longer key");
+
+        check(snapshot.find_index("nope", 4) == snapshot.size(), "a missing key by index");
+
+        // keys declared as in omicron_keys.h are hashed by the compiler
+        constexpr omicronlib::omicron_key key = "key_longer";
+        static_assert(key.hash() == omicronlib::hash_key("key_longer"), "the key is hashed at compile time");
+
+        const auto hashed = snapshot.find(key);
+        check(hashed && hashed->int_ == 2, "a key hashed beforehand");
+        check(snapshot.find_index(key) == longer, "the index of a key hashed beforehand");
+
+        constexpr omicronlib::omicron_key missing = "key_long";
+        check(snapshot.find(missing) == nullptr, "a missing key hashed beforehand");
+    }
+
+    void test_empty()
+    {
+        rapidjson::Document empty_object;
+        const auto empty = make_snapshot("{}", empty_object);
+        check(empty.size() == 0 && empty.find("key") == nullptr, "an empty config");
+
+        rapidjson::Document not_object;
+        const auto array = make_snapshot("[1, 2]", not_object);
+        check(array.size() == 0 && array.find_index("key", 3) == 0, "a config which is not an object");
+    }
+
+    void test_many_keys()
+    {
+        std::string json = "{";
+        for (int i = 0; i < 1000; ++i)
+            json += (i ? ",\"key_" : "\"key_") + std::to_string(i) + "\":" + std::to_string(i);
+        json += "}";
+
+        rapidjson::Document document;
+        const auto snapshot = make_snapshot(json.c_str(), document);
+
+        auto all_found = true;
+        for (int i = 0; i < 1000 && all_found; ++i)
+        {
+            const auto value = snapshot.find(("key_" + std::to_string(i)).c_str());
+            all_found = value && value->int_ == i;
+        }
+        check(all_found, "every key of a large config is found");
+        check(snapshot.find("key_1000") == nullptr, "a missing key in a large config");
+    }
+}
+
+int main()
+{
+    test_types();
+    test_lookups();
+    test_empty();
+    test_many_keys();
+
+    if (failures == 0)
+        std::cout << "all snapshot tests passed\n";
+
+    return failures == 0 ? 0 : 1;
+}